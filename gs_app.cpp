@@ -99,6 +99,12 @@ GS_Application::GS_Application()
     m_fFrameRate = GS_DEFAULT_FPS;
     m_fFrameTime = 0.0f;
     m_fWaitTime  = 0.0f;
+
+    // Headless rendering is only supported by the SDL implementation.
+    m_bIsHeadless       = FALSE;
+    m_nHeadlessFrames   = 0;
+    m_nNumFrames        = 0;
+    m_szReadbackFile[0] = '\0';
 }
 
 
@@ -913,6 +919,33 @@ GS_Application::GS_Application()
     m_fFrameRate = GS_DEFAULT_FPS;
     m_fFrameTime = 0.0f;
     m_fWaitTime  = 0.0f;
+
+    m_bIsHeadless       = FALSE;
+    m_nHeadlessFrames   = 0;
+    m_nNumFrames        = 0;
+    m_szReadbackFile[0] = '\0';
+
+    // The application is created before main() is called, so a headless run for benchmarks is
+    // requested through the environment rather than the command line.
+    const char* pszValue = getenv(GS_HEADLESS_ENV);
+    if (pszValue && atoi(pszValue) > 0)
+    {
+        m_bIsHeadless = TRUE;
+
+        pszValue = getenv(GS_HEADLESS_FRAMES_ENV);
+        m_nHeadlessFrames = pszValue ? atoi(pszValue) : GS_HEADLESS_FRAMES;
+        if (m_nHeadlessFrames <= 0)
+        {
+            m_nHeadlessFrames = GS_HEADLESS_FRAMES;
+        }
+
+        pszValue = getenv(GS_HEADLESS_READBACK_ENV);
+        if (pszValue)
+        {
+            strncpy(m_szReadbackFile, pszValue, _MAX_PATH - 1);
+            m_szReadbackFile[_MAX_PATH - 1] = '\0';
+        }
+    }
 }
 
 GS_Application::~GS_Application()
@@ -961,6 +994,14 @@ BOOL GS_Application::Create(int nWidth, int nHeight, int nDepth, BOOL bIsWindowe
     }
 #endif
 
+    if (m_bIsHeadless)
+    {
+        // Render into the EGL pbuffer of SDL's offscreen driver and play sound into the dummy
+        // driver, so no display or audio device is needed (unless other drivers are chosen).
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    }
+
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0)
     {
@@ -977,10 +1018,10 @@ BOOL GS_Application::Create(int nWidth, int nHeight, int nDepth, BOOL bIsWindowe
     m_nDisplayWidth  = (nWidth > 0) ? nWidth : GS_DEFAULT_WIDTH;
     m_nDisplayHeight = (nHeight > 0) ? nHeight : GS_DEFAULT_HEIGHT;
     m_nColorDepth    = (nDepth > 0) ? nDepth : GS_DEFAULT_DEPTH;
-    m_bIsWindowed    = bIsWindowed;
+    m_bIsWindowed    = bIsWindowed || m_bIsHeadless;
 
     // Get desktop dimensions for fullscreen mode
-    if (!bIsWindowed)
+    if (!m_bIsWindowed)
     {
         SDL_DisplayMode dm;
         if (SDL_GetDesktopDisplayMode(0, &dm) == 0)
@@ -990,8 +1031,16 @@ BOOL GS_Application::Create(int nWidth, int nHeight, int nDepth, BOOL bIsWindowe
         }
     }
 
-    Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN;
-    if (!bIsWindowed)
+    Uint32 flags = SDL_WINDOW_OPENGL;
+    if (m_bIsHeadless)
+    {
+        flags |= SDL_WINDOW_HIDDEN;
+    }
+    else
+    {
+        flags |= SDL_WINDOW_SHOWN;
+    }
+    if (!m_bIsWindowed)
     {
         flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
     }
@@ -1023,6 +1072,12 @@ BOOL GS_Application::Create(int nWidth, int nHeight, int nDepth, BOOL bIsWindowe
     // Make context current
     SDL_GL_MakeCurrent(m_pWindow, m_glContext);
 
+    // Never wait for a vertical blank in headless runs.
+    if (m_bIsHeadless)
+    {
+        SDL_GL_SetSwapInterval(0);
+    }
+
     // Set up client rect
     m_rcWindowClient.left = 0;
     m_rcWindowClient.top = m_nDisplayHeight;
@@ -1093,7 +1148,7 @@ INT GS_Application::Run()
     SDL_Event event;
     bool running = true;
 
-    if (m_fFrameRate > 0.0f)
+    if ((m_fFrameRate > 0.0f) && (!m_bIsHeadless))
     {
         m_fWaitTime = 1000.0f / m_fFrameRate;
     }
@@ -1102,11 +1157,26 @@ INT GS_Application::Run()
         m_fWaitTime = 0.0f;
     }
 
+    // Let the frame limiter hold the frame-rate instead of polling the frame timer.
+    m_gsFrameLimiter.SetFrameRate(m_bIsHeadless ? 0.0f : m_fFrameRate);
+    m_gsFrameLimiter.Reset();
+    m_gsFrameLimiter.ResetStats();
+
+    // Time the whole run when headless.
+    GS_Timer gsRunTimer;
+    m_nNumFrames = 0;
+
     // Enable text input for WM_CHAR simulation
     SDL_StartTextInput();
 
     while (running)
     {
+        // Sleep until the next frame is due, then read the input so it is as fresh as possible.
+        if (m_bIsActive && m_bIsReady)
+        {
+            m_gsFrameLimiter.Wait();
+        }
+
         while (SDL_PollEvent(&event))
         {
             if (event.type == SDL_QUIT)
@@ -1129,6 +1199,7 @@ INT GS_Application::Run()
                     {
                         GameRestore();
                         m_gsFrameTimer.MarkFrame();
+                        m_gsFrameLimiter.Reset();
                         m_bIsActive = TRUE;
                     }
                 }
@@ -1298,19 +1369,17 @@ INT GS_Application::Run()
 
         if (m_bIsActive && m_bIsReady)
         {
-            if ((m_fFrameTime = m_gsFrameTimer.GetFrameTime()) >= m_fWaitTime)
+            m_fFrameTime = m_gsFrameTimer.GetFrameTime();
+            m_gsFrameTimer.MarkFrame();
+            if (TRUE != GameLoop())
             {
-                m_gsFrameTimer.MarkFrame();
-                if (TRUE != GameLoop())
-                {
-                    GS_Error::Report("GS_APP.CPP", 165, "Error running main game loop!");
-                    running = false;
-                }
+                GS_Error::Report("GS_APP.CPP", 165, "Error running main game loop!");
+                running = false;
             }
-            else
+            // Stop once a headless run has completed its frames.
+            if ((m_bIsHeadless) && (++m_nNumFrames >= m_nHeadlessFrames))
             {
-                // Small delay to prevent busy-waiting
-                SDL_Delay(1);
+                running = false;
             }
         }
         else
@@ -1320,6 +1389,16 @@ INT GS_Application::Run()
     }
 
     SDL_StopTextInput();
+
+    if (m_bIsHeadless)
+    {
+        // Report the throughput on the console, there is no one to click a message box away.
+        float fRunTime   = gsRunTimer.GetTime();
+        float fFrameRate = (fRunTime > 0.0f) ? (m_nNumFrames * 1000.0f) / fRunTime : 0.0f;
+        printf("Headless run: %d frames in %0.2f ms (%0.2f frames per second).\n",
+               m_nNumFrames, fRunTime, fFrameRate);
+    }
+
     this->Destroy();
     return 0;
 }
@@ -1352,7 +1431,8 @@ void GS_Application::SetFrameRate(float fFrameRate)
 {
     m_fFrameRate = fFrameRate;
 
-    if (m_fFrameRate > 0.0f)
+    // Headless runs are never throttled.
+    if ((m_fFrameRate > 0.0f) && (!m_bIsHeadless))
     {
         m_fWaitTime = 1000.0f / m_fFrameRate;
     }
@@ -1360,13 +1440,17 @@ void GS_Application::SetFrameRate(float fFrameRate)
     {
         m_fWaitTime = 0.0f;
     }
+
+    m_gsFrameLimiter.SetFrameRate(m_fWaitTime > 0.0f ? m_fFrameRate : 0.0f);
 }
 
 void GS_Application::ShowFrameRate()
 {
-    char outputString[128] = { 0 };
-    sprintf(outputString, "The program ran at an average of %0.2f frames per second.",
-            m_gsFrameTimer.GetFrameRate());
+    char outputString[256] = { 0 };
+    sprintf(outputString, "The program ran at an average of %0.2f frames per second. Frames "
+            "started %0.3f ms late on average (%0.3f ms deviation, %0.3f ms at most).",
+            m_gsFrameTimer.GetFrameRate(), m_gsFrameLimiter.GetMeanJitter(),
+            m_gsFrameLimiter.GetJitterDeviation(), m_gsFrameLimiter.GetMaxJitter());
     MessageBox(NULL, outputString, "GAME INFORMATION", MB_OK | MB_ICONINFORMATION);
 }
 
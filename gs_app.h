@@ -27,6 +27,11 @@
 #define GS_DEFAULT_DEPTH  32
 #define GS_DEFAULT_MODE   1
 #define GS_DEFAULT_FPS    60.0f
+// ---------------------------------------------------------------------------------------------
+#define GS_HEADLESS_ENV          "GS_HEADLESS"          // Set to 1 to render without a display.
+#define GS_HEADLESS_FRAMES_ENV   "GS_HEADLESS_FRAMES"   // Number of frames a headless run lasts.
+#define GS_HEADLESS_READBACK_ENV "GS_HEADLESS_READBACK" // TGA file the last frame is saved to.
+#define GS_HEADLESS_FRAMES       1000
 //==============================================================================================
 
 
@@ -48,6 +53,7 @@
 // Include standard C library header files.
 // ---------------------------------------------------------------------------------------------
 #include <stdio.h>
+#include <stdlib.h>
 //==============================================================================================
 
 
@@ -104,6 +110,13 @@ private:
     float         m_fFrameTime;   // Time it took to complete the last frame.
     float         m_fWaitTime;    // Time to wait between frames.
 
+    GS_FrameLimiter m_gsFrameLimiter; // Holds the frame-rate by sleeping between frames (SDL).
+
+    BOOL  m_bIsHeadless;     // Whether application renders offscreen without a display.
+    int   m_nHeadlessFrames; // Number of frames to run before quitting when headless.
+    int   m_nNumFrames;      // Number of frames run so far.
+    char  m_szReadbackFile[_MAX_PATH]; // File the last frame is saved to when headless.
+
 protected:
 
     virtual BOOL GameInit()
@@ -204,6 +217,10 @@ public:
     {
         return m_fFrameTime;
     }
+    GS_FrameLimiter* GetFrameLimiter()
+    {
+        return &m_gsFrameLimiter;
+    }
 
     void SetTitle(LPCTSTR lpString)
     {
@@ -230,6 +247,15 @@ public:
     {
         return m_bIsWindowed;
     }
+    BOOL IsHeadless()
+    {
+        return m_bIsHeadless;
+    }
+
+    LPCTSTR GetReadbackFile()
+    {
+        return (m_szReadbackFile[0] != '\0') ? m_szReadbackFile : NULL;
+    }
 
     void Pause(BOOL bPause)
     {
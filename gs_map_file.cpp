@@ -0,0 +1,1004 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_map_file.cpp, gs_map_file.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_MapFile                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Reads and writes tile maps, either as the text files of GS_OGLMap::LoadMap() or in  |
+ |        a versioned binary format with a header (dimensions, tile size, start position)     |
+ |        followed by run length encoded tile IDs. Files are read and written in one go.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_map_file.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GS_MapFile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_MapFile::GS_MapFile()
+{
+
+    memset(&m_gsHeader, 0, sizeof(GS_MapFileHeader));
+    m_gsHeader.nStartCol = -1;
+    m_gsHeader.nStartRow = -1;
+
+    m_pnTileIDs = NULL;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::~GS_MapFile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_MapFile::~GS_MapFile()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates a map of the specified size holding the tile IDs in the array (row by row,
+//          the bottom row first), or only empty cells if no array is specified.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::Create(int nNumRows, int nNumCols, const int* pnTileIDs)
+{
+
+    // Destroy map if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    // Is the map too small or too big to fit in memory?
+    if ((nNumRows <= 0) || (nNumCols <= 0) || (nNumCols > (GS_MAP_FILE_MAX_CELLS / nNumRows)))
+    {
+        return FALSE;
+    }
+
+    m_pnTileIDs = new int[nNumRows * nNumCols];
+
+    for (int nCell = 0; nCell < (nNumRows * nNumCols); nCell++)
+    {
+        m_pnTileIDs[nCell] = (pnTileIDs != NULL) ? pnTileIDs[nCell] : -1;
+    }
+
+    m_gsHeader.nNumRows = nNumRows;
+    m_gsHeader.nNumCols = nNumCols;
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees the tile IDs and resets the header.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::Destroy()
+{
+
+    GS_SAFE_DELETE_ARRAY(m_pnTileIDs);
+
+    memset(&m_gsHeader, 0, sizeof(GS_MapFileHeader));
+    m_gsHeader.nStartCol = -1;
+    m_gsHeader.nStartRow = -1;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether the map holds any tiles.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it does, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Load/Save Methods. //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::Load():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads the whole file with a single read and loads the map from it.
+// ---------------------------------------------------------------------------------------------
+// Details: Binary map files carry their own dimensions, the number of rows and columns are
+//          only needed for text map files.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::Load(const char* pszPathname, int nNumRows, int nNumCols)
+{
+
+    if (NULL == pszPathname)
+    {
+        return FALSE;
+    }
+
+    GS_File gsMapFile;
+
+    // Were we able to open the file for reading?
+    if (FALSE == gsMapFile.Open(pszPathname, FILE_READ))
+    {
+        return FALSE;
+    }
+
+    unsigned long ulLength = gsMapFile.GetLength();
+
+    if ((ulLength == 0) || (ulLength > INT_MAX))
+    {
+        gsMapFile.Close();
+        return FALSE;
+    }
+
+    BYTE* pBuffer = new BYTE[ulLength];
+
+    unsigned long ulBytesRead = gsMapFile.Read(pBuffer, ulLength);
+
+    // Close the map file.
+    gsMapFile.Close();
+
+    BOOL bResult = FALSE;
+
+    if (ulBytesRead == ulLength)
+    {
+        bResult = this->LoadFromMemory(pBuffer, (int) ulLength, nNumRows, nNumCols);
+    }
+
+    delete[] pBuffer;
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::LoadFromMemory():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads the map from the contents of a binary or text map file already in memory.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::LoadFromMemory(const BYTE* pData, int nSize, int nNumRows, int nNumCols)
+{
+
+    if ((NULL == pData) || (nSize <= 0))
+    {
+        return FALSE;
+    }
+
+    if (!GS_MapFile::IsBinary(pData, nSize))
+    {
+        // Without a header we need to be told the size of the map.
+        if (!this->Create(nNumRows, nNumCols))
+        {
+            return FALSE;
+        }
+
+        return this->ParseText(pData, nSize, nNumRows, nNumCols);
+    }
+
+    GS_MapFileHeader gsHeader;
+    GS_MapFile::ReadHeader(pData, &gsHeader);
+
+    // Is the header one we understand?
+    if ((gsHeader.nVersion < 1) || (gsHeader.nVersion > GS_MAP_FILE_VERSION) ||
+        ((gsHeader.nCompression != GS_MAP_FILE_RAW) &&
+         (gsHeader.nCompression != GS_MAP_FILE_RLE)) ||
+        ((gsHeader.nTileBytes != 1) && (gsHeader.nTileBytes != 2)) ||
+        (gsHeader.nDataSize < 0) ||
+        (gsHeader.nDataSize > (nSize - GS_MAP_FILE_HEADER_SIZE)))
+    {
+        GS_Error::Report("GS_MAP_FILE.CPP", 263, "Unsupported map file!");
+        return FALSE;
+    }
+
+    // Check the size of the map before allocating anything for it.
+    if ((gsHeader.nNumRows <= 0) || (gsHeader.nNumCols <= 0) ||
+        (gsHeader.nNumCols > (GS_MAP_FILE_MAX_CELLS / gsHeader.nNumRows)))
+    {
+        GS_Error::Report("GS_MAP_FILE.CPP", 270, "Invalid map size!");
+        return FALSE;
+    }
+
+    // Raw tile data holds every cell, run length encoded data at least one run per
+    // GS_MAP_FILE_MAX_RUN cells and at most one run per cell.
+    int nNumCells = gsHeader.nNumRows * gsHeader.nNumCols;
+    int nMinSize  = nNumCells * gsHeader.nTileBytes;
+    int nMaxSize  = nMinSize;
+
+    if (gsHeader.nCompression == GS_MAP_FILE_RLE)
+    {
+        nMinSize = ((nNumCells + GS_MAP_FILE_MAX_RUN - 1) / GS_MAP_FILE_MAX_RUN) *
+                   (gsHeader.nTileBytes + 1);
+        nMaxSize = nNumCells * (gsHeader.nTileBytes + 1);
+    }
+
+    if ((gsHeader.nDataSize < nMinSize) || (gsHeader.nDataSize > nMaxSize))
+    {
+        GS_Error::Report("GS_MAP_FILE.CPP", 289, "Corrupt map file!");
+        return FALSE;
+    }
+
+    if (!this->Create(gsHeader.nNumRows, gsHeader.nNumCols))
+    {
+        return FALSE;
+    }
+
+    m_gsHeader = gsHeader;
+
+    if (!this->DecodeTiles(pData + GS_MAP_FILE_HEADER_SIZE, gsHeader.nDataSize))
+    {
+        GS_Error::Report("GS_MAP_FILE.CPP", 302, "Corrupt map file!");
+        this->Destroy();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::Save():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the map as a binary map file with a single write. Tile IDs are stored in a
+//          byte each unless one of them needs two.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::Save(const char* pszPathname, int nCompression)
+{
+
+    if (NULL == pszPathname)
+    {
+        return FALSE;
+    }
+
+    int nSize = this->SaveToMemory(NULL, nCompression);
+
+    if (nSize <= 0)
+    {
+        return FALSE;
+    }
+
+    BYTE* pBuffer = new BYTE[nSize];
+    this->SaveToMemory(pBuffer, nCompression);
+
+    GS_File gsMapFile;
+    BOOL    bResult = FALSE;
+
+    // Were we able to open the file for writing?
+    if (gsMapFile.Open(pszPathname, FILE_WRITE))
+    {
+        bResult = (gsMapFile.Write(pBuffer, nSize) == (unsigned long) nSize);
+        gsMapFile.Close();
+    }
+
+    delete[] pBuffer;
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::SaveToMemory():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the map in the binary map format into the buffer, or only works out how many
+//          bytes that takes if no buffer is specified.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bytes of the binary map, 0 if failed.
+//==============================================================================================
+
+int GS_MapFile::SaveToMemory(BYTE* pBuffer, int nCompression)
+{
+
+    if (!m_bIsReady)
+    {
+        return 0;
+    }
+
+    if ((nCompression != GS_MAP_FILE_RAW) && (nCompression != GS_MAP_FILE_RLE))
+    {
+        return 0;
+    }
+
+    // Use two bytes per tile ID if any of them does not fit in one.
+    m_gsHeader.nTileBytes = 1;
+
+    for (int nCell = 0; nCell < (m_gsHeader.nNumRows * m_gsHeader.nNumCols); nCell++)
+    {
+        if (m_pnTileIDs[nCell] >= 0xFF)
+        {
+            m_gsHeader.nTileBytes = 2;
+            break;
+        }
+    }
+
+    memcpy(m_gsHeader.szMagic, GS_MAP_FILE_MAGIC, 4);
+    m_gsHeader.nVersion     = GS_MAP_FILE_VERSION;
+    m_gsHeader.nCompression = nCompression;
+    m_gsHeader.nDataSize    = this->EncodeTiles(NULL, nCompression);
+
+    if (pBuffer != NULL)
+    {
+        GS_MapFile::WriteHeader(pBuffer, &m_gsHeader);
+        this->EncodeTiles(pBuffer + GS_MAP_FILE_HEADER_SIZE, nCompression);
+    }
+
+    return GS_MAP_FILE_HEADER_SIZE + m_gsHeader.nDataSize;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::SaveText():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the map as a text map file with a single write, the top row first and one
+//          character per tile (see CharToTileID()).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::SaveText(const char* pszPathname)
+{
+
+    if ((NULL == pszPathname) || (!m_bIsReady))
+    {
+        return FALSE;
+    }
+
+    int   nNumRows = m_gsHeader.nNumRows;
+    int   nNumCols = m_gsHeader.nNumCols;
+    int   nSize    = nNumRows * (nNumCols + 2);
+    BYTE* pBuffer  = new BYTE[nSize];
+    int   nOffset  = 0;
+
+    for (int nRow = nNumRows - 1; nRow >= 0; nRow--)
+    {
+        for (int nCol = 0; nCol < nNumCols; nCol++)
+        {
+            pBuffer[nOffset++] = (BYTE) GS_MapFile::TileIDToChar(this->GetTileID(nRow, nCol));
+        }
+
+        // Write end of line characters.
+        pBuffer[nOffset++] = 0x0D;
+        pBuffer[nOffset++] = 0x0A;
+    }
+
+    GS_File gsMapFile;
+    BOOL    bResult = FALSE;
+
+    // Were we able to open the file for writing?
+    if (gsMapFile.Open(pszPathname, FILE_WRITE))
+    {
+        bResult = (gsMapFile.Write(pBuffer, nSize) == (unsigned long) nSize);
+        gsMapFile.Close();
+    }
+
+    delete[] pBuffer;
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::ParseText():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads the tile IDs from the contents of a text map file, which holds the top row
+//          first. Cells missing at the end of the file are left empty.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::ParseText(const BYTE* pData, int nSize, int nNumRows, int nNumCols)
+{
+
+    int nOffset = 0;
+
+    for (int nRow = nNumRows - 1; nRow >= 0; nRow--)
+    {
+        for (int nCol = 0; nCol < nNumCols; nCol++)
+        {
+            // Skip all end of line characters.
+            while ((nOffset < nSize) && ((pData[nOffset] == 0x0A) || (pData[nOffset] == 0x0D)))
+            {
+                nOffset++;
+            }
+
+            if (nOffset < nSize)
+            {
+                m_pnTileIDs[(nRow * nNumCols) + nCol] = GS_MapFile::CharToTileID(pData[nOffset++]);
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::ReadHeader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads the header at the start of a binary map file, putting together each value from
+//          its bytes (the lowest first) so it does not matter what byte order the host uses.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::ReadHeader(const BYTE* pData, GS_MapFileHeader* pHeader)
+{
+
+    int* pnValues[] =
+    {
+        &pHeader->nVersion, &pHeader->nCompression, &pHeader->nNumRows, &pHeader->nNumCols,
+        &pHeader->nTileBytes, &pHeader->nTileWidth, &pHeader->nTileHeight,
+        &pHeader->nStartCol, &pHeader->nStartRow, &pHeader->nDataSize
+    };
+
+    memcpy(pHeader->szMagic, pData, 4);
+    pData += 4;
+
+    for (int nLoop = 0; nLoop < (int) (sizeof(pnValues) / sizeof(pnValues[0])); nLoop++)
+    {
+        unsigned int unValue = (unsigned int) pData[0] | ((unsigned int) pData[1] << 8) |
+                               ((unsigned int) pData[2] << 16) | ((unsigned int) pData[3] << 24);
+
+        *pnValues[nLoop] = (int) unValue;
+        pData += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::WriteHeader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the header of a binary map file into the buffer, each value as four bytes
+//          with the lowest first.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::WriteHeader(BYTE* pBuffer, const GS_MapFileHeader* pHeader)
+{
+
+    int nValues[] =
+    {
+        pHeader->nVersion, pHeader->nCompression, pHeader->nNumRows, pHeader->nNumCols,
+        pHeader->nTileBytes, pHeader->nTileWidth, pHeader->nTileHeight,
+        pHeader->nStartCol, pHeader->nStartRow, pHeader->nDataSize
+    };
+
+    memcpy(pBuffer, pHeader->szMagic, 4);
+    pBuffer += 4;
+
+    for (int nLoop = 0; nLoop < (int) (sizeof(nValues) / sizeof(nValues[0])); nLoop++)
+    {
+        unsigned int unValue = (unsigned int) nValues[nLoop];
+
+        pBuffer[0] = (BYTE) (unValue & 0xFF);
+        pBuffer[1] = (BYTE) ((unValue >> 8) & 0xFF);
+        pBuffer[2] = (BYTE) ((unValue >> 16) & 0xFF);
+        pBuffer[3] = (BYTE) ((unValue >> 24) & 0xFF);
+        pBuffer += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::DecodeTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Decodes the tile data following the header of a binary map file.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the data fills the map exactly, FALSE if it is corrupt.
+//==============================================================================================
+
+BOOL GS_MapFile::DecodeTiles(const BYTE* pData, int nSize)
+{
+
+    int nNumCells  = m_gsHeader.nNumRows * m_gsHeader.nNumCols;
+    int nTileBytes = m_gsHeader.nTileBytes;
+    int nEmpty     = (nTileBytes == 1) ? 0xFF : 0xFFFF;
+    int nRecord    = (m_gsHeader.nCompression == GS_MAP_FILE_RLE) ? nTileBytes + 1 : nTileBytes;
+    int nOffset    = 0;
+    int nCell      = 0;
+
+    while ((nOffset + nRecord) <= nSize)
+    {
+        int nCount = 1;
+
+        if (m_gsHeader.nCompression == GS_MAP_FILE_RLE)
+        {
+            nCount = pData[nOffset++];
+        }
+
+        int nTileID = pData[nOffset++];
+
+        if (nTileBytes == 2)
+        {
+            nTileID |= pData[nOffset++] << 8;
+        }
+
+        if ((nCount == 0) || ((nCell + nCount) > nNumCells))
+        {
+            return FALSE;
+        }
+
+        for (int nLoop = 0; nLoop < nCount; nLoop++)
+        {
+            m_pnTileIDs[nCell++] = (nTileID == nEmpty) ? -1 : nTileID;
+        }
+    }
+
+    return ((nCell == nNumCells) && (nOffset == nSize));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::EncodeTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Encodes the tile IDs into the buffer with the tile size set in the header, or only
+//          works out how many bytes that takes if no buffer is specified.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bytes of tile data.
+//==============================================================================================
+
+int GS_MapFile::EncodeTiles(BYTE* pBuffer, int nCompression)
+{
+
+    int nNumCells  = m_gsHeader.nNumRows * m_gsHeader.nNumCols;
+    int nTileBytes = m_gsHeader.nTileBytes;
+    int nEmpty     = (nTileBytes == 1) ? 0xFF : 0xFFFF;
+    int nOffset    = 0;
+    int nCell      = 0;
+
+    while (nCell < nNumCells)
+    {
+        int nTileID = m_pnTileIDs[nCell];
+        int nCount  = 1;
+
+        if (nCompression == GS_MAP_FILE_RLE)
+        {
+            // Count how many cells in a row hold the same tile ID.
+            while (((nCell + nCount) < nNumCells) && (nCount < GS_MAP_FILE_MAX_RUN) &&
+                   (m_pnTileIDs[nCell + nCount] == nTileID))
+            {
+                nCount++;
+            }
+
+            if (pBuffer != NULL)
+            {
+                pBuffer[nOffset] = (BYTE) nCount;
+            }
+            nOffset++;
+        }
+
+        // Anything that does not fit is written as an empty cell.
+        if ((nTileID < 0) || (nTileID >= nEmpty))
+        {
+            nTileID = nEmpty;
+        }
+
+        if (pBuffer != NULL)
+        {
+            pBuffer[nOffset] = (BYTE) (nTileID & 0xFF);
+
+            if (nTileBytes == 2)
+            {
+                pBuffer[nOffset + 1] = (BYTE) ((nTileID >> 8) & 0xFF);
+            }
+        }
+        nOffset += nTileBytes;
+
+        nCell += nCount;
+    }
+
+    return nOffset;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::IsBinary():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether the data starts with the header of a binary map file.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it does, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapFile::IsBinary(const BYTE* pData, int nSize)
+{
+
+    if ((NULL == pData) || (nSize < GS_MAP_FILE_HEADER_SIZE))
+    {
+        return FALSE;
+    }
+
+    return (memcmp(pData, GS_MAP_FILE_MAGIC, 4) == 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::CharToTileID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a character of a text map file to a tile ID, '0' - '9' to 0 - 9, 'A' - 'Z'
+//          to 10 - 35 and 'a' - 'z' to 36 - 61.
+// ---------------------------------------------------------------------------------------------
+// Returns: The tile ID, or -1 for any other character.
+//==============================================================================================
+
+int GS_MapFile::CharToTileID(int nChar)
+{
+
+    if ((nChar >= 48) && (nChar <= 57))
+    {
+        // 0 - 9 is 0 - 9.
+        return nChar - 48;
+    }
+    else if ((nChar >= 65) && (nChar <= 90))
+    {
+        // A - Z is 10 to 35.
+        return nChar - 55;
+    }
+    else if ((nChar >= 97) && (nChar <= 122))
+    {
+        // a - z is 36 to 61.
+        return nChar - 61;
+    }
+
+    // Unrecognised value.
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::TileIDToChar():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a tile ID to a character of a text map file (see CharToTileID()).
+// ---------------------------------------------------------------------------------------------
+// Returns: The character, or a space for tile IDs that have none.
+//==============================================================================================
+
+int GS_MapFile::TileIDToChar(int nTileID)
+{
+
+    if ((nTileID >= 0) && (nTileID <= 9))
+    {
+        // Write numbers 0 - 9 as characters '0' - '9'.
+        return nTileID + 48;
+    }
+    else if ((nTileID >= 10) && (nTileID <= 35))
+    {
+        // Write numbers 10 - 35 as characters 'A' - 'Z'.
+        return nTileID + 55;
+    }
+    else if ((nTileID >= 36) && (nTileID <= 61))
+    {
+        // Write numbers 36 - 61 as characters 'a' - 'z'.
+        return nTileID + 61;
+    }
+
+    return ' ';
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Access Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetNumRows():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of rows in the map.
+//==============================================================================================
+
+int GS_MapFile::GetNumRows()
+{
+
+    return m_gsHeader.nNumRows;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetNumCols():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of columns in the map.
+//==============================================================================================
+
+int GS_MapFile::GetNumCols()
+{
+
+    return m_gsHeader.nNumCols;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetTileIDs():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The tile IDs (row by row, the bottom row first, -1 for empty cells), or NULL if the
+//          map holds no tiles.
+//==============================================================================================
+
+const int* GS_MapFile::GetTileIDs()
+{
+
+    return m_pnTileIDs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetTileID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The tile ID at the specified row and column, -1 if empty or outside the map.
+//==============================================================================================
+
+int GS_MapFile::GetTileID(int nRow, int nCol)
+{
+
+    if ((!m_bIsReady) || (nRow < 0) || (nRow >= m_gsHeader.nNumRows) || (nCol < 0) ||
+        (nCol >= m_gsHeader.nNumCols))
+    {
+        return -1;
+    }
+
+    return m_pnTileIDs[(nRow * m_gsHeader.nNumCols) + nCol];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::SetTileID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::SetTileID(int nRow, int nCol, int nTileID)
+{
+
+    if ((!m_bIsReady) || (nRow < 0) || (nRow >= m_gsHeader.nNumRows) || (nCol < 0) ||
+        (nCol >= m_gsHeader.nNumCols))
+    {
+        return;
+    }
+
+    m_pnTileIDs[(nRow * m_gsHeader.nNumCols) + nCol] = nTileID;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::SetTileSize():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the size of the tiles in pixels stored in the header.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::SetTileSize(int nTileWidth, int nTileHeight)
+{
+
+    m_gsHeader.nTileWidth  = nTileWidth;
+    m_gsHeader.nTileHeight = nTileHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetTileWidth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width of the tiles in pixels, 0 if not specified.
+//==============================================================================================
+
+int GS_MapFile::GetTileWidth()
+{
+
+    return m_gsHeader.nTileWidth;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetTileHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of the tiles in pixels, 0 if not specified.
+//==============================================================================================
+
+int GS_MapFile::GetTileHeight()
+{
+
+    return m_gsHeader.nTileHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::SetStart():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the column and row the player starts on stored in the header.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapFile::SetStart(int nStartCol, int nStartRow)
+{
+
+    m_gsHeader.nStartCol = nStartCol;
+    m_gsHeader.nStartRow = nStartRow;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetStartCol():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The column the player starts on, -1 if not specified.
+//==============================================================================================
+
+int GS_MapFile::GetStartCol()
+{
+
+    return m_gsHeader.nStartCol;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapFile::GetStartRow():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The row the player starts on, -1 if not specified.
+//==============================================================================================
+
+int GS_MapFile::GetStartRow()
+{
+
+    return m_gsHeader.nStartRow;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
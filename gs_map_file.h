@@ -0,0 +1,146 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_map_file.cpp, gs_map_file.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_MapFile                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Reads and writes tile maps, either as the text files of GS_OGLMap::LoadMap() or in  |
+ |        a versioned binary format with a header (dimensions, tile size, start position)     |
+ |        followed by run length encoded tile IDs. Files are read and written in one go.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_MAP_FILE_H
+#define GS_MAP_FILE_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <limits.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_file.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Map file defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_FILE_MAGIC   "GSMP" // First four bytes of a binary map file.
+#define GS_MAP_FILE_VERSION 1      // Version written by Save().
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_FILE_RAW 0 // Tile IDs stored one after the other.
+#define GS_MAP_FILE_RLE 1 // Tile IDs stored as runs of a count byte followed by the tile ID.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_FILE_MAX_RUN 255 // Longest run of the same tile ID in a GS_MAP_FILE_RLE file.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_FILE_MAX_CELLS 16777216 // Most cells a map can have, keeps all sizes within an int.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_FILE_HEADER_SIZE 44 // Bytes taken by the header in a file, the magic and ten ints.
+//==============================================================================================
+
+
+//==============================================================================================
+// Binary map file header, followed by nDataSize bytes of tile IDs (row by row, the bottom row
+// first, 0xFF or 0xFFFF for empty cells). All values are little endian, and the header is
+// read and written one field at a time so files are the same on any host.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_FILE_HEADER
+{
+    char szMagic[4];   // GS_MAP_FILE_MAGIC (not zero terminated).
+    int  nVersion;     // GS_MAP_FILE_VERSION.
+    int  nCompression; // GS_MAP_FILE_RAW or GS_MAP_FILE_RLE.
+    int  nNumRows;     // Dimensions of the map in tiles.
+    int  nNumCols;
+    int  nTileBytes;   // Bytes taken by each tile ID (1 or 2).
+    int  nTileWidth;   // Size of the tiles in pixels, 0 if not specified.
+    int  nTileHeight;
+    int  nStartCol;    // Column and row the player starts on, -1 if not specified.
+    int  nStartRow;
+    int  nDataSize;    // Number of bytes following the header.
+} GS_MapFileHeader;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_MapFile : public GS_Object
+{
+
+private:
+
+    GS_MapFileHeader m_gsHeader;  // Header of the map.
+    int*             m_pnTileIDs; // Tile IDs (row by row, the bottom row first, -1 if empty).
+
+    BOOL m_bIsReady; // Wether the map holds any tiles.
+
+    static void ReadHeader(const BYTE* pData, GS_MapFileHeader* pHeader);
+    static void WriteHeader(BYTE* pBuffer, const GS_MapFileHeader* pHeader);
+
+    BOOL ParseText(const BYTE* pData, int nSize, int nNumRows, int nNumCols);
+    BOOL DecodeTiles(const BYTE* pData, int nSize);
+    int  EncodeTiles(BYTE* pBuffer, int nCompression);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_MapFile();
+    ~GS_MapFile();
+
+    BOOL Create(int nNumRows, int nNumCols, const int* pnTileIDs = NULL);
+    void Destroy();
+    BOOL IsReady();
+
+    BOOL Load(const char* pszPathname, int nNumRows = 0, int nNumCols = 0);
+    BOOL LoadFromMemory(const BYTE* pData, int nSize, int nNumRows = 0, int nNumCols = 0);
+    BOOL Save(const char* pszPathname, int nCompression = GS_MAP_FILE_RLE);
+    int  SaveToMemory(BYTE* pBuffer, int nCompression = GS_MAP_FILE_RLE);
+    BOOL SaveText(const char* pszPathname);
+
+    static BOOL IsBinary(const BYTE* pData, int nSize);
+    static int  CharToTileID(int nChar);
+    static int  TileIDToChar(int nTileID);
+
+    int        GetNumRows();
+    int        GetNumCols();
+    const int* GetTileIDs();
+    int        GetTileID(int nRow, int nCol);
+    void       SetTileID(int nRow, int nCol, int nTileID);
+
+    void SetTileSize(int nTileWidth, int nTileHeight);
+    int  GetTileWidth();
+    int  GetTileHeight();
+
+    void SetStart(int nStartCol, int nStartRow);
+    int  GetStartCol();
+    int  GetStartRow();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
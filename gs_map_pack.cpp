@@ -0,0 +1,417 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_map_pack.cpp, gs_map_pack.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_MapPack                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A single file holding any number of binary maps (see GS_MapFile), each with a few   |
+ |        integer properties whose meaning is up to the game (speeds, enemy counts, ...).     |
+ |        The whole pack is read with a single read and all its maps are kept in memory.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_map_pack.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::GS_MapPack():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_MapPack::GS_MapPack()
+{
+
+    // Nothing to initialize, the pack starts out empty.
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::~GS_MapPack():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_MapPack::~GS_MapPack()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees all the maps in the pack.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_MapPack::Destroy()
+{
+
+    for (int nLoop = 0; nLoop < m_gsMapList.GetNumItems(); nLoop++)
+    {
+        if (m_gsMapList.GetItem(nLoop))
+        {
+            delete m_gsMapList.GetItem(nLoop);
+        }
+    }
+
+    m_gsMapList.RemoveAllItems();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether the pack holds any maps.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it does, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapPack::IsReady()
+{
+
+    return (m_gsMapList.GetNumItems() > 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Load/Save Methods. //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::Load():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads the whole pack file with a single read and decodes all its maps.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapPack::Load(const char* pszPathname)
+{
+
+    if (NULL == pszPathname)
+    {
+        return FALSE;
+    }
+
+    GS_File gsPackFile;
+
+    // Were we able to open the file for reading?
+    if (FALSE == gsPackFile.Open(pszPathname, FILE_READ))
+    {
+        return FALSE;
+    }
+
+    unsigned long ulLength = gsPackFile.GetLength();
+
+    if ((ulLength == 0) || (ulLength > INT_MAX))
+    {
+        gsPackFile.Close();
+        return FALSE;
+    }
+
+    BYTE* pBuffer = new BYTE[ulLength];
+
+    unsigned long ulBytesRead = gsPackFile.Read(pBuffer, ulLength);
+
+    // Close the pack file.
+    gsPackFile.Close();
+
+    BOOL bResult = FALSE;
+
+    if (ulBytesRead == ulLength)
+    {
+        bResult = this->LoadFromMemory(pBuffer, (int) ulLength);
+    }
+
+    delete[] pBuffer;
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::LoadFromMemory():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the maps of the pack with those in the contents of a pack file.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapPack::LoadFromMemory(const BYTE* pData, int nSize)
+{
+
+    this->Destroy();
+
+    if ((NULL == pData) || (nSize < (int) sizeof(GS_MapPackHeader)))
+    {
+        return FALSE;
+    }
+
+    GS_MapPackHeader gsHeader;
+    memcpy(&gsHeader, pData, sizeof(GS_MapPackHeader));
+
+    // Is the header one we understand?
+    if ((memcmp(gsHeader.szMagic, GS_MAP_PACK_MAGIC, 4) != 0) || (gsHeader.nVersion < 1) ||
+        (gsHeader.nVersion > GS_MAP_PACK_VERSION) || (gsHeader.nNumMaps <= 0) ||
+        (gsHeader.nNumMaps > ((nSize - (int) sizeof(GS_MapPackHeader)) /
+                              (int) sizeof(GS_MapPackEntry))))
+    {
+        GS_Error::Report("GS_MAP_PACK.CPP", 193, "Unsupported map pack!");
+        return FALSE;
+    }
+
+    const BYTE* pEntries = pData + sizeof(GS_MapPackHeader);
+
+    for (int nLoop = 0; nLoop < gsHeader.nNumMaps; nLoop++)
+    {
+        GS_MapPackEntry gsEntry;
+        memcpy(&gsEntry, pEntries + (nLoop * sizeof(GS_MapPackEntry)), sizeof(GS_MapPackEntry));
+
+        GS_PackedMap* pgsPackedMap = new GS_PackedMap;
+
+        // Does the entry point inside the pack and hold a valid map?
+        if ((gsEntry.nOffset < 0) || (gsEntry.nSize <= 0) ||
+            (gsEntry.nOffset > (nSize - gsEntry.nSize)) ||
+            (!pgsPackedMap->gsMapFile.LoadFromMemory(pData + gsEntry.nOffset, gsEntry.nSize)))
+        {
+            GS_Error::Report("GS_MAP_PACK.CPP", 209, "Corrupt map pack!");
+            delete pgsPackedMap;
+            this->Destroy();
+            return FALSE;
+        }
+
+        memcpy(pgsPackedMap->nProperties, gsEntry.nProperties, sizeof(gsEntry.nProperties));
+
+        m_gsMapList.AddItem(pgsPackedMap);
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::Save():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes all the maps of the pack to a pack file with a single write.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapPack::Save(const char* pszPathname)
+{
+
+    int nNumMaps = m_gsMapList.GetNumItems();
+
+    if ((NULL == pszPathname) || (nNumMaps <= 0))
+    {
+        return FALSE;
+    }
+
+    // Work out where each map goes, they follow the header and the entries.
+    GS_MapPackEntry* pEntries = new GS_MapPackEntry[nNumMaps];
+    int              nSize    = sizeof(GS_MapPackHeader) + (nNumMaps * sizeof(GS_MapPackEntry));
+
+    for (int nLoop = 0; nLoop < nNumMaps; nLoop++)
+    {
+        GS_PackedMap* pgsPackedMap = m_gsMapList.GetItem(nLoop);
+
+        pEntries[nLoop].nOffset = nSize;
+        pEntries[nLoop].nSize   = pgsPackedMap->gsMapFile.SaveToMemory(NULL);
+        memcpy(pEntries[nLoop].nProperties, pgsPackedMap->nProperties,
+               sizeof(pgsPackedMap->nProperties));
+
+        nSize += pEntries[nLoop].nSize;
+    }
+
+    GS_MapPackHeader gsHeader;
+    memcpy(gsHeader.szMagic, GS_MAP_PACK_MAGIC, 4);
+    gsHeader.nVersion = GS_MAP_PACK_VERSION;
+    gsHeader.nNumMaps = nNumMaps;
+
+    BYTE* pBuffer = new BYTE[nSize];
+
+    memcpy(pBuffer, &gsHeader, sizeof(GS_MapPackHeader));
+    memcpy(pBuffer + sizeof(GS_MapPackHeader), pEntries, nNumMaps * sizeof(GS_MapPackEntry));
+
+    for (int nLoop = 0; nLoop < nNumMaps; nLoop++)
+    {
+        m_gsMapList.GetItem(nLoop)->gsMapFile.SaveToMemory(pBuffer + pEntries[nLoop].nOffset);
+    }
+
+    GS_File gsPackFile;
+    BOOL    bResult = FALSE;
+
+    // Were we able to open the file for writing?
+    if (gsPackFile.Open(pszPathname, FILE_WRITE))
+    {
+        bResult = (gsPackFile.Write(pBuffer, nSize) == (unsigned long) nSize);
+        gsPackFile.Close();
+    }
+
+    delete[] pBuffer;
+    delete[] pEntries;
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Map Methods. ////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::AddMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a copy of the map with the specified properties (GS_MAP_PACK_PROPERTIES of
+//          them, or all 0 if none are specified) to the end of the pack.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_MapPack::AddMap(GS_MapFile* pgsMapFile, const int* pnProperties)
+{
+
+    if ((NULL == pgsMapFile) || (!pgsMapFile->IsReady()))
+    {
+        return FALSE;
+    }
+
+    GS_PackedMap* pgsPackedMap = new GS_PackedMap;
+
+    if (!pgsPackedMap->gsMapFile.Create(pgsMapFile->GetNumRows(), pgsMapFile->GetNumCols(),
+                                        pgsMapFile->GetTileIDs()))
+    {
+        delete pgsPackedMap;
+        return FALSE;
+    }
+
+    pgsPackedMap->gsMapFile.SetTileSize(pgsMapFile->GetTileWidth(), pgsMapFile->GetTileHeight());
+    pgsPackedMap->gsMapFile.SetStart(pgsMapFile->GetStartCol(), pgsMapFile->GetStartRow());
+
+    for (int nLoop = 0; nLoop < GS_MAP_PACK_PROPERTIES; nLoop++)
+    {
+        pgsPackedMap->nProperties[nLoop] = (pnProperties != NULL) ? pnProperties[nLoop] : 0;
+    }
+
+    m_gsMapList.AddItem(pgsPackedMap);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::GetNumMaps():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of maps in the pack.
+//==============================================================================================
+
+int GS_MapPack::GetNumMaps()
+{
+
+    return m_gsMapList.GetNumItems();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::GetMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The map at the specified index (counting from 0), NULL if there is no such map.
+//==============================================================================================
+
+GS_MapFile* GS_MapPack::GetMap(int nIndex)
+{
+
+    if ((nIndex < 0) || (nIndex >= m_gsMapList.GetNumItems()))
+    {
+        return NULL;
+    }
+
+    return &m_gsMapList.GetItem(nIndex)->gsMapFile;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_MapPack::GetProperty():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The property of the map at the specified index, 0 if there is no such map or
+//          property.
+//==============================================================================================
+
+int GS_MapPack::GetProperty(int nIndex, int nProperty)
+{
+
+    if ((nIndex < 0) || (nIndex >= m_gsMapList.GetNumItems()) || (nProperty < 0) ||
+        (nProperty >= GS_MAP_PACK_PROPERTIES))
+    {
+        return 0;
+    }
+
+    return m_gsMapList.GetItem(nIndex)->nProperties[nProperty];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
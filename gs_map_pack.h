@@ -0,0 +1,121 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_map_pack.cpp, gs_map_pack.h                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_MapPack                                                                          |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A single file holding any number of binary maps (see GS_MapFile), each with a few   |
+ |        integer properties whose meaning is up to the game (speeds, enemy counts, ...).     |
+ |        The whole pack is read with a single read and all its maps are kept in memory.      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_MAP_PACK_H
+#define GS_MAP_PACK_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_file.h"
+#include "gs_list.h"
+#include "gs_map_file.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Map pack defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_PACK_MAGIC      "GSPK" // First four bytes of a map pack file.
+#define GS_MAP_PACK_VERSION    1      // Version written by Save().
+#define GS_MAP_PACK_PROPERTIES 4      // Number of properties stored with each map.
+//==============================================================================================
+
+
+//==============================================================================================
+// Map pack file header, followed by nNumMaps entries and the binary maps they point to. All
+// values are little endian.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_PACK_HEADER
+{
+    char szMagic[4]; // GS_MAP_PACK_MAGIC (not zero terminated).
+    int  nVersion;   // GS_MAP_PACK_VERSION.
+    int  nNumMaps;   // Number of maps in the pack.
+} GS_MapPackHeader;
+//==============================================================================================
+
+
+//==============================================================================================
+// Map pack file entry.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_PACK_ENTRY
+{
+    int nOffset;                             // Offset of the binary map from the file start.
+    int nSize;                               // Size of the binary map in bytes.
+    int nProperties[GS_MAP_PACK_PROPERTIES]; // Properties of the map, 0 if not specified.
+} GS_MapPackEntry;
+//==============================================================================================
+
+
+//==============================================================================================
+// Map held by a pack.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_PACKED_MAP
+{
+    GS_MapFile gsMapFile;
+    int        nProperties[GS_MAP_PACK_PROPERTIES];
+} GS_PackedMap;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_MapPack : public GS_Object
+{
+
+private:
+
+    GS_List<GS_PackedMap*> m_gsMapList; // The maps in the pack.
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_MapPack();
+    ~GS_MapPack();
+
+    void Destroy();
+    BOOL IsReady();
+
+    BOOL Load(const char* pszPathname);
+    BOOL LoadFromMemory(const BYTE* pData, int nSize);
+    BOOL Save(const char* pszPathname);
+
+    BOOL AddMap(GS_MapFile* pgsMapFile, const int* pnProperties = NULL);
+
+    int         GetNumMaps();
+    GS_MapFile* GetMap(int nIndex);
+    int         GetProperty(int nIndex, int nProperty);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
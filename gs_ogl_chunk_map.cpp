@@ -0,0 +1,1185 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_chunk_map.cpp, gs_ogl_chunk_map.h                                            |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLChunkMap                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A tile map of any size (or without an end) split into chunks of a fixed number of   |
+ |        rows and columns, each one a GS_OGLMap. The chunks around the clip box are loaded   |
+ |        and decoded by a background thread as the map scrolls, turned into geometry a few   |
+ |        at a time, and the least recently used ones are dropped when the chunks take more   |
+ |        memory than the budget.                                                             |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_chunk_map.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GS_OGLChunkMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLChunkMap::GS_OGLChunkMap()
+{
+
+    m_gluTexture     = 0;
+    m_nTextureWidth  = 0;
+    m_nTextureHeight = 0;
+    m_nTotalTiles    = 0;
+    m_nTilesPerLine  = 0;
+    m_nTileWidth     = 0;
+    m_nTileHeight    = 0;
+
+    m_nChunkRows = 0;
+    m_nChunkCols = 0;
+    m_nWorldCols = 0;
+    m_nWorldRows = 0;
+
+    SetRect(&m_rcClipBox, 0, 0, 0, 0);
+    m_nMapCoordX = 0;
+    m_nMapCoordY = 0;
+
+    m_nClearTileID = -1;
+    m_gsModulateColor.fRed   = 1.0f;
+    m_gsModulateColor.fGreen = 1.0f;
+    m_gsModulateColor.fBlue  = 1.0f;
+    m_gsModulateColor.fAlpha = 1.0f;
+
+    m_pLoader        = LoadChunkFile;
+    m_pLoaderData    = this;
+    m_szChunkFile[0] = '\0';
+
+    m_bIsStopping = FALSE;
+
+    m_nMemoryBudget = GS_CHUNK_DEFAULT_BUDGET;
+    m_nMemoryUsage  = 0;
+    m_ulFrame       = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::~GS_OGLChunkMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The destructor, stops the background thread and frees all the chunks.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLChunkMap::~GS_OGLChunkMap()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets up a chunk map drawing its tiles from the specified texture (laid out like
+//          for GS_OGLMap::Create()) in chunks of nChunkRows by nChunkCols tiles, and starts
+//          the background thread loading them. Set where the chunks come from with
+//          SetChunkFiles() or SetLoader() before the first Update().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLChunkMap::Create(GLuint glTexture, int nWidth, int nHeight, int nTotalTiles,
+                            int nTilesPerLine, int nTileWidth, int nTileHeight, int nChunkRows,
+                            int nChunkCols)
+{
+
+    // Destroy chunk map if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    if ((!glTexture) || (nTileWidth <= 0) || (nTileHeight <= 0) || (nChunkRows <= 0) ||
+        (nChunkCols <= 0))
+    {
+        return FALSE;
+    }
+
+    m_gluTexture     = glTexture;
+    m_nTextureWidth  = nWidth;
+    m_nTextureHeight = nHeight;
+    m_nTotalTiles    = nTotalTiles;
+    m_nTilesPerLine  = nTilesPerLine;
+    m_nTileWidth     = nTileWidth;
+    m_nTileHeight    = nTileHeight;
+
+    m_nChunkRows = nChunkRows;
+    m_nChunkCols = nChunkCols;
+
+    m_ulFrame      = 0;
+    m_nMemoryUsage = 0;
+
+    m_bIsStopping = FALSE;
+    m_Worker      = std::thread(&GS_OGLChunkMap::Work, this);
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops the background thread and frees all the chunks.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::Destroy()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    // Let the background thread finish the chunk it is loading and end.
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bIsStopping = TRUE;
+    }
+    m_Condition.notify_all();
+
+    if (m_Worker.joinable())
+    {
+        m_Worker.join();
+    }
+
+    std::map<long long, GS_MapChunk*>::iterator it;
+
+    for (it = m_Chunks.begin(); it != m_Chunks.end(); ++it)
+    {
+        this->FreeChunk(it->second);
+    }
+    m_Chunks.clear();
+    m_Queue.clear();
+
+    m_gluTexture = 0;
+    m_nChunkRows = 0;
+    m_nChunkCols = 0;
+
+    m_nMemoryUsage = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the chunk map has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLChunkMap::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetLoader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the function the background thread calls to fill in the tile IDs of a chunk.
+//          Chunks already loaded are kept.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetLoader(GS_ChunkLoader pLoader, void* pUserData)
+{
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_pLoader     = pLoader;
+    m_pLoaderData = pUserData;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetChunkFiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads the chunks from map files (in the format of GS_OGLMap::LoadMap()) named by
+//          a pattern taking the column and row of the chunk, e.g. "data/world_%d_%d.map".
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetChunkFiles(const char* pszPattern)
+{
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    strncpy(m_szChunkFile, (pszPattern != NULL) ? pszPattern : "", _MAX_PATH - 1);
+    m_szChunkFile[_MAX_PATH - 1] = '\0';
+
+    m_pLoader     = LoadChunkFile;
+    m_pLoaderData = this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetWorldSize():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Limits the map to the specified number of chunks to the right of and above chunk
+//          (0, 0), so no chunks are requested outside of it. Zero (the default) lets the map
+//          go on in that direction (and into negative chunk positions) without an end.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetWorldSize(int nNumChunkCols, int nNumChunkRows)
+{
+
+    m_nWorldCols = (nNumChunkCols > 0) ? nNumChunkCols : 0;
+    m_nWorldRows = (nNumChunkRows > 0) ? nNumChunkRows : 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Streaming Methods. //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::MakeKey():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The key the chunk at the specified position is stored under.
+//==============================================================================================
+
+long long GS_OGLChunkMap::MakeKey(int nChunkCol, int nChunkRow)
+{
+
+    return ((long long) nChunkRow << 32) | (unsigned int) nChunkCol;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::FloorDiv():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Divides rounding down (towards minus infinity) instead of towards zero, so pixels
+//          left of or below the map origin fall in negative chunks.
+// ---------------------------------------------------------------------------------------------
+// Returns: The quotient.
+//==============================================================================================
+
+int GS_OGLChunkMap::FloorDiv(int nValue, int nDivisor)
+{
+
+    if (nValue >= 0)
+    {
+        return nValue / nDivisor;
+    }
+
+    return -((-nValue + nDivisor - 1) / nDivisor);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetChunkRange():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Works out the chunks covering the clip box, extended by nMargin chunks on every
+//          side and limited to the world size if one was set.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if any chunk is in range, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLChunkMap::GetChunkRange(int nMargin, int* pnFirstCol, int* pnLastCol,
+                                   int* pnFirstRow, int* pnLastRow)
+{
+
+    int nClipWidth  = m_rcClipBox.right - m_rcClipBox.left;
+    int nClipHeight = m_rcClipBox.top   - m_rcClipBox.bottom;
+
+    if ((!m_bIsReady) || (nClipWidth <= 0) || (nClipHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    int nChunkWidth  = m_nChunkCols * m_nTileWidth;
+    int nChunkHeight = m_nChunkRows * m_nTileHeight;
+
+    // The clip box in pixels relative to the bottom left corner of chunk (0, 0).
+    *pnFirstCol = FloorDiv(-m_nMapCoordX, nChunkWidth) - nMargin;
+    *pnFirstRow = FloorDiv(-m_nMapCoordY, nChunkHeight) - nMargin;
+    *pnLastCol  = FloorDiv(-m_nMapCoordX + nClipWidth - 1, nChunkWidth) + nMargin;
+    *pnLastRow  = FloorDiv(-m_nMapCoordY + nClipHeight - 1, nChunkHeight) + nMargin;
+
+    if (m_nWorldCols > 0)
+    {
+        if (*pnFirstCol < 0)             *pnFirstCol = 0;
+        if (*pnLastCol >= m_nWorldCols) *pnLastCol  = m_nWorldCols - 1;
+    }
+    if (m_nWorldRows > 0)
+    {
+        if (*pnFirstRow < 0)             *pnFirstRow = 0;
+        if (*pnLastRow >= m_nWorldRows) *pnLastRow  = m_nWorldRows - 1;
+    }
+
+    return ((*pnFirstCol <= *pnLastCol) && (*pnFirstRow <= *pnLastRow));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::RequestChunks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Marks the chunks around the clip box as needed and queues the ones not loaded yet
+//          for the background thread, those inside the clip box first.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::RequestChunks()
+{
+
+    BOOL bIsQueued = FALSE;
+
+    // The chunks inside the clip box, then those around it.
+    int nMargins[2] = { 0, GS_CHUNK_PRELOAD };
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        for (int nPass = 0; nPass < 2; nPass++)
+        {
+            int nFirstCol, nLastCol, nFirstRow, nLastRow;
+
+            if (!this->GetChunkRange(nMargins[nPass], &nFirstCol, &nLastCol, &nFirstRow,
+                                     &nLastRow))
+            {
+                break;
+            }
+
+            for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+            {
+                for (int nCol = nFirstCol; nCol <= nLastCol; nCol++)
+                {
+                    long long llKey = MakeKey(nCol, nRow);
+
+                    std::map<long long, GS_MapChunk*>::iterator it = m_Chunks.find(llKey);
+
+                    if (it != m_Chunks.end())
+                    {
+                        it->second->ulLastUsed = m_ulFrame;
+                        continue;
+                    }
+
+                    GS_MapChunk* pgsChunk = new GS_MapChunk;
+                    pgsChunk->nChunkCol  = nCol;
+                    pgsChunk->nChunkRow  = nRow;
+                    pgsChunk->nState     = GS_CHUNK_QUEUED;
+                    pgsChunk->pnTileIDs  = NULL;
+                    pgsChunk->pgsMap     = NULL;
+                    pgsChunk->ulLastUsed = m_ulFrame;
+
+                    m_Chunks[llKey] = pgsChunk;
+                    m_Queue.push_back(llKey);
+
+                    bIsQueued = TRUE;
+                }
+            }
+        }
+    }
+
+    if (bIsQueued)
+    {
+        m_Condition.notify_one();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::Update():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Requests the chunks around the clip box, forgets queued chunks that scrolled out
+//          of range before they were loaded, turns up to GS_CHUNK_MAX_UPLOADS decoded chunks
+//          into geometry and drops the least recently used chunks while over the memory
+//          budget. Render() calls it, so it only needs calling when not rendering.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::Update()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    m_ulFrame++;
+
+    this->RequestChunks();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    int nNumBuilt = 0;
+
+    m_nMemoryUsage = 0;
+
+    std::map<long long, GS_MapChunk*>::iterator it = m_Chunks.begin();
+
+    while (it != m_Chunks.end())
+    {
+        GS_MapChunk* pgsChunk = it->second;
+
+        // Not loaded yet and no longer needed?
+        if ((pgsChunk->nState == GS_CHUNK_QUEUED) && (pgsChunk->ulLastUsed != m_ulFrame))
+        {
+            this->FreeChunk(pgsChunk);
+            m_Chunks.erase(it++);
+            continue;
+        }
+
+        if ((pgsChunk->nState == GS_CHUNK_DECODED) && (nNumBuilt < GS_CHUNK_MAX_UPLOADS))
+        {
+            this->BuildChunk(pgsChunk);
+            nNumBuilt++;
+        }
+
+        m_nMemoryUsage += sizeof(GS_MapChunk);
+
+        if (pgsChunk->pgsMap != NULL)
+        {
+            m_nMemoryUsage += pgsChunk->pgsMap->GetMemoryUsage();
+        }
+        if (pgsChunk->pnTileIDs != NULL)
+        {
+            m_nMemoryUsage += m_nChunkRows * m_nChunkCols * sizeof(int);
+        }
+
+        ++it;
+    }
+
+    this->EvictChunks();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::BuildChunk():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Turns the decoded tile IDs of a chunk into a GS_OGLMap with its geometry (which
+//          needs the rendering context, so it is done here rather than on the background
+//          thread).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::BuildChunk(GS_MapChunk* pgsChunk)
+{
+
+    GS_OGLMap* pgsMap = new GS_OGLMap;
+
+    if ((pgsMap->Create(m_gluTexture, m_nTextureWidth, m_nTextureHeight, m_nTotalTiles,
+                        m_nTilesPerLine, m_nTileWidth, m_nTileHeight)) &&
+        (pgsMap->SetTiles(pgsChunk->pnTileIDs, m_nChunkRows, m_nChunkCols)))
+    {
+        pgsMap->SetClearTileID(m_nClearTileID);
+        pgsMap->SetModulateColor(m_gsModulateColor);
+
+        pgsChunk->pgsMap = pgsMap;
+        pgsChunk->nState = GS_CHUNK_READY;
+    }
+    else
+    {
+        delete pgsMap;
+        pgsChunk->nState = GS_CHUNK_EMPTY;
+    }
+
+    delete[] pgsChunk->pnTileIDs;
+    pgsChunk->pnTileIDs = NULL;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::EvictChunks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Drops the least recently used chunks not needed by the last Update() until the
+//          chunks fit in the memory budget again (must be called with the mutex locked).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::EvictChunks()
+{
+
+    while (m_nMemoryUsage > m_nMemoryBudget)
+    {
+        std::map<long long, GS_MapChunk*>::iterator itOldest = m_Chunks.end();
+        std::map<long long, GS_MapChunk*>::iterator it;
+
+        for (it = m_Chunks.begin(); it != m_Chunks.end(); ++it)
+        {
+            // Only chunks the background thread is done with can go.
+            if ((it->second->ulLastUsed == m_ulFrame) || (it->second->nState == GS_CHUNK_QUEUED))
+            {
+                continue;
+            }
+            if ((itOldest == m_Chunks.end()) ||
+                (it->second->ulLastUsed < itOldest->second->ulLastUsed))
+            {
+                itOldest = it;
+            }
+        }
+
+        // Is everything left still needed?
+        if (itOldest == m_Chunks.end())
+        {
+            break;
+        }
+
+        GS_MapChunk* pgsChunk = itOldest->second;
+
+        m_nMemoryUsage -= sizeof(GS_MapChunk);
+
+        if (pgsChunk->pgsMap != NULL)
+        {
+            m_nMemoryUsage -= pgsChunk->pgsMap->GetMemoryUsage();
+        }
+        if (pgsChunk->pnTileIDs != NULL)
+        {
+            m_nMemoryUsage -= m_nChunkRows * m_nChunkCols * sizeof(int);
+        }
+
+        this->FreeChunk(pgsChunk);
+        m_Chunks.erase(itOldest);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::FreeChunk():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees a chunk and everything it holds.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::FreeChunk(GS_MapChunk* pgsChunk)
+{
+
+    if (pgsChunk->pgsMap != NULL)
+    {
+        delete pgsChunk->pgsMap;
+    }
+    if (pgsChunk->pnTileIDs != NULL)
+    {
+        delete[] pgsChunk->pnTileIDs;
+    }
+
+    delete pgsChunk;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::Work():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The background thread: takes queued chunks one at a time and calls the loader for
+//          them with the mutex unlocked, so the game never waits for the disk. A chunk that
+//          was dropped while it was being loaded is simply thrown away.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::Work()
+{
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    while (!m_bIsStopping)
+    {
+        if (m_Queue.empty())
+        {
+            m_Condition.wait(lock);
+            continue;
+        }
+
+        long long llKey = m_Queue.front();
+        m_Queue.pop_front();
+
+        std::map<long long, GS_MapChunk*>::iterator it = m_Chunks.find(llKey);
+
+        if ((it == m_Chunks.end()) || (it->second->nState != GS_CHUNK_QUEUED))
+        {
+            continue;
+        }
+
+        int nChunkCol = it->second->nChunkCol;
+        int nChunkRow = it->second->nChunkRow;
+        int nNumRows  = m_nChunkRows;
+        int nNumCols  = m_nChunkCols;
+
+        GS_ChunkLoader pLoader   = m_pLoader;
+        void*          pUserData = m_pLoaderData;
+
+        lock.unlock();
+
+        int* pnTileIDs = new int[nNumRows * nNumCols];
+
+        for (int nCell = 0; nCell < (nNumRows * nNumCols); nCell++)
+        {
+            pnTileIDs[nCell] = -1;
+        }
+
+        BOOL bIsLoaded = (pLoader != NULL) &&
+                         (pLoader(nChunkCol, nChunkRow, nNumRows, nNumCols, pnTileIDs, pUserData));
+
+        lock.lock();
+
+        // Is the chunk still waiting for us?
+        it = m_Chunks.find(llKey);
+
+        if ((it != m_Chunks.end()) && (it->second->nState == GS_CHUNK_QUEUED))
+        {
+            if (bIsLoaded)
+            {
+                it->second->pnTileIDs = pnTileIDs;
+                it->second->nState    = GS_CHUNK_DECODED;
+                continue;
+            }
+
+            it->second->nState = GS_CHUNK_EMPTY;
+        }
+
+        delete[] pnTileIDs;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::LoadChunkFile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The default loader, reads the map file (binary or text) named by the pattern given
+//          to SetChunkFiles() with a single read, like GS_OGLMap::LoadMap().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if there is no such file.
+//==============================================================================================
+
+BOOL GS_OGLChunkMap::LoadChunkFile(int nChunkCol, int nChunkRow, int nNumRows, int nNumCols,
+                                   int* pnTileIDs, void* pUserData)
+{
+
+    GS_OGLChunkMap* pgsChunkMap = (GS_OGLChunkMap*) pUserData;
+
+    if ((NULL == pgsChunkMap) || (pgsChunkMap->m_szChunkFile[0] == '\0'))
+    {
+        return FALSE;
+    }
+
+    char szPathname[_MAX_PATH];
+    snprintf(szPathname, _MAX_PATH, pgsChunkMap->m_szChunkFile, nChunkCol, nChunkRow);
+
+    GS_MapFile gsMapFile;
+
+    if (!gsMapFile.Load(szPathname, nNumRows, nNumCols))
+    {
+        return FALSE;
+    }
+
+    // Copy the tiles that fall inside the chunk.
+    for (int nRow = 0; nRow < nNumRows; nRow++)
+    {
+        for (int nCol = 0; nCol < nNumCols; nCol++)
+        {
+            pnTileIDs[(nRow * nNumCols) + nCol] = gsMapFile.GetTileID(nRow, nCol);
+        }
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::Render():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Updates the chunks and draws those that are ready inside the clip box. Chunks
+//          still being loaded are left out until they are ready.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLChunkMap::Render(HWND hWnd)
+{
+
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    this->Update();
+
+    int nFirstCol, nLastCol, nFirstRow, nLastRow;
+
+    if (!this->GetChunkRange(0, &nFirstCol, &nLastCol, &nFirstRow, &nLastRow))
+    {
+        return TRUE;
+    }
+
+    int nChunkWidth  = m_nChunkCols * m_nTileWidth;
+    int nChunkHeight = m_nChunkRows * m_nTileHeight;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+    {
+        for (int nCol = nFirstCol; nCol <= nLastCol; nCol++)
+        {
+            std::map<long long, GS_MapChunk*>::iterator it = m_Chunks.find(MakeKey(nCol, nRow));
+
+            if ((it == m_Chunks.end()) || (it->second->nState != GS_CHUNK_READY))
+            {
+                continue;
+            }
+
+            GS_OGLMap* pgsMap = it->second->pgsMap;
+
+            pgsMap->SetClipBox(m_rcClipBox);
+            pgsMap->Render(m_nMapCoordX + (nCol * nChunkWidth),
+                           m_nMapCoordY + (nRow * nChunkHeight), hWnd);
+        }
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// ClipBox And Scroll Methods. /////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetClipBox():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the screen rectangle the map is drawn in, like GS_OGLMap::SetClipBox().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetClipBox(int nMinX, int nMinY, int nMaxX, int nMaxY)
+{
+
+    if (nMinX >= 0)
+    {
+        m_rcClipBox.left   = nMinX;
+    }
+    if (nMinY >= 0)
+    {
+        m_rcClipBox.bottom = nMinY;
+    }
+    if (nMaxX >= 0)
+    {
+        m_rcClipBox.right  = nMaxX;
+    }
+    if (nMaxY >= 0)
+    {
+        m_rcClipBox.top    = nMaxY;
+    }
+
+    this->RequestChunks();
+}
+
+
+void GS_OGLChunkMap::SetClipBox(RECT rcClipBox)
+{
+
+    m_rcClipBox = rcClipBox;
+
+    this->RequestChunks();
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetClipBox():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A RECT structure containing the clip box coordinates.
+//==============================================================================================
+
+RECT GS_OGLChunkMap::GetClipBox()
+{
+
+    return m_rcClipBox;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetMapX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves the map horizontally and requests the chunks that come into range.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetMapX(int nDestX)
+{
+
+    m_nMapCoordX = nDestX;
+
+    this->RequestChunks();
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetMapY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Moves the map vertically and requests the chunks that come into range.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetMapY(int nDestY)
+{
+
+    m_nMapCoordY = nDestY;
+
+    this->RequestChunks();
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetMapX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The current horizontal map coordinate.
+//==============================================================================================
+
+int GS_OGLChunkMap::GetMapX()
+{
+
+    return m_nMapCoordX;
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetMapY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The current vertical map coordinate.
+//==============================================================================================
+
+int GS_OGLChunkMap::GetMapY()
+{
+
+    return m_nMapCoordY;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::ScrollX():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Scrolls the map horizontally by the specified number of pixels (negative values
+//          scroll it left), there are no limits or wrapping.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::ScrollX(int nDistance)
+{
+
+    this->SetMapX(m_nMapCoordX + nDistance);
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::ScrollY():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Scrolls the map vertically by the specified number of pixels (negative values
+//          scroll it down), there are no limits or wrapping.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::ScrollY(int nDistance)
+{
+
+    this->SetMapY(m_nMapCoordY + nDistance);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Tile And Color Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetTileID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks up a tile by its row and column counted from the bottom left corner of chunk
+//          (0, 0), which may be negative.
+// ---------------------------------------------------------------------------------------------
+// Returns: The tile ID, or -1 if the tile is empty or its chunk is not ready.
+//==============================================================================================
+
+int GS_OGLChunkMap::GetTileID(int nRow, int nCol)
+{
+
+    if (!m_bIsReady)
+    {
+        return -1;
+    }
+
+    int nChunkCol = FloorDiv(nCol, m_nChunkCols);
+    int nChunkRow = FloorDiv(nRow, m_nChunkRows);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    std::map<long long, GS_MapChunk*>::iterator it = m_Chunks.find(MakeKey(nChunkCol, nChunkRow));
+
+    if ((it == m_Chunks.end()) || (it->second->nState != GS_CHUNK_READY))
+    {
+        return -1;
+    }
+
+    return it->second->pgsMap->GetTileID(nRow - (nChunkRow * m_nChunkRows),
+                                         nCol - (nChunkCol * m_nChunkCols));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetClearTileID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets which tile ID is not drawn, for the chunks loaded and still to come.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetClearTileID(int nTileID)
+{
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_nClearTileID = nTileID;
+
+    std::map<long long, GS_MapChunk*>::iterator it;
+
+    for (it = m_Chunks.begin(); it != m_Chunks.end(); ++it)
+    {
+        if (it->second->pgsMap != NULL)
+        {
+            it->second->pgsMap->SetClearTileID(nTileID);
+        }
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetModulateColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the color the chunks are drawn with, negative values keep that component.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetModulateColor(float fRed, float fGreen, float fBlue, float fAlpha)
+{
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (fRed   >= 0.0f) m_gsModulateColor.fRed   = fRed;
+    if (fGreen >= 0.0f) m_gsModulateColor.fGreen = fGreen;
+    if (fBlue  >= 0.0f) m_gsModulateColor.fBlue  = fBlue;
+    if (fAlpha >= 0.0f) m_gsModulateColor.fAlpha = fAlpha;
+
+    std::map<long long, GS_MapChunk*>::iterator it;
+
+    for (it = m_Chunks.begin(); it != m_Chunks.end(); ++it)
+    {
+        if (it->second->pgsMap != NULL)
+        {
+            it->second->pgsMap->SetModulateColor(m_gsModulateColor);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLChunkMap::SetMemoryBudget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how many bytes the chunks may take before the least recently used ones are
+//          dropped. The chunks around the clip box are always kept, even over the budget.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLChunkMap::SetMemoryBudget(int nBytes)
+{
+
+    m_nMemoryBudget = (nBytes > 0) ? nBytes : 0;
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetMemoryBudget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The memory budget in bytes.
+//==============================================================================================
+
+int GS_OGLChunkMap::GetMemoryBudget()
+{
+
+    return m_nMemoryBudget;
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetMemoryUsage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The bytes taken by the chunks after the last Update().
+//==============================================================================================
+
+int GS_OGLChunkMap::GetMemoryUsage()
+{
+
+    return m_nMemoryUsage;
+}
+
+
+//==============================================================================================
+// GS_OGLChunkMap::GetNumChunks():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of chunks loaded or being loaded.
+//==============================================================================================
+
+int GS_OGLChunkMap::GetNumChunks()
+{
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    return (int) m_Chunks.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
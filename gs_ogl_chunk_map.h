@@ -0,0 +1,199 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_chunk_map.cpp, gs_ogl_chunk_map.h                                            |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLChunkMap                                                                      |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: A tile map of any size (or without an end) split into chunks of a fixed number of   |
+ |        rows and columns, each one a GS_OGLMap. The chunks around the clip box are loaded   |
+ |        and decoded by a background thread as the map scrolls, turned into geometry a few   |
+ |        at a time, and the least recently used ones are dropped when the chunks take more   |
+ |        memory than the budget.                                                             |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_CHUNK_MAP_H
+#define GS_OGL_CHUNK_MAP_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_file.h"
+#include "gs_map_file.h"
+#include "gs_ogl_color.h"
+#include "gs_ogl_map.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Chunk map defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_CHUNK_DEFAULT_BUDGET (8 * 1024 * 1024) // Default memory budget in bytes.
+#define GS_CHUNK_MAX_UPLOADS    2 // Most decoded chunks turned into geometry per Update().
+#define GS_CHUNK_PRELOAD        1 // Chunks loaded beyond each edge of the clip box.
+// ---------------------------------------------------------------------------------------------
+#define GS_CHUNK_QUEUED  0 // Waiting for the background thread.
+#define GS_CHUNK_DECODED 1 // Tile IDs decoded, waiting for Update() to build the geometry.
+#define GS_CHUNK_READY   2 // Ready to render.
+#define GS_CHUNK_EMPTY   3 // The loader had nothing for the chunk, nothing is rendered.
+//==============================================================================================
+
+
+//==============================================================================================
+// Chunk loader, called on the background thread to fill the tile IDs of a chunk (row by row,
+// the bottom row first, -1 for empty cells). Returns FALSE if there is no such chunk.
+// ---------------------------------------------------------------------------------------------
+typedef BOOL (*GS_ChunkLoader)(int nChunkCol, int nChunkRow, int nNumRows, int nNumCols,
+                               int* pnTileIDs, void* pUserData);
+//==============================================================================================
+
+
+//==============================================================================================
+// Map chunk structure.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_CHUNK
+{
+    int           nChunkCol;  // Position of the chunk in chunks from the map origin.
+    int           nChunkRow;
+    int           nState;     // GS_CHUNK_QUEUED, _DECODED, _READY or _EMPTY.
+    int*          pnTileIDs;  // The decoded tile IDs while the chunk is GS_CHUNK_DECODED.
+    GS_OGLMap*    pgsMap;     // The map rendering the chunk once it is GS_CHUNK_READY.
+    unsigned long ulLastUsed; // Last Update() the chunk was needed in.
+} GS_MapChunk;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLChunkMap : public GS_Object
+{
+
+private:
+
+    GLuint m_gluTexture;     // Texture holding the tile images (owned by the caller).
+    int    m_nTextureWidth;  // Dimensions of the texture.
+    int    m_nTextureHeight;
+    int    m_nTotalTiles;    // Tile layout of the texture.
+    int    m_nTilesPerLine;
+    int    m_nTileWidth;     // Tile width and height in pixels.
+    int    m_nTileHeight;
+
+    int m_nChunkRows;  // Size of each chunk in tiles.
+    int m_nChunkCols;
+    int m_nWorldCols;  // Size of the map in chunks (0 if it has no end).
+    int m_nWorldRows;
+
+    RECT m_rcClipBox;  // Rectangle structure containing the viewport coordinates.
+    int  m_nMapCoordX; // Map coordinates of the bottom left corner of chunk (0, 0).
+    int  m_nMapCoordY;
+
+    int         m_nClearTileID;    // Which tile ID will not be drawn.
+    GS_OGLColor m_gsModulateColor; // Color the chunks are drawn with.
+
+    GS_ChunkLoader m_pLoader;                // Loader filling in the tile IDs of the chunks.
+    void*          m_pLoaderData;            // Passed to the loader.
+    char           m_szChunkFile[_MAX_PATH]; // File name pattern used by LoadChunkFile().
+
+    std::map<long long, GS_MapChunk*> m_Chunks; // The chunks loaded or being loaded.
+    std::deque<long long>   m_Queue;            // Chunks waiting for the background thread.
+    std::mutex              m_Mutex;            // Guards the chunks and the queue.
+    std::condition_variable m_Condition;        // Wakes the background thread.
+    std::thread             m_Worker;           // The background thread.
+    BOOL                    m_bIsStopping;      // Wether the background thread should end.
+
+    int           m_nMemoryBudget; // Most bytes the chunks should take.
+    int           m_nMemoryUsage;  // Bytes taken by the chunks at the last Update().
+    unsigned long m_ulFrame;       // Number of Update() calls so far.
+
+    BOOL m_bIsReady; // Wether the chunk map has been created or not.
+
+    static long long MakeKey(int nChunkCol, int nChunkRow);
+    static int FloorDiv(int nValue, int nDivisor);
+
+    BOOL GetChunkRange(int nMargin, int* pnFirstCol, int* pnLastCol, int* pnFirstRow,
+                       int* pnLastRow);
+    void RequestChunks();
+    void BuildChunk(GS_MapChunk* pgsChunk);
+    void EvictChunks();
+    void FreeChunk(GS_MapChunk* pgsChunk);
+    void Work();
+
+    static BOOL LoadChunkFile(int nChunkCol, int nChunkRow, int nNumRows, int nNumCols,
+                              int* pnTileIDs, void* pUserData);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLChunkMap();
+    ~GS_OGLChunkMap();
+
+    BOOL Create(GLuint glTexture, int nWidth, int nHeight, int nTotalTiles, int nTilesPerLine,
+                int nTileWidth, int nTileHeight, int nChunkRows, int nChunkCols);
+    void Destroy();
+    BOOL IsReady();
+
+    void SetLoader(GS_ChunkLoader pLoader, void* pUserData);
+    void SetChunkFiles(const char* pszPattern);
+    void SetWorldSize(int nNumChunkCols, int nNumChunkRows);
+
+    void Update();
+    BOOL Render(HWND hWnd = NULL);
+
+    void SetClipBox(int nMinX = -1, int nMinY = -1, int nMaxX = -1, int nMaxY = -1);
+    void SetClipBox(RECT rcClipBox);
+    RECT GetClipBox();
+
+    void SetMapX(int nDestX);
+    void SetMapY(int nDestY);
+    int  GetMapX();
+    int  GetMapY();
+
+    void ScrollX(int nDistance);
+    void ScrollY(int nDistance);
+
+    int  GetTileID(int nRow, int nCol);
+
+    void SetClearTileID(int nTileID);
+    void SetModulateColor(float fRed = -1.0f, float fGreen = -1.0f, float fBlue = -1.0f,
+                          float fAlpha = -1.0f);
+
+    void SetMemoryBudget(int nBytes);
+    int  GetMemoryBudget();
+    int  GetMemoryUsage();
+    int  GetNumChunks();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,834 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_core_renderer.cpp, gs_ogl_core_renderer.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLCoreRenderer                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Draws the quads of the GS library with one shader program, vertex buffers that are  |
+ |        created once and reused every frame, and a projection uniform instead of the fixed- |
+ |        function matrices, so the library can run on an OpenGL 3.3 core profile context.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_core_renderer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Shader sources. The vertex shader does what the modelview and projection matrices did for
+// the fixed-function pipeline, the fragment shader what GL_MODULATE did.
+// ---------------------------------------------------------------------------------------------
+static const char* g_pszVertexShader =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 aPosition;\n"
+    "layout(location = 1) in vec2 aTexCoord;\n"
+    "layout(location = 2) in vec4 aColor;\n"
+    "uniform mat4 uProjection;\n"
+    "uniform vec2 uOffset;\n"
+    "uniform vec2 uScale;\n"
+    "out vec2 vTexCoord;\n"
+    "out vec4 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    vTexCoord   = aTexCoord;\n"
+    "    vColor      = aColor;\n"
+    "    gl_Position = uProjection * vec4((aPosition * uScale) + uOffset, 0.0, 1.0);\n"
+    "}\n";
+// ---------------------------------------------------------------------------------------------
+static const char* g_pszFragmentShader =
+    "#version 330 core\n"
+    "in vec2 vTexCoord;\n"
+    "in vec4 vColor;\n"
+    "uniform sampler2D uTexture;\n"
+    "out vec4 fColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fColor = texture(uTexture, vTexCoord) * vColor;\n"
+    "}\n";
+// ---------------------------------------------------------------------------------------------
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+BOOL GS_OGLCoreRenderer::m_bIsActive   = FALSE;
+BOOL GS_OGLCoreRenderer::m_bIsSoftware = FALSE;
+// ---------------------------------------------------------------------------------------------
+GLuint GS_OGLCoreRenderer::m_gluProgram       = 0;
+GLint  GS_OGLCoreRenderer::m_gliProjectionLoc = -1;
+GLint  GS_OGLCoreRenderer::m_gliOffsetLoc     = -1;
+GLint  GS_OGLCoreRenderer::m_gliScaleLoc      = -1;
+// ---------------------------------------------------------------------------------------------
+GLuint GS_OGLCoreRenderer::m_gluStreamArray  = 0;
+GLuint GS_OGLCoreRenderer::m_gluStreamBuffer = 0;
+int    GS_OGLCoreRenderer::m_nStreamSize     = 0;
+int    GS_OGLCoreRenderer::m_nStreamOffset   = 0;
+// ---------------------------------------------------------------------------------------------
+GLuint GS_OGLCoreRenderer::m_gluBufferArray = 0;
+// ---------------------------------------------------------------------------------------------
+const BYTE*     GS_OGLCoreRenderer::m_pBufferData           = NULL;
+int             GS_OGLCoreRenderer::m_nBufferStride         = 0;
+int             GS_OGLCoreRenderer::m_nBufferTexCoordOffset = 0;
+GS_OGLColor     GS_OGLCoreRenderer::m_gsBufferColor;
+GS_BatchVertex* GS_OGLCoreRenderer::m_pBufferVertices       = NULL;
+int             GS_OGLCoreRenderer::m_nBufferSize           = 0;
+// ---------------------------------------------------------------------------------------------
+GLuint GS_OGLCoreRenderer::m_gluIndexBuffer   = 0;
+int    GS_OGLCoreRenderer::m_nNumIndexedQuads = 0;
+// ---------------------------------------------------------------------------------------------
+GLfloat GS_OGLCoreRenderer::m_glfProjection[16];
+GLfloat GS_OGLCoreRenderer::m_glfProjectionStack[GS_CORE_MAX_PROJECTIONS][16];
+int     GS_OGLCoreRenderer::m_nNumProjections = 0;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds the shader program and the buffers, must be called with an OpenGL 3.3 (or
+//          later) rendering context current and GS_OGLExtensions loaded. From then on the GS
+//          library draws through the renderer instead of the fixed-function pipeline. With
+//          bSoftware no shaders or buffers are made, the quads are handed to GS_SoftRenderer
+//          (which must have been created) to rasterize on the CPU.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLCoreRenderer::Create(BOOL bSoftware)
+{
+
+    if (m_bIsActive)
+    {
+        Destroy();
+    }
+
+    if (bSoftware)
+    {
+        if (!GS_SoftRenderer::IsActive())
+        {
+            GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 128, "Software renderer not created!");
+            return FALSE;
+        }
+
+        m_nNumProjections = 0;
+        m_bIsSoftware     = TRUE;
+        m_bIsActive       = TRUE;
+
+        SetOrtho(0.0f, (GLfloat) GS_SoftRenderer::GetWidth(), 0.0f,
+                 (GLfloat) GS_SoftRenderer::GetHeight(), -1.0f, 1.0f);
+
+        return TRUE;
+    }
+
+    if (!GS_OGLExtensions::HasShaders())
+    {
+        GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 116, "OpenGL 3.3 is not available!");
+        return FALSE;
+    }
+
+    GLuint gluVertexShader   = CompileShader(GL_VERTEX_SHADER, g_pszVertexShader);
+    GLuint gluFragmentShader = CompileShader(GL_FRAGMENT_SHADER, g_pszFragmentShader);
+
+    if ((gluVertexShader == 0) || (gluFragmentShader == 0))
+    {
+        if (gluVertexShader != 0)
+        {
+            gsglDeleteShader(gluVertexShader);
+        }
+        if (gluFragmentShader != 0)
+        {
+            gsglDeleteShader(gluFragmentShader);
+        }
+        return FALSE;
+    }
+
+    m_gluProgram = gsglCreateProgram();
+
+    gsglAttachShader(m_gluProgram, gluVertexShader);
+    gsglAttachShader(m_gluProgram, gluFragmentShader);
+    gsglLinkProgram(m_gluProgram);
+
+    // The program keeps the shaders alive for as long as it needs them.
+    gsglDeleteShader(gluVertexShader);
+    gsglDeleteShader(gluFragmentShader);
+
+    GLint gliStatus = 0;
+    gsglGetProgramiv(m_gluProgram, GL_LINK_STATUS, &gliStatus);
+
+    if (!gliStatus)
+    {
+        char szLog[512] = { 0 };
+        gsglGetProgramInfoLog(m_gluProgram, sizeof(szLog) - 1, NULL, szLog);
+        GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 153, szLog);
+        Destroy();
+        return FALSE;
+    }
+
+    m_gliProjectionLoc = gsglGetUniformLocation(m_gluProgram, "uProjection");
+    m_gliOffsetLoc     = gsglGetUniformLocation(m_gluProgram, "uOffset");
+    m_gliScaleLoc      = gsglGetUniformLocation(m_gluProgram, "uScale");
+
+    // Nothing else uses shaders, so the program stays in use.
+    gsglUseProgram(m_gluProgram);
+    gsglUniform1i(gsglGetUniformLocation(m_gluProgram, "uTexture"), 0);
+    gsglUniform2f(m_gliOffsetLoc, 0.0f, 0.0f);
+    gsglUniform2f(m_gliScaleLoc, 1.0f, 1.0f);
+
+    gsglGenVertexArrays(1, &m_gluStreamArray);
+    gsglGenVertexArrays(1, &m_gluBufferArray);
+    gsglGenBuffers(1, &m_gluStreamBuffer);
+    gsglGenBuffers(1, &m_gluIndexBuffer);
+
+    // Allocate the stream buffer once, it is only reallocated if a draw doesn't fit.
+    m_nStreamSize   = GS_CORE_DEFAULT_QUADS * 4;
+    m_nStreamOffset = 0;
+
+    gsglBindBuffer(GL_ARRAY_BUFFER, m_gluStreamBuffer);
+    gsglBufferData(GL_ARRAY_BUFFER, m_nStreamSize * sizeof(GS_BatchVertex), NULL, GL_STREAM_DRAW);
+
+    if (!MakeIndices(GS_CORE_DEFAULT_QUADS))
+    {
+        Destroy();
+        return FALSE;
+    }
+
+    SetupArray(m_gluStreamArray, m_gluStreamBuffer, sizeof(GS_BatchVertex),
+               offsetof(GS_BatchVertex, fU), offsetof(GS_BatchVertex, fRed));
+
+    m_nNumProjections = 0;
+
+    m_bIsActive = TRUE;
+
+    // Start out with a projection that maps one unit to one pixel of the viewport.
+    GLint gliViewport[4] = { 0, 0, 1, 1 };
+    glGetIntegerv(GL_VIEWPORT, gliViewport);
+
+    SetOrtho(0.0f, (GLfloat) gliViewport[2], 0.0f, (GLfloat) gliViewport[3], -1.0f, 1.0f);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Deletes the program and the buffers, must be called before the rendering context
+//          is destroyed (GS_OGLDisplay::Destroy() does this).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::Destroy()
+{
+
+    if ((m_gluProgram != 0) && (gsglDeleteProgram))
+    {
+        gsglUseProgram(0);
+        gsglDeleteProgram(m_gluProgram);
+    }
+    m_gluProgram = 0;
+
+    if (gsglDeleteVertexArrays)
+    {
+        if (m_gluStreamArray != 0)
+        {
+            gsglDeleteVertexArrays(1, &m_gluStreamArray);
+        }
+        if (m_gluBufferArray != 0)
+        {
+            gsglDeleteVertexArrays(1, &m_gluBufferArray);
+        }
+    }
+    m_gluStreamArray = 0;
+    m_gluBufferArray = 0;
+
+    if (gsglDeleteBuffers)
+    {
+        if (m_gluStreamBuffer != 0)
+        {
+            gsglDeleteBuffers(1, &m_gluStreamBuffer);
+        }
+        if (m_gluIndexBuffer != 0)
+        {
+            gsglDeleteBuffers(1, &m_gluIndexBuffer);
+        }
+    }
+    m_gluStreamBuffer = 0;
+    m_gluIndexBuffer  = 0;
+
+    m_gliProjectionLoc = -1;
+    m_gliOffsetLoc     = -1;
+    m_gliScaleLoc      = -1;
+
+    m_nStreamSize      = 0;
+    m_nStreamOffset    = 0;
+    m_nNumIndexedQuads = 0;
+    m_nNumProjections  = 0;
+
+    if (m_pBufferVertices)
+    {
+        delete[] m_pBufferVertices;
+        m_pBufferVertices = NULL;
+    }
+    m_nBufferSize = 0;
+    m_pBufferData = NULL;
+
+    m_bIsSoftware = FALSE;
+    m_bIsActive   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::CompileShader():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Compiles a single shader, reporting the compiler output if it fails.
+// ---------------------------------------------------------------------------------------------
+// Returns: The shader, 0 if it could not be compiled.
+//==============================================================================================
+
+GLuint GS_OGLCoreRenderer::CompileShader(GLenum glType, const char* pszSource)
+{
+
+    GLuint gluShader = gsglCreateShader(glType);
+
+    if (gluShader == 0)
+    {
+        return 0;
+    }
+
+    gsglShaderSource(gluShader, 1, &pszSource, NULL);
+    gsglCompileShader(gluShader);
+
+    GLint gliStatus = 0;
+    gsglGetShaderiv(gluShader, GL_COMPILE_STATUS, &gliStatus);
+
+    if (!gliStatus)
+    {
+        char szLog[512] = { 0 };
+        gsglGetShaderInfoLog(gluShader, sizeof(szLog) - 1, NULL, szLog);
+        GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 297, szLog);
+        gsglDeleteShader(gluShader);
+        return 0;
+    }
+
+    return gluShader;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::MakeIndices():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes sure the index buffer covers the specified number of quads. Core profiles
+//          have no GL_QUADS, so every four vertices are drawn as two triangles (0, 1, 2 and
+//          0, 2, 3), which works for all the quads in the library since they are stored as
+//          bottom left, bottom right, top right and top left.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLCoreRenderer::MakeIndices(int nNumQuads)
+{
+
+    if (nNumQuads <= m_nNumIndexedQuads)
+    {
+        return TRUE;
+    }
+
+    // Grow by at least doubling so growing batches don't rebuild the indices every frame.
+    if (nNumQuads < (m_nNumIndexedQuads * 2))
+    {
+        nNumQuads = m_nNumIndexedQuads * 2;
+    }
+
+    GLuint* pIndices = new GLuint[nNumQuads * 6];
+
+    if (!pIndices)
+    {
+        GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 338, "Failed to allocate quad indices!");
+        return FALSE;
+    }
+
+    for (int nQuad = 0; nQuad < nNumQuads; nQuad++)
+    {
+        GLuint* pIndex  = &pIndices[nQuad * 6];
+        GLuint  gluBase = nQuad * 4;
+
+        pIndex[0] = gluBase;
+        pIndex[1] = gluBase + 1;
+        pIndex[2] = gluBase + 2;
+        pIndex[3] = gluBase;
+        pIndex[4] = gluBase + 2;
+        pIndex[5] = gluBase + 3;
+    }
+
+    // The element buffer binding belongs to the bound vertex array, so bind one first.
+    gsglBindVertexArray(m_gluStreamArray);
+    gsglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_gluIndexBuffer);
+    gsglBufferData(GL_ELEMENT_ARRAY_BUFFER, nNumQuads * 6 * sizeof(GLuint), pIndices,
+                   GL_STATIC_DRAW);
+
+    delete[] pIndices;
+
+    m_nNumIndexedQuads = nNumQuads;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::SetupArray():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Points a vertex array at the position, texture coordinates and (if nColorOffset is
+//          not negative) the colors in a vertex buffer, and at the shared index buffer.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::SetupArray(GLuint gluArray, GLuint gluBuffer, int nStride,
+                                    int nTexCoordOffset, int nColorOffset)
+{
+
+    gsglBindVertexArray(gluArray);
+    gsglBindBuffer(GL_ARRAY_BUFFER, gluBuffer);
+    gsglBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_gluIndexBuffer);
+
+    gsglVertexAttribPointer(GS_CORE_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, nStride,
+                            (const void*) 0);
+    gsglEnableVertexAttribArray(GS_CORE_ATTRIB_POSITION);
+
+    gsglVertexAttribPointer(GS_CORE_ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, nStride,
+                            (const void*) (size_t) nTexCoordOffset);
+    gsglEnableVertexAttribArray(GS_CORE_ATTRIB_TEXCOORD);
+
+    if (nColorOffset >= 0)
+    {
+        gsglVertexAttribPointer(GS_CORE_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE, nStride,
+                                (const void*) (size_t) nColorOffset);
+        gsglEnableVertexAttribArray(GS_CORE_ATTRIB_COLOR);
+    }
+    else
+    {
+        gsglDisableVertexAttribArray(GS_CORE_ATTRIB_COLOR);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Projection Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::IsActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks wether the renderer is drawing the quads of the GS library, the classes that
+//          draw directly use it to choose between their shader and fixed-function code.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if active, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLCoreRenderer::IsActive()
+{
+
+    return m_bIsActive;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::IsSoftware():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks wether the quads are rasterized by GS_SoftRenderer instead of the shaders.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if they are, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLCoreRenderer::IsSoftware()
+{
+
+    return m_bIsSoftware;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::SetOrtho():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the current projection with the same matrix glOrtho() would produce.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::SetOrtho(GLfloat glfLeft, GLfloat glfRight, GLfloat glfBottom,
+                                  GLfloat glfTop, GLfloat glfNear, GLfloat glfFar)
+{
+
+    memset(m_glfProjection, 0, sizeof(m_glfProjection));
+
+    // Column major, as OpenGL expects it.
+    m_glfProjection[0]  = 2.0f / (glfRight - glfLeft);
+    m_glfProjection[5]  = 2.0f / (glfTop - glfBottom);
+    m_glfProjection[10] = -2.0f / (glfFar - glfNear);
+    m_glfProjection[12] = -(glfRight + glfLeft) / (glfRight - glfLeft);
+    m_glfProjection[13] = -(glfTop + glfBottom) / (glfTop - glfBottom);
+    m_glfProjection[14] = -(glfFar + glfNear) / (glfFar - glfNear);
+    m_glfProjection[15] = 1.0f;
+
+    if ((m_bIsActive) && (!m_bIsSoftware))
+    {
+        gsglUniformMatrix4fv(m_gliProjectionLoc, 1, GL_FALSE, m_glfProjection);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::PushProjection():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves the current projection, like glPushMatrix() did for GL_PROJECTION.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::PushProjection()
+{
+
+    if (m_nNumProjections >= GS_CORE_MAX_PROJECTIONS)
+    {
+        GS_Error::Report("GS_OGL_CORE_RENDERER.CPP", 483, "Projection stack overflow!");
+        return;
+    }
+
+    memcpy(m_glfProjectionStack[m_nNumProjections], m_glfProjection, sizeof(m_glfProjection));
+    m_nNumProjections++;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::PopProjection():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Restores the projection saved by the last PushProjection().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::PopProjection()
+{
+
+    if (m_nNumProjections <= 0)
+    {
+        return;
+    }
+
+    m_nNumProjections--;
+    memcpy(m_glfProjection, m_glfProjectionStack[m_nNumProjections], sizeof(m_glfProjection));
+
+    if ((m_bIsActive) && (!m_bIsSoftware))
+    {
+        gsglUniformMatrix4fv(m_gliProjectionLoc, 1, GL_FALSE, m_glfProjection);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Draw Methods. ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::DrawQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws quads given in screen coordinates with the currently bound texture, four
+//          vertices per quad. The vertices are appended to the stream buffer, which is only
+//          orphaned (so the driver doesn't have to wait for earlier draws) when it is full.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::DrawQuads(const GS_BatchVertex* pVertices, int nNumVertices)
+{
+
+    if ((!m_bIsActive) || (!pVertices) || (nNumVertices < 4))
+    {
+        return;
+    }
+
+    if (m_bIsSoftware)
+    {
+        GS_SoftRenderer::DrawQuads(GS_OGLState::GetTexture(), pVertices, nNumVertices,
+                                   m_glfProjection);
+        return;
+    }
+
+    int nNumQuads = nNumVertices / 4;
+
+    if (!MakeIndices(nNumQuads))
+    {
+        return;
+    }
+
+    gsglBindBuffer(GL_ARRAY_BUFFER, m_gluStreamBuffer);
+
+    if (nNumVertices > m_nStreamSize)
+    {
+        // Too big for the buffer, make it larger.
+        m_nStreamSize   = (nNumVertices > (m_nStreamSize * 2)) ? nNumVertices : (m_nStreamSize * 2);
+        m_nStreamOffset = 0;
+        gsglBufferData(GL_ARRAY_BUFFER, m_nStreamSize * sizeof(GS_BatchVertex), NULL,
+                       GL_STREAM_DRAW);
+    }
+    else if ((m_nStreamOffset + nNumVertices) > m_nStreamSize)
+    {
+        // The buffer is full, start over in fresh storage.
+        m_nStreamOffset = 0;
+        gsglBufferData(GL_ARRAY_BUFFER, m_nStreamSize * sizeof(GS_BatchVertex), NULL,
+                       GL_STREAM_DRAW);
+    }
+
+    gsglBufferSubData(GL_ARRAY_BUFFER, m_nStreamOffset * sizeof(GS_BatchVertex),
+                      nNumQuads * 4 * sizeof(GS_BatchVertex), pVertices);
+
+    gsglBindVertexArray(m_gluStreamArray);
+    gsglDrawElementsBaseVertex(GL_TRIANGLES, nNumQuads * 6, GL_UNSIGNED_INT, (const void*) 0,
+                               m_nStreamOffset);
+
+    m_nStreamOffset += nNumQuads * 4;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::BeginBuffer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Prepares to draw quads from a vertex buffer owned by the caller (like the cached
+//          geometry of GS_OGLMap), with a position at the start of each vertex, the texture
+//          coordinates at nTexCoordOffset and one color for all of them. pData holds the same
+//          vertices in memory, they are drawn from there by the software renderer (or if
+//          gluBuffer is 0).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::BeginBuffer(GLuint gluBuffer, const GLvoid* pData, int nStride,
+                                     int nTexCoordOffset, const GS_OGLColor& gsColor)
+{
+
+    if (!m_bIsActive)
+    {
+        return;
+    }
+
+    m_nBufferStride         = nStride;
+    m_nBufferTexCoordOffset = nTexCoordOffset;
+    m_gsBufferColor         = gsColor;
+
+    if ((m_bIsSoftware) || (gluBuffer == 0))
+    {
+        m_pBufferData = (const BYTE*) pData;
+        return;
+    }
+
+    m_pBufferData = NULL;
+
+    SetupArray(m_gluBufferArray, gluBuffer, nStride, nTexCoordOffset, -1);
+
+    // With the color array disabled every vertex gets this color.
+    gsglVertexAttrib4f(GS_CORE_ATTRIB_COLOR, gsColor.fRed, gsColor.fGreen, gsColor.fBlue,
+                       gsColor.fAlpha);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::DrawBuffer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws nNumVertices vertices of the buffer given to BeginBuffer(), starting at
+//          nFirstVertex, each position scaled and then offset (like glTranslatef() followed
+//          by glScalef()).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::DrawBuffer(int nFirstVertex, int nNumVertices, GLfloat glfOffsetX,
+                                    GLfloat glfOffsetY, GLfloat glfScaleX, GLfloat glfScaleY)
+{
+
+    if ((!m_bIsActive) || (nFirstVertex < 0) || (nNumVertices < 4))
+    {
+        return;
+    }
+
+    int nNumQuads = nNumVertices / 4;
+
+    if (m_pBufferData)
+    {
+        // Apply the offset and scale here and draw the vertices like batched quads.
+        if ((nNumQuads * 4) > m_nBufferSize)
+        {
+            if (m_pBufferVertices)
+            {
+                delete[] m_pBufferVertices;
+            }
+            m_nBufferSize     = nNumQuads * 4;
+            m_pBufferVertices = new GS_BatchVertex[m_nBufferSize];
+        }
+
+        for (int nVertex = 0; nVertex < (nNumQuads * 4); nVertex++)
+        {
+            const BYTE*    pVertex   = m_pBufferData +
+                                       ((nFirstVertex + nVertex) * m_nBufferStride);
+            const GLfloat* pPosition = (const GLfloat*) pVertex;
+            const GLfloat* pTexCoord = (const GLfloat*) (pVertex + m_nBufferTexCoordOffset);
+
+            m_pBufferVertices[nVertex].fX     = (pPosition[0] * glfScaleX) + glfOffsetX;
+            m_pBufferVertices[nVertex].fY     = (pPosition[1] * glfScaleY) + glfOffsetY;
+            m_pBufferVertices[nVertex].fU     = pTexCoord[0];
+            m_pBufferVertices[nVertex].fV     = pTexCoord[1];
+            m_pBufferVertices[nVertex].fRed   = m_gsBufferColor.fRed;
+            m_pBufferVertices[nVertex].fGreen = m_gsBufferColor.fGreen;
+            m_pBufferVertices[nVertex].fBlue  = m_gsBufferColor.fBlue;
+            m_pBufferVertices[nVertex].fAlpha = m_gsBufferColor.fAlpha;
+        }
+
+        DrawQuads(m_pBufferVertices, nNumQuads * 4);
+        return;
+    }
+
+    if (!MakeIndices(nNumQuads))
+    {
+        return;
+    }
+
+    gsglUniform2f(m_gliOffsetLoc, glfOffsetX, glfOffsetY);
+    gsglUniform2f(m_gliScaleLoc, glfScaleX, glfScaleY);
+
+    gsglBindVertexArray(m_gluBufferArray);
+    gsglDrawElementsBaseVertex(GL_TRIANGLES, nNumQuads * 6, GL_UNSIGNED_INT, (const void*) 0,
+                               nFirstVertex);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::EndBuffer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finishes drawing from the caller's vertex buffer.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::EndBuffer()
+{
+
+    if (!m_bIsActive)
+    {
+        return;
+    }
+
+    if (m_pBufferData)
+    {
+        m_pBufferData = NULL;
+        return;
+    }
+
+    gsglUniform2f(m_gliOffsetLoc, 0.0f, 0.0f);
+    gsglUniform2f(m_gliScaleLoc, 1.0f, 1.0f);
+
+    gsglBindVertexArray(m_gluStreamArray);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLCoreRenderer::DrawQuad():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws a single quad in screen coordinates with the specified texture, for the code
+//          that used to draw directly with glBegin() when no sprite batch is active.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLCoreRenderer::DrawQuad(GLuint gluTexture, const GLfloat* pVertices,
+                                  const GLfloat* pTexCoords, const GS_OGLColor& gsColor)
+{
+
+    if (!m_bIsActive)
+    {
+        return;
+    }
+
+    GS_BatchVertex gsVertices[4];
+
+    for (int nCorner = 0; nCorner < 4; nCorner++)
+    {
+        gsVertices[nCorner].fX     = pVertices[nCorner * 2];
+        gsVertices[nCorner].fY     = pVertices[(nCorner * 2) + 1];
+        gsVertices[nCorner].fU     = pTexCoords[nCorner * 2];
+        gsVertices[nCorner].fV     = pTexCoords[(nCorner * 2) + 1];
+        gsVertices[nCorner].fRed   = gsColor.fRed;
+        gsVertices[nCorner].fGreen = gsColor.fGreen;
+        gsVertices[nCorner].fBlue  = gsColor.fBlue;
+        gsVertices[nCorner].fAlpha = gsColor.fAlpha;
+    }
+
+    GS_OGLState::BindTexture(gluTexture);
+
+    DrawQuads(gsVertices, 4);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,139 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_core_renderer.cpp, gs_ogl_core_renderer.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLCoreRenderer                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Draws the quads of the GS library with one shader program, vertex buffers that are  |
+ |        created once and reused every frame, and a projection uniform instead of the fixed- |
+ |        function matrices, so the library can run on an OpenGL 3.3 core profile context.   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_CORE_RENDERER_H
+#define GS_OGL_CORE_RENDERER_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_ogl_color.h"
+#include "gs_ogl_extensions.h"
+#include "gs_ogl_state.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_soft_renderer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Core renderer defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_CORE_DEFAULT_QUADS    4096 // Number of quads the stream buffer initially holds.
+#define GS_CORE_MAX_PROJECTIONS  4    // Depth of the projection stack.
+// ---------------------------------------------------------------------------------------------
+#define GS_CORE_ATTRIB_POSITION  0    // Vertex attribute locations used by the shaders.
+#define GS_CORE_ATTRIB_TEXCOORD  1
+#define GS_CORE_ATTRIB_COLOR     2
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLCoreRenderer
+{
+
+private:
+
+    static BOOL m_bIsActive;   // Wether the renderer has been created and is drawing the quads.
+    static BOOL m_bIsSoftware; // Wether the quads are handed to GS_SoftRenderer instead.
+
+    static GLuint m_gluProgram; // The shader program used for everything.
+    static GLint  m_gliProjectionLoc; // Uniform locations.
+    static GLint  m_gliOffsetLoc;
+    static GLint  m_gliScaleLoc;
+
+    static GLuint m_gluStreamArray;  // Vertex array reading from the stream buffer.
+    static GLuint m_gluStreamBuffer; // Vertex buffer the batched quads are written to.
+    static int    m_nStreamSize;     // Size of the stream buffer in vertices.
+    static int    m_nStreamOffset;   // First unused vertex in the stream buffer.
+
+    static GLuint m_gluBufferArray;  // Vertex array reading from a buffer owned by the caller.
+
+    static const BYTE*     m_pBufferData;    // The same vertices in memory, for the software renderer.
+    static int             m_nBufferStride;  // Layout of the caller's vertices.
+    static int             m_nBufferTexCoordOffset;
+    static GS_OGLColor     m_gsBufferColor;  // Color of the caller's vertices.
+    static GS_BatchVertex* m_pBufferVertices; // The caller's vertices converted for DrawQuads().
+    static int             m_nBufferSize;     // Size of that array in vertices.
+
+    static GLuint m_gluIndexBuffer; // Indices turning every four vertices into two triangles.
+    static int    m_nNumIndexedQuads; // Number of quads the index buffer covers.
+
+    static GLfloat m_glfProjection[16]; // The current projection matrix.
+    static GLfloat m_glfProjectionStack[GS_CORE_MAX_PROJECTIONS][16];
+    static int     m_nNumProjections;   // Number of matrices on the projection stack.
+
+    static GLuint CompileShader(GLenum glType, const char* pszSource);
+    static BOOL   MakeIndices(int nNumQuads);
+    static void   SetupArray(GLuint gluArray, GLuint gluBuffer, int nStride, int nTexCoordOffset,
+                             int nColorOffset);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    static BOOL Create(BOOL bSoftware = FALSE);
+    static void Destroy();
+
+    static BOOL IsActive();
+    static BOOL IsSoftware();
+
+    static void SetOrtho(GLfloat glfLeft, GLfloat glfRight, GLfloat glfBottom, GLfloat glfTop,
+                         GLfloat glfNear, GLfloat glfFar);
+    static void PushProjection();
+    static void PopProjection();
+
+    static void DrawQuads(const GS_BatchVertex* pVertices, int nNumVertices);
+    static void DrawQuad(GLuint gluTexture, const GLfloat* pVertices, const GLfloat* pTexCoords,
+                         const GS_OGLColor& gsColor);
+
+    static void BeginBuffer(GLuint gluBuffer, const GLvoid* pData, int nStride,
+                            int nTexCoordOffset, const GS_OGLColor& gsColor);
+    static void DrawBuffer(int nFirstVertex, int nNumVertices, GLfloat glfOffsetX,
+                           GLfloat glfOffsetY, GLfloat glfScaleX, GLfloat glfScaleY);
+    static void EndBuffer();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -36,12 +36,27 @@ GS_OGLDisplay::GS_OGLDisplay()
     m_hRC = NULL;
     m_PixelFormat = 0;
 
+    m_nBackend = GS_BACKEND_FIXED;
+
     m_bIsAliasingEnabled = FALSE;
     m_bIsVSyncEnabled    = FALSE;
 
     m_bIsDepthTestEnabled = FALSE;
     m_bIsLightingEnabled  = FALSE;
 
+    m_bIsBatchingEnabled = FALSE;
+    m_bIsSortingEnabled  = FALSE;
+
+    m_pReadback          = NULL;
+    m_nReadbackWidth     = 0;
+    m_nReadbackHeight    = 0;
+    m_bIsReadbackEnabled = FALSE;
+
+    m_nInternalWidth  = 0;
+    m_nInternalHeight = 0;
+    m_nUpscaleMode    = GS_UPSCALE_NONE;
+    SetRect(&m_rcWindow, 0, 0, 0, 0);
+
     m_bIsReady = FALSE;
 
     g_fRenderModX = 0.0f;
@@ -80,15 +95,20 @@ GS_OGLDisplay::~GS_OGLDisplay()
 //==============================================================================================
 // GS_OGLDisplay::Create():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Creates the rendering context. With GS_BACKEND_SHADER everything is drawn by
+//          GS_OGLCoreRenderer (on an OpenGL 3.3 core profile context where SDL is used), if
+//          that isn't available the fixed-function pipeline is used instead (see GetBackend()).
+//          With GS_BACKEND_SOFTWARE the quads are rasterized by GS_SoftRenderer on the CPU and
+//          the finished frame is copied to the window.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull,FALSE if failed.
 //==============================================================================================
 
 #ifdef GS_PLATFORM_WINDOWS
-BOOL GS_OGLDisplay::Create(HDC& hDC, int nWidth, int nHeight, int nDepth)
+BOOL GS_OGLDisplay::Create(HDC& hDC, int nWidth, int nHeight, int nDepth, int nBackend)
 #else
-BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDepth)
+BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDepth,
+                           int nBackend)
 #endif
 {
     (void)nDepth; // Depth handled by SDL/OpenGL automatically
@@ -171,8 +191,38 @@ BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDe
         return FALSE;
     }
 #else
+    m_hRC = NULL;
+
+    // The shader backend doesn't need the fixed-function pipeline, so ask for a core profile.
+    if (nBackend == GS_BACKEND_SHADER)
+    {
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#ifdef __APPLE__
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+#endif
+
+        m_hRC = SDL_GL_CreateContext(pWindow);
+
+        // Put back the attributes of the fixed-function context.
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, 0);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, 0);
+
+        // Use the fixed-function pipeline if there is no core profile.
+        if (!m_hRC)
+        {
+            nBackend = GS_BACKEND_FIXED;
+        }
+    }
+
     // SDL OpenGL initialization
-    m_hRC = SDL_GL_CreateContext(pWindow);
+    if (!m_hRC)
+    {
+        m_hRC = SDL_GL_CreateContext(pWindow);
+    }
     if (!m_hRC)
     {
         GS_Error::Report("GS_OGL_DISPLAY.CPP", 144, "Failed to create GL context!");
@@ -187,6 +237,41 @@ BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDe
     }
 #endif
 
+    // Load the OpenGL functions beyond OpenGL 1.1 now that the rendering context is current.
+    GS_OGLExtensions::Load();
+
+    // Set up the software renderer if it was asked for, the fixed-function pipeline remains.
+    if (nBackend == GS_BACKEND_SOFTWARE)
+    {
+        if ((!GS_SoftRenderer::Create(nWidth, nHeight)) || (!GS_OGLCoreRenderer::Create(TRUE)))
+        {
+            GS_SoftRenderer::Destroy();
+            GS_Error::Report("GS_OGL_DISPLAY.CPP", 244, "Failed to create the software renderer!");
+            nBackend = GS_BACKEND_FIXED;
+        }
+    }
+
+    // Set up the shader renderer if it was asked for.
+    if ((nBackend == GS_BACKEND_SHADER) && (!GS_OGLCoreRenderer::Create()))
+    {
+#ifdef GS_PLATFORM_WINDOWS
+        // The context still has the fixed-function pipeline.
+        nBackend = GS_BACKEND_FIXED;
+#else
+        // A core profile context can't fall back to the fixed-function pipeline.
+        SDL_GL_DeleteContext(m_hRC);
+        m_hRC = NULL;
+        GS_OGLExtensions::Unload();
+        GS_Error::Report("GS_OGL_DISPLAY.CPP", 242, "Failed to create the shader renderer!");
+        return FALSE;
+#endif
+    }
+
+    m_nBackend = nBackend;
+
+    // Put the state shadowed by GS_OGLState into a known state.
+    GS_OGLState::Reset(m_nBackend != GS_BACKEND_SHADER);
+
     // Display has been successfully created.
     m_bIsReady = TRUE;
 
@@ -198,20 +283,31 @@ BOOL GS_OGLDisplay::Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDe
     // Depth buffer setup.
     glClearDepth(1.0f);
 
-    // Enable texture mapping.
-    glEnable(GL_TEXTURE_2D);
+    // Enable texture mapping (the shader renderer always samples its texture).
+    if (m_nBackend == GS_BACKEND_FIXED)
+    {
+        glEnable(GL_TEXTURE_2D);
+    }
 
     // Draw front and back faces of polygons.
     glDisable(GL_CULL_FACE);
     // Use depth testing.
-    glEnable(GL_DEPTH_TEST);
+    GS_OGLState::EnableDepthTest(TRUE);
     // The type of depth testing to do.
     glDepthFunc(GL_LEQUAL);
-    // Enable smooth shading.
-    glShadeModel(GL_SMOOTH);
+    if (m_nBackend == GS_BACKEND_FIXED)
+    {
+        // Enable smooth shading.
+        glShadeModel(GL_SMOOTH);
 
-    // Really nice perspective calculations.
-    glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+        // Really nice perspective calculations.
+        glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+    }
+    else
+    {
+        // The shader renderer only draws batched quads.
+        this->EnableBatching(TRUE);
+    }
 
     return TRUE;
 }
@@ -235,6 +331,14 @@ GLvoid GS_OGLDisplay::Destroy()
         return;
     }
 
+    // The scene target and the shader renderer's objects belong to the rendering context.
+    m_gsSceneTarget.Destroy();
+    m_nUpscaleMode = GS_UPSCALE_NONE;
+
+    GS_OGLCoreRenderer::Destroy();
+    GS_SoftRenderer::Destroy();
+    m_nBackend = GS_BACKEND_FIXED;
+
 #ifdef GS_PLATFORM_WINDOWS
     if (m_hRC)
     {
@@ -255,6 +359,9 @@ GLvoid GS_OGLDisplay::Destroy()
 #endif
     m_hRC = NULL;
 
+    // The function pointers belonged to the rendering context.
+    GS_OGLExtensions::Unload();
+
     m_PixelFormat = 0;
 
     m_bIsAliasingEnabled = FALSE;
@@ -263,6 +370,21 @@ GLvoid GS_OGLDisplay::Destroy()
     m_bIsDepthTestEnabled = FALSE;
     m_bIsLightingEnabled  = FALSE;
 
+    m_gsSpriteBatch.Destroy();
+    m_bIsBatchingEnabled = FALSE;
+
+    m_gsRenderQueue.Destroy();
+    m_bIsSortingEnabled = FALSE;
+
+    if (m_pReadback)
+    {
+        delete[] m_pReadback;
+        m_pReadback = NULL;
+    }
+    m_nReadbackWidth     = 0;
+    m_nReadbackHeight    = 0;
+    m_bIsReadbackEnabled = FALSE;
+
     m_bIsReady = FALSE;
 }
 
@@ -296,8 +418,18 @@ GLvoid GS_OGLDisplay::SetViewport(GLsizei glWidth, GLsizei glHeight, GLdouble gl
     // Set the OpenGL viewport.
     glViewport(0, 0, glWidth, glHeight);
 
+    // The shader and software renderers only have the projection set by BeginRender2D().
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        GS_SoftRenderer::Resize(glWidth, glHeight);
+    }
+    if (m_nBackend != GS_BACKEND_FIXED)
+    {
+        return;
+    }
+
     // Set projection matrix to the identity matrix.
-    glMatrixMode(GL_PROJECTION);
+    GS_OGLState::SetMatrixMode(GL_PROJECTION);
     glLoadIdentity();
 
     // Calculate the aspect ratio of the window with the following parameters: field of view in
@@ -306,7 +438,7 @@ GLvoid GS_OGLDisplay::SetViewport(GLsizei glWidth, GLsizei glHeight, GLdouble gl
     gluPerspective(glView, (GLfloat)glWidth / (GLfloat)glHeight, 0.1f, 100.0f);
 
     // Set the model view matrix to the identity matrix.
-    glMatrixMode(GL_MODELVIEW);
+    GS_OGLState::SetMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 }
 
@@ -407,13 +539,13 @@ GLvoid GS_OGLDisplay::EnableDepthTesting(BOOL bEnable, GLenum glType)
     if (bEnable)
     {
         // Enable depth testing and set type.
-        glEnable(GL_DEPTH_TEST);
+        GS_OGLState::EnableDepthTest(TRUE);
         glDepthFunc(glType);
     }
     else
     {
         // Disable depth testing.
-        glDisable(GL_DEPTH_TEST);
+        GS_OGLState::EnableDepthTest(FALSE);
     }
 }
 
@@ -436,13 +568,13 @@ GLvoid GS_OGLDisplay::EnableBlending(BOOL bEnable, GLenum glSourceFactor, GLenum
     if (bEnable)
     {
         // Set type of blending and enable it.
-        glBlendFunc(glSourceFactor, glDestFactor);
-        glEnable(GL_BLEND);
+        GS_OGLState::SetBlendFunc(glSourceFactor, glDestFactor);
+        GS_OGLState::EnableBlending(TRUE);
     }
     else
     {
         // Disable blending.
-        glDisable(GL_BLEND);
+        GS_OGLState::EnableBlending(FALSE);
     }
 }
 
@@ -465,14 +597,269 @@ GLvoid GS_OGLDisplay::EnableLighting(BOOL bEnable, GLenum glLightNum)
     if (bEnable)
     {
         // Enable lighting and set type.
-        glEnable(GL_LIGHTING);
-        glEnable(glLightNum);
+        GS_OGLState::EnableLighting(TRUE);
+
+        if (m_nBackend == GS_BACKEND_FIXED)
+        {
+            glEnable(glLightNum);
+        }
     }
     else
     {
         // Disable lighting.
-        glDisable(GL_LIGHTING);
+        GS_OGLState::EnableLighting(FALSE);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::EnableBatching():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When enabled, sprites and particles rendered between BeginRender2D() and
+//          EndRender2D() are collected in a sprite batch and drawn with as few draw calls as
+//          possible instead of one glBegin()/glEnd() block each.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::EnableBatching(BOOL bEnable)
+{
+
+    // Should we enable batching?
+    if (bEnable)
+    {
+        // Create the batch the first time batching is enabled.
+        if (!m_gsSpriteBatch.IsReady())
+        {
+            if (!m_gsSpriteBatch.Create())
+            {
+                GS_Error::Report("GS_OGL_DISPLAY.CPP", 508, "Failed to create sprite batch!");
+                return;
+            }
+        }
+        m_bIsBatchingEnabled = TRUE;
+    }
+    else
+    {
+        // The shader and software renderers can't draw without the batch.
+        if (m_nBackend != GS_BACKEND_FIXED)
+        {
+            return;
+        }
+
+        // Draw anything still in the batch.
+        m_gsSpriteBatch.End();
+        m_bIsBatchingEnabled = FALSE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::EnableSorting():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When enabled (along with batching), batched quads are held in a render queue and
+//          drawn sorted by layer (see GS_OGLRenderQueue::SetLayer()) and, within layers that
+//          allow it, by blend mode and texture whenever the batch is flushed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::EnableSorting(BOOL bEnable)
+{
+
+    // Should we enable sorting?
+    if (bEnable)
+    {
+        // Sorting only applies to batched quads.
+        if (!m_bIsBatchingEnabled)
+        {
+            this->EnableBatching(TRUE);
+        }
+
+        // Create the queue the first time sorting is enabled.
+        if (!m_gsRenderQueue.IsReady())
+        {
+            if (!m_gsRenderQueue.Create())
+            {
+                GS_Error::Report("GS_OGL_DISPLAY.CPP", 566, "Failed to create render queue!");
+                return;
+            }
+        }
+        m_gsSpriteBatch.SetQueue(&m_gsRenderQueue);
+        m_bIsSortingEnabled = TRUE;
+    }
+    else
+    {
+        // Draw anything still in the queue.
+        m_gsSpriteBatch.SetQueue(NULL);
+        m_bIsSortingEnabled = FALSE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::EnableReadback():
+// ---------------------------------------------------------------------------------------------
+// Purpose: When enabled, every frame is read back from the back buffer by EndRender() before
+//          it is shown, so the last one can be saved with SaveFrame() (used by headless runs).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::EnableReadback(BOOL bEnable)
+{
+
+    m_bIsReadbackEnabled = bEnable;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::SetInternalResolution():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes BeginRender2D() render the scene into an offscreen target of the specified
+//          size, which EndRender2D() then scales to the window in one draw (letterboxed to
+//          keep the aspect ratio). Sprites, fonts and maps no longer have to be scaled one by
+//          one, so the game should keep the scale factors at 1.0 while this is on. Passing
+//          GS_UPSCALE_NONE renders straight to the window again.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not (for instance without framebuffer objects, in
+//          which case rendering stays as it was).
+//==============================================================================================
+
+BOOL GS_OGLDisplay::SetInternalResolution(int nWidth, int nHeight, int nUpscaleMode)
+{
+
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    m_gsSceneTarget.Destroy();
+    m_nUpscaleMode = GS_UPSCALE_NONE;
+
+    if (nUpscaleMode == GS_UPSCALE_NONE)
+    {
+        return TRUE;
     }
+
+    if ((nUpscaleMode != GS_UPSCALE_INTEGER) && (nUpscaleMode != GS_UPSCALE_LINEAR))
+    {
+        return FALSE;
+    }
+
+    m_gsSceneTarget.SetFilter((nUpscaleMode == GS_UPSCALE_LINEAR) ? GL_LINEAR : GL_NEAREST);
+
+    if (!m_gsSceneTarget.Create(nWidth, nHeight))
+    {
+        return FALSE;
+    }
+
+    m_nInternalWidth  = nWidth;
+    m_nInternalHeight = nHeight;
+    m_nUpscaleMode    = nUpscaleMode;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::GetUpscaleRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Works out where the internal resolution is drawn in the window: as large as fits
+//          with the same aspect ratio (whole multiples only for GS_UPSCALE_INTEGER, unless the
+//          window is too small for even one) and centered on whole pixels. The rectangle is in
+//          OpenGL coordinates, so top is above bottom.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::GetUpscaleRect(RECT* prcDest)
+{
+
+    int nWindowWidth  = m_rcWindow.right  - m_rcWindow.left;
+    int nWindowHeight = m_rcWindow.bottom - m_rcWindow.top;
+
+    float fScaleX = (float) nWindowWidth  / (float) m_nInternalWidth;
+    float fScaleY = (float) nWindowHeight / (float) m_nInternalHeight;
+    float fScale  = (fScaleX < fScaleY) ? fScaleX : fScaleY;
+
+    if ((m_nUpscaleMode == GS_UPSCALE_INTEGER) && (fScale >= 1.0f))
+    {
+        fScale = (float) floor(fScale);
+    }
+
+    int nWidth  = (int) (m_nInternalWidth  * fScale);
+    int nHeight = (int) (m_nInternalHeight * fScale);
+
+    prcDest->left   = (nWindowWidth  - nWidth)  / 2;
+    prcDest->bottom = (nWindowHeight - nHeight) / 2;
+    prcDest->right  = prcDest->left   + nWidth;
+    prcDest->top    = prcDest->bottom + nHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::WindowToInternal():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts coordinates in the client area of the window (with the origin at the top
+//          left, like mouse messages) to the internal resolution (same origin), clamped to the
+//          edges when they lie in the borders around the scaled scene.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the coordinates were converted, FALSE if there is no internal resolution.
+//==============================================================================================
+
+BOOL GS_OGLDisplay::WindowToInternal(int* pnX, int* pnY)
+{
+
+    if ((m_nUpscaleMode == GS_UPSCALE_NONE) || (m_rcWindow.right <= m_rcWindow.left))
+    {
+        return FALSE;
+    }
+
+    RECT rcDest;
+    this->GetUpscaleRect(&rcDest);
+
+    int nWidth  = rcDest.right - rcDest.left;
+    int nHeight = rcDest.top   - rcDest.bottom;
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    // The top of the scene measured from the top of the window.
+    int nTop = (m_rcWindow.bottom - m_rcWindow.top) - rcDest.top;
+
+    int nX = ((*pnX - rcDest.left) * m_nInternalWidth)  / nWidth;
+    int nY = ((*pnY - nTop)        * m_nInternalHeight) / nHeight;
+
+    if (nX < 0) nX = 0;
+    if (nY < 0) nY = 0;
+    if (nX >= m_nInternalWidth)  nX = m_nInternalWidth  - 1;
+    if (nY >= m_nInternalHeight) nY = m_nInternalHeight - 1;
+
+    *pnX = nX;
+    *pnY = nY;
+
+    return TRUE;
 }
 
 
@@ -579,6 +966,20 @@ GLvoid GS_OGLDisplay::BeginRender()
     // Clear screen and depth buffer.
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        GLfloat glfClearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, glfClearColor);
+        GS_SoftRenderer::Clear(glfClearColor[0], glfClearColor[1], glfClearColor[2],
+                               glfClearColor[3]);
+    }
+
+    // There is no 3D view with the shader or software renderer.
+    if (m_nBackend != GS_BACKEND_FIXED)
+    {
+        return;
+    }
+
     // Reset the current modelview matrix.
     glLoadIdentity();
 
@@ -607,6 +1008,14 @@ GLvoid GS_OGLDisplay::EndRender(HDC& hDC)
     {
         return;
     }
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        GS_SoftRenderer::Present();
+    }
+    if (m_bIsReadbackEnabled)
+    {
+        this->ReadFrame();
+    }
     SwapBuffers(hDC);
 }
 #else
@@ -616,6 +1025,14 @@ GLvoid GS_OGLDisplay::EndRender(SDL_Window* pWindow)
     {
         return;
     }
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        GS_SoftRenderer::Present();
+    }
+    if (m_bIsReadbackEnabled)
+    {
+        this->ReadFrame();
+    }
     SDL_GL_SwapWindow(pWindow);
 }
 #endif
@@ -624,6 +1041,133 @@ GLvoid GS_OGLDisplay::EndRender(SDL_Window* pWindow)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLDisplay::ReadFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies the pixels of the finished frame from the back buffer, so the cost of reading
+//          frames back is part of what is measured and the last frame can be saved. With the
+//          software renderer the frame is copied from its framebuffer instead.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GLvoid GS_OGLDisplay::ReadFrame()
+{
+
+    int nWidth  = 0;
+    int nHeight = 0;
+
+    // The frame of the software renderer is read without OpenGL.
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        nWidth  = GS_SoftRenderer::GetWidth();
+        nHeight = GS_SoftRenderer::GetHeight();
+    }
+    else
+    {
+        GLint glViewport[4];
+        glGetIntegerv(GL_VIEWPORT, glViewport);
+
+        nWidth  = glViewport[0] + glViewport[2];
+        nHeight = glViewport[1] + glViewport[3];
+    }
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        return;
+    }
+
+    // Only reallocate the buffer when the size of the frame has changed.
+    if ((!m_pReadback) || (nWidth != m_nReadbackWidth) || (nHeight != m_nReadbackHeight))
+    {
+        if (m_pReadback)
+        {
+            delete[] m_pReadback;
+        }
+        m_pReadback       = new BYTE[nWidth * nHeight * 4];
+        m_nReadbackWidth  = nWidth;
+        m_nReadbackHeight = nHeight;
+    }
+
+    if (m_nBackend == GS_BACKEND_SOFTWARE)
+    {
+        GS_SoftRenderer::PresentToMemory(m_pReadback);
+        return;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, nWidth, nHeight, GL_RGBA, GL_UNSIGNED_BYTE, m_pReadback);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLDisplay::SaveFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Saves the last frame that was read back as an uncompressed 32-bit TGA file.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLDisplay::SaveFrame(LPCTSTR pszFilename)
+{
+
+    if ((!m_pReadback) || (!pszFilename))
+    {
+        return FALSE;
+    }
+
+    FILE* pFile = fopen(pszFilename, "wb");
+
+    if (!pFile)
+    {
+        GS_Error::Report("GS_OGL_DISPLAY.CPP", 924, "Failed to create frame file!");
+        return FALSE;
+    }
+
+    // An uncompressed true-color header with the origin in the lower left, which is also the
+    // order OpenGL returns the rows in.
+    BYTE byHeader[18] = { 0 };
+    byHeader[2]  = 2;
+    byHeader[12] = (BYTE) (m_nReadbackWidth & 0xFF);
+    byHeader[13] = (BYTE) ((m_nReadbackWidth >> 8) & 0xFF);
+    byHeader[14] = (BYTE) (m_nReadbackHeight & 0xFF);
+    byHeader[15] = (BYTE) ((m_nReadbackHeight >> 8) & 0xFF);
+    byHeader[16] = 32;
+    byHeader[17] = 8;
+
+    fwrite(byHeader, sizeof(BYTE), 18, pFile);
+
+    // TGA files store the pixels as BGRA.
+    int   nRowSize = m_nReadbackWidth * 4;
+    BYTE* pRow     = new BYTE[nRowSize];
+
+    for (int nRow = 0; nRow < m_nReadbackHeight; nRow++)
+    {
+        BYTE* pSource = m_pReadback + (nRow * nRowSize);
+        for (int nByte = 0; nByte < nRowSize; nByte += 4)
+        {
+            pRow[nByte]     = pSource[nByte + 2];
+            pRow[nByte + 1] = pSource[nByte + 1];
+            pRow[nByte + 2] = pSource[nByte];
+            pRow[nByte + 3] = pSource[nByte + 3];
+        }
+        fwrite(pRow, sizeof(BYTE), nRowSize, pFile);
+    }
+
+    delete[] pRow;
+
+    fclose(pFile);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLDisplay::BeginRender2D():
 // ---------------------------------------------------------------------------------------------
@@ -639,6 +1183,9 @@ BOOL GS_OGLDisplay::BeginRender2D(HWND& hWnd)
         return FALSE;
     }
 
+    // Start counting the state calls of a new frame.
+    GS_OGLState::BeginFrame();
+
     RECT ClientRect;
 
 #ifdef GS_PLATFORM_WINDOWS
@@ -647,48 +1194,81 @@ BOOL GS_OGLDisplay::BeginRender2D(HWND& hWnd)
     GS_Platform::GetClientRect(hWnd, &ClientRect);
 #endif
 
-    // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
-    {
-        glDisable(GL_DEPTH_TEST);
-        m_bIsDepthTestEnabled = TRUE;
-    }
-    else
-    {
-        m_bIsDepthTestEnabled = FALSE;
-    }
+    // Store the client rectangle so sprites rendered this frame don't have to ask for it
+    // (the scene target when rendering at the internal resolution).
+    m_rcWindow = ClientRect;
 
-    // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
+    if (m_nUpscaleMode != GS_UPSCALE_NONE)
     {
-        glDisable(GL_LIGHTING);
-        m_bIsLightingEnabled = TRUE;
+        RECT rcInternal;
+        SetRect(&rcInternal, 0, 0, m_nInternalWidth, m_nInternalHeight);
+        GS_OGLState::SetClientRect(hWnd, rcInternal);
     }
     else
     {
-        m_bIsLightingEnabled = FALSE;
+        GS_OGLState::SetClientRect(hWnd, ClientRect);
     }
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPushMatrix();              // Store the projection matrix.
-    glLoadIdentity();            // Reset the projection matrix.
+    // Disable depth testing if enabled.
+    m_bIsDepthTestEnabled = GS_OGLState::IsDepthTestEnabled();
+    GS_OGLState::EnableDepthTest(FALSE);
+
+    // Disable lighting if enabled.
+    m_bIsLightingEnabled = GS_OGLState::IsLightingEnabled();
+    GS_OGLState::EnableLighting(FALSE);
 
     // Set up an ortho screen with the same dimensions as the client area of the current
     // window and with a depth large enough to rotate the entire screen around either
     // the x or y axis.
-    if (ClientRect.right >= ClientRect.top)
+    if (m_nBackend != GS_BACKEND_FIXED)
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
-                ((ClientRect.right-ClientRect.left)/2));
+        GS_OGLCoreRenderer::PushProjection();
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.right-ClientRect.left)/2),
+                                         ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.top-ClientRect.bottom)/2),
+                                         ((ClientRect.top-ClientRect.bottom)/2));
+        }
     }
     else
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
-                ((ClientRect.top-ClientRect.bottom)/2));
+        GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+        glPushMatrix();                            // Store the projection matrix.
+        glLoadIdentity();                          // Reset the projection matrix.
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
+                    ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
+                    ((ClientRect.top-ClientRect.bottom)/2));
+        }
+
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
+        glPushMatrix();                           // Store the modelview matrix.
     }
 
-    glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
-    glPushMatrix();             // Store the modelview matrix.
+    // Start collecting sprites if batching is enabled.
+    if (m_bIsBatchingEnabled)
+    {
+        m_gsSpriteBatch.Begin();
+    }
+
+    // Render the scene at the internal resolution, EndRender2D() scales it to the window.
+    if (m_nUpscaleMode != GS_UPSCALE_NONE)
+    {
+        m_gsSceneTarget.Begin(0.0f, 0.0f);
+    }
 
     return TRUE;
 }
@@ -707,11 +1287,46 @@ BOOL GS_OGLDisplay::BeginRender2D(HWND& hWnd)
 
 BOOL GS_OGLDisplay::EndRender2D()
 {
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+    // Scale the scene rendered at the internal resolution to the window in a single draw,
+    // replacing whatever is there (including the alpha of the borders).
+    if (m_gsSceneTarget.IsReady() && (m_nUpscaleMode != GS_UPSCALE_NONE))
+    {
+        m_gsSceneTarget.End();
+
+        RECT rcDest;
+        this->GetUpscaleRect(&rcDest);
+
+        BOOL bIsBlendingEnabled = GS_OGLState::IsBlendingEnabled();
+        GS_OGLSpriteBatch::FlushActive();
+        GS_OGLState::EnableBlending(FALSE);
+
+        m_gsSceneTarget.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+        m_gsSceneTarget.RenderStretched((GLfloat) rcDest.left, (GLfloat) rcDest.bottom,
+                                        (GLfloat) (rcDest.right - rcDest.left),
+                                        (GLfloat) (rcDest.top - rcDest.bottom));
+
+        GS_OGLSpriteBatch::FlushActive();
+        GS_OGLState::EnableBlending(bIsBlendingEnabled);
+    }
+
+    // Draw whatever is left in the batch while the 2D projection is still set.
+    if (m_bIsBatchingEnabled)
+    {
+        m_gsSpriteBatch.End();
+    }
+
+    if (m_nBackend != GS_BACKEND_FIXED)
+    {
+        GS_OGLCoreRenderer::PopProjection();
+    }
+    else
+    {
+        GS_OGLState::SetMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+    }
     
     return TRUE;
 }
@@ -725,53 +1340,89 @@ BOOL GS_OGLDisplay::BeginRender2D(void* pWindow)
 {
     if (!m_bIsReady) return FALSE;
 
+    // Start counting the state calls of a new frame.
+    GS_OGLState::BeginFrame();
+
     RECT ClientRect;
 
     GS_Platform::GetClientRect(pWindow, &ClientRect);
 
-    // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
+    // Store the client rectangle so sprites rendered this frame don't have to ask for it
+    // (the scene target when rendering at the internal resolution).
+    m_rcWindow = ClientRect;
+
+    if (m_nUpscaleMode != GS_UPSCALE_NONE)
     {
-        glDisable(GL_DEPTH_TEST);
-        m_bIsDepthTestEnabled = TRUE;
+        RECT rcInternal;
+        SetRect(&rcInternal, 0, 0, m_nInternalWidth, m_nInternalHeight);
+        GS_OGLState::SetClientRect(pWindow, rcInternal);
     }
     else
     {
-        m_bIsDepthTestEnabled = FALSE;
+        GS_OGLState::SetClientRect(pWindow, ClientRect);
     }
 
+    // Disable depth testing if enabled.
+    m_bIsDepthTestEnabled = GS_OGLState::IsDepthTestEnabled();
+    GS_OGLState::EnableDepthTest(FALSE);
+
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
+    m_bIsLightingEnabled = GS_OGLState::IsLightingEnabled();
+    GS_OGLState::EnableLighting(FALSE);
+
+    // Set up an ortho screen with the same dimensions as the client area of the current
+    // window and with a depth large enough to rotate the entire screen around either
+    // the x or y axis.
+    if (m_nBackend != GS_BACKEND_FIXED)
     {
-        glDisable(GL_LIGHTING);
-        m_bIsLightingEnabled = TRUE;
+        GS_OGLCoreRenderer::PushProjection();
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.right-ClientRect.left)/2),
+                                         ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.top-ClientRect.bottom)/2),
+                                         ((ClientRect.top-ClientRect.bottom)/2));
+        }
     }
     else
     {
-        m_bIsLightingEnabled = FALSE;
-    }
+        GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+        glPushMatrix();                            // Store the projection matrix.
+        glLoadIdentity();                          // Reset the projection matrix.
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
+                    ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
+                    ((ClientRect.top-ClientRect.bottom)/2));
+        }
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPushMatrix();              // Store the projection matrix.
-    glLoadIdentity();            // Reset the projection matrix.
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
+        glPushMatrix();                           // Store the modelview matrix.
+    }
 
-    // Set up an ortho screen with the same dimensions as the client area of the current
-    // window and with a depth large enough to rotate the entire screen around either
-    // the x or y axis.
-    if (ClientRect.right >= ClientRect.top)
+    // Start collecting sprites if batching is enabled.
+    if (m_bIsBatchingEnabled)
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.right-ClientRect.left)/2),
-                ((ClientRect.right-ClientRect.left)/2));
+        m_gsSpriteBatch.Begin();
     }
-    else
+
+    // Render the scene at the internal resolution, EndRender2D() scales it to the window.
+    if (m_nUpscaleMode != GS_UPSCALE_NONE)
     {
-        glOrtho(0,ClientRect.right,0,ClientRect.bottom,-((ClientRect.top-ClientRect.bottom)/2),
-                ((ClientRect.top-ClientRect.bottom)/2));
+        m_gsSceneTarget.Begin(0.0f, 0.0f);
     }
 
-    glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
-    glPushMatrix();             // Store the modelview matrix.
-    
     return TRUE;
 }
 #endif
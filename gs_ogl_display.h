@@ -21,6 +21,15 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+//==============================================================================================
+
+
 //==============================================================================================
 // Include OpenGL header files.
 // ---------------------------------------------------------------------------------------------
@@ -39,6 +48,13 @@
 // ---------------------------------------------------------------------------------------------
 #include "gs_error.h"
 #include "gs_object.h"
+#include "gs_ogl_core_renderer.h"
+#include "gs_ogl_render_queue.h"
+#include "gs_ogl_render_target.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_extensions.h"
+#include "gs_ogl_state.h"
+#include "gs_soft_renderer.h"
 //==============================================================================================
 
 
@@ -54,6 +70,24 @@ extern float g_fScaleFactorY;
 // ---------------------------------------------------------------------------------------------
 
 
+//==============================================================================================
+// Rendering backends.
+// ---------------------------------------------------------------------------------------------
+#define GS_BACKEND_FIXED    0 // OpenGL 2.1 fixed-function pipeline.
+#define GS_BACKEND_SHADER   1 // OpenGL 3.3 core profile with GS_OGLCoreRenderer.
+#define GS_BACKEND_SOFTWARE 2 // GS_SoftRenderer rasterizing on the CPU (2D only).
+// ---------------------------------------------------------------------------------------------
+
+
+//==============================================================================================
+// Ways of scaling the internal resolution up to the window (see SetInternalResolution()).
+// ---------------------------------------------------------------------------------------------
+#define GS_UPSCALE_NONE    0 // Render straight to the window (sprites scale themselves).
+#define GS_UPSCALE_INTEGER 1 // Whole multiples of the internal resolution, sharp pixels.
+#define GS_UPSCALE_LINEAR  2 // Fill the window keeping the aspect ratio, filtered.
+// ---------------------------------------------------------------------------------------------
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -71,12 +105,35 @@ private:
 #endif
     GLuint m_PixelFormat; // OpenGL pixel format.
 
+    int m_nBackend; // The rendering backend in use (GS_BACKEND_...).
+
     BOOL m_bIsAliasingEnabled; // Wether vertical sync is enabled or not.
     BOOL m_bIsVSyncEnabled;    // Wether vertical sync is enabled or not.
 
     BOOL m_bIsDepthTestEnabled; // Wether depth testing is enabled (for 2D rendering).
     BOOL m_bIsLightingEnabled;  // Wether lighting is enabled (for 2D rendering).
 
+    GS_OGLSpriteBatch m_gsSpriteBatch; // Batch collecting the quads drawn during 2D rendering.
+    BOOL m_bIsBatchingEnabled;         // Wether 2D rendering is batched or not.
+
+    GS_OGLRenderQueue m_gsRenderQueue; // Queue sorting the batched quads by layer and state.
+    BOOL m_bIsSortingEnabled;          // Wether the batched quads are sorted or not.
+
+    BYTE* m_pReadback;           // Pixels of the last frame read back from the back buffer.
+    int   m_nReadbackWidth;      // Dimensions of the frame in m_pReadback.
+    int   m_nReadbackHeight;
+    BOOL  m_bIsReadbackEnabled;  // Wether every frame is read back before it is shown.
+
+    GLvoid ReadFrame();
+
+    GS_OGLRenderTarget m_gsSceneTarget; // The 2D scene at the internal resolution.
+    int  m_nInternalWidth;              // Dimensions of the internal resolution.
+    int  m_nInternalHeight;
+    int  m_nUpscaleMode;                // How the scene is scaled to the window (GS_UPSCALE_...).
+    RECT m_rcWindow;                    // Client area of the window the scene is scaled to.
+
+    GLvoid GetUpscaleRect(RECT* prcDest);
+
     BOOL m_bIsReady;      // Wether OpenGL display is ready or not.
 
 protected:
@@ -89,9 +146,11 @@ public:
     ~GS_OGLDisplay();
 
 #ifdef GS_PLATFORM_WINDOWS
-    BOOL Create(HDC& hDC, int nWidth, int nHeight, int nDepth);
+    BOOL Create(HDC& hDC, int nWidth, int nHeight, int nDepth,
+                int nBackend = GS_BACKEND_FIXED);
 #else
-    BOOL Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDepth);
+    BOOL Create(SDL_Window* pWindow, int nWidth, int nHeight, int nDepth,
+                int nBackend = GS_BACKEND_FIXED);
 #endif
     GLvoid Destroy();
 
@@ -103,6 +162,12 @@ public:
     GLvoid EnableBlending(BOOL bEnable = TRUE, GLenum glSourceFactor = GL_SRC_ALPHA,
                           GLenum glDestFactor = GL_ONE_MINUS_SRC_ALPHA);
     GLvoid EnableLighting(BOOL bEnable = TRUE, GLenum glLightNum = GL_LIGHT1);
+    GLvoid EnableBatching(BOOL bEnable = TRUE);
+    GLvoid EnableSorting(BOOL bEnable = TRUE);
+    GLvoid EnableReadback(BOOL bEnable = TRUE);
+
+    BOOL   SetInternalResolution(int nWidth, int nHeight, int nUpscaleMode);
+    BOOL   WindowToInternal(int* pnX, int* pnY);
 
     GLvoid SetLightAmbient( GLfloat fRed, GLfloat fGreen, GLfloat fBlue, GLfloat fAlpha,
                             GLenum glLightNum = GL_LIGHT1);
@@ -120,6 +185,8 @@ public:
     GLvoid EndRender(SDL_Window* pWindow);
 #endif
 
+    BOOL   SaveFrame(LPCTSTR pszFilename);
+
     BOOL   BeginRender2D(HWND& hWnd);
 #ifdef GS_PLATFORM_WINDOWS
     BOOL   EndRender2D();
@@ -133,6 +200,11 @@ public:
         return m_bIsReady;
     }
 
+    int GetBackend()
+    {
+        return m_nBackend;
+    }
+
     BOOL IsAliasingEnabled()
     {
         return m_bIsAliasingEnabled;
@@ -141,18 +213,65 @@ public:
     {
         return m_bIsVSyncEnabled;
     }
+    BOOL IsBatchingEnabled()
+    {
+        return m_bIsBatchingEnabled;
+    }
+    GS_OGLSpriteBatch* GetSpriteBatch()
+    {
+        return &m_gsSpriteBatch;
+    }
+    BOOL IsSortingEnabled()
+    {
+        return m_bIsSortingEnabled;
+    }
+    GS_OGLRenderQueue* GetRenderQueue()
+    {
+        return &m_gsRenderQueue;
+    }
+    BOOL IsReadbackEnabled()
+    {
+        return m_bIsReadbackEnabled;
+    }
+    // The last frame read back (RGBA, bottom row first), NULL if none has been.
+    const BYTE* GetReadback()
+    {
+        return m_pReadback;
+    }
+    int GetReadbackWidth()
+    {
+        return m_nReadbackWidth;
+    }
+    int GetReadbackHeight()
+    {
+        return m_nReadbackHeight;
+    }
+    BOOL IsInternalResolution()
+    {
+        return (m_nUpscaleMode != GS_UPSCALE_NONE);
+    }
 
     BOOL IsBlendingEnabled()
     {
-        return glIsEnabled(GL_BLEND);
+        return GS_OGLState::IsBlendingEnabled();
     }
     BOOL IsLightingEnabled()
     {
-        return glIsEnabled(GL_LIGHTING);
+        return GS_OGLState::IsLightingEnabled();
     }
     BOOL IsDepthTestingEnabled()
     {
-        return glIsEnabled(GL_DEPTH_TEST);
+        return GS_OGLState::IsDepthTestEnabled();
+    }
+
+    // State calls made and skipped by the GS_OGLState cache during the previous frame.
+    int GetNumStateCalls()
+    {
+        return GS_OGLState::GetNumCalls();
+    }
+    int GetNumSkippedStateCalls()
+    {
+        return GS_OGLState::GetNumSkippedCalls();
     }
 
     // Static functions for ajusting the scale factor
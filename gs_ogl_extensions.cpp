@@ -0,0 +1,280 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_extensions.cpp, gs_ogl_extensions.h                                          |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLExtensions                                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Loads the OpenGL entry points beyond OpenGL 1.1 that the GS library can make use of |
+ |        when the driver provides them (Windows only exports OpenGL 1.1 directly).           |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_extensions.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// OpenGL function pointers.
+// ---------------------------------------------------------------------------------------------
+GS_PFNGLGENBUFFERSPROC    gsglGenBuffers    = NULL;
+GS_PFNGLDELETEBUFFERSPROC gsglDeleteBuffers = NULL;
+GS_PFNGLBINDBUFFERPROC    gsglBindBuffer    = NULL;
+GS_PFNGLBUFFERDATAPROC    gsglBufferData    = NULL;
+GS_PFNGLBUFFERSUBDATAPROC gsglBufferSubData = NULL;
+// ---------------------------------------------------------------------------------------------
+GS_PFNGLPOINTPARAMETERIPROC gsglPointParameteri = NULL;
+// ---------------------------------------------------------------------------------------------
+GS_PFNGLGENFRAMEBUFFERSPROC        gsglGenFramebuffers        = NULL;
+GS_PFNGLDELETEFRAMEBUFFERSPROC     gsglDeleteFramebuffers     = NULL;
+GS_PFNGLBINDFRAMEBUFFERPROC        gsglBindFramebuffer        = NULL;
+GS_PFNGLFRAMEBUFFERTEXTURE2DPROC   gsglFramebufferTexture2D   = NULL;
+GS_PFNGLCHECKFRAMEBUFFERSTATUSPROC gsglCheckFramebufferStatus = NULL;
+// ---------------------------------------------------------------------------------------------
+GS_PFNGLCREATESHADERPROC             gsglCreateShader             = NULL;
+GS_PFNGLDELETESHADERPROC             gsglDeleteShader             = NULL;
+GS_PFNGLSHADERSOURCEPROC             gsglShaderSource             = NULL;
+GS_PFNGLCOMPILESHADERPROC            gsglCompileShader            = NULL;
+GS_PFNGLGETSHADERIVPROC              gsglGetShaderiv              = NULL;
+GS_PFNGLGETSHADERINFOLOGPROC         gsglGetShaderInfoLog         = NULL;
+GS_PFNGLCREATEPROGRAMPROC            gsglCreateProgram            = NULL;
+GS_PFNGLDELETEPROGRAMPROC            gsglDeleteProgram            = NULL;
+GS_PFNGLATTACHSHADERPROC             gsglAttachShader             = NULL;
+GS_PFNGLLINKPROGRAMPROC              gsglLinkProgram              = NULL;
+GS_PFNGLGETPROGRAMIVPROC             gsglGetProgramiv             = NULL;
+GS_PFNGLGETPROGRAMINFOLOGPROC        gsglGetProgramInfoLog        = NULL;
+GS_PFNGLUSEPROGRAMPROC               gsglUseProgram               = NULL;
+GS_PFNGLGETUNIFORMLOCATIONPROC       gsglGetUniformLocation       = NULL;
+GS_PFNGLUNIFORM1IPROC                gsglUniform1i                = NULL;
+GS_PFNGLUNIFORM2FPROC                gsglUniform2f                = NULL;
+GS_PFNGLUNIFORMMATRIX4FVPROC         gsglUniformMatrix4fv         = NULL;
+GS_PFNGLVERTEXATTRIBPOINTERPROC      gsglVertexAttribPointer      = NULL;
+GS_PFNGLENABLEVERTEXATTRIBARRAYPROC  gsglEnableVertexAttribArray  = NULL;
+GS_PFNGLDISABLEVERTEXATTRIBARRAYPROC gsglDisableVertexAttribArray = NULL;
+GS_PFNGLVERTEXATTRIB4FPROC           gsglVertexAttrib4f           = NULL;
+GS_PFNGLGENVERTEXARRAYSPROC          gsglGenVertexArrays          = NULL;
+GS_PFNGLDELETEVERTEXARRAYSPROC       gsglDeleteVertexArrays       = NULL;
+GS_PFNGLBINDVERTEXARRAYPROC          gsglBindVertexArray          = NULL;
+GS_PFNGLDRAWELEMENTSBASEVERTEXPROC   gsglDrawElementsBaseVertex   = NULL;
+// ---------------------------------------------------------------------------------------------
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+BOOL GS_OGLExtensions::m_bIsLoaded         = FALSE;
+BOOL GS_OGLExtensions::m_bHasBufferObjects = FALSE;
+BOOL GS_OGLExtensions::m_bHasPointSprites  = FALSE;
+BOOL GS_OGLExtensions::m_bHasFramebuffers  = FALSE;
+BOOL GS_OGLExtensions::m_bHasShaders       = FALSE;
+// ---------------------------------------------------------------------------------------------
+GLfloat GS_OGLExtensions::m_glfMaxPointSize = 1.0f;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Load Methods. ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLExtensions::GetProcAddress():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks up an OpenGL function, trying the alternative (usually ARB) name if the core
+//          name is not found.
+// ---------------------------------------------------------------------------------------------
+// Returns: A pointer to the function, NULL if not available.
+//==============================================================================================
+
+void* GS_OGLExtensions::GetProcAddress(const char* pszName, const char* pszAltName)
+{
+
+    void* pFunction = NULL;
+
+#ifdef GS_PLATFORM_WINDOWS
+    pFunction = (void*) wglGetProcAddress(pszName);
+    if ((!pFunction) && (pszAltName))
+    {
+        pFunction = (void*) wglGetProcAddress(pszAltName);
+    }
+#else
+    pFunction = SDL_GL_GetProcAddress(pszName);
+    if ((!pFunction) && (pszAltName))
+    {
+        pFunction = SDL_GL_GetProcAddress(pszAltName);
+    }
+#endif
+
+    return pFunction;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLExtensions::Load():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads all the function pointers, must be called with the rendering context current
+//          (GS_OGLDisplay::Create() does this). Missing functions are not an error, callers
+//          check the Has...() methods and fall back to what OpenGL 1.1 offers.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLExtensions::Load()
+{
+
+    // Vertex buffer objects (core in OpenGL 1.5, GL_ARB_vertex_buffer_object before that).
+    gsglGenBuffers    = (GS_PFNGLGENBUFFERSPROC)    GetProcAddress("glGenBuffers",    "glGenBuffersARB");
+    gsglDeleteBuffers = (GS_PFNGLDELETEBUFFERSPROC) GetProcAddress("glDeleteBuffers", "glDeleteBuffersARB");
+    gsglBindBuffer    = (GS_PFNGLBINDBUFFERPROC)    GetProcAddress("glBindBuffer",    "glBindBufferARB");
+    gsglBufferData    = (GS_PFNGLBUFFERDATAPROC)    GetProcAddress("glBufferData",    "glBufferDataARB");
+    gsglBufferSubData = (GS_PFNGLBUFFERSUBDATAPROC) GetProcAddress("glBufferSubData", "glBufferSubDataARB");
+
+    m_bHasBufferObjects = (gsglGenBuffers && gsglDeleteBuffers && gsglBindBuffer &&
+                           gsglBufferData && gsglBufferSubData);
+
+    // Point sprites (core in OpenGL 2.0, which also lets us put the texture origin at the lower
+    // left like everywhere else in the library).
+    gsglPointParameteri = (GS_PFNGLPOINTPARAMETERIPROC) GetProcAddress("glPointParameteri");
+
+    const char* pszVersion = (const char*) glGetString(GL_VERSION);
+
+    m_bHasPointSprites = ((pszVersion) && (atoi(pszVersion) >= 2) && (gsglPointParameteri));
+
+    GLfloat glfPointSizeRange[2] = { 1.0f, 1.0f };
+    glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, glfPointSizeRange);
+
+    m_glfMaxPointSize = glfPointSizeRange[1];
+
+    // Framebuffer objects (core in OpenGL 3.0, GL_EXT_framebuffer_object before that).
+    gsglGenFramebuffers        = (GS_PFNGLGENFRAMEBUFFERSPROC)        GetProcAddress("glGenFramebuffers",        "glGenFramebuffersEXT");
+    gsglDeleteFramebuffers     = (GS_PFNGLDELETEFRAMEBUFFERSPROC)     GetProcAddress("glDeleteFramebuffers",     "glDeleteFramebuffersEXT");
+    gsglBindFramebuffer        = (GS_PFNGLBINDFRAMEBUFFERPROC)        GetProcAddress("glBindFramebuffer",        "glBindFramebufferEXT");
+    gsglFramebufferTexture2D   = (GS_PFNGLFRAMEBUFFERTEXTURE2DPROC)   GetProcAddress("glFramebufferTexture2D",   "glFramebufferTexture2DEXT");
+    gsglCheckFramebufferStatus = (GS_PFNGLCHECKFRAMEBUFFERSTATUSPROC) GetProcAddress("glCheckFramebufferStatus", "glCheckFramebufferStatusEXT");
+
+    m_bHasFramebuffers = (gsglGenFramebuffers && gsglDeleteFramebuffers && gsglBindFramebuffer &&
+                          gsglFramebufferTexture2D && gsglCheckFramebufferStatus);
+
+    // Shaders (core in OpenGL 2.0), vertex array objects (core in OpenGL 3.0) and base vertex
+    // drawing (core in OpenGL 3.2), everything GS_OGLCoreRenderer needs besides buffers.
+    gsglCreateShader             = (GS_PFNGLCREATESHADERPROC)             GetProcAddress("glCreateShader");
+    gsglDeleteShader             = (GS_PFNGLDELETESHADERPROC)             GetProcAddress("glDeleteShader");
+    gsglShaderSource             = (GS_PFNGLSHADERSOURCEPROC)             GetProcAddress("glShaderSource");
+    gsglCompileShader            = (GS_PFNGLCOMPILESHADERPROC)            GetProcAddress("glCompileShader");
+    gsglGetShaderiv              = (GS_PFNGLGETSHADERIVPROC)              GetProcAddress("glGetShaderiv");
+    gsglGetShaderInfoLog         = (GS_PFNGLGETSHADERINFOLOGPROC)         GetProcAddress("glGetShaderInfoLog");
+    gsglCreateProgram            = (GS_PFNGLCREATEPROGRAMPROC)            GetProcAddress("glCreateProgram");
+    gsglDeleteProgram            = (GS_PFNGLDELETEPROGRAMPROC)            GetProcAddress("glDeleteProgram");
+    gsglAttachShader             = (GS_PFNGLATTACHSHADERPROC)             GetProcAddress("glAttachShader");
+    gsglLinkProgram              = (GS_PFNGLLINKPROGRAMPROC)              GetProcAddress("glLinkProgram");
+    gsglGetProgramiv             = (GS_PFNGLGETPROGRAMIVPROC)             GetProcAddress("glGetProgramiv");
+    gsglGetProgramInfoLog        = (GS_PFNGLGETPROGRAMINFOLOGPROC)        GetProcAddress("glGetProgramInfoLog");
+    gsglUseProgram               = (GS_PFNGLUSEPROGRAMPROC)               GetProcAddress("glUseProgram");
+    gsglGetUniformLocation       = (GS_PFNGLGETUNIFORMLOCATIONPROC)       GetProcAddress("glGetUniformLocation");
+    gsglUniform1i                = (GS_PFNGLUNIFORM1IPROC)                GetProcAddress("glUniform1i");
+    gsglUniform2f                = (GS_PFNGLUNIFORM2FPROC)                GetProcAddress("glUniform2f");
+    gsglUniformMatrix4fv         = (GS_PFNGLUNIFORMMATRIX4FVPROC)         GetProcAddress("glUniformMatrix4fv");
+    gsglVertexAttribPointer      = (GS_PFNGLVERTEXATTRIBPOINTERPROC)      GetProcAddress("glVertexAttribPointer");
+    gsglEnableVertexAttribArray  = (GS_PFNGLENABLEVERTEXATTRIBARRAYPROC)  GetProcAddress("glEnableVertexAttribArray");
+    gsglDisableVertexAttribArray = (GS_PFNGLDISABLEVERTEXATTRIBARRAYPROC) GetProcAddress("glDisableVertexAttribArray");
+    gsglVertexAttrib4f           = (GS_PFNGLVERTEXATTRIB4FPROC)           GetProcAddress("glVertexAttrib4f");
+    gsglGenVertexArrays          = (GS_PFNGLGENVERTEXARRAYSPROC)          GetProcAddress("glGenVertexArrays");
+    gsglDeleteVertexArrays       = (GS_PFNGLDELETEVERTEXARRAYSPROC)       GetProcAddress("glDeleteVertexArrays");
+    gsglBindVertexArray          = (GS_PFNGLBINDVERTEXARRAYPROC)          GetProcAddress("glBindVertexArray");
+    gsglDrawElementsBaseVertex   = (GS_PFNGLDRAWELEMENTSBASEVERTEXPROC)   GetProcAddress("glDrawElementsBaseVertex");
+
+    // The version string starts with "major.minor".
+    int nMajor = (pszVersion) ? atoi(pszVersion) : 0;
+    int nMinor = ((pszVersion) && (strchr(pszVersion, '.'))) ? atoi(strchr(pszVersion, '.') + 1) : 0;
+
+    m_bHasShaders = (((nMajor > 3) || ((nMajor == 3) && (nMinor >= 3))) && (m_bHasBufferObjects) &&
+                     (gsglCreateShader) && (gsglDeleteShader) && (gsglShaderSource) &&
+                     (gsglCompileShader) && (gsglGetShaderiv) && (gsglGetShaderInfoLog) &&
+                     (gsglCreateProgram) && (gsglDeleteProgram) && (gsglAttachShader) &&
+                     (gsglLinkProgram) && (gsglGetProgramiv) && (gsglGetProgramInfoLog) &&
+                     (gsglUseProgram) && (gsglGetUniformLocation) && (gsglUniform1i) &&
+                     (gsglUniform2f) && (gsglUniformMatrix4fv) && (gsglVertexAttribPointer) &&
+                     (gsglEnableVertexAttribArray) && (gsglDisableVertexAttribArray) &&
+                     (gsglVertexAttrib4f) && (gsglGenVertexArrays) && (gsglDeleteVertexArrays) &&
+                     (gsglBindVertexArray) && (gsglDrawElementsBaseVertex));
+
+    m_bIsLoaded = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLExtensions::Unload():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Clears all the function pointers when the rendering context is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLExtensions::Unload()
+{
+
+    gsglGenBuffers    = NULL;
+    gsglDeleteBuffers = NULL;
+    gsglBindBuffer    = NULL;
+    gsglBufferData    = NULL;
+    gsglBufferSubData = NULL;
+
+    gsglPointParameteri = NULL;
+
+    gsglGenFramebuffers        = NULL;
+    gsglDeleteFramebuffers     = NULL;
+    gsglBindFramebuffer        = NULL;
+    gsglFramebufferTexture2D   = NULL;
+    gsglCheckFramebufferStatus = NULL;
+
+    gsglCreateShader             = NULL;
+    gsglDeleteShader             = NULL;
+    gsglShaderSource             = NULL;
+    gsglCompileShader            = NULL;
+    gsglGetShaderiv              = NULL;
+    gsglGetShaderInfoLog         = NULL;
+    gsglCreateProgram            = NULL;
+    gsglDeleteProgram            = NULL;
+    gsglAttachShader             = NULL;
+    gsglLinkProgram              = NULL;
+    gsglGetProgramiv             = NULL;
+    gsglGetProgramInfoLog        = NULL;
+    gsglUseProgram               = NULL;
+    gsglGetUniformLocation       = NULL;
+    gsglUniform1i                = NULL;
+    gsglUniform2f                = NULL;
+    gsglUniformMatrix4fv         = NULL;
+    gsglVertexAttribPointer      = NULL;
+    gsglEnableVertexAttribArray  = NULL;
+    gsglDisableVertexAttribArray = NULL;
+    gsglVertexAttrib4f           = NULL;
+    gsglGenVertexArrays          = NULL;
+    gsglDeleteVertexArrays       = NULL;
+    gsglBindVertexArray          = NULL;
+    gsglDrawElementsBaseVertex   = NULL;
+
+    m_bHasBufferObjects = FALSE;
+    m_bHasPointSprites  = FALSE;
+    m_bHasFramebuffers  = FALSE;
+    m_bHasShaders       = FALSE;
+
+    m_glfMaxPointSize = 1.0f;
+
+    m_bIsLoaded = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,287 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_extensions.cpp, gs_ogl_extensions.h                                          |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLExtensions                                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Loads the OpenGL entry points beyond OpenGL 1.1 that the GS library can make use of |
+ |        when the driver provides them (Windows only exports OpenGL 1.1 directly).           |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_EXTENSIONS_H
+#define GS_OGL_EXTENSIONS_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// OpenGL defines not found in every gl.h (the OpenGL 1.1 header on Windows in particular).
+// ---------------------------------------------------------------------------------------------
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+// ---------------------------------------------------------------------------------------------
+#ifndef GL_ARRAY_BUFFER
+    #define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STATIC_DRAW
+    #define GL_STATIC_DRAW  0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+    #define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_STREAM_DRAW
+    #define GL_STREAM_DRAW  0x88E0
+#endif
+// ---------------------------------------------------------------------------------------------
+#ifndef GL_POINT_SPRITE
+    #define GL_POINT_SPRITE              0x8861
+#endif
+#ifndef GL_COORD_REPLACE
+    #define GL_COORD_REPLACE             0x8862
+#endif
+#ifndef GL_POINT_SPRITE_COORD_ORIGIN
+    #define GL_POINT_SPRITE_COORD_ORIGIN 0x8CA0
+#endif
+#ifndef GL_LOWER_LEFT
+    #define GL_LOWER_LEFT                0x8CA1
+#endif
+#ifndef GL_ALIASED_POINT_SIZE_RANGE
+    #define GL_ALIASED_POINT_SIZE_RANGE  0x846D
+#endif
+// ---------------------------------------------------------------------------------------------
+#ifndef GL_FRAMEBUFFER
+    #define GL_FRAMEBUFFER          0x8D40
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+    #define GL_COLOR_ATTACHMENT0    0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+    #define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_FRAMEBUFFER_BINDING
+    #define GL_FRAMEBUFFER_BINDING  0x8CA6
+#endif
+// ---------------------------------------------------------------------------------------------
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+    #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_FRAGMENT_SHADER
+    #define GL_FRAGMENT_SHADER      0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+    #define GL_VERTEX_SHADER        0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+    #define GL_COMPILE_STATUS       0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+    #define GL_LINK_STATUS          0x8B82
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+    #define GL_CLAMP_TO_EDGE        0x812F
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// OpenGL function pointer types.
+// ---------------------------------------------------------------------------------------------
+typedef ptrdiff_t GS_GLsizeiptr;
+typedef ptrdiff_t GS_GLintptr;
+// ---------------------------------------------------------------------------------------------
+typedef void (APIENTRY* GS_PFNGLGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* GS_PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* GS_PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* GS_PFNGLBUFFERDATAPROC)(GLenum target, GS_GLsizeiptr size,
+                                                const void* data, GLenum usage);
+typedef void (APIENTRY* GS_PFNGLBUFFERSUBDATAPROC)(GLenum target, GS_GLintptr offset,
+                                                   GS_GLsizeiptr size, const void* data);
+typedef void (APIENTRY* GS_PFNGLPOINTPARAMETERIPROC)(GLenum pname, GLint param);
+// ---------------------------------------------------------------------------------------------
+typedef void   (APIENTRY* GS_PFNGLGENFRAMEBUFFERSPROC)(GLsizei n, GLuint* framebuffers);
+typedef void   (APIENTRY* GS_PFNGLDELETEFRAMEBUFFERSPROC)(GLsizei n, const GLuint* framebuffers);
+typedef void   (APIENTRY* GS_PFNGLBINDFRAMEBUFFERPROC)(GLenum target, GLuint framebuffer);
+typedef void   (APIENTRY* GS_PFNGLFRAMEBUFFERTEXTURE2DPROC)(GLenum target, GLenum attachment,
+                                                            GLenum textarget, GLuint texture,
+                                                            GLint level);
+typedef GLenum (APIENTRY* GS_PFNGLCHECKFRAMEBUFFERSTATUSPROC)(GLenum target);
+// ---------------------------------------------------------------------------------------------
+typedef GLuint (APIENTRY* GS_PFNGLCREATESHADERPROC)(GLenum type);
+typedef void   (APIENTRY* GS_PFNGLDELETESHADERPROC)(GLuint shader);
+typedef void   (APIENTRY* GS_PFNGLSHADERSOURCEPROC)(GLuint shader, GLsizei count,
+                                                    const char* const* string,
+                                                    const GLint* length);
+typedef void   (APIENTRY* GS_PFNGLCOMPILESHADERPROC)(GLuint shader);
+typedef void   (APIENTRY* GS_PFNGLGETSHADERIVPROC)(GLuint shader, GLenum pname, GLint* params);
+typedef void   (APIENTRY* GS_PFNGLGETSHADERINFOLOGPROC)(GLuint shader, GLsizei bufSize,
+                                                        GLsizei* length, char* infoLog);
+typedef GLuint (APIENTRY* GS_PFNGLCREATEPROGRAMPROC)();
+typedef void   (APIENTRY* GS_PFNGLDELETEPROGRAMPROC)(GLuint program);
+typedef void   (APIENTRY* GS_PFNGLATTACHSHADERPROC)(GLuint program, GLuint shader);
+typedef void   (APIENTRY* GS_PFNGLLINKPROGRAMPROC)(GLuint program);
+typedef void   (APIENTRY* GS_PFNGLGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint* params);
+typedef void   (APIENTRY* GS_PFNGLGETPROGRAMINFOLOGPROC)(GLuint program, GLsizei bufSize,
+                                                         GLsizei* length, char* infoLog);
+typedef void   (APIENTRY* GS_PFNGLUSEPROGRAMPROC)(GLuint program);
+typedef GLint  (APIENTRY* GS_PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const char* name);
+typedef void   (APIENTRY* GS_PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
+typedef void   (APIENTRY* GS_PFNGLUNIFORM2FPROC)(GLint location, GLfloat v0, GLfloat v1);
+typedef void   (APIENTRY* GS_PFNGLUNIFORMMATRIX4FVPROC)(GLint location, GLsizei count,
+                                                        GLboolean transpose,
+                                                        const GLfloat* value);
+typedef void   (APIENTRY* GS_PFNGLVERTEXATTRIBPOINTERPROC)(GLuint index, GLint size, GLenum type,
+                                                           GLboolean normalized, GLsizei stride,
+                                                           const void* pointer);
+typedef void   (APIENTRY* GS_PFNGLENABLEVERTEXATTRIBARRAYPROC)(GLuint index);
+typedef void   (APIENTRY* GS_PFNGLDISABLEVERTEXATTRIBARRAYPROC)(GLuint index);
+typedef void   (APIENTRY* GS_PFNGLVERTEXATTRIB4FPROC)(GLuint index, GLfloat x, GLfloat y,
+                                                      GLfloat z, GLfloat w);
+typedef void   (APIENTRY* GS_PFNGLGENVERTEXARRAYSPROC)(GLsizei n, GLuint* arrays);
+typedef void   (APIENTRY* GS_PFNGLDELETEVERTEXARRAYSPROC)(GLsizei n, const GLuint* arrays);
+typedef void   (APIENTRY* GS_PFNGLBINDVERTEXARRAYPROC)(GLuint array);
+typedef void   (APIENTRY* GS_PFNGLDRAWELEMENTSBASEVERTEXPROC)(GLenum mode, GLsizei count,
+                                                              GLenum type, const void* indices,
+                                                              GLint basevertex);
+//==============================================================================================
+
+
+//==============================================================================================
+// OpenGL function pointers (NULL until GS_OGLExtensions::Load() finds them).
+// ---------------------------------------------------------------------------------------------
+extern GS_PFNGLGENBUFFERSPROC    gsglGenBuffers;
+extern GS_PFNGLDELETEBUFFERSPROC gsglDeleteBuffers;
+extern GS_PFNGLBINDBUFFERPROC    gsglBindBuffer;
+extern GS_PFNGLBUFFERDATAPROC    gsglBufferData;
+extern GS_PFNGLBUFFERSUBDATAPROC gsglBufferSubData;
+// ---------------------------------------------------------------------------------------------
+extern GS_PFNGLPOINTPARAMETERIPROC gsglPointParameteri;
+// ---------------------------------------------------------------------------------------------
+extern GS_PFNGLGENFRAMEBUFFERSPROC        gsglGenFramebuffers;
+extern GS_PFNGLDELETEFRAMEBUFFERSPROC     gsglDeleteFramebuffers;
+extern GS_PFNGLBINDFRAMEBUFFERPROC        gsglBindFramebuffer;
+extern GS_PFNGLFRAMEBUFFERTEXTURE2DPROC   gsglFramebufferTexture2D;
+extern GS_PFNGLCHECKFRAMEBUFFERSTATUSPROC gsglCheckFramebufferStatus;
+// ---------------------------------------------------------------------------------------------
+extern GS_PFNGLCREATESHADERPROC             gsglCreateShader;
+extern GS_PFNGLDELETESHADERPROC             gsglDeleteShader;
+extern GS_PFNGLSHADERSOURCEPROC             gsglShaderSource;
+extern GS_PFNGLCOMPILESHADERPROC            gsglCompileShader;
+extern GS_PFNGLGETSHADERIVPROC              gsglGetShaderiv;
+extern GS_PFNGLGETSHADERINFOLOGPROC         gsglGetShaderInfoLog;
+extern GS_PFNGLCREATEPROGRAMPROC            gsglCreateProgram;
+extern GS_PFNGLDELETEPROGRAMPROC            gsglDeleteProgram;
+extern GS_PFNGLATTACHSHADERPROC             gsglAttachShader;
+extern GS_PFNGLLINKPROGRAMPROC              gsglLinkProgram;
+extern GS_PFNGLGETPROGRAMIVPROC             gsglGetProgramiv;
+extern GS_PFNGLGETPROGRAMINFOLOGPROC        gsglGetProgramInfoLog;
+extern GS_PFNGLUSEPROGRAMPROC               gsglUseProgram;
+extern GS_PFNGLGETUNIFORMLOCATIONPROC       gsglGetUniformLocation;
+extern GS_PFNGLUNIFORM1IPROC                gsglUniform1i;
+extern GS_PFNGLUNIFORM2FPROC                gsglUniform2f;
+extern GS_PFNGLUNIFORMMATRIX4FVPROC         gsglUniformMatrix4fv;
+extern GS_PFNGLVERTEXATTRIBPOINTERPROC      gsglVertexAttribPointer;
+extern GS_PFNGLENABLEVERTEXATTRIBARRAYPROC  gsglEnableVertexAttribArray;
+extern GS_PFNGLDISABLEVERTEXATTRIBARRAYPROC gsglDisableVertexAttribArray;
+extern GS_PFNGLVERTEXATTRIB4FPROC           gsglVertexAttrib4f;
+extern GS_PFNGLGENVERTEXARRAYSPROC          gsglGenVertexArrays;
+extern GS_PFNGLDELETEVERTEXARRAYSPROC       gsglDeleteVertexArrays;
+extern GS_PFNGLBINDVERTEXARRAYPROC          gsglBindVertexArray;
+extern GS_PFNGLDRAWELEMENTSBASEVERTEXPROC   gsglDrawElementsBaseVertex;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLExtensions
+{
+
+private:
+
+    static BOOL m_bIsLoaded;           // Wether Load() has been called for the current context.
+    static BOOL m_bHasBufferObjects;   // Wether vertex buffer objects are available.
+    static BOOL m_bHasPointSprites;    // Wether textured point sprites are available.
+    static BOOL m_bHasFramebuffers;    // Wether framebuffer objects are available.
+    static BOOL m_bHasShaders;         // Wether everything GS_OGLCoreRenderer needs is available.
+    static GLfloat m_glfMaxPointSize;  // Largest supported point size in pixels.
+
+    static void* GetProcAddress(const char* pszName, const char* pszAltName = NULL);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    static BOOL Load();
+    static void Unload();
+
+    static BOOL IsLoaded()
+    {
+        return m_bIsLoaded;
+    }
+
+    static BOOL HasBufferObjects()
+    {
+        return m_bHasBufferObjects;
+    }
+
+    static BOOL HasPointSprites()
+    {
+        return m_bHasPointSprites;
+    }
+
+    static GLfloat GetMaxPointSize()
+    {
+        return m_glfMaxPointSize;
+    }
+
+    static BOOL HasFramebuffers()
+    {
+        return m_bHasFramebuffers;
+    }
+
+    static BOOL HasShaders()
+    {
+        return m_bHasShaders;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
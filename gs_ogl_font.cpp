@@ -39,6 +39,12 @@ GS_OGLFont::GS_OGLFont() : GS_OGLSprite()
     m_nCharsPerLine = 0;
     m_nLetterWidth  = 0;
     m_nLetterHeight = 0;
+
+    ZeroMemory(m_gsMeshes, sizeof(m_gsMeshes));
+
+    m_nNumMeshes   = 0;
+    m_nMesh        = -1;
+    m_ulNumRenders = 0;
 }
 
 
@@ -125,6 +131,33 @@ BOOL GS_OGLFont::Create(GLuint glTexture, int nWidth, int nHeight, int nCharsPer
 }
 
 
+//==============================================================================================
+// GS_OGLFont::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the font from a shared texture object, unlike the texture ID this also
+//          works for textures that were packed into a texture atlas.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLFont::Create(GS_OGLTexture& gsTexture, int nCharsPerLine, int nLetterWidth,
+                        int nLetterHeight)
+{
+
+    if (!this->Create(gsTexture.GetID(), gsTexture.GetWidth(), gsTexture.GetHeight(),
+                      nCharsPerLine, nLetterWidth, nLetterHeight))
+    {
+        return FALSE;
+    }
+
+    // Only use the part of the texture holding the font image.
+    GS_OGLSprite::SetTextureRegion(gsTexture.GetOffsetX(), gsTexture.GetOffsetY(),
+                                   gsTexture.GetPageWidth(), gsTexture.GetPageHeight());
+
+    return TRUE;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -146,6 +179,8 @@ void GS_OGLFont::Destroy()
 
     GS_OGLSprite::Destroy();
 
+    this->DestroyMeshes();
+
     if (m_pszTextString)
     {
         delete [] m_pszTextString;
@@ -186,6 +221,30 @@ BOOL GS_OGLFont::Render(HWND hWnd)
         return FALSE;
     }
 
+    // Nothing to render without text.
+    if (!m_pszTextString)
+    {
+        return TRUE;
+    }
+
+    // Unless the characters have to be rotated, draw the text from its cached geometry.
+    if ((GS_OGLSprite::GetRotateX() == 0.0f) && (GS_OGLSprite::GetRotateY() == 0.0f) &&
+            (GS_OGLSprite::GetRotateZ() == 0.0f))
+    {
+        int nMesh = this->FindMesh();
+
+        if (nMesh < 0)
+        {
+            nMesh = this->BuildMesh();
+        }
+
+        if (nMesh >= 0)
+        {
+            m_nMesh = nMesh;
+            return this->RenderMesh(&m_gsMeshes[nMesh], hWnd);
+        }
+    }
+
     BOOL bResult;
 
     // Store the original (x ,y) starting position.
@@ -222,76 +281,6 @@ BOOL GS_OGLFont::Render(HWND hWnd)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-/*
-BOOL GS_OGLFont::Render(HWND hWnd) {
-
-   // Can't render if no valid sprite.
-   if (!GS_OGLSprite::IsReady()) {
-      return FALSE;
-      }
-
-   char cTextChar;
-   int nLoop;
-   int nXoffset, nYoffset; // The x,y top left location of the character image.
-   GS_OGLColor gsColor;
-   this->GetModulateColor(&gsColor);
-
-   // Store the original (x ,y) starting position.
-   GLint gliStartX = GS_OGLSprite::GetDestX();
-   GLint gliStartY = GS_OGLSprite::GetDestY();
-
-   // For each character in the string to be rendered.
-   for (nLoop=0; nLoop<(int)(lstrlen(m_pszTextString)); nLoop++) {
-      // Find and render the current character from the text string.
-      // bResult = RenderChar(m_pszTextString[nLoop], hWnd);
-      // We are allowing ascii characters from space (32) to ~ (126). As the 1st char on our
-      // image surface is a space, we can subtract 32 from the ascii value of the character we
-      // want to render. This gives us a zero based index.
-      cTextChar = char(m_pszTextString[nLoop] - 32);
-      // Check wether character is within minimum bounds.
-      if (cTextChar < 0) {
-         cTextChar = 0;
-         }
-      // Use the remainder to determine the horizontal offset of the letter.
-      nXoffset = (cTextChar%m_nCharsPerLine) * m_nLetterWidth;
-      // Use the quotient to determine the vertical offset of the letter starting from the top
-      // of the image and working towards the bottom.
-      nYoffset = this->GetTextureHeight() - (((cTextChar - (cTextChar%m_nCharsPerLine)) /
-                 m_nCharsPerLine) * m_nLetterHeight);
-      // Set the target to the specified letter.
-      m_gsTargets[nLoop].nDestX     = gliStartX;
-      m_gsTargets[nLoop].nDestY     = gliStartY;
-      m_gsTargets[nLoop].nSrcLeft   = nXoffset;
-      m_gsTargets[nLoop].nSrcTop    = nYoffset;
-      m_gsTargets[nLoop].nSrcRight  = nXoffset + m_nLetterWidth;
-      m_gsTargets[nLoop].nSrcBottom = nYoffset - m_nLetterHeight;
-      m_gsTargets[nLoop].fScaleX  = this->GetScaleX();
-      m_gsTargets[nLoop].fScaleY  = this->GetScaleY();
-      m_gsTargets[nLoop].fRotateX = this->GetRotateX();
-      m_gsTargets[nLoop].fRotateY = this->GetRotateY();
-      m_gsTargets[nLoop].fRotateZ = this->GetRotateZ();
-      m_gsTargets[nLoop].fRed     = gsColor.fRed;
-      m_gsTargets[nLoop].fGreen   = gsColor.fGreen;
-      m_gsTargets[nLoop].fBlue    = gsColor.fBlue;
-      m_gsTargets[nLoop].fAlpha   = gsColor.fAlpha;
-      m_gsTargets[nLoop].fScrollX = this->GetScrollX();
-      m_gsTargets[nLoop].fScrollY = this->GetScrollY();
-      // Shift the target X location to the right by the pixel width of each letter. If we
-      // don't do this, we'll be drawing each letter directly on top of the previous.
-      gliStartX += this->GetLetterWidth();
-      }
-
-   // Render all the letters at once.
-   this->RenderTargets(nLoop, m_gsTargets, hWnd);
-
-   return TRUE;
-}
-*/
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
 //==============================================================================================
 // GS_OGLFont::RenderChar():
 // ---------------------------------------------------------------------------------------------
@@ -312,9 +301,36 @@ BOOL GS_OGLFont::RenderChar(char cTextChar, HWND hWnd)
         return FALSE;
     }
 
-    int nXoffset, nYoffset; // The x,y top left location of the character image.
     RECT SourceRect; // The source rectangle for the specified character.
 
+    // Set the source rectangle to the specified frame.
+    this->GetCharRect(cTextChar, &SourceRect);
+    GS_OGLSprite::SetSourceRect(SourceRect);
+
+    // Draw the selected character on the surface.
+    return GS_OGLSprite::Render(hWnd);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::GetCharRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Determines the source rectangle of a character on the font image.
+// ---------------------------------------------------------------------------------------------
+// Notes: For the calculation to be correct, this method assumes that the source image of the
+//        font begins at the coordinate (0, 0) on the texture surface.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLFont::GetCharRect(char cTextChar, RECT* pSourceRect)
+{
+
+    int nXoffset, nYoffset; // The x,y top left location of the character image.
+
     // We are allowing ascii characters from space (32) to ~ (126). As the 1st char on our
     // image surface is a space, we can subtract 32 from the ascii value of the character we
     // want to render. This gives us a zero based index.
@@ -334,15 +350,306 @@ BOOL GS_OGLFont::RenderChar(char cTextChar, HWND hWnd)
     nYoffset = this->GetTextureHeight() - (((cTextChar - (cTextChar%m_nCharsPerLine)) /
                                             m_nCharsPerLine) * m_nLetterHeight);
 
-    // Set the source rectangle to the specified frame.
-    SourceRect.left   = nXoffset;
-    SourceRect.top    = nYoffset;
-    SourceRect.right  = nXoffset + m_nLetterWidth;
-    SourceRect.bottom = nYoffset - m_nLetterHeight;
-    GS_OGLSprite::SetSourceRect(SourceRect);
+    pSourceRect->left   = nXoffset;
+    pSourceRect->top    = nYoffset;
+    pSourceRect->right  = nXoffset + m_nLetterWidth;
+    pSourceRect->bottom = nYoffset - m_nLetterHeight;
+}
 
-    // Draw the selected character on the surface.
-    return GS_OGLSprite::Render(hWnd);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Mesh Methods. ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::FindMesh():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Looks for the mesh of the current text at the current scale, checking the mesh
+//          used last first since the same string is usually rendered again and again.
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the mesh, -1 if it has to be built.
+//==============================================================================================
+
+int GS_OGLFont::FindMesh()
+{
+
+    GLfloat glfScaleX = GS_OGLSprite::GetScaleX();
+    GLfloat glfScaleY = GS_OGLSprite::GetScaleY();
+
+    if ((m_nMesh >= 0) && (m_nMesh < m_nNumMeshes) &&
+            (m_gsMeshes[m_nMesh].glfScaleX == glfScaleX) &&
+            (m_gsMeshes[m_nMesh].glfScaleY == glfScaleY) &&
+            (strcmp(m_gsMeshes[m_nMesh].pszText, m_pszTextString) == 0))
+    {
+        return m_nMesh;
+    }
+
+    for (int nLoop = 0; nLoop < m_nNumMeshes; nLoop++)
+    {
+        if ((m_gsMeshes[nLoop].glfScaleX == glfScaleX) &&
+                (m_gsMeshes[nLoop].glfScaleY == glfScaleY) &&
+                (strcmp(m_gsMeshes[nLoop].pszText, m_pszTextString) == 0))
+        {
+            return nLoop;
+        }
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::BuildMesh():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds the quads for the current text at the current scale, replacing the least
+//          recently rendered mesh if all of them are in use.
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the mesh, -1 if it could not be built.
+//==============================================================================================
+
+int GS_OGLFont::BuildMesh()
+{
+
+    int nMesh = m_nNumMeshes;
+
+    // Are all the meshes in use?
+    if (nMesh >= GS_FONT_MAX_MESHES)
+    {
+        nMesh = 0;
+
+        for (int nLoop = 1; nLoop < GS_FONT_MAX_MESHES; nLoop++)
+        {
+            if (m_gsMeshes[nLoop].ulLastUsed < m_gsMeshes[nMesh].ulLastUsed)
+            {
+                nMesh = nLoop;
+            }
+        }
+
+        delete[] m_gsMeshes[nMesh].pszText;
+        delete[] m_gsMeshes[nMesh].pVertices;
+    }
+    else
+    {
+        m_nNumMeshes++;
+    }
+
+    GS_FontMesh* pgsMesh = &m_gsMeshes[nMesh];
+
+    int nNumChars = lstrlen(m_pszTextString);
+
+    pgsMesh->pszText = new char[nNumChars + 1];
+    lstrcpy(pgsMesh->pszText, m_pszTextString);
+
+    pgsMesh->glfScaleX    = GS_OGLSprite::GetScaleX();
+    pgsMesh->glfScaleY    = GS_OGLSprite::GetScaleY();
+    pgsMesh->pVertices    = new GS_FontVertex[(nNumChars * 4) + 1];
+    pgsMesh->nNumVertices = nNumChars * 4;
+    pgsMesh->ulLastUsed   = m_ulNumRenders;
+
+    // The letters are placed exactly as Render() places them one by one.
+    GLfloat glfWidth   = m_nLetterWidth  * pgsMesh->glfScaleX;
+    GLfloat glfHeight  = m_nLetterHeight * pgsMesh->glfScaleY;
+    GLint   gliAdvance = int(this->GetLetterWidth());
+
+    GS_FontVertex* pVertex = pgsMesh->pVertices;
+
+    for (int nLoop = 0; nLoop < nNumChars; nLoop++)
+    {
+        RECT SourceRect;
+        this->GetCharRect(m_pszTextString[nLoop], &SourceRect);
+
+        GLfloat glfLeft  = (GLfloat) (nLoop * gliAdvance);
+        GLfloat glfRight = glfLeft + glfWidth;
+
+        GLfloat glfTexLeft   = GS_OGLSprite::GetTexCoordU((GLfloat) SourceRect.left);
+        GLfloat glfTexBottom = GS_OGLSprite::GetTexCoordV((GLfloat) SourceRect.bottom);
+        GLfloat glfTexRight  = GS_OGLSprite::GetTexCoordU((GLfloat) SourceRect.right);
+        GLfloat glfTexTop    = GS_OGLSprite::GetTexCoordV((GLfloat) SourceRect.top);
+
+        // Bottom left corner.
+        pVertex[0].fX = glfLeft;
+        pVertex[0].fY = 0.0f;
+        pVertex[0].fU = glfTexLeft;
+        pVertex[0].fV = glfTexBottom;
+        // Bottom right corner.
+        pVertex[1].fX = glfRight;
+        pVertex[1].fY = 0.0f;
+        pVertex[1].fU = glfTexRight;
+        pVertex[1].fV = glfTexBottom;
+        // Top right corner.
+        pVertex[2].fX = glfRight;
+        pVertex[2].fY = glfHeight;
+        pVertex[2].fU = glfTexRight;
+        pVertex[2].fV = glfTexTop;
+        // Top left corner.
+        pVertex[3].fX = glfLeft;
+        pVertex[3].fY = glfHeight;
+        pVertex[3].fU = glfTexLeft;
+        pVertex[3].fV = glfTexTop;
+
+        pVertex += 4;
+    }
+
+    return nMesh;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::DestroyMeshes():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees all the cached meshes, they are built again when next needed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLFont::DestroyMeshes()
+{
+
+    for (int nLoop = 0; nLoop < m_nNumMeshes; nLoop++)
+    {
+        delete[] m_gsMeshes[nLoop].pszText;
+        delete[] m_gsMeshes[nLoop].pVertices;
+    }
+
+    ZeroMemory(m_gsMeshes, sizeof(m_gsMeshes));
+
+    m_nNumMeshes = 0;
+    m_nMesh      = -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLFont::RenderMesh():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws a mesh at the current position and color, with a single draw call or as part
+//          of the active sprite batch.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLFont::RenderMesh(GS_FontMesh* pgsMesh, HWND hWnd)
+{
+
+    pgsMesh->ulLastUsed = ++m_ulNumRenders;
+
+    if (pgsMesh->nNumVertices <= 0)
+    {
+        return TRUE;
+    }
+
+    GS_OGLColor gsColor;
+    GS_OGLSprite::GetModulateColor(&gsColor);
+
+    // Screen position of the start of the text.
+    GLfloat glfDestX = (GS_OGLSprite::GetDestX() * g_fScaleFactorX) + g_fRenderModX;
+    GLfloat glfDestY = (GS_OGLSprite::GetDestY() * g_fScaleFactorY) + g_fRenderModY;
+
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    if ((hWnd == NULL) && (pgsBatch != NULL))
+    {
+        GLfloat glfVertices[8];
+        GLfloat glfTexCoords[8];
+
+        GS_FontVertex* pVertex = pgsMesh->pVertices;
+
+        for (int nLoop = 0; nLoop < pgsMesh->nNumVertices; nLoop += 4)
+        {
+            for (int nCorner = 0; nCorner < 4; nCorner++)
+            {
+                glfVertices[nCorner * 2]        = glfDestX + (pVertex[nCorner].fX * g_fScaleFactorX);
+                glfVertices[(nCorner * 2) + 1]  = glfDestY + (pVertex[nCorner].fY * g_fScaleFactorY);
+                glfTexCoords[nCorner * 2]       = pVertex[nCorner].fU;
+                glfTexCoords[(nCorner * 2) + 1] = pVertex[nCorner].fV;
+            }
+
+            if (!pgsBatch->AddQuad(GS_OGLSprite::GetTextureID(), GS_BLEND_DEFAULT, glfVertices,
+                                   glfTexCoords, gsColor))
+            {
+                return FALSE;
+            }
+
+            pVertex += 4;
+        }
+
+        return TRUE;
+    }
+
+    // Setup display for 2D rendering (drawing any batched quads first).
+    if (hWnd != NULL)
+    {
+        GS_OGLSpriteBatch::FlushActive();
+        GS_OGLSprite::BeginRender(hWnd);
+    }
+
+    // The shader renderer gets the letters as quads in screen coordinates.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GLfloat glfVertices[8];
+        GLfloat glfTexCoords[8];
+
+        GS_FontVertex* pVertex = pgsMesh->pVertices;
+
+        for (int nLoop = 0; nLoop < pgsMesh->nNumVertices; nLoop += 4)
+        {
+            for (int nCorner = 0; nCorner < 4; nCorner++)
+            {
+                glfVertices[nCorner * 2]        = glfDestX + (pVertex[nCorner].fX * g_fScaleFactorX);
+                glfVertices[(nCorner * 2) + 1]  = glfDestY + (pVertex[nCorner].fY * g_fScaleFactorY);
+                glfTexCoords[nCorner * 2]       = pVertex[nCorner].fU;
+                glfTexCoords[(nCorner * 2) + 1] = pVertex[nCorner].fV;
+            }
+
+            GS_OGLCoreRenderer::DrawQuad(GS_OGLSprite::GetTextureID(), glfVertices, glfTexCoords,
+                                         gsColor);
+
+            pVertex += 4;
+        }
+    }
+    else
+    {
+        // Position the text.
+        glLoadIdentity();
+        glTranslatef(glfDestX, glfDestY, 0.0f);
+        glScalef(g_fScaleFactorX, g_fScaleFactorY, 1.0f);
+
+        GS_OGLState::SetColor(gsColor.fRed, gsColor.fGreen, gsColor.fBlue, gsColor.fAlpha);
+        GS_OGLState::BindTexture(GS_OGLSprite::GetTextureID());
+
+        // Draw all the letters at once.
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        glVertexPointer(2, GL_FLOAT, sizeof(GS_FontVertex), &pgsMesh->pVertices[0].fX);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_FontVertex), &pgsMesh->pVertices[0].fU);
+
+        glDrawArrays(GL_QUADS, 0, pgsMesh->nNumVertices);
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        GS_OGLSprite::EndRender();
+    }
+
+    return TRUE;
 }
 
 
@@ -381,6 +688,9 @@ void GS_OGLFont::SetCharsPerLine(int nCharsPerLine)
 {
 
     m_nCharsPerLine = nCharsPerLine;
+
+    // The cached meshes no longer match the font.
+    this->DestroyMeshes();
 }
 
 
@@ -414,6 +724,9 @@ void GS_OGLFont::SetLetterWidth(int nLetterWidth)
 {
 
     m_nLetterWidth = nLetterWidth;
+
+    // The cached meshes no longer match the font.
+    this->DestroyMeshes();
 }
 
 
@@ -447,6 +760,9 @@ void GS_OGLFont::SetLetterHeight(int nLetterHeight)
 {
 
     m_nLetterHeight = nLetterHeight;
+
+    // The cached meshes no longer match the font.
+    this->DestroyMeshes();
 }
 
 
@@ -488,13 +804,6 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
         return;
     }
 
-    // Delete string if exists.
-    if (m_pszTextString)
-    {
-        delete [] m_pszTextString;
-    }
-    m_pszTextString=NULL;
-
     char szTempString[256];
 
     // Pointer to a list of arguments.
@@ -506,6 +815,22 @@ void GS_OGLFont::SetText(const char* pszTextString, ...)
     vsprintf(szTempString, pszTextString, pArg);
     va_end(pArg);
 
+    // Keep the string (and its mesh) if the text didn't change.
+    if ((m_pszTextString) && (strcmp(m_pszTextString, szTempString) == 0))
+    {
+        return;
+    }
+
+    // Delete string if exists.
+    if (m_pszTextString)
+    {
+        delete [] m_pszTextString;
+    }
+    m_pszTextString=NULL;
+
+    // The mesh has to be looked up again.
+    m_nMesh = -1;
+
     // Determine length of string and allocate memory.
     int nStringLength = lstrlen(szTempString) + 1;
     m_pszTextString = new char[nStringLength];
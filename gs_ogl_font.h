@@ -43,6 +43,48 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Global variables for adjusting the scale factor of sprites allowing upscaling and downscaling
+// without affecting the game mechanics in any way. These variable will be declared and used in
+// the gs_ogl_sprite.cpp file
+// ---------------------------------------------------------------------------------------------
+extern float g_fRenderModX;
+extern float g_fRenderModY;
+extern float g_fScaleFactorX;
+extern float g_fScaleFactorY;
+// ---------------------------------------------------------------------------------------------
+
+
+//==============================================================================================
+// Font defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_FONT_MAX_MESHES 32 // Number of text strings a font keeps the geometry of.
+//==============================================================================================
+
+
+//==============================================================================================
+// Font mesh structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_FONT_VERTEX
+{
+    GLfloat fX; // Position of the vertex relative to the start of the text.
+    GLfloat fY;
+    GLfloat fU; // Texture coordinates of the vertex.
+    GLfloat fV;
+} GS_FontVertex;
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_FONT_MESH
+{
+    char*          pszText;      // The text string the mesh was built for.
+    GLfloat        glfScaleX;    // The font scale the mesh was built for.
+    GLfloat        glfScaleY;
+    GS_FontVertex* pVertices;    // Four vertices for each character of the string.
+    int            nNumVertices; // Number of vertices in the mesh.
+    unsigned long  ulLastUsed;   // When the mesh was last rendered (to find one to replace).
+} GS_FontMesh;
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,14 +95,24 @@ class GS_OGLFont : public GS_OGLSprite
 
 private:
 
-    // GS_RenderTarget m_gsTargets[160]; // ...
-
     char* m_pszTextString; // Text string to output to screen.
 
     int   m_nCharsPerLine; // Number of characters per line of the font image.
     int   m_nLetterWidth;  // Width of each letter.
     int   m_nLetterHeight; // Height of each letter.
 
+    GS_FontMesh   m_gsMeshes[GS_FONT_MAX_MESHES]; // Geometry of recently rendered strings.
+    int           m_nNumMeshes;                   // Number of meshes in use.
+    int           m_nMesh;                        // Mesh of the current text, -1 if unknown.
+    unsigned long m_ulNumRenders;                 // Number of meshes rendered so far.
+
+    void GetCharRect(char cTextChar, RECT* pSourceRect);
+
+    int  FindMesh();
+    int  BuildMesh();
+    void DestroyMeshes();
+    BOOL RenderMesh(GS_FontMesh* pgsMesh, HWND hWnd);
+
 protected:
 
     // ...
@@ -74,6 +126,8 @@ public:
                 BOOL bFiltered = FALSE, BOOL bMipmap = TRUE);
     BOOL Create(GLuint glTexture, int nWidth, int nHeight, int nCharsPerLine,
                 int nLetterWidth, int nLetterHeight);
+    BOOL Create(GS_OGLTexture& gsTexture, int nCharsPerLine, int nLetterWidth,
+                int nLetterHeight);
 
     void Destroy();
 
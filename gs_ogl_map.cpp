@@ -34,16 +34,19 @@
 GS_OGLMap::GS_OGLMap()
 {
 
-    for (int nRows = 0; nRows < MAX_MAP_ROWS; nRows++)
-    {
-        for (int nCols = 0; nCols < MAX_MAP_COLS; nCols++)
-        {
-            m_nMap[nRows][nCols] = -1;
-        }
-    }
+    m_pMapMemory = NULL;
+    m_pMap       = NULL;
+    m_nTileBytes = 1;
     m_nNumCols = 0;
     m_nNumRows = 0;
 
+    m_pSolidMask = NULL;
+    m_nMaskWords = 0;
+
+    memset(m_gsSumTables, 0, sizeof(m_gsSumTables));
+    m_ulMapStamp = 1;
+    m_ulSumClock = 0;
+
     m_rcClipBox.left   = 0;
     m_rcClipBox.top    = 0;
     m_rcClipBox.right  = 0;
@@ -62,6 +65,13 @@ GS_OGLMap::GS_OGLMap()
     m_bWrapX  = FALSE;
     m_bWrapY  = FALSE;
 
+    m_pVertices        = NULL;
+    m_nNumVertices     = 0;
+    m_gluVertexBuffer  = 0;
+    m_gluDisplayList   = 0;
+    m_bIsGeometryDirty = TRUE;
+    m_bIsListDirty     = TRUE;
+
     m_bIsReady = FALSE;
 }
 
@@ -82,6 +92,9 @@ GS_OGLMap::~GS_OGLMap()
 {
 
     this->Destroy();
+
+    // A map can be loaded without creating the tiles.
+    this->FreeMap();
 }
 
 
@@ -119,6 +132,9 @@ BOOL GS_OGLMap::Create(const char* pszPathname, int nTotalTiles, int nTilesPerLi
     m_nTileWidth  = nTileWidth;
     m_nTileHeight = nTileHeight;
 
+    // The tile geometry depends on the tile image.
+    m_bIsGeometryDirty = TRUE;
+
     m_bIsReady = TRUE;
 
     return TRUE;
@@ -151,6 +167,9 @@ BOOL GS_OGLMap::Create(GLuint glTexture, int nWidth, int nHeight, int nTotalTile
     m_nTileWidth  = nTileWidth;
     m_nTileHeight = nTileHeight;
 
+    // The tile geometry depends on the tile image.
+    m_bIsGeometryDirty = TRUE;
+
     m_bIsReady = TRUE;
 
     return TRUE;
@@ -178,15 +197,9 @@ void GS_OGLMap::Destroy()
 
     m_gsTileSprites.Destroy();
 
-    for (int nRows = 0; nRows < MAX_MAP_ROWS; nRows++)
-    {
-        for (int nCols = 0; nCols < MAX_MAP_COLS; nCols++)
-        {
-            m_nMap[nRows][nCols] = -1;
-        }
-    }
-    m_nNumCols = 0;
-    m_nNumRows = 0;
+    this->DestroyGeometry();
+
+    this->FreeMap();
 
     m_rcClipBox.left   = 0;
     m_rcClipBox.top    = 0;
@@ -206,6 +219,13 @@ void GS_OGLMap::Destroy()
     m_bWrapX  = FALSE;
     m_bWrapY  = FALSE;
 
+    m_pVertices        = NULL;
+    m_nNumVertices     = 0;
+    m_gluVertexBuffer  = 0;
+    m_gluDisplayList   = 0;
+    m_bIsGeometryDirty = TRUE;
+    m_bIsListDirty     = TRUE;
+
     m_bIsReady = FALSE;
 }
 
@@ -235,61 +255,16 @@ BOOL GS_OGLMap::Render(int nMapCoordX, int nMapCoordY, HWND hWnd)
         return FALSE;
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Create a scissor box. ////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // Create a window (called a scissor box) that will automatically clip any rendering to fit.
-    glScissor
-    (
-        m_rcClipBox.left * g_fScaleFactorX + g_fRenderModX,
-        m_rcClipBox.bottom * g_fScaleFactorY + g_fRenderModY,
-        (m_rcClipBox.right - m_rcClipBox.left) * g_fScaleFactorX + g_fRenderModX,
-        (m_rcClipBox.top - m_rcClipBox.bottom) * g_fScaleFactorY + g_fRenderModY
-    );
-
-    // Enable the scissor box.
-    glEnable(GL_SCISSOR_TEST);
-
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Render the map. //////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
-
-    // For every element of the map.
-    for (int nRow = 0; nRow < m_nNumRows; nRow++)
+    // Set up the scissor box, texture and cached tile geometry.
+    if (!this->BeginGeometry(hWnd))
     {
-        for (int nCol = 0; nCol < m_nNumCols; nCol++)
-        {
-            // Is the map element visible?
-            if (m_nMap[nRow][nCol] != m_nClearTileID)
-            {
-                // Set the tile image depending on the map.
-                m_gsTileSprites.SetFrame(m_nMap[nRow][nCol]);
-                // Determine the x and y coordinates at which to render the tile image.
-                int nDestX = m_rcClipBox.left   + nMapCoordX + (m_nTileWidth  * nCol);
-                int nDestY = m_rcClipBox.bottom + nMapCoordY + (m_nTileHeight * nRow);
-                // Does the tile overlap the clip box area?
-                if ((nDestX > m_rcClipBox.left   -  m_nTileWidth) &&
-                        (nDestX < m_rcClipBox.right) &&
-                        (nDestY > m_rcClipBox.bottom - m_nTileHeight) &&
-                        (nDestY < m_rcClipBox.top))
-                {
-                    // Set the tile coordinates.
-                    m_gsTileSprites.SetDestX(nDestX);
-                    m_gsTileSprites.SetDestY(nDestY);
-                    // Render the tile.
-                    m_gsTileSprites.Render(hWnd);
-                }
-            }
-        }
+        return FALSE;
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Destroy the scissor box. /////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Draw the part of the map inside the clip box.
+    this->DrawGeometry(nMapCoordX, nMapCoordY);
 
-    // Disable the scissor box.
-    glDisable(GL_SCISSOR_TEST);
+    this->EndGeometry(hWnd);
 
     return TRUE;
 }
@@ -327,12 +302,15 @@ BOOL GS_OGLMap::Render(HWND hWnd)
     // Render the map at the default map coordinates. ///////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Was rendering the map at the map coordinates not successful?
-    if (!this->Render(m_nMapCoordX, m_nMapCoordY, hWnd))
+    // Set up the scissor box, texture and cached tile geometry once for all the passes.
+    if (!this->BeginGeometry(hWnd))
     {
         return FALSE;
     }
 
+    // Draw the map at the map coordinates.
+    this->DrawGeometry(m_nMapCoordX, m_nMapCoordY);
+
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Render the horizontal wrap of the map. ///////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
@@ -355,11 +333,8 @@ BOOL GS_OGLMap::Render(HWND hWnd)
         // Was the x coordinate altered?
         if (nWrapCoordX != m_nMapCoordX)
         {
-            // Was rendering the map at the wrap x coordinate not successful?
-            if (!this->Render(nWrapCoordX, m_nMapCoordY, hWnd))
-            {
-                return FALSE;
-            }
+            // Draw the map again at the wrap x coordinate.
+            this->DrawGeometry(nWrapCoordX, m_nMapCoordY);
         }
     }
 
@@ -385,11 +360,8 @@ BOOL GS_OGLMap::Render(HWND hWnd)
         // Was the y coordinate altered?
         if (nWrapCoordY != m_nMapCoordY)
         {
-            // Was rendering the map at the wrap y coordinate not successful?
-            if (!this->Render(m_nMapCoordX, nWrapCoordY, hWnd))
-            {
-                return FALSE;
-            }
+            // Draw the map again at the wrap y coordinate.
+            this->DrawGeometry(m_nMapCoordX, nWrapCoordY);
         }
     }
 
@@ -397,77 +369,894 @@ BOOL GS_OGLMap::Render(HWND hWnd)
     // Render the combined horizontal and vertical wraps. ///////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Were both the x and y coordinates altered?
-    if ((nWrapCoordX != m_nMapCoordX) && (nWrapCoordY != m_nMapCoordY))
+    // Were both the x and y coordinates altered?
+    if ((nWrapCoordX != m_nMapCoordX) && (nWrapCoordY != m_nMapCoordY))
+    {
+        // Draw the map again at the wrap coordinates.
+        this->DrawGeometry(nWrapCoordX, nWrapCoordY);
+    }
+
+    this->EndGeometry(hWnd);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Geometry Methods. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetCellVertices():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Fills in the four cached vertices of a map cell from its current tile ID. A clear
+//          cell is given a degenerate quad so every cell keeps the same place in the buffer.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetCellVertices(int nRow, int nCol)
+{
+
+    GS_MapVertex* pVertex = &m_pVertices[((nRow * m_nNumCols) + nCol) * 4];
+
+    int nTileID = this->GetCell(nRow, nCol);
+
+    // Is the map element not visible?
+    if (nTileID == m_nClearTileID)
+    {
+        memset(pVertex, 0, sizeof(GS_MapVertex) * 4);
+        return;
+    }
+
+    // Get the source rectangle of the tile image depending on the map.
+    RECT rcFrame;
+    m_gsTileSprites.GetFrameRect(nTileID, &rcFrame);
+
+    // Determine the tile position relative to the bottom left corner of the map.
+    GLfloat fLeft   = (GLfloat) (m_nTileWidth  * nCol);
+    GLfloat fBottom = (GLfloat) (m_nTileHeight * nRow);
+    GLfloat fRight  = fLeft   + (rcFrame.right - rcFrame.left)   * m_gsTileSprites.GetScaleX();
+    GLfloat fTop    = fBottom + (rcFrame.top   - rcFrame.bottom) * m_gsTileSprites.GetScaleY();
+
+    // Determine the tile texture coordinates as a factor of one.
+    GLfloat fTexLeft   = m_gsTileSprites.GetTexCoordU((GLfloat) rcFrame.left);
+    GLfloat fTexBottom = m_gsTileSprites.GetTexCoordV((GLfloat) rcFrame.bottom);
+    GLfloat fTexRight  = m_gsTileSprites.GetTexCoordU((GLfloat) rcFrame.right);
+    GLfloat fTexTop    = m_gsTileSprites.GetTexCoordV((GLfloat) rcFrame.top);
+
+    // Bottom left, bottom right, top right and top left, the same order GS_OGLSprite uses.
+    pVertex[0].fX = fLeft;  pVertex[0].fY = fBottom; pVertex[0].fU = fTexLeft;  pVertex[0].fV = fTexBottom;
+    pVertex[1].fX = fRight; pVertex[1].fY = fBottom; pVertex[1].fU = fTexRight; pVertex[1].fV = fTexBottom;
+    pVertex[2].fX = fRight; pVertex[2].fY = fTop;    pVertex[2].fU = fTexRight; pVertex[2].fV = fTexTop;
+    pVertex[3].fX = fLeft;  pVertex[3].fY = fTop;    pVertex[3].fU = fTexLeft;  pVertex[3].fV = fTexTop;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::BuildGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds the cached geometry for the whole map and uploads it to a vertex buffer
+//          object, or marks the display list for recompiling if there are no VBOs. Called
+//          after a map is loaded or whenever a change affects every cell.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::BuildGeometry()
+{
+
+    // Can't build any geometry without a map.
+    if ((!m_bIsReady) || (m_nNumCols <= 0) || (m_nNumRows <= 0))
+    {
+        return;
+    }
+
+    // Allocate a new vertex array if the size of the map changed.
+    if (m_nNumVertices != (m_nNumRows * m_nNumCols * 4))
+    {
+        if (m_pVertices)
+        {
+            delete[] m_pVertices;
+        }
+        m_nNumVertices = m_nNumRows * m_nNumCols * 4;
+        m_pVertices    = new GS_MapVertex[m_nNumVertices];
+    }
+
+    // For every element of the map.
+    for (int nRow = 0; nRow < m_nNumRows; nRow++)
+    {
+        for (int nCol = 0; nCol < m_nNumCols; nCol++)
+        {
+            this->SetCellVertices(nRow, nCol);
+        }
+    }
+
+    // Without a rendering context the upload has to wait for the first render.
+    if (!GS_OGLExtensions::IsLoaded())
+    {
+        m_bIsGeometryDirty = TRUE;
+        return;
+    }
+
+    if (GS_OGLExtensions::HasBufferObjects())
+    {
+        if (m_gluVertexBuffer == 0)
+        {
+            gsglGenBuffers(1, &m_gluVertexBuffer);
+        }
+        gsglBindBuffer(GL_ARRAY_BUFFER, m_gluVertexBuffer);
+        gsglBufferData(GL_ARRAY_BUFFER, sizeof(GS_MapVertex) * m_nNumVertices, m_pVertices,
+                       GL_STATIC_DRAW);
+        gsglBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else
+    {
+        m_bIsListDirty = TRUE;
+    }
+
+    m_bIsGeometryDirty = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::UpdateGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Updates the cached geometry of a single map cell after its tile ID changed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::UpdateGeometry(int nRow, int nCol)
+{
+
+    // Will the whole map be rebuilt anyway?
+    if ((m_bIsGeometryDirty) || (!m_pVertices))
+    {
+        m_bIsGeometryDirty = TRUE;
+        return;
+    }
+
+    this->SetCellVertices(nRow, nCol);
+
+    if (m_gluVertexBuffer != 0)
+    {
+        int nFirst = ((nRow * m_nNumCols) + nCol) * 4;
+        gsglBindBuffer(GL_ARRAY_BUFFER, m_gluVertexBuffer);
+        gsglBufferSubData(GL_ARRAY_BUFFER, sizeof(GS_MapVertex) * nFirst,
+                          sizeof(GS_MapVertex) * 4, &m_pVertices[nFirst]);
+        gsglBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else
+    {
+        m_bIsListDirty = TRUE;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::DestroyGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Releases the cached geometry and the OpenGL objects holding it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::DestroyGeometry()
+{
+
+    if ((m_gluVertexBuffer != 0) && (gsglDeleteBuffers))
+    {
+        gsglDeleteBuffers(1, &m_gluVertexBuffer);
+    }
+    m_gluVertexBuffer = 0;
+
+    if (m_gluDisplayList != 0)
+    {
+        glDeleteLists(m_gluDisplayList, 1);
+    }
+    m_gluDisplayList = 0;
+
+    if (m_pVertices)
+    {
+        delete[] m_pVertices;
+    }
+    m_pVertices    = NULL;
+    m_nNumVertices = 0;
+
+    m_bIsGeometryDirty = TRUE;
+    m_bIsListDirty     = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::BeginGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets up everything needed to draw the cached geometry: the scissor box that clips
+//          the map to the clip box, the tile texture and color, and the vertex arrays (or the
+//          display list). The state is shared by every DrawGeometry() call up to EndGeometry().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::BeginGeometry(HWND hWnd)
+{
+
+    // Rebuild the geometry if the map or the tile layout changed.
+    if (m_bIsGeometryDirty)
+    {
+        this->BuildGeometry();
+    }
+
+    if (!m_pVertices)
+    {
+        return FALSE;
+    }
+
+    // Draw any batched quads first, the map is drawn directly and changes the scissor box.
+    GS_OGLSpriteBatch::FlushActive();
+
+    // Setup display for 2D rendering.
+    if (hWnd != NULL)
+    {
+        m_gsTileSprites.BeginRender(hWnd);
+    }
+
+    // Create a window (called a scissor box) that will automatically clip any rendering to fit.
+    GS_OGLState::SetScissor
+    (
+        m_rcClipBox.left * g_fScaleFactorX + g_fRenderModX,
+        m_rcClipBox.bottom * g_fScaleFactorY + g_fRenderModY,
+        (m_rcClipBox.right - m_rcClipBox.left) * g_fScaleFactorX + g_fRenderModX,
+        (m_rcClipBox.top - m_rcClipBox.bottom) * g_fScaleFactorY + g_fRenderModY
+    );
+
+    // Enable the scissor box.
+    GS_OGLState::EnableScissor(TRUE);
+
+    // Draw the tiles in a different hue or with transparency depending on the alpha factor.
+    GS_OGLColor gsColor;
+    m_gsTileSprites.GetModulateColor(&gsColor);
+    GS_OGLState::SetColor(gsColor.fRed, gsColor.fGreen, gsColor.fBlue, gsColor.fAlpha);
+
+    // Select the tile texture.
+    GS_OGLState::BindTexture(m_gsTileSprites.GetTextureID());
+
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        // Let the shader renderer read the vertex buffer object (or the software renderer the
+        // cached vertices).
+        GS_OGLCoreRenderer::BeginBuffer(m_gluVertexBuffer, m_pVertices, sizeof(GS_MapVertex),
+                                        2 * sizeof(GLfloat), gsColor);
+    }
+    else if (m_gluVertexBuffer != 0)
+    {
+        // Point the vertex arrays at the vertex buffer object.
+        gsglBindBuffer(GL_ARRAY_BUFFER, m_gluVertexBuffer);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(GS_MapVertex), (const GLvoid*) 0);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_MapVertex),
+                          (const GLvoid*) (2 * sizeof(GLfloat)));
+    }
+    else if ((m_bIsListDirty) || (m_gluDisplayList == 0))
+    {
+        // Compile the visible tiles into a display list.
+        if (m_gluDisplayList == 0)
+        {
+            m_gluDisplayList = glGenLists(1);
+        }
+
+        glNewList(m_gluDisplayList, GL_COMPILE);
+        glBegin(GL_QUADS);
+        for (int nCell = 0; nCell < (m_nNumRows * m_nNumCols); nCell++)
+        {
+            // Skip the degenerate quads of clear cells.
+            if (this->GetCell(nCell / m_nNumCols, nCell % m_nNumCols) == m_nClearTileID)
+            {
+                continue;
+            }
+            for (int nVertex = nCell * 4; nVertex < (nCell * 4) + 4; nVertex++)
+            {
+                glTexCoord2f(m_pVertices[nVertex].fU, m_pVertices[nVertex].fV);
+                glVertex2f(m_pVertices[nVertex].fX, m_pVertices[nVertex].fY);
+            }
+        }
+        glEnd();
+        glEndList();
+
+        m_bIsListDirty = FALSE;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::GetVisibleCells():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Works out the first and last row and column of the map that fall inside the clip
+//          box with the bottom left corner of the map at the given map coordinates.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if any cell is visible, FALSE if the map lies entirely outside the clip box.
+//==============================================================================================
+
+BOOL GS_OGLMap::GetVisibleCells(int nMapCoordX, int nMapCoordY, int* pnFirstRow, int* pnLastRow,
+                                int* pnFirstCol, int* pnLastCol)
+{
+
+    if ((m_nTileWidth <= 0) || (m_nTileHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    // The clip box in pixels relative to the bottom left corner of the map.
+    int nLeft   = -nMapCoordX;
+    int nBottom = -nMapCoordY;
+    int nRight  = nLeft   + this->GetClipBoxWidth()  - 1;
+    int nTop    = nBottom + this->GetClipBoxHeight() - 1;
+
+    if ((nRight < 0) || (nTop < 0) || (nRight < nLeft) || (nTop < nBottom))
+    {
+        return FALSE;
+    }
+
+    // Only the far edges can lie left of or below the map, where dividing would round the
+    // wrong way, so clamp the near edges before dividing.
+    *pnFirstCol = (nLeft   > 0) ? (nLeft   / m_nTileWidth)  : 0;
+    *pnFirstRow = (nBottom > 0) ? (nBottom / m_nTileHeight) : 0;
+    *pnLastCol  = nRight / m_nTileWidth;
+    *pnLastRow  = nTop   / m_nTileHeight;
+
+    if (*pnLastCol >= m_nNumCols) *pnLastCol = m_nNumCols - 1;
+    if (*pnLastRow >= m_nNumRows) *pnLastRow = m_nNumRows - 1;
+
+    return ((*pnFirstCol <= *pnLastCol) && (*pnFirstRow <= *pnLastRow));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::DrawGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the cached geometry of the cells that fall inside the clip box, the bottom
+//          left corner of the map placed at the given map coordinates. The cells are stored
+//          row by row, so the visible rows are drawn with a single call when every column is
+//          visible and with one call per row otherwise. The display list (used without VBOs)
+//          can only be drawn whole and is clipped by the scissor box instead.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::DrawGeometry(int nMapCoordX, int nMapCoordY)
+{
+
+    int nFirstRow, nLastRow, nFirstCol, nLastCol;
+
+    // Is no part of the map inside the clip box?
+    if (!this->GetVisibleCells(nMapCoordX, nMapCoordY, &nFirstRow, &nLastRow, &nFirstCol,
+                               &nLastCol))
+    {
+        return;
+    }
+
+    // Position the map, adjusting coordinates and size by the scale factor (this causes
+    // upscaling or downscaling without affecting the actual game mechanics).
+    GLfloat glfOffsetX = (m_rcClipBox.left + nMapCoordX) * g_fScaleFactorX + g_fRenderModX;
+    GLfloat glfOffsetY = (m_rcClipBox.bottom + nMapCoordY) * g_fScaleFactorY + g_fRenderModY;
+
+    // The shader renderer positions and scales the map with its uniforms.
+    if (!GS_OGLCoreRenderer::IsActive())
+    {
+        glLoadIdentity();
+        glTranslatef(glfOffsetX, glfOffsetY, 0.0f);
+        glScalef(g_fScaleFactorX, g_fScaleFactorY, 1.0f);
+
+        if (m_gluVertexBuffer == 0)
+        {
+            glCallList(m_gluDisplayList);
+            return;
+        }
+    }
+
+    // Are all the columns visible, making the visible rows one run of vertices?
+    if ((nFirstCol == 0) && (nLastCol == (m_nNumCols - 1)))
+    {
+        this->DrawCells(nFirstRow * m_nNumCols * 4, (nLastRow - nFirstRow + 1) * m_nNumCols * 4,
+                        glfOffsetX, glfOffsetY);
+        return;
+    }
+
+    for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+    {
+        this->DrawCells(((nRow * m_nNumCols) + nFirstCol) * 4, (nLastCol - nFirstCol + 1) * 4,
+                        glfOffsetX, glfOffsetY);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::DrawCells():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws a run of the cached vertices with the state set up by BeginGeometry() (the
+//          offset is only used by the shader renderer, DrawGeometry() sets the matrix).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::DrawCells(int nFirstVertex, int nNumVertices, GLfloat glfOffsetX,
+                          GLfloat glfOffsetY)
+{
+
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::DrawBuffer(nFirstVertex, nNumVertices, glfOffsetX, glfOffsetY,
+                                       g_fScaleFactorX, g_fScaleFactorY);
+    }
+    else
+    {
+        glDrawArrays(GL_QUADS, nFirstVertex, nNumVertices);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::EndGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Restores the state changed by BeginGeometry().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::EndGeometry(HWND hWnd)
+{
+
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::EndBuffer();
+    }
+    else if (m_gluVertexBuffer != 0)
+    {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        gsglBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Disable the scissor box.
+    GS_OGLState::EnableScissor(FALSE);
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        m_gsTileSprites.EndRender();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// ClipBox Methods. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SetClipBox():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::SetClipBox(int nMinX, int nMinY, int nMaxX, int nMaxY)
+{
+
+    if (nMinX >= 0)
+    {
+        m_rcClipBox.left   = nMinX;
+    }
+    if (nMinY >= 0)
+    {
+        m_rcClipBox.bottom = nMinY;
+    }
+    if (nMaxX >= 0)
+    {
+        m_rcClipBox.right  = nMaxX;
+    }
+    if (nMaxY >= 0)
+    {
+        m_rcClipBox.top    = nMaxY;
+    }
+}
+
+
+void GS_OGLMap::SetClipBox(RECT rcClipBox)
+{
+
+    m_rcClipBox = rcClipBox;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBox():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A RECT structure containing the clip box coordinates.
+//==============================================================================================
+
+RECT GS_OGLMap::GetClipBox()
+{
+
+    return m_rcClipBox;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxLeft():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The left coordinate of the clip box.
+//==============================================================================================
+
+long GS_OGLMap::GetClipBoxLeft()
+{
+
+    return m_rcClipBox.left;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxRight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The right coordinate of the clip box.
+//==============================================================================================
+
+long GS_OGLMap::GetClipBoxRight()
+{
+
+    return m_rcClipBox.right;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxBottom():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The bottom coordinate of the clip box.
+//==============================================================================================
+
+long GS_OGLMap::GetClipBoxBottom()
+{
+
+    return m_rcClipBox.bottom;
+}
+
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxTop():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The top coordinate of the clip box.
+//==============================================================================================
+
+long GS_OGLMap::GetClipBoxTop()
+{
+
+    return m_rcClipBox.top;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxWidth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width of the clip box in pixels.
+//==============================================================================================
+
+int GS_OGLMap::GetClipBoxWidth()
+{
+
+    return (m_rcClipBox.right - m_rcClipBox.left);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::GetClipBoxHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of the clip box in pixels.
+//==============================================================================================
+
+int GS_OGLMap::GetClipBoxHeight()
+{
+
+    return (m_rcClipBox.top - m_rcClipBox.bottom);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Tile Storage Methods. ///////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::AllocateMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the tile array with an empty one of the specified size, each tile ID
+//          taking nTileBytes bytes (1 for up to 254 tiles, 2 for up to 65534). The array is
+//          stored row by row and starts on a cache line.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::AllocateMap(int nNumRows, int nNumCols, int nTileBytes)
+{
+
+    if ((nNumRows <= 0) || (nNumCols <= 0) || ((nTileBytes != 1) && (nTileBytes != 2)))
+    {
+        return FALSE;
+    }
+
+    // Would the number of bytes not fit in an int?
+    if ((double) nNumRows * (double) nNumCols * (double) nTileBytes > (double) INT_MAX)
+    {
+        return FALSE;
+    }
+
+    this->FreeMap();
+
+    int nSize = nNumRows * nNumCols * nTileBytes;
+
+    m_pMapMemory = new BYTE[nSize + GS_MAP_ALIGNMENT - 1];
+    m_pMap       = (BYTE*) (((size_t) m_pMapMemory + GS_MAP_ALIGNMENT - 1) &
+                            ~((size_t) GS_MAP_ALIGNMENT - 1));
+
+    // Both empty values have every bit set.
+    memset(m_pMap, 0xFF, nSize);
+
+    m_nTileBytes = nTileBytes;
+    m_nNumRows   = nNumRows;
+    m_nNumCols   = nNumCols;
+
+    m_nMaskWords = (nNumCols + 31) / 32;
+    m_pSolidMask = new DWORD[nNumRows * m_nMaskWords];
+
+    this->BuildSolidMask();
+
+    m_ulMapStamp++;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::FreeMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Releases the tile array, leaving a map without rows or columns.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::FreeMap()
+{
+
+    if (m_pMapMemory)
+    {
+        delete[] m_pMapMemory;
+    }
+    m_pMapMemory = NULL;
+    m_pMap       = NULL;
+    m_nTileBytes = 1;
+    m_nNumCols   = 0;
+    m_nNumRows   = 0;
+
+    GS_SAFE_DELETE_ARRAY(m_pSolidMask);
+    m_nMaskWords = 0;
+
+    this->FreeSumTables();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::WidenMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a tile array of bytes to one of 16 bit values, for a tile ID above 254.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::WidenMap()
+{
+
+    if (m_nTileBytes == 2)
+    {
+        return TRUE;
+    }
+
+    // Keep the old array while the new one is filled.
+    BYTE* pOldMemory = m_pMapMemory;
+    BYTE* pOldMap    = m_pMap;
+
+    m_pMapMemory = NULL;
+
+    if (!this->AllocateMap(m_nNumRows, m_nNumCols, 2))
+    {
+        m_pMapMemory = pOldMemory;
+        return FALSE;
+    }
+
+    WORD* pNewMap = (WORD*) m_pMap;
+
+    for (int nCell = 0; nCell < (m_nNumRows * m_nNumCols); nCell++)
+    {
+        pNewMap[nCell] = (pOldMap[nCell] == GS_MAP_EMPTY_8) ? GS_MAP_EMPTY_16 : pOldMap[nCell];
+    }
+
+    delete[] pOldMemory;
+
+    // The new array started out empty, so the solid mask has to be built again.
+    this->BuildSolidMask();
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::BuildSolidMask():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the bit of every cell in the solid mask that does not hold the clear tile ID.
+//          The bits past the last column of each row are left clear.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMap::BuildSolidMask()
+{
+
+    if (NULL == m_pSolidMask)
+    {
+        return;
+    }
+
+    memset(m_pSolidMask, 0, m_nNumRows * m_nMaskWords * sizeof(DWORD));
+
+    for (int nRow = 0; nRow < m_nNumRows; nRow++)
     {
-        // Was rendering the map at the wrap coordinates not successful?
-        if (!this->Render(nWrapCoordX, nWrapCoordY, hWnd))
+        DWORD* pMaskRow = m_pSolidMask + (nRow * m_nMaskWords);
+
+        for (int nCol = 0; nCol < m_nNumCols; nCol++)
         {
-            return FALSE;
+            if (this->GetCell(nRow, nCol) != m_nClearTileID)
+            {
+                pMaskRow[nCol >> 5] |= (DWORD) 1 << (nCol & 31);
+            }
         }
     }
-
-    return TRUE;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////
-// ClipBox Methods. ///////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-
 //==============================================================================================
-// GS_OGLMap::SetClipBox():
+// GS_OGLMap::SetCell():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Stores a tile ID in the tile array, widening the array if the ID does not fit in
+//          a byte. Any negative ID is stored as an empty cell (read back as -1).
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing.
+// Returns: TRUE if successful, FALSE if the ID is too large to store.
 //==============================================================================================
 
-void GS_OGLMap::SetClipBox(int nMinX, int nMinY, int nMaxX, int nMaxY)
+BOOL GS_OGLMap::SetCell(int nRow, int nCol, int nTileID)
 {
 
-    if (nMinX >= 0)
+    int nIndex     = (nRow * m_nNumCols) + nCol;
+    int nOldTileID = this->GetCell(nRow, nCol);
+
+    if ((nTileID >= GS_MAP_EMPTY_8) && (m_nTileBytes == 1) && (!this->WidenMap()))
     {
-        m_rcClipBox.left   = nMinX;
+        return FALSE;
     }
-    if (nMinY >= 0)
+
+    if (m_nTileBytes == 1)
     {
-        m_rcClipBox.bottom = nMinY;
+        m_pMap[nIndex] = (nTileID < 0) ? GS_MAP_EMPTY_8 : (BYTE) nTileID;
     }
-    if (nMaxX >= 0)
+    else if (nTileID >= GS_MAP_EMPTY_16)
     {
-        m_rcClipBox.right  = nMaxX;
+        return FALSE;
     }
-    if (nMaxY >= 0)
+    else
     {
-        m_rcClipBox.top    = nMaxY;
+        ((WORD*) m_pMap)[nIndex] = (nTileID < 0) ? GS_MAP_EMPTY_16 : (WORD) nTileID;
     }
-}
 
+    int nNewTileID = this->GetCell(nRow, nCol);
 
-void GS_OGLMap::SetClipBox(RECT rcClipBox)
-{
+    if (nNewTileID == nOldTileID)
+    {
+        return TRUE;
+    }
 
-    m_rcClipBox = rcClipBox;
-}
+    // Keep the solid mask in step with the cell.
+    DWORD* pMaskWord = m_pSolidMask + (nRow * m_nMaskWords) + (nCol >> 5);
+    DWORD  dwBit     = (DWORD) 1 << (nCol & 31);
 
+    if (nNewTileID != m_nClearTileID)
+    {
+        *pMaskWord |= dwBit;
+    }
+    else
+    {
+        *pMaskWord &= ~dwBit;
+    }
 
-//==============================================================================================
-// GS_OGLMap::GetClipBox():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: A RECT structure containing the clip box coordinates.
-//==============================================================================================
+    // Only the summed area tables counting the old or the new tile ID are rebuilt when next
+    // queried, and the solid ones only if the cell became solid or clear.
+    this->InvalidateSumTables(nOldTileID);
+    this->InvalidateSumTables(nNewTileID);
 
-RECT GS_OGLMap::GetClipBox()
-{
+    if ((nOldTileID == m_nClearTileID) || (nNewTileID == m_nClearTileID))
+    {
+        this->InvalidateSumTables(GS_MAP_SOLID);
+    }
 
-    return m_rcClipBox;
+    return TRUE;
 }
 
 
@@ -475,96 +1264,134 @@ RECT GS_OGLMap::GetClipBox()
 
 
 //==============================================================================================
-// GS_OGLMap::GetClipBoxLeft():
+// GS_OGLMap::FreeSumTables():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Releases all summed area tables.
 // ---------------------------------------------------------------------------------------------
-// Returns: The left coordinate of the clip box.
+// Returns: Nothing.
 //==============================================================================================
 
-long GS_OGLMap::GetClipBoxLeft()
+void GS_OGLMap::FreeSumTables()
 {
 
-    return m_rcClipBox.left;
+    for (int nTable = 0; nTable < GS_MAP_SUM_TABLES; nTable++)
+    {
+        GS_SAFE_DELETE_ARRAY(m_gsSumTables[nTable].pnSums);
+        m_gsSumTables[nTable].ulStamp    = 0;
+        m_gsSumTables[nTable].ulLastUsed = 0;
+    }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::GetClipBoxRight():
+// GS_OGLMap::InvalidateSumTables():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Marks the summed area table of a tile class (if there is one) out of date, so it is
+//          rebuilt when next queried. The tables of other tile classes are kept.
 // ---------------------------------------------------------------------------------------------
-// Returns: The right coordinate of the clip box.
+// Returns: Nothing.
 //==============================================================================================
 
-long GS_OGLMap::GetClipBoxRight()
+void GS_OGLMap::InvalidateSumTables(int nTileClass)
 {
 
-    return m_rcClipBox.right;
+    for (int nTable = 0; nTable < GS_MAP_SUM_TABLES; nTable++)
+    {
+        if ((m_gsSumTables[nTable].pnSums) && (m_gsSumTables[nTable].nTileClass == nTileClass))
+        {
+            m_gsSumTables[nTable].ulStamp = 0;
+        }
+    }
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
-// GS_OGLMap::GetClipBoxBottom():
+// GS_OGLMap::GetSumTable():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Finds the summed area table of a tile class, building it if there is none yet or
+//          the map has changed since it was built. A new table takes the place of the table
+//          that has gone unused the longest.
 // ---------------------------------------------------------------------------------------------
-// Returns: The bottom coordinate of the clip box.
+// Returns: The sums of the table, NULL if there is no map.
 //==============================================================================================
 
-long GS_OGLMap::GetClipBoxBottom()
+int* GS_OGLMap::GetSumTable(int nTileClass)
 {
 
-    return m_rcClipBox.bottom;
-}
+    if ((NULL == m_pMap) || ((double) (m_nNumRows + 1) * (double) (m_nNumCols + 1) >
+                             (double) INT_MAX))
+    {
+        return NULL;
+    }
 
+    GS_MapSumTable* pgsTable = &m_gsSumTables[0];
 
+    for (int nTable = 0; nTable < GS_MAP_SUM_TABLES; nTable++)
+    {
+        // Is this the table of the tile class?
+        if ((m_gsSumTables[nTable].pnSums) && (m_gsSumTables[nTable].nTileClass == nTileClass))
+        {
+            pgsTable = &m_gsSumTables[nTable];
+            break;
+        }
 
-//==============================================================================================
-// GS_OGLMap::GetClipBoxTop():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The top coordinate of the clip box.
-//==============================================================================================
+        if (m_gsSumTables[nTable].ulLastUsed < pgsTable->ulLastUsed)
+        {
+            pgsTable = &m_gsSumTables[nTable];
+        }
+    }
 
-long GS_OGLMap::GetClipBoxTop()
-{
+    pgsTable->ulLastUsed = ++m_ulSumClock;
 
-    return m_rcClipBox.top;
-}
+    if ((pgsTable->pnSums) && (pgsTable->nTileClass == nTileClass) &&
+        (pgsTable->ulStamp == m_ulMapStamp))
+    {
+        return pgsTable->pnSums;
+    }
 
+    int nPitch = m_nNumCols + 1;
 
-////////////////////////////////////////////////////////////////////////////////////////////////
+    if (NULL == pgsTable->pnSums)
+    {
+        pgsTable->pnSums = new int[(m_nNumRows + 1) * nPitch];
+    }
 
+    pgsTable->nTileClass = nTileClass;
+    pgsTable->ulStamp    = m_ulMapStamp;
 
-//==============================================================================================
-// GS_OGLMap::GetClipBoxWidth():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The width of the clip box in pixels.
-//==============================================================================================
+    int* pnSums = pgsTable->pnSums;
 
-int GS_OGLMap::GetClipBoxWidth()
-{
+    // The bottom row and left column of corners have no cells below or left of them.
+    memset(pnSums, 0, nPitch * sizeof(int));
 
-    return (m_rcClipBox.right - m_rcClipBox.left);
-}
+    for (int nRow = 0; nRow < m_nNumRows; nRow++)
+    {
+        int* pnBelow = pnSums + (nRow * nPitch);
+        int* pnAbove = pnBelow + nPitch;
+        int  nRowSum = 0;
 
+        pnAbove[0] = 0;
 
-//==============================================================================================
-// GS_OGLMap::GetClipBoxHeight():
-// ---------------------------------------------------------------------------------------------
-// Purpose: ...
-// ---------------------------------------------------------------------------------------------
-// Returns: The height of the clip box in pixels.
-//==============================================================================================
+        for (int nCol = 0; nCol < m_nNumCols; nCol++)
+        {
+            int nTileID = this->GetCell(nRow, nCol);
 
-int GS_OGLMap::GetClipBoxHeight()
-{
+            if (nTileClass == GS_MAP_SOLID ? (nTileID != m_nClearTileID) : (nTileID == nTileClass))
+            {
+                nRowSum++;
+            }
 
-    return (m_rcClipBox.top - m_rcClipBox.bottom);
+            pnAbove[nCol + 1] = pnBelow[nCol + 1] + nRowSum;
+        }
+    }
+
+    return pnSums;
 }
 
 
@@ -579,11 +1406,12 @@ int GS_OGLMap::GetClipBoxHeight()
 //==============================================================================================
 // GS_OGLMap::LoadMap():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Loads a map file, binary (see GS_MapFile) or text, read with a single read.
 // ---------------------------------------------------------------------------------------------
-// Details: Maps can have a total of 61 different elements. Characters '0' - '9' represents the
-//          elements 0 - 9, 'A' - 'Z' represents the elements 10 - 35 and 'a' - 'z' represents
-//          the elements 36 - 61.
+// Details: Text maps can have a total of 61 different elements. Characters '0' - '9' represents
+//          the elements 0 - 9, 'A' - 'Z' represents the elements 10 - 35 and 'a' - 'z'
+//          represents the elements 36 - 61. Binary maps carry their own dimensions, so the
+//          number of rows and columns are only needed for text maps.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
@@ -591,75 +1419,87 @@ int GS_OGLMap::GetClipBoxHeight()
 BOOL GS_OGLMap::LoadMap(const char* pszPathname, int nNumRows, int nNumCols)
 {
 
-    // Are the filename and the row and column values valid?
-    if ((NULL == pszPathname) || (nNumRows <= 0) || (nNumCols <= 0))
+    GS_MapFile gsMapFile;
+
+    // Were we able to read the map file?
+    if (FALSE == gsMapFile.Load(pszPathname, nNumRows, nNumCols))
     {
         return FALSE;
     }
 
-    GS_File gsMapFile;
+    return this->LoadMap(&gsMapFile);
+}
+
 
-    // Were we able to open the file for reading?
-    if (FALSE == gsMapFile.Open(pszPathname, FILE_READ))
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::LoadMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Replaces the map with the tiles of a map file already loaded, so the caller can
+//          read the rest of its header (tile size, start position).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMap::LoadMap(GS_MapFile* pgsMapFile)
+{
+
+    if ((NULL == pgsMapFile) || (!pgsMapFile->IsReady()))
     {
         return FALSE;
     }
 
-    // Make sure map is not too large.
-    if (nNumRows > MAX_MAP_ROWS)
+    return this->SetTiles(pgsMapFile->GetTileIDs(), pgsMapFile->GetNumRows(),
+                          pgsMapFile->GetNumCols());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::SaveMap():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the map to a text map file, or a binary one, with a single write.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successful, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMap::SaveMap(const char* pszPathname, BOOL bBinary)
+{
+
+    // Do we have a valid filename and a map to save?
+    if ((NULL == pszPathname) || (NULL == m_pMap))
     {
-        nNumRows =  MAX_MAP_ROWS;
+        return FALSE;
     }
-    if (nNumCols > MAX_MAP_COLS)
+
+    GS_MapFile gsMapFile;
+
+    if (!gsMapFile.Create(m_nNumRows, m_nNumCols))
     {
-        nNumCols =  MAX_MAP_COLS;
+        return FALSE;
     }
 
-    // Read all the values from the file into the map array.
-    for (int nRows = nNumRows - 1; nRows >= 0; nRows--)
+    // Copy all the values from the map array.
+    for (int nRows = 0; nRows < m_nNumRows; nRows++)
     {
-        for (int nCols = 0; nCols < nNumCols; nCols++)
+        for (int nCols = 0; nCols < m_nNumCols; nCols++)
         {
-            // Read the value from the file.
-            int nTemp = gsMapFile.GetByte();
-            // Have we encountered an end of line character?
-            while ((nTemp == 0x0A) || (nTemp == 0x0D))
-            {
-                // Eat all end of line characters.
-                nTemp = gsMapFile.GetByte();
-            }
-            // Determine the map equivalent of the file value.
-            if ((nTemp >= 48) && (nTemp <= 57))
-            {
-                // 0 - 9 is 0 - 9.
-                m_nMap[nRows][nCols] = nTemp - 48;
-            }
-            else if ((nTemp >= 65) && (nTemp <= 90))
-            {
-                // A - Z is 10 to 35.
-                m_nMap[nRows][nCols] = nTemp - 55;
-            }
-            else if ((nTemp >= 97) && (nTemp <= 122))
-            {
-                // a - z is 36 to 61.
-                m_nMap[nRows][nCols] = nTemp - 61;
-            }
-            else
-            {
-                // Unrecognised value.
-                m_nMap[nRows][nCols] = -1;
-            }
+            gsMapFile.SetTileID(nRows, nCols, this->GetCell(nRows, nCols));
         }
     }
 
-    // Save map dimensions.
-    m_nNumCols = nNumCols;
-    m_nNumRows = nNumRows;
+    gsMapFile.SetTileSize(m_nTileWidth, m_nTileHeight);
 
-    // Close the map file.
-    gsMapFile.Close();
+    if (bBinary)
+    {
+        return gsMapFile.Save(pszPathname);
+    }
 
-    return TRUE;
+    return gsMapFile.SaveText(pszPathname);
 }
 
 
@@ -667,66 +1507,50 @@ BOOL GS_OGLMap::LoadMap(const char* pszPathname, int nNumRows, int nNumCols)
 
 
 //==============================================================================================
-// GS_OGLMap::SaveMap():
+// GS_OGLMap::SetTiles():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Replaces the map with one of the specified size holding the tile IDs in the array
+//          (row by row, the bottom row first, -1 for empty cells), like LoadMap() does with
+//          the contents of a map file.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successful, FALSE if failed.
 //==============================================================================================
 
-BOOL GS_OGLMap::SaveMap(const char* pszPathname)
+BOOL GS_OGLMap::SetTiles(const int* pnTileIDs, int nNumRows, int nNumCols)
 {
 
-    // Do we have a valid filename?
-    if (NULL == pszPathname)
+    if ((NULL == pnTileIDs) || (nNumRows <= 0) || (nNumCols <= 0))
     {
         return FALSE;
     }
 
-    GS_File gsMapFile;
+    // Use 16 bit tile IDs straight away if any of them needs it.
+    int nTileBytes = 1;
+
+    for (int nCell = 0; nCell < (nNumRows * nNumCols); nCell++)
+    {
+        if (pnTileIDs[nCell] >= GS_MAP_EMPTY_8)
+        {
+            nTileBytes = 2;
+            break;
+        }
+    }
 
-    // Were we able to open the file for writing?
-    if (FALSE == gsMapFile.Open(pszPathname, FILE_WRITE))
+    if (!this->AllocateMap(nNumRows, nNumCols, nTileBytes))
     {
         return FALSE;
     }
 
-    // Write all the values from the map array to the file.
-    for (int nRows = m_nNumRows - 1; nRows >= 0; nRows--)
+    for (int nRow = 0; nRow < nNumRows; nRow++)
     {
-        for (int nCols = 0; nCols < m_nNumCols; nCols++)
+        for (int nCol = 0; nCol < nNumCols; nCol++)
         {
-            // Write numbers 0 - 9 as characters '0' - '9'.
-            if ((m_nMap[nRows][nCols] >= 0) && (m_nMap[nRows][nCols] <= 9))
-            {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 48));
-            }
-            // Write numbers 10 - 35 as characters 'A' - 'Z'.
-            else if ((m_nMap[nRows][nCols] >= 10) && (m_nMap[nRows][nCols] <= 35))
-            {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 55));
-            }
-            // Write numbers 36 - 61 as characters 'a' - 'z'.
-            else if ((m_nMap[nRows][nCols] >= 36) && (m_nMap[nRows][nCols] <= 61))
-            {
-                gsMapFile.PutByte((unsigned short)(m_nMap[nRows][nCols] + 61));
-            }
-            else
-            {
-                gsMapFile.PutByte(' ');
-            }
-            // Are we at the end of the line?
-            if (nCols == m_nNumCols-1)
-            {
-                // Write end of line characters.
-                gsMapFile.PutByte(0x0D);
-                gsMapFile.PutByte(0x0A);
-            }
+            this->SetCell(nRow, nCol, pnTileIDs[(nRow * nNumCols) + nCol]);
         }
     }
 
-    // Close the map file.
-    gsMapFile.Close();
+    // Cache the geometry of the new map.
+    this->BuildGeometry();
 
     return TRUE;
 }
@@ -735,6 +1559,24 @@ BOOL GS_OGLMap::SaveMap(const char* pszPathname)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLMap::GetMemoryUsage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of bytes used by the tile IDs and the cached geometry.
+//==============================================================================================
+
+int GS_OGLMap::GetMemoryUsage()
+{
+
+    return (m_nNumRows * m_nNumCols * m_nTileBytes) + (m_nNumVertices * sizeof(GS_MapVertex));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLMap::SetMapX():
 // ---------------------------------------------------------------------------------------------
@@ -1044,7 +1886,11 @@ void GS_OGLMap::SetTileID(int nRow, int nCol, int nNewTileID)
 
     if ((nRow >= 0) && (nRow < m_nNumRows) && (nCol >= 0) && (nCol < m_nNumCols))
     {
-        m_nMap[nRow][nCol] = nNewTileID;
+        // Only update the cached geometry if the tile actually changed.
+        if ((this->GetCell(nRow, nCol) != nNewTileID) && (this->SetCell(nRow, nCol, nNewTileID)))
+        {
+            this->UpdateGeometry(nRow, nCol);
+        }
     }
 }
 
@@ -1062,7 +1908,7 @@ int GS_OGLMap::GetTileID(int nRow, int nCol)
 
     if ((nRow >= 0) && (nRow < m_nNumRows) && (nCol >= 0) && (nCol < m_nNumCols))
     {
-        return m_nMap[nRow][nCol];
+        return this->GetCell(nRow, nCol);
     }
 
     return -1;
@@ -1084,9 +1930,10 @@ void GS_OGLMap::ReplaceTileID(int nOldTileID, int nNewTileID)
     {
         for (int nCols = 0; nCols < m_nNumCols; nCols++)
         {
-            if (m_nMap[nRows][nCols] == nOldTileID)
+            if ((this->GetCell(nRows, nCols) == nOldTileID) &&
+                (this->SetCell(nRows, nCols, nNewTileID)))
             {
-                m_nMap[nRows][nCols] = nNewTileID;
+                this->UpdateGeometry(nRows, nCols);
             }
         }
     }
@@ -1107,7 +1954,17 @@ void GS_OGLMap::ReplaceTileID(int nOldTileID, int nNewTileID)
 void GS_OGLMap::SetClearTileID(int nTileID)
 {
 
-    m_nClearTileID = nTileID;
+    // Clear tiles are left out of the cached geometry and the solid mask.
+    if (m_nClearTileID != nTileID)
+    {
+        m_nClearTileID     = nTileID;
+        m_bIsGeometryDirty = TRUE;
+
+        this->BuildSolidMask();
+
+        // Only the tables counting solid cells depend on the clear tile ID.
+        this->InvalidateSumTables(GS_MAP_SOLID);
+    }
 }
 
 
@@ -1159,6 +2016,8 @@ void GS_OGLMap::SetTotalTiles(int nTotalTiles)
 {
 
     m_gsTileSprites.SetTotalFrames(nTotalTiles);
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1192,6 +2051,8 @@ void GS_OGLMap::SetTilesPerLine(int nTilesPerLine)
 {
 
     m_gsTileSprites.SetFramesPerLine(nTilesPerLine);
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1237,7 +2098,7 @@ int GS_OGLMap::MapToID(int nCoordX, int nCoordY)
     }
 
     // Return the tile ID at the specified coordinates.
-    return(m_nMap[nRow][nCol]);
+    return(this->GetCell(nRow, nCol));
 }
 
 
@@ -1923,51 +2784,11 @@ BOOL GS_OGLMap::IsOnTile(RECT rcSource, int nTileID)
         return FALSE;
     }
 
-    int nMaxCoordY = rcSource.top   + m_nTileHeight;
-    int nMaxCoordX = rcSource.right + m_nTileWidth;
-
-    int nTempX, nTempY;
-
-    // Check every tile within the source rectangle's area.
-    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
-    {
-        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
-        {
-            // Have we reached the maximum x-coordinate?
-            if (nCoordX >= rcSource.right)
-            {
-                // Set x-coordinate to maximum.
-                nTempX = rcSource.right-1;
-            }
-            else
-            {
-                nTempX = nCoordX;
-            }
-            // Have we reached the maximum y-coordinate?
-            if (nCoordY >= rcSource.top)
-            {
-                // Set y-coordinate to maximum.
-                nTempY = rcSource.top-1;
-            }
-            else
-            {
-                nTempY = nCoordY;
-            }
-            // Were we able to convert the screen coordinate to a map coordinate?
-            if (this->ScreenToMap(&nTempX, &nTempY))
-            {
-                // Is the tile at the specified coordinate the right kind?
-                if (this->MapToID(nTempX, nTempY) == nTileID)
-                {
-                    // Overlap occured.
-                    return TRUE;
-                }
-            }
-        }
-    }
+    int nNumCells;
 
-    // No overlap occured.
-    return FALSE;
+    // Does any cell of the map under the source hold the tile (found with the summed area
+    // table of the tile, whatever the size of the source)?
+    return (this->CountTilesOnScreen(rcSource, nTileID, &nNumCells) > 0);
 }
 
 
@@ -1988,61 +2809,23 @@ BOOL GS_OGLMap::IsInTile(RECT rcSource, int nTileID)
         return FALSE;
     }
 
-    int nMaxCoordY = rcSource.top   + m_nTileHeight;
-    int nMaxCoordX = rcSource.right + m_nTileWidth;
-
-    int nTempX, nTempY;
-
-    // Check every tile within the source rectangle's area.
-    for (int nCoordY = rcSource.bottom; nCoordY < nMaxCoordY; nCoordY += m_nTileHeight)
+    // Are the x-coordinates of the source not entirely within the clip box?
+    if ((rcSource.left < m_rcClipBox.left) || (rcSource.right > m_rcClipBox.right))
+    {
+        return FALSE;
+    }
+
+    // Are the y-coordinates of the source not entirely within the clip box?
+    if ((rcSource.bottom < m_rcClipBox.bottom) || (rcSource.top > m_rcClipBox.top))
     {
-        for (int nCoordX = rcSource.left; nCoordX < nMaxCoordX; nCoordX += m_nTileWidth)
-        {
-            // Have we reached the maximum x-coordinate?
-            if (nCoordX >= rcSource.right)
-            {
-                // Set x-coordinate to maximum.
-                nTempX = rcSource.right-1;
-            }
-            else
-            {
-                nTempX = nCoordX;
-            }
-            // Are the x-coordinates not entirely within the clip box?
-            if ((nTempX < m_rcClipBox.left) || (nTempX >= m_rcClipBox.right))
-            {
-                return FALSE;
-            }
-            // Have we reached the maximum y-coordinate?
-            if (nCoordY >= rcSource.top)
-            {
-                // Set y-coordinate to maximum.
-                nTempY = rcSource.top-1;
-            }
-            else
-            {
-                nTempY = nCoordY;
-            }
-            // Are the y-coordinates not entirely within the clip box?
-            if ((nTempY < m_rcClipBox.bottom) || (nTempY >= m_rcClipBox.top))
-            {
-                return FALSE;
-            }
-            // Were we able to convert the screen coordinate to a map coordinate?
-            if (this->ScreenToMap(&nTempX, &nTempY))
-            {
-                // Is the tile at the specified coordinate the wrong kind?
-                if (this->MapToID(nTempX, nTempY) != nTileID)
-                {
-                    // Source not within tile(s).
-                    return FALSE;
-                }
-            }
-        }
+        return FALSE;
     }
 
-    // Source is within tile(s).
-    return TRUE;
+    int nNumCells;
+
+    // Do all the cells of the map under the source hold the tile (counted with the summed
+    // area table of the tile, whatever the size of the source)?
+    return (this->CountTilesOnScreen(rcSource, nTileID, &nNumCells) == nNumCells);
 }
 
 
@@ -2519,6 +3302,448 @@ BOOL GS_OGLMap::IsInArea(RECT rcSource, RECT rcMapArea)
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLMap::IsSolidCell():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether the cell holds anything but the clear tile ID, using the solid mask.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the cell is solid or outside the map, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsSolidCell(int nRow, int nCol)
+{
+
+    if ((nRow < 0) || (nRow >= m_nNumRows) || (nCol < 0) || (nCol >= m_nNumCols))
+    {
+        return TRUE;
+    }
+
+    return (m_pSolidMask[(nRow * m_nMaskWords) + (nCol >> 5)] >> (nCol & 31)) & 1;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsSolidArea():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether any cell from the first to the last row and column (inclusive) holds
+//          anything but the clear tile ID. Each row is checked 32 cells at a time.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if any cell is solid or the area reaches outside the map, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsSolidArea(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol)
+{
+
+    if ((nFirstRow < 0) || (nLastRow >= m_nNumRows) || (nFirstCol < 0) ||
+        (nLastCol >= m_nNumCols))
+    {
+        return TRUE;
+    }
+
+    if ((nFirstRow > nLastRow) || (nFirstCol > nLastCol))
+    {
+        return FALSE;
+    }
+
+    int   nFirstWord = nFirstCol >> 5;
+    int   nLastWord  = nLastCol >> 5;
+    DWORD dwFirst    = 0xFFFFFFFF << (nFirstCol & 31);
+    DWORD dwLast     = 0xFFFFFFFF >> (31 - (nLastCol & 31));
+
+    for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+    {
+        const DWORD* pMaskRow = m_pSolidMask + (nRow * m_nMaskWords);
+
+        // Does the area start and end in the same word?
+        if (nFirstWord == nLastWord)
+        {
+            if (pMaskRow[nFirstWord] & dwFirst & dwLast)
+            {
+                return TRUE;
+            }
+            continue;
+        }
+
+        if ((pMaskRow[nFirstWord] & dwFirst) || (pMaskRow[nLastWord] & dwLast))
+        {
+            return TRUE;
+        }
+
+        for (int nWord = nFirstWord + 1; nWord < nLastWord; nWord++)
+        {
+            if (pMaskRow[nWord])
+            {
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsSolid():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether a screen coordinate is on a cell holding anything but the clear tile
+//          ID, using the solid mask.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it is or the coordinate is outside the map, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsSolid(int nCoordX, int nCoordY)
+{
+
+    // Were we unable to convert the screen to map coordinate?
+    if (!this->ScreenToMap(&nCoordX, &nCoordY))
+    {
+        return TRUE;
+    }
+
+    return this->IsSolidCell(nCoordY / m_nTileHeight, nCoordX / m_nTileWidth);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsSolid():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether a source area overlaps any cell holding anything but the clear tile
+//          ID, using the solid mask. An area crossing the edge of a wrapped map is checked on
+//          both sides of the edge.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it does or any part of the area is outside the map, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsSolid(RECT rcSource)
+{
+
+    // An empty area overlaps nothing.
+    if ((rcSource.right <= rcSource.left) || (rcSource.top <= rcSource.bottom))
+    {
+        return FALSE;
+    }
+
+    int nMinX = rcSource.left;
+    int nMinY = rcSource.bottom;
+    int nMaxX = rcSource.right - 1;
+    int nMaxY = rcSource.top - 1;
+
+    // Were we unable to convert both corners to map coordinates?
+    if ((!this->ScreenToMap(&nMinX, &nMinY)) || (!this->ScreenToMap(&nMaxX, &nMaxY)))
+    {
+        return TRUE;
+    }
+
+    int nMapWidth  = m_nNumCols * m_nTileWidth;
+    int nMapHeight = m_nNumRows * m_nTileHeight;
+
+    // An area as wide or as high as a wrapped map covers all of its columns or rows.
+    if ((rcSource.right - rcSource.left) >= nMapWidth)
+    {
+        nMinX = 0;
+        nMaxX = nMapWidth - 1;
+    }
+
+    if ((rcSource.top - rcSource.bottom) >= nMapHeight)
+    {
+        nMinY = 0;
+        nMaxY = nMapHeight - 1;
+    }
+
+    // Split an area wrapped around the right edge of the map in two.
+    if (nMaxX < nMinX)
+    {
+        RECT rcLeft  = rcSource;
+        RECT rcRight = rcSource;
+
+        rcLeft.right = rcSource.left + (nMapWidth - nMinX);
+        rcRight.left = rcLeft.right;
+
+        return (this->IsSolid(rcLeft) || this->IsSolid(rcRight));
+    }
+
+    // Split an area wrapped around the top edge of the map in two.
+    if (nMaxY < nMinY)
+    {
+        RECT rcBottom = rcSource;
+        RECT rcTop    = rcSource;
+
+        rcBottom.top = rcSource.bottom + (nMapHeight - nMinY);
+        rcTop.bottom = rcBottom.top;
+
+        return (this->IsSolid(rcBottom) || this->IsSolid(rcTop));
+    }
+
+    // Count the solid cells with the summed area table, whatever the size of the area.
+    return (this->CountTiles(nMinY / m_nTileHeight, nMaxY / m_nTileHeight, nMinX / m_nTileWidth,
+                             nMaxX / m_nTileWidth, GS_MAP_SOLID) > 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Region Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMap::CountTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Counts the cells from the first to the last row and column (inclusive) holding a
+//          tile ID, or anything but the clear tile ID if the tile class is GS_MAP_SOLID. Cells
+//          outside the map are not counted. Uses the summed area table of the tile class, so
+//          the time taken does not depend on the size of the area.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of cells found.
+//==============================================================================================
+
+int GS_OGLMap::CountTiles(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol,
+                          int nTileClass)
+{
+
+    nFirstRow = (nFirstRow < 0) ? 0 : nFirstRow;
+    nFirstCol = (nFirstCol < 0) ? 0 : nFirstCol;
+    nLastRow  = (nLastRow >= m_nNumRows) ? m_nNumRows - 1 : nLastRow;
+    nLastCol  = (nLastCol >= m_nNumCols) ? m_nNumCols - 1 : nLastCol;
+
+    if ((nFirstRow > nLastRow) || (nFirstCol > nLastCol))
+    {
+        return 0;
+    }
+
+    const int* pnSums = this->GetSumTable(nTileClass);
+
+    if (NULL == pnSums)
+    {
+        return 0;
+    }
+
+    int nPitch = m_nNumCols + 1;
+
+    const int* pnBelow = pnSums + (nFirstRow * nPitch);
+    const int* pnAbove = pnSums + ((nLastRow + 1) * nPitch);
+
+    return pnAbove[nLastCol + 1] - pnAbove[nFirstCol] - pnBelow[nLastCol + 1] +
+           pnBelow[nFirstCol];
+}
+
+
+//==============================================================================================
+// GS_OGLMap::CountTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Counts the cells overlapping a map area (in map pixels) holding a tile ID, or
+//          anything but the clear tile ID if the tile class is GS_MAP_SOLID.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of cells found.
+//==============================================================================================
+
+int GS_OGLMap::CountTiles(RECT rcMapArea, int nTileClass)
+{
+
+    if ((m_nTileWidth <= 0) || (m_nTileHeight <= 0))
+    {
+        return 0;
+    }
+
+    int nMapWidth  = m_nNumCols * m_nTileWidth;
+    int nMapHeight = m_nNumRows * m_nTileHeight;
+
+    // Only the part of the area on the map is counted.
+    int nMinX = (rcMapArea.left < 0) ? 0 : rcMapArea.left;
+    int nMinY = (rcMapArea.bottom < 0) ? 0 : rcMapArea.bottom;
+    int nMaxX = (rcMapArea.right > nMapWidth) ? nMapWidth : rcMapArea.right;
+    int nMaxY = (rcMapArea.top > nMapHeight) ? nMapHeight : rcMapArea.top;
+
+    if ((nMaxX <= nMinX) || (nMaxY <= nMinY))
+    {
+        return 0;
+    }
+
+    return this->CountTiles(nMinY / m_nTileHeight, (nMaxY - 1) / m_nTileHeight,
+                            nMinX / m_nTileWidth, (nMaxX - 1) / m_nTileWidth, nTileClass);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::SplitRange():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the columns (or rows) of the map under a range of map pixels, from the minimum
+//          up to but not including the maximum. On a map that isn't wrapped only the part of
+//          the range on the map is kept, on a wrapped map the range goes around the edge and is
+//          split in two where it does. The parts are stored in the ranges as pairs of the first
+//          and the last column (or row).
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of parts found (0 - 2).
+//==============================================================================================
+
+int GS_OGLMap::SplitRange(int nMin, int nMax, int nTileSize, int nNumCells, BOOL bIsWrapped,
+                          int* pnRanges)
+{
+
+    if ((nMax <= nMin) || (nTileSize <= 0) || (nNumCells <= 0))
+    {
+        return 0;
+    }
+
+    if (!bIsWrapped)
+    {
+        // Only the part of the range on the map is kept.
+        nMin = (nMin < 0) ? 0 : nMin;
+        nMax = (nMax > (nNumCells * nTileSize)) ? nNumCells * nTileSize : nMax;
+
+        if (nMax <= nMin)
+        {
+            return 0;
+        }
+
+        pnRanges[0] = nMin / nTileSize;
+        pnRanges[1] = (nMax - 1) / nTileSize;
+        return 1;
+    }
+
+    // Find the first and the last cell, rounding down for pixels left of (or below) the map.
+    int nFirst = (nMin >= 0) ? nMin / nTileSize : -((nTileSize - 1 - nMin) / nTileSize);
+    int nLast  = (nMax > 0) ? (nMax - 1) / nTileSize : -((nTileSize - nMax) / nTileSize);
+
+    // A range as long as the wrapped map covers all of it.
+    if ((nLast - nFirst) >= (nNumCells - 1))
+    {
+        pnRanges[0] = 0;
+        pnRanges[1] = nNumCells - 1;
+        return 1;
+    }
+
+    // Move the range so it starts on the map.
+    int nStart = nFirst % nNumCells;
+
+    if (nStart < 0)
+    {
+        nStart += nNumCells;
+    }
+
+    nLast += nStart - nFirst;
+
+    pnRanges[0] = nStart;
+
+    if (nLast < nNumCells)
+    {
+        pnRanges[1] = nLast;
+        return 1;
+    }
+
+    // Split a range crossing the edge of the map in two.
+    pnRanges[1] = nNumCells - 1;
+    pnRanges[2] = 0;
+    pnRanges[3] = nLast - nNumCells;
+    return 2;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::CountTilesOnScreen():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Counts the cells of the map under a source area (in screen coordinates) holding a
+//          tile ID, or anything but the clear tile ID if the tile class is GS_MAP_SOLID. Only
+//          the part of the source within the clip box and on the map is counted, going around
+//          the edges of a wrapped map. Also gives the number of cells under that part.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of cells found.
+//==============================================================================================
+
+int GS_OGLMap::CountTilesOnScreen(RECT rcSource, int nTileClass, int* pnNumCells)
+{
+
+    *pnNumCells = 0;
+
+    // Only the part of the source within the clip box is counted.
+    int nMinX = (rcSource.left < m_rcClipBox.left) ? m_rcClipBox.left : rcSource.left;
+    int nMinY = (rcSource.bottom < m_rcClipBox.bottom) ? m_rcClipBox.bottom : rcSource.bottom;
+    int nMaxX = (rcSource.right > m_rcClipBox.right) ? m_rcClipBox.right : rcSource.right;
+    int nMaxY = (rcSource.top > m_rcClipBox.top) ? m_rcClipBox.top : rcSource.top;
+
+    // Convert the source to map pixels and find the columns and rows under it.
+    int nOffsetX = m_nMapCoordX + m_rcClipBox.left;
+    int nOffsetY = m_nMapCoordY + m_rcClipBox.bottom;
+    int nCols[4];
+    int nRows[4];
+
+    int nNumColRanges = this->SplitRange(nMinX - nOffsetX, nMaxX - nOffsetX, m_nTileWidth,
+                                         m_nNumCols, m_bWrapX, nCols);
+    int nNumRowRanges = this->SplitRange(nMinY - nOffsetY, nMaxY - nOffsetY, m_nTileHeight,
+                                         m_nNumRows, m_bWrapY, nRows);
+
+    int nCount = 0;
+
+    for (int nRowRange = 0; nRowRange < nNumRowRanges; nRowRange++)
+    {
+        int nFirstRow = nRows[nRowRange * 2];
+        int nLastRow  = nRows[(nRowRange * 2) + 1];
+
+        for (int nColRange = 0; nColRange < nNumColRanges; nColRange++)
+        {
+            int nFirstCol = nCols[nColRange * 2];
+            int nLastCol  = nCols[(nColRange * 2) + 1];
+
+            nCount += this->CountTiles(nFirstRow, nLastRow, nFirstCol, nLastCol, nTileClass);
+
+            *pnNumCells += (nLastRow - nFirstRow + 1) * (nLastCol - nFirstCol + 1);
+        }
+    }
+
+    return nCount;
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsTileInArea():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether any cell overlapping a map area (in map pixels) holds a tile ID, or
+//          anything but the clear tile ID if the tile class is GS_MAP_SOLID.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it does, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsTileInArea(RECT rcMapArea, int nTileClass)
+{
+
+    return (this->CountTiles(rcMapArea, nTileClass) > 0);
+}
+
+
+//==============================================================================================
+// GS_OGLMap::IsAreaOfTile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether every cell overlapping a map area (in map pixels) holds a tile ID, or
+//          anything but the clear tile ID if the tile class is GS_MAP_SOLID.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if they do, FALSE if not or if the area is empty or reaches outside the map.
+//==============================================================================================
+
+BOOL GS_OGLMap::IsAreaOfTile(RECT rcMapArea, int nTileClass)
+{
+
+    if ((m_nTileWidth <= 0) || (m_nTileHeight <= 0) ||
+        (rcMapArea.right <= rcMapArea.left) || (rcMapArea.top <= rcMapArea.bottom) ||
+        (rcMapArea.left < 0) || (rcMapArea.bottom < 0) ||
+        (rcMapArea.right > m_nNumCols * m_nTileWidth) ||
+        (rcMapArea.top > m_nNumRows * m_nTileHeight))
+    {
+        return FALSE;
+    }
+
+    int nNumCols = ((rcMapArea.right - 1) / m_nTileWidth) - (rcMapArea.left / m_nTileWidth) + 1;
+    int nNumRows = ((rcMapArea.top - 1) / m_nTileHeight) - (rcMapArea.bottom / m_nTileHeight) +
+                   1;
+
+    return (this->CountTiles(rcMapArea, nTileClass) == (nNumRows * nNumCols));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Color Methods. //////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,7 +25,9 @@
 //==============================================================================================
 // Include standard C library header files.
 // ---------------------------------------------------------------------------------------------
+#include <limits.h>
 #include <math.h>
+#include <string.h>
 //==============================================================================================
 
 
@@ -47,17 +49,51 @@
 #include "gs_error.h"
 #include "gs_object.h"
 #include "gs_file.h"
+#include "gs_map_file.h"
 #include "gs_math.h"
 #include "gs_ogl_color.h"
 #include "gs_ogl_sprite_ex.h"
+#include "gs_ogl_extensions.h"
 //==============================================================================================
 
 
 //==============================================================================================
 // Defines.
 // ---------------------------------------------------------------------------------------------
-#define MAX_MAP_COLS 128
-#define MAX_MAP_ROWS 128
+#define GS_MAP_ALIGNMENT 64     // Alignment in bytes of the tile array (a cache line).
+#define GS_MAP_EMPTY_8   0xFF   // Value stored for an empty cell (tile ID -1) in 8 bits
+#define GS_MAP_EMPTY_16  0xFFFF // and in 16 bits, so the highest IDs are 254 and 65534.
+// ---------------------------------------------------------------------------------------------
+#define GS_MAP_SOLID      -2 // Tile class counting every tile but the clear one (see CountTiles).
+#define GS_MAP_SUM_TABLES 4  // Most summed area tables kept at once, the oldest is replaced.
+//==============================================================================================
+
+
+//==============================================================================================
+// Map vertex structure (the cached tile geometry, in unscaled map pixels).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_VERTEX
+{
+    GLfloat fX; // Position of the vertex relative to the bottom left corner of the map.
+    GLfloat fY;
+    GLfloat fU; // Texture coordinates of the vertex.
+    GLfloat fV;
+} GS_MapVertex;
+//==============================================================================================
+
+
+//==============================================================================================
+// Summed area table of a tile class, holding for each cell corner the number of cells of that
+// class below and left of it ((rows + 1) * (cols + 1) values, row by row).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MAP_SUM_TABLE
+{
+    int           nTileClass; // Tile ID counted, or GS_MAP_SOLID.
+    int*          pnSums;     // The sums, NULL if the table is unused.
+    unsigned long ulStamp;    // Map stamp the sums were built at, 0 once a cell of the class
+                              // has changed since.
+    unsigned long ulLastUsed; // Sum clock when the table was last used.
+} GS_MapSumTable;
 //==============================================================================================
 
 
@@ -93,9 +129,44 @@ private:
 
     GS_OGLSpriteEx m_gsTileSprites; // Sprite object to hold tile images.
 
-    int m_nMap[MAX_MAP_ROWS][MAX_MAP_COLS]; // Map array to hold tile IDs.
-    int m_nNumCols;
-    int m_nNumRows;
+    BYTE* m_pMapMemory; // Memory holding the tile IDs (m_pMap is aligned inside it).
+    BYTE* m_pMap;       // Tile IDs row by row, the bottom row first.
+    int   m_nTileBytes; // Size of each tile ID in bytes (1 or 2).
+    int   m_nNumCols;
+    int   m_nNumRows;
+
+    DWORD* m_pSolidMask; // A bit per cell, set if it is not the clear tile, row by row.
+    int    m_nMaskWords; // Number of 32 bit words per row of the solid mask.
+
+    GS_MapSumTable m_gsSumTables[GS_MAP_SUM_TABLES]; // Tables built when first queried.
+    unsigned long  m_ulMapStamp; // Changed whenever the map is allocated, outdating all tables.
+    unsigned long  m_ulSumClock; // Counts table queries, to find the oldest table.
+
+    BOOL AllocateMap(int nNumRows, int nNumCols, int nTileBytes);
+    void FreeMap();
+    BOOL WidenMap();
+    void BuildSolidMask();
+    void FreeSumTables();
+    void InvalidateSumTables(int nTileClass);
+    int* GetSumTable(int nTileClass);
+    int  SplitRange(int nMin, int nMax, int nTileSize, int nNumCells, BOOL bIsWrapped,
+                    int* pnRanges);
+    int  CountTilesOnScreen(RECT rcSource, int nTileClass, int* pnNumCells);
+
+    int GetCell(int nRow, int nCol)
+    {
+        int nIndex = (nRow * m_nNumCols) + nCol;
+
+        if (m_nTileBytes == 1)
+        {
+            return (m_pMap[nIndex] == GS_MAP_EMPTY_8) ? -1 : m_pMap[nIndex];
+        }
+
+        WORD wTileID = ((WORD*) m_pMap)[nIndex];
+        return (wTileID == GS_MAP_EMPTY_16) ? -1 : wTileID;
+    }
+
+    BOOL SetCell(int nRow, int nCol, int nTileID);
 
     RECT m_rcClipBox; // Rectangle structure containing the viewport coordinates.
 
@@ -114,6 +185,24 @@ private:
 
     BOOL m_bIsReady; // Wether we are ready to render or not.
 
+    GS_MapVertex* m_pVertices;       // Cached tile geometry, four vertices per map cell.
+    int           m_nNumVertices;    // Number of vertices in the cached geometry.
+    GLuint        m_gluVertexBuffer; // Vertex buffer object holding the cached geometry.
+    GLuint        m_gluDisplayList;  // Display list holding the geometry if there are no VBOs.
+    BOOL          m_bIsGeometryDirty; // Wether the geometry has to be rebuilt before rendering.
+    BOOL          m_bIsListDirty;     // Wether the display list has to be recompiled.
+
+    void SetCellVertices(int nRow, int nCol);
+    void BuildGeometry();
+    void UpdateGeometry(int nRow, int nCol);
+    void DestroyGeometry();
+    BOOL BeginGeometry(HWND hWnd);
+    BOOL GetVisibleCells(int nMapCoordX, int nMapCoordY, int* pnFirstRow, int* pnLastRow,
+                         int* pnFirstCol, int* pnLastCol);
+    void DrawGeometry(int nMapCoordX, int nMapCoordY);
+    void DrawCells(int nFirstVertex, int nNumVertices, GLfloat glfOffsetX, GLfloat glfOffsetY);
+    void EndGeometry(HWND hWnd);
+
 protected:
 
     // ...
@@ -153,8 +242,12 @@ public:
 
     // Map methods.
 
-    BOOL LoadMap(const char* pszPathname, int nNumRows, int nNumCols);
-    BOOL SaveMap(const char* pszPathname = NULL);
+    BOOL LoadMap(const char* pszPathname, int nNumRows = 0, int nNumCols = 0);
+    BOOL LoadMap(GS_MapFile* pgsMapFile);
+    BOOL SaveMap(const char* pszPathname = NULL, BOOL bBinary = FALSE);
+    BOOL SetTiles(const int* pnTileIDs, int nNumRows, int nNumCols);
+
+    int  GetMemoryUsage();
 
     void SetMapX(int nDestX);
     void SetMapY(int nDestY);
@@ -220,6 +313,18 @@ public:
     BOOL IsOnArea(RECT rcSource, RECT rcMapArea);
     BOOL IsInArea(RECT rcSource, RECT rcMapArea);
 
+    BOOL IsSolidCell(int nRow, int nCol);
+    BOOL IsSolidArea(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol);
+    BOOL IsSolid(int nCoordX, int nCoordY);
+    BOOL IsSolid(RECT rcSource);
+
+    // Region methods.
+
+    int  CountTiles(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol, int nTileClass);
+    int  CountTiles(RECT rcMapArea, int nTileClass);
+    BOOL IsTileInArea(RECT rcMapArea, int nTileClass);
+    BOOL IsAreaOfTile(RECT rcMapArea, int nTileClass);
+
     // Color methods.
 
     void GetModulateColor(GS_OGLColor* pgsColor);
@@ -42,6 +42,15 @@ GS_OGLMenu::GS_OGLMenu()
     m_nHighlightOption = -1;
 
     m_pszTitleString = NULL;
+
+    m_pVertices = NULL;
+
+    m_nNumVertsAllocated       = 0;
+    m_nNumFrameVertices        = 0;
+    m_nNumHighlightVertices    = 0;
+    m_nNumHighlightBarVertices = 0;
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -167,6 +176,49 @@ BOOL GS_OGLMenu::Create(const char* pszMenuPathname, GLuint glFontTexture, int n
 }
 
 
+//==============================================================================================
+// GS_OGLMenu::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the menu with a font using a shared texture object (which may have been
+//          packed into a texture atlas).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMenu::Create(const char* pszMenuPathname, GS_OGLTexture& gsFontTexture,
+                        int nTilesPerLine, int nTileWidth, int nTileHeight, BOOL bFiltered,
+                        BOOL bMipmap)
+{
+
+    BOOL bResult;
+
+    // Create the tiled sprite that will be used to render the menu.
+    bResult = m_gsMenuSprite.Create(pszMenuPathname, MENU_TILES, MENU_TILES_PER_LINE,
+                                    nTileWidth, nTileHeight, bFiltered, bMipmap);
+
+    // Exit if failed.
+    if (bResult != TRUE)
+    {
+        GS_Error::Report("GS_OGL_MENU.CPP", 190, "Failed to create menu sprite!");
+        return FALSE;
+    }
+
+    // Create the font that will be used to render the menu title and options.
+    bResult = m_gsMenuFont.Create(gsFontTexture, nTilesPerLine, nTileWidth, nTileHeight);
+
+    // Exit if failed.
+    if (bResult != TRUE)
+    {
+        GS_Error::Report("GS_OGL_MENU.CPP", 200, "Failed to create menu font!");
+        return FALSE;
+    }
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -209,6 +261,19 @@ void GS_OGLMenu::Destroy()
 
     m_nHighlightOption = -1;
 
+    if (m_pVertices)
+    {
+        delete[] m_pVertices;
+    }
+    m_pVertices = NULL;
+
+    m_nNumVertsAllocated       = 0;
+    m_nNumFrameVertices        = 0;
+    m_nNumHighlightVertices    = 0;
+    m_nNumHighlightBarVertices = 0;
+
+    m_bIsGeometryDirty = TRUE;
+
     m_bIsReady = FALSE;
 }
 
@@ -238,160 +303,105 @@ BOOL GS_OGLMenu::Render(HWND hWnd)
         return FALSE;
     }
 
-    // Setup variables that will be used to render the menu.
-    int nRows    = this->GetRows();
-    int nColumns = this->GetCols();
-
-    int nHighlightRow;
-
-    float fWidth  =  this->GetCols() * m_gsMenuSprite.GetFrameWidth();
+    // Setup variables that will be used to render the menu text.
     float fHeight = this->GetRows() * m_gsMenuSprite.GetFrameHeight();
 
     float fTileWidth  = m_gsMenuSprite.GetFrameWidth();
     float fTileHeight = m_gsMenuSprite.GetFrameHeight();
 
+    int yLoop;
+
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Render the menu. /////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Render top left corner.
-    m_gsMenuSprite.SetFrame(MENU_TOP_LEFT);
-    m_gsMenuSprite.SetDestX(m_lDestX);
-    m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render top right corner.
-    m_gsMenuSprite.SetFrame(MENU_TOP_RIGHT);
-    m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-    m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render bottom left corner.
-    m_gsMenuSprite.SetFrame(MENU_BOTTOM_LEFT);
-    m_gsMenuSprite.SetDestX(m_lDestX);
-    m_gsMenuSprite.SetDestY(m_lDestY);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render bottom right corner.
-    m_gsMenuSprite.SetFrame(MENU_BOTTOM_RIGHT);
-    m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-    m_gsMenuSprite.SetDestY(m_lDestY);
-    m_gsMenuSprite.Render(hWnd);
+    // Render the frame, background and highlight (with the highlight bar).
+    if (!this->RenderFrame(TRUE, hWnd))
+    {
+        return FALSE;
+    }
 
-    int xLoop, yLoop;
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Render the menu text. ////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Render the top and bottom borders.
-    for (xLoop = 1; xLoop < (nColumns - 1); xLoop++)
+    // Render the title if any.
+    if (m_pszTitleString)
     {
-        // Render top border.
-        m_gsMenuSprite.SetFrame(MENU_TOP);
-        m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-        m_gsMenuSprite.Render(hWnd);
-        // Render bottom border.
-        m_gsMenuSprite.SetFrame(MENU_BOTTOM);
-        m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-        m_gsMenuSprite.SetDestY(m_lDestY);
-        m_gsMenuSprite.Render(hWnd);
+        m_gsMenuFont.SetText(m_pszTitleString);
+        m_gsMenuFont.SetDestX(m_lDestX + fTileWidth);
+        m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*2));
+        m_gsMenuFont.Render(hWnd);
     }
 
-    // Render the left and right borders.
-    for (yLoop = 1; yLoop < (nRows - 1); yLoop++)
+    // Render the menu options.
+    for (yLoop = 0; yLoop < m_gsOptionList.GetNumItems(); yLoop++)
     {
-        // Determine wether to render the left seperator.
-        if ((m_pszTitleString) && (yLoop==2))
-        {
-            m_gsMenuSprite.SetFrame(MENU_SEPERATOR_LEFT);
-        }
-        else
-        {
-            m_gsMenuSprite.SetFrame(MENU_LEFT);
-        }
-        // Render left border or seperator.
-        m_gsMenuSprite.SetDestX(m_lDestX);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
-        // Determine wether to render the right seperator.
-        if ((m_pszTitleString) && (yLoop==2))
+        // Get the option text to render.
+        m_gsMenuFont.SetText(m_gsOptionList[yLoop]);
+        // Determine the destination coordinates.
+        m_gsMenuFont.SetDestX(m_lDestX + fTileWidth);
+        if (m_pszTitleString)
         {
-            m_gsMenuSprite.SetFrame(MENU_SEPERATOR_RIGHT);
+            m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*(yLoop+4)));
         }
         else
         {
-            m_gsMenuSprite.SetFrame(MENU_RIGHT);
+            m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*(yLoop+2)));
         }
-        // Render right border or seperator.
-        m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
+        // Render the option text.
+        m_gsMenuFont.Render(hWnd);
     }
 
+    return TRUE;
+}
 
-    // Render the menu background and seperator.
-    for (xLoop = 1; xLoop < (nColumns - 1); xLoop++)
-    {
-        for (yLoop = 1; yLoop < (nRows - 1); yLoop++)
-        {
-            // Determine wether to render menu background or seperator.
-            if ((m_pszTitleString) && (yLoop==2))
-            {
-                m_gsMenuSprite.SetFrame(MENU_SEPERATOR);
-            }
-            else
-            {
-                m_gsMenuSprite.SetFrame(MENU_BACKGROUND);
-            }
-            // Render menu background or seperator.
-            m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-            m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-            m_gsMenuSprite.Render(hWnd);
-        }
-    }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Render the menu highlight.////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMenu::Render():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMenu::Render(GS_OGLColor gsNormalColor, GS_OGLColor gsHighlightColor, HWND hWnd)
+{
 
-    // Render highlight only if valid option is highlighted.
-    if (m_nHighlightOption >= 0)
+    // Exit if menu not created.
+    if (!m_bIsReady)
     {
+        return FALSE;
+    }
 
-        // Determine which row to highlight.
-        if (m_pszTitleString)
-        {
-            nHighlightRow = (3 + m_nHighlightOption);
-        }
-        else
-        {
-            nHighlightRow = (1 + m_nHighlightOption);
-        }
+    // Setup variables that will be used to render the menu text.
+    float fHeight = this->GetRows() * m_gsMenuSprite.GetFrameHeight();
+
+    float fTileWidth  = m_gsMenuSprite.GetFrameWidth();
+    float fTileHeight = m_gsMenuSprite.GetFrameHeight();
 
-        // Render the left highlight.
-        m_gsMenuSprite.SetFrame(MENU_HIGHLIGHT_LEFT);
-        m_gsMenuSprite.SetDestX(m_lDestX);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((nHighlightRow+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
+    int yLoop;
 
-        // Render the highlighted row.
-        for (xLoop = 1; xLoop <= lstrlen(m_gsOptionList[m_nHighlightOption]); xLoop++)
-        {
-            m_gsMenuSprite.SetFrame(MENU_HIGHLIGHT);
-            m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-            m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((nHighlightRow+1) * fTileHeight));
-            m_gsMenuSprite.Render(hWnd);
-        }
+    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Render the menu. /////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////
 
-        // Render the right highlight.
-        m_gsMenuSprite.SetFrame(MENU_HIGHLIGHT_RIGHT);
-        m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((nHighlightRow+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
+    // Render the frame, background and highlight (without the highlight bar).
+    if (!this->RenderFrame(FALSE, hWnd))
+    {
+        return FALSE;
     }
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Render the menu text. ////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 
+    // Reset the modulate color for the title.
+    m_gsMenuFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+
     // Render the title if any.
     if (m_pszTitleString)
     {
@@ -404,6 +414,16 @@ BOOL GS_OGLMenu::Render(HWND hWnd)
     // Render the menu options.
     for (yLoop = 0; yLoop < m_gsOptionList.GetNumItems(); yLoop++)
     {
+        // Render options using the normal color.
+        if (m_nHighlightOption >= 0)
+        {
+            m_gsMenuFont.SetModulateColor(gsNormalColor);
+        }
+        // Render the higlighted option in the highlight color.
+        if (yLoop == m_nHighlightOption)
+        {
+            m_gsMenuFont.SetModulateColor(gsHighlightColor);
+        }
         // Get the option text to render.
         m_gsMenuFont.SetText(m_gsOptionList[yLoop]);
         // Determine the destination coordinates.
@@ -428,203 +448,340 @@ BOOL GS_OGLMenu::Render(HWND hWnd)
 
 
 //==============================================================================================
-// GS_OGLMenu::Render():
+// GS_OGLMenu::AllocateVertices():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Makes sure the vertex array has room for the specified number of vertices.
 // ---------------------------------------------------------------------------------------------
-// Returns: TRUE if successfull, FALSE if failed.
+// Returns: TRUE if successfull, FALSE if not.
 //==============================================================================================
 
-BOOL GS_OGLMenu::Render(GS_OGLColor gsNormalColor, GS_OGLColor gsHighlightColor, HWND hWnd)
+BOOL GS_OGLMenu::AllocateVertices(int nNumVertices)
 {
 
-    // Exit if menu not created.
-    if (!m_bIsReady)
+    if (nNumVertices <= m_nNumVertsAllocated)
+    {
+        return TRUE;
+    }
+
+    if (m_pVertices)
+    {
+        delete[] m_pVertices;
+    }
+
+    m_nNumVertsAllocated = 0;
+
+    m_pVertices = new GS_MenuVertex[nNumVertices];
+
+    if (!m_pVertices)
     {
+        GS_Error::Report("GS_OGL_MENU.CPP", 477, "Failed to allocate menu vertices!");
         return FALSE;
     }
 
-    // Setup variables that will be used to render the menu.
+    m_nNumVertsAllocated = nNumVertices;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMenu::AddTile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Fills in the four vertices of a tile of the menu at the specified position relative
+//          to the bottom left of the menu.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLMenu::AddTile(int nFrame, GLfloat glfX, GLfloat glfY, GS_MenuVertex* pVertex)
+{
+
+    RECT rcFrame;
+    m_gsMenuSprite.GetFrameRect(nFrame, &rcFrame);
+
+    GLfloat glfLeft   = m_gsMenuSprite.GetTexCoordU((GLfloat) rcFrame.left);
+    GLfloat glfBottom = m_gsMenuSprite.GetTexCoordV((GLfloat) rcFrame.bottom);
+    GLfloat glfRight  = m_gsMenuSprite.GetTexCoordU((GLfloat) rcFrame.right);
+    GLfloat glfTop    = m_gsMenuSprite.GetTexCoordV((GLfloat) rcFrame.top);
+
+    GLfloat glfWidth  = m_gsMenuSprite.GetFrameWidth();
+    GLfloat glfHeight = m_gsMenuSprite.GetFrameHeight();
+
+    // Bottom left, bottom right, top right and top left.
+    pVertex[0].fX = glfX;            pVertex[0].fY = glfY;
+    pVertex[0].fU = glfLeft;         pVertex[0].fV = glfBottom;
+    pVertex[1].fX = glfX + glfWidth; pVertex[1].fY = glfY;
+    pVertex[1].fU = glfRight;        pVertex[1].fV = glfBottom;
+    pVertex[2].fX = glfX + glfWidth; pVertex[2].fY = glfY + glfHeight;
+    pVertex[2].fU = glfRight;        pVertex[2].fV = glfTop;
+    pVertex[3].fX = glfX;            pVertex[3].fY = glfY + glfHeight;
+    pVertex[3].fU = glfLeft;         pVertex[3].fV = glfTop;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMenu::BuildGeometry():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds the quads of the frame, background, title seperator and highlight. This is
+//          only done when the options, title, scale or highlight have changed, as the position
+//          of the menu and the display scaling are applied when it is drawn.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLMenu::BuildGeometry()
+{
+
     int nRows    = this->GetRows();
     int nColumns = this->GetCols();
 
-    float fWidth  =  this->GetCols() * m_gsMenuSprite.GetFrameWidth();
-    float fHeight = this->GetRows() * m_gsMenuSprite.GetFrameHeight();
+    float fWidth  = nColumns * m_gsMenuSprite.GetFrameWidth();
+    float fHeight = nRows    * m_gsMenuSprite.GetFrameHeight();
 
     float fTileWidth  = m_gsMenuSprite.GetFrameWidth();
     float fTileHeight = m_gsMenuSprite.GetFrameHeight();
 
-    int nHighlightRow;
+    int nHighlightRow = -1;
+    int nBarLength    = 0;
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Render the menu. /////////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    // Determine which row to highlight, if any.
+    if ((m_nHighlightOption >= 0) && (m_nHighlightOption < m_gsOptionList.GetNumItems()))
+    {
+        if (m_pszTitleString)
+        {
+            nHighlightRow = (3 + m_nHighlightOption);
+        }
+        else
+        {
+            nHighlightRow = (1 + m_nHighlightOption);
+        }
 
-    // Render top left corner.
-    m_gsMenuSprite.SetFrame(MENU_TOP_LEFT);
-    m_gsMenuSprite.SetDestX(m_lDestX);
-    m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render top right corner.
-    m_gsMenuSprite.SetFrame(MENU_TOP_RIGHT);
-    m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-    m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render bottom left corner.
-    m_gsMenuSprite.SetFrame(MENU_BOTTOM_LEFT);
-    m_gsMenuSprite.SetDestX(m_lDestX);
-    m_gsMenuSprite.SetDestY(m_lDestY);
-    m_gsMenuSprite.Render(hWnd);
-
-    // Render bottom right corner.
-    m_gsMenuSprite.SetFrame(MENU_BOTTOM_RIGHT);
-    m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-    m_gsMenuSprite.SetDestY(m_lDestY);
-    m_gsMenuSprite.Render(hWnd);
+        nBarLength = lstrlen(m_gsOptionList[m_nHighlightOption]);
+    }
 
-    int xLoop, yLoop;
+    int nNumQuads = nRows * nColumns;
 
-    // Render the top and bottom borders.
-    for (xLoop = 1; xLoop < (nColumns - 1); xLoop++)
+    if (nHighlightRow >= 0)
     {
-        // Render top border.
-        m_gsMenuSprite.SetFrame(MENU_TOP);
-        m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - fTileHeight);
-        m_gsMenuSprite.Render(hWnd);
-        // Render bottom border.
-        m_gsMenuSprite.SetFrame(MENU_BOTTOM);
-        m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-        m_gsMenuSprite.SetDestY(m_lDestY);
-        m_gsMenuSprite.Render(hWnd);
+        nNumQuads += 2 + nBarLength;
     }
 
-    // Render the left and right borders.
-    for (yLoop = 1; yLoop < (nRows - 1); yLoop++)
+    if (!this->AllocateVertices(nNumQuads * 4))
     {
-        // Determine wether to render the left seperator.
-        if ((m_pszTitleString) && (yLoop==2))
-        {
-            m_gsMenuSprite.SetFrame(MENU_SEPERATOR_LEFT);
-        }
-        else
-        {
-            m_gsMenuSprite.SetFrame(MENU_LEFT);
-        }
-        // Render left border or seperator.
-        m_gsMenuSprite.SetDestX(m_lDestX);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
-        // Determine wether to render the right seperator.
-        if ((m_pszTitleString) && (yLoop==2))
-        {
-            m_gsMenuSprite.SetFrame(MENU_SEPERATOR_RIGHT);
-        }
-        else
-        {
-            m_gsMenuSprite.SetFrame(MENU_RIGHT);
-        }
-        // Render right border or seperator.
-        m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
+        return FALSE;
     }
 
+    GS_MenuVertex* pVertex = m_pVertices;
 
-    // Render the menu background and seperator.
-    for (xLoop = 1; xLoop < (nColumns - 1); xLoop++)
+    int xLoop, yLoop;
+    int nFrame;
+
+    // The frame and background, row by row from the top. Positions are rounded down to whole
+    // pixels like GS_OGLSprite::SetDestX() and SetDestY() do.
+    for (yLoop = 0; yLoop < nRows; yLoop++)
     {
-        for (yLoop = 1; yLoop < (nRows - 1); yLoop++)
+        GLfloat glfY = (GLfloat) long(fHeight - ((yLoop + 1) * fTileHeight));
+
+        for (xLoop = 0; xLoop < nColumns; xLoop++)
         {
-            // Determine wether to render menu background or seperator.
-            if ((m_pszTitleString) && (yLoop==2))
+            GLfloat glfX = (GLfloat) long(xLoop * fTileWidth);
+
+            if (yLoop == 0)
+            {
+                nFrame = (xLoop == 0) ? MENU_TOP_LEFT :
+                         (xLoop == nColumns - 1) ? MENU_TOP_RIGHT : MENU_TOP;
+            }
+            else if (yLoop == nRows - 1)
+            {
+                nFrame = (xLoop == 0) ? MENU_BOTTOM_LEFT :
+                         (xLoop == nColumns - 1) ? MENU_BOTTOM_RIGHT : MENU_BOTTOM;
+            }
+            else if ((m_pszTitleString) && (yLoop == 2))
             {
-                m_gsMenuSprite.SetFrame(MENU_SEPERATOR);
+                nFrame = (xLoop == 0) ? MENU_SEPERATOR_LEFT :
+                         (xLoop == nColumns - 1) ? MENU_SEPERATOR_RIGHT : MENU_SEPERATOR;
             }
             else
             {
-                m_gsMenuSprite.SetFrame(MENU_BACKGROUND);
+                nFrame = (xLoop == 0) ? MENU_LEFT :
+                         (xLoop == nColumns - 1) ? MENU_RIGHT : MENU_BACKGROUND;
             }
-            // Render menu background or seperator.
-            m_gsMenuSprite.SetDestX(m_lDestX + (xLoop * fTileWidth));
-            m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((yLoop+1) * fTileHeight));
-            m_gsMenuSprite.Render(hWnd);
+
+            this->AddTile(nFrame, glfX, glfY, pVertex);
+            pVertex += 4;
         }
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Render the menu highlight.////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    m_nNumFrameVertices        = nRows * nColumns * 4;
+    m_nNumHighlightVertices    = 0;
+    m_nNumHighlightBarVertices = 0;
 
-    // Render highlight only if valid option is highlighted.
-    if (m_nHighlightOption >= 0)
+    // The ends of the highlight, followed by the bar under the highlighted option.
+    if (nHighlightRow >= 0)
     {
-        // Determine which row to highlight.
-        if (m_pszTitleString)
+        GLfloat glfY = (GLfloat) long(fHeight - ((nHighlightRow + 1) * fTileHeight));
+
+        this->AddTile(MENU_HIGHLIGHT_LEFT, 0.0f, glfY, pVertex);
+        pVertex += 4;
+
+        this->AddTile(MENU_HIGHLIGHT_RIGHT, (GLfloat) long(fWidth - fTileWidth), glfY, pVertex);
+        pVertex += 4;
+
+        for (xLoop = 1; xLoop <= nBarLength; xLoop++)
         {
-            nHighlightRow = (3 + m_nHighlightOption);
+            this->AddTile(MENU_HIGHLIGHT, (GLfloat) long(xLoop * fTileWidth), glfY, pVertex);
+            pVertex += 4;
         }
-        else
+
+        m_nNumHighlightVertices    = 8;
+        m_nNumHighlightBarVertices = nBarLength * 4;
+    }
+
+    m_bIsGeometryDirty = FALSE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLMenu::RenderFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the frame, background and highlight of the menu with a single draw call (or
+//          adds them to the active sprite batch), building the quads first if necessary. The
+//          highlight bar behind the highlighted option is only drawn if specified.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if failed.
+//==============================================================================================
+
+BOOL GS_OGLMenu::RenderFrame(BOOL bHighlightBar, HWND hWnd)
+{
+
+    if (m_bIsGeometryDirty)
+    {
+        if (!this->BuildGeometry())
         {
-            nHighlightRow = (1 + m_nHighlightOption);
+            return FALSE;
         }
-        // Render the left highlight.
-        m_gsMenuSprite.SetFrame(MENU_HIGHLIGHT_LEFT);
-        m_gsMenuSprite.SetDestX(m_lDestX);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((nHighlightRow+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
-        // Render the right highlight.
-        m_gsMenuSprite.SetFrame(MENU_HIGHLIGHT_RIGHT);
-        m_gsMenuSprite.SetDestX(m_lDestX + fWidth - fTileWidth);
-        m_gsMenuSprite.SetDestY(m_lDestY + fHeight - ((nHighlightRow+1) * fTileHeight));
-        m_gsMenuSprite.Render(hWnd);
     }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////
-    // Render the menu text. ////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////////////////////////////
+    int nNumVertices = m_nNumFrameVertices + m_nNumHighlightVertices;
 
-    // Reset the modulate color for the title.
-    m_gsMenuFont.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+    if (bHighlightBar)
+    {
+        nNumVertices += m_nNumHighlightBarVertices;
+    }
 
-    // Render the title if any.
-    if (m_pszTitleString)
+    if (nNumVertices <= 0)
     {
-        m_gsMenuFont.SetText(m_pszTitleString);
-        m_gsMenuFont.SetDestX(m_lDestX + fTileWidth);
-        m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*2));
-        m_gsMenuFont.Render(hWnd);
+        return TRUE;
     }
 
-    // Render the menu options.
-    for (yLoop = 0; yLoop < m_gsOptionList.GetNumItems(); yLoop++)
+    GS_OGLColor gsColor;
+    m_gsMenuSprite.GetModulateColor(&gsColor);
+
+    // Screen position of the bottom left of the menu.
+    GLfloat glfDestX = (m_lDestX * g_fScaleFactorX) + g_fRenderModX;
+    GLfloat glfDestY = (m_lDestY * g_fScaleFactorY) + g_fRenderModY;
+
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    if ((hWnd == NULL) && (pgsBatch != NULL))
     {
-        // Render options using the normal color.
-        if (m_nHighlightOption >= 0)
-        {
-            m_gsMenuFont.SetModulateColor(gsNormalColor);
-        }
-        // Render the higlighted option in the highlight color.
-        if (yLoop == m_nHighlightOption)
-        {
-            m_gsMenuFont.SetModulateColor(gsHighlightColor);
-        }
-        // Get the option text to render.
-        m_gsMenuFont.SetText(m_gsOptionList[yLoop]);
-        // Determine the destination coordinates.
-        m_gsMenuFont.SetDestX(m_lDestX + fTileWidth);
-        if (m_pszTitleString)
+        GLfloat glfVertices[8];
+        GLfloat glfTexCoords[8];
+
+        GS_MenuVertex* pVertex = m_pVertices;
+
+        for (int nLoop = 0; nLoop < nNumVertices; nLoop += 4)
         {
-            m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*(yLoop+4)));
+            for (int nCorner = 0; nCorner < 4; nCorner++)
+            {
+                glfVertices[nCorner * 2]        = glfDestX + (pVertex[nCorner].fX * g_fScaleFactorX);
+                glfVertices[(nCorner * 2) + 1]  = glfDestY + (pVertex[nCorner].fY * g_fScaleFactorY);
+                glfTexCoords[nCorner * 2]       = pVertex[nCorner].fU;
+                glfTexCoords[(nCorner * 2) + 1] = pVertex[nCorner].fV;
+            }
+
+            if (!pgsBatch->AddQuad(m_gsMenuSprite.GetTextureID(), GS_BLEND_DEFAULT, glfVertices,
+                                   glfTexCoords, gsColor))
+            {
+                return FALSE;
+            }
+
+            pVertex += 4;
         }
-        else
+
+        return TRUE;
+    }
+
+    // Setup display for 2D rendering (drawing any batched quads first).
+    if (hWnd != NULL)
+    {
+        GS_OGLSpriteBatch::FlushActive();
+        m_gsMenuSprite.BeginRender(hWnd);
+    }
+
+    // The shader renderer gets the tiles as quads in screen coordinates.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GLfloat glfVertices[8];
+        GLfloat glfTexCoords[8];
+
+        GS_MenuVertex* pVertex = m_pVertices;
+
+        for (int nLoop = 0; nLoop < nNumVertices; nLoop += 4)
         {
-            m_gsMenuFont.SetDestY(m_lDestY + fHeight - (fTileHeight*(yLoop+2)));
+            for (int nCorner = 0; nCorner < 4; nCorner++)
+            {
+                glfVertices[nCorner * 2]        = glfDestX + (pVertex[nCorner].fX * g_fScaleFactorX);
+                glfVertices[(nCorner * 2) + 1]  = glfDestY + (pVertex[nCorner].fY * g_fScaleFactorY);
+                glfTexCoords[nCorner * 2]       = pVertex[nCorner].fU;
+                glfTexCoords[(nCorner * 2) + 1] = pVertex[nCorner].fV;
+            }
+
+            GS_OGLCoreRenderer::DrawQuad(m_gsMenuSprite.GetTextureID(), glfVertices,
+                                         glfTexCoords, gsColor);
+
+            pVertex += 4;
         }
-        // Render the option text.
-        m_gsMenuFont.Render(hWnd);
+    }
+    else
+    {
+        // Position the menu.
+        glLoadIdentity();
+        glTranslatef(glfDestX, glfDestY, 0.0f);
+        glScalef(g_fScaleFactorX, g_fScaleFactorY, 1.0f);
+
+        GS_OGLState::SetColor(gsColor.fRed, gsColor.fGreen, gsColor.fBlue, gsColor.fAlpha);
+        GS_OGLState::BindTexture(m_gsMenuSprite.GetTextureID());
+
+        // Draw all the tiles at once.
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        glVertexPointer(2, GL_FLOAT, sizeof(GS_MenuVertex), &m_pVertices[0].fX);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_MenuVertex), &m_pVertices[0].fU);
+
+        glDrawArrays(GL_QUADS, 0, nNumVertices);
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        m_gsMenuSprite.EndRender();
     }
 
     return TRUE;
@@ -665,6 +822,8 @@ BOOL GS_OGLMenu::AddOption(const char* pszOptionString)
     // Add the option to the list.
     m_gsOptionList.AddItem(pszTempString);
 
+    m_bIsGeometryDirty = TRUE;
+
     return TRUE;
 }
 
@@ -699,6 +858,8 @@ BOOL GS_OGLMenu::RemoveOption(int nIndex)
     // Remove option indicated by index from list.
     m_gsOptionList.RemoveIndex(nIndex);
 
+    m_bIsGeometryDirty = TRUE;
+
     return TRUE;
 }
 
@@ -739,6 +900,8 @@ BOOL GS_OGLMenu::SetOption(int nIndex, const char* pszOptionString)
     // Set the item indicated to the new value.
     m_gsOptionList.SetItem(nIndex, pszTempString);
 
+    m_bIsGeometryDirty = TRUE;
+
     return TRUE;
 }
 
@@ -860,6 +1023,8 @@ void GS_OGLMenu::ClearOptions()
 
     // Remove all the options from the list.
     m_gsOptionList.RemoveAllItems();
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -904,6 +1069,8 @@ void GS_OGLMenu::SetHighlight(int nIndex)
     }
 
     m_nHighlightOption = nIndex;
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -983,6 +1150,8 @@ void GS_OGLMenu::HighlightNext(BOOL bSkipEmpty)
             }
         }
     }
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1032,6 +1201,8 @@ void GS_OGLMenu::HighlightPrev(BOOL bSkipEmpty)
             }
         }
     }
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1108,6 +1279,8 @@ void GS_OGLMenu::SetTitle(const char* pszTextString)
         strcpy(m_pszTitleString, pszTextString);       // Assign the string to the class string.
         m_pszTitleString[nStringLength-1] = '\0';      // End the title string with a NULL;
     }
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1207,6 +1380,8 @@ void GS_OGLMenu::SetScaleXY(float glfScaleX, float glfScaleY)
 
     m_gsMenuSprite.SetScaleXY(glfScaleX, glfScaleY);
     m_gsMenuFont.SetScaleXY(glfScaleX, glfScaleY);
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1244,6 +1419,8 @@ void GS_OGLMenu::SetScaleX(float glfScaleX)
 
     m_gsMenuSprite.SetScaleX(glfScaleX);
     m_gsMenuFont.SetScaleX(glfScaleX);
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -1281,6 +1458,8 @@ void GS_OGLMenu::SetScaleY(float glfScaleY)
 
     m_gsMenuSprite.SetScaleY(glfScaleY);
     m_gsMenuFont.SetScaleY(glfScaleY);
+
+    m_bIsGeometryDirty = TRUE;
 }
 
 
@@ -72,6 +72,19 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Menu vertex structure (relative to the menu position, interleaved for vertex arrays).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_MENU_VERTEX
+{
+    GLfloat fX; // Position of the vertex relative to the bottom left of the menu.
+    GLfloat fY;
+    GLfloat fU; // Texture coordinates of the vertex.
+    GLfloat fV;
+} GS_MenuVertex;
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +109,18 @@ private:
 
     int m_nHighlightOption;
 
+    GS_MenuVertex* m_pVertices;       // Frame and highlight quads of the menu.
+    int m_nNumVertsAllocated;         // Number of vertices for which space has been allocated.
+    int m_nNumFrameVertices;          // Number of vertices in the frame and background.
+    int m_nNumHighlightVertices;      // Number of vertices in the ends of the highlight bar.
+    int m_nNumHighlightBarVertices;   // Number of vertices in the middle of the highlight bar.
+    BOOL m_bIsGeometryDirty;          // Wether the quads need to be built again.
+
+    BOOL AllocateVertices(int nNumVertices);
+    void AddTile(int nFrame, GLfloat glfX, GLfloat glfY, GS_MenuVertex* pVertex);
+    BOOL BuildGeometry();
+    BOOL RenderFrame(BOOL bHighlightBar, HWND hWnd);
+
 protected:
 
     // ...
@@ -110,6 +135,8 @@ public:
     BOOL Create(const char* pszMenuPathname, GLuint glFontTexture, int nWidth, int nHeight,
                 int nTilesPerLine, int nTileWidth, int nTileHeight, BOOL bFiltered = FALSE,
                 BOOL bMipmap = TRUE);
+    BOOL Create(const char* pszMenuPathname, GS_OGLTexture& gsFontTexture, int nTilesPerLine,
+                int nTileWidth, int nTileHeight, BOOL bFiltered = FALSE, BOOL bMipmap = TRUE);
     void Destroy();
 
     BOOL Render(HWND hWnd = NULL);
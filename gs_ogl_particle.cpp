@@ -46,21 +46,21 @@ GS_OGLParticle::GS_OGLParticle()
     m_gliWidth  = 0;
     m_gliHeight = 0;
 
-    for (int nLoop = 0; nLoop < MAX_PARTICLES; nLoop++)
-    {
-        m_gsParticles[nLoop].bIsActive = FALSE;
-        m_gsParticles[nLoop].gliDestX = 0;
-        m_gsParticles[nLoop].gliDestY = 0;
-        m_gsParticles[nLoop].glfRotateX = 0.0f;
-        m_gsParticles[nLoop].glfRotateY = 0.0f;
-        m_gsParticles[nLoop].glfRotateZ = 0.0f;
-        m_gsParticles[nLoop].glfScaleX = 1.0f;
-        m_gsParticles[nLoop].glfScaleY = 1.0f;
-        m_gsParticles[nLoop].glfR = 1.0f;
-        m_gsParticles[nLoop].glfG = 1.0f;
-        m_gsParticles[nLoop].glfB = 1.0f;
-        m_gsParticles[nLoop].glfA = 1.0f;
-    }
+    m_glfTexLeft   = 0.0f;
+    m_glfTexBottom = 0.0f;
+    m_glfTexRight  = 1.0f;
+    m_glfTexTop    = 1.0f;
+
+    m_pParticles    = NULL;
+    m_nNumAllocated = 0;
+
+    m_pVertices          = NULL;
+    m_nNumVertsAllocated = 0;
+
+    m_gsRenderMode = GS_PARTICLE_QUADS;
+
+    // Allocate a few particles so there always are some to access.
+    this->Allocate(GS_PARTICLE_MIN_ALLOC);
 }
 
 
@@ -79,6 +79,18 @@ GS_OGLParticle::~GS_OGLParticle()
 {
 
     this->Destroy();
+
+    if (m_pParticles)
+    {
+        delete[] m_pParticles;
+    }
+    m_pParticles = NULL;
+
+    if (m_pVertices)
+    {
+        delete[] m_pVertices;
+    }
+    m_pVertices = NULL;
 }
 
 
@@ -159,14 +171,24 @@ BOOL GS_OGLParticle::Create(const char* pszPathname,int nNumParticles,BOOL bFilt
     m_gliWidth  = m_gsTexture.GetWidth();
     m_gliHeight = m_gsTexture.GetHeight();
 
+    // Determine the texture coordinates of the image (it may share an atlas page).
+    m_glfTexLeft   = (GLfloat) m_gsTexture.GetOffsetX() / (GLfloat) m_gsTexture.GetPageWidth();
+    m_glfTexBottom = (GLfloat) m_gsTexture.GetOffsetY() / (GLfloat) m_gsTexture.GetPageHeight();
+    m_glfTexRight  = (GLfloat) (m_gsTexture.GetOffsetX() + m_gliWidth) /
+                     (GLfloat) m_gsTexture.GetPageWidth();
+    m_glfTexTop    = (GLfloat) (m_gsTexture.GetOffsetY() + m_gliHeight) /
+                     (GLfloat) m_gsTexture.GetPageHeight();
+
     // Set how many particles are active initially.
-    if (nNumParticles > MAX_PARTICLES)
+    if (nNumParticles < 0)
     {
-        nNumParticles = MAX_PARTICLES;
+        nNumParticles = 0;
     }
-    else if (nNumParticles < 0)
+
+    // Make room for the particles.
+    if (!this->Allocate(nNumParticles))
     {
-        nNumParticles = 0;
+        return FALSE;
     }
 
     m_nNumParticles = nNumParticles;
@@ -174,7 +196,7 @@ BOOL GS_OGLParticle::Create(const char* pszPathname,int nNumParticles,BOOL bFilt
     // Activate the specified number of particles.
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].bIsActive = TRUE;
+        m_pParticles[nLoop].bIsActive = TRUE;
     }
 
     m_bIsReady = TRUE;
@@ -213,14 +235,22 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
     m_gliWidth  = nWidth;
     m_gliHeight = nHeight;
 
+    // The image covers the whole texture.
+    m_glfTexLeft   = 0.0f;
+    m_glfTexBottom = 0.0f;
+    m_glfTexRight  = 1.0f;
+    m_glfTexTop    = 1.0f;
+
     // Set how many particles are active initially.
-    if (nNumParticles > MAX_PARTICLES)
+    if (nNumParticles < 0)
     {
-        nNumParticles = MAX_PARTICLES;
+        nNumParticles = 0;
     }
-    else if (nNumParticles < 0)
+
+    // Make room for the particles.
+    if (!this->Allocate(nNumParticles))
     {
-        nNumParticles = 0;
+        return FALSE;
     }
 
     m_nNumParticles = nNumParticles;
@@ -228,7 +258,7 @@ BOOL GS_OGLParticle::Create(GLuint glTexture, int nWidth, int nHeight, int nNumP
     // Activate the specified number of particles.
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].bIsActive = TRUE;
+        m_pParticles[nLoop].bIsActive = TRUE;
     }
 
     m_bIsReady = TRUE;
@@ -270,20 +300,25 @@ void GS_OGLParticle::Destroy()
     m_gliWidth  = 0;
     m_gliHeight = 0;
 
-    for (int nLoop = 0; nLoop < MAX_PARTICLES; nLoop++)
-    {
-        m_gsParticles[nLoop].bIsActive = FALSE;
-        m_gsParticles[nLoop].gliDestX = 0;
-        m_gsParticles[nLoop].gliDestY = 0;
-        m_gsParticles[nLoop].glfRotateX = 0.0f;
-        m_gsParticles[nLoop].glfRotateY = 0.0f;
-        m_gsParticles[nLoop].glfRotateZ = 0.0f;
-        m_gsParticles[nLoop].glfScaleX = 1.0f;
-        m_gsParticles[nLoop].glfScaleY = 1.0f;
-        m_gsParticles[nLoop].glfR = 1.0f;
-        m_gsParticles[nLoop].glfG = 1.0f;
-        m_gsParticles[nLoop].glfB = 1.0f;
-        m_gsParticles[nLoop].glfA = 1.0f;
+    m_glfTexLeft   = 0.0f;
+    m_glfTexBottom = 0.0f;
+    m_glfTexRight  = 1.0f;
+    m_glfTexTop    = 1.0f;
+
+    for (int nLoop = 0; nLoop < m_nNumAllocated; nLoop++)
+    {
+        m_pParticles[nLoop].bIsActive = FALSE;
+        m_pParticles[nLoop].gliDestX = 0;
+        m_pParticles[nLoop].gliDestY = 0;
+        m_pParticles[nLoop].glfRotateX = 0.0f;
+        m_pParticles[nLoop].glfRotateY = 0.0f;
+        m_pParticles[nLoop].glfRotateZ = 0.0f;
+        m_pParticles[nLoop].glfScaleX = 1.0f;
+        m_pParticles[nLoop].glfScaleY = 1.0f;
+        m_pParticles[nLoop].glfR = 1.0f;
+        m_pParticles[nLoop].glfG = 1.0f;
+        m_pParticles[nLoop].glfB = 1.0f;
+        m_pParticles[nLoop].glfA = 1.0f;
     }
 }
 
@@ -315,37 +350,41 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
 
     RECT ClientRect;
 
-#ifdef GS_PLATFORM_WINDOWS
-    GetClientRect(hWnd, &ClientRect);
-#else
-    GS_Platform::GetClientRect(hWnd, &ClientRect);
-#endif
+    // Use the client rectangle stored for this frame instead of asking the window system.
+    GS_OGLState::GetClientRect(hWnd, &ClientRect);
 
     // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
-    {
-        glDisable(GL_DEPTH_TEST);
-        m_bDepthTestEnabled = TRUE;
-    }
-    else
-    {
-        m_bDepthTestEnabled = FALSE;
-    }
+    m_bDepthTestEnabled = GS_OGLState::IsDepthTestEnabled();
+    GS_OGLState::EnableDepthTest(FALSE);
 
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
-    {
-        glDisable(GL_LIGHTING);
-        m_bLightingEnabled = TRUE;
-    }
-    else
+    m_bLightingEnabled = GS_OGLState::IsLightingEnabled();
+    GS_OGLState::EnableLighting(FALSE);
+
+    // The shader renderer keeps its own projection.
+    if (GS_OGLCoreRenderer::IsActive())
     {
-        m_bLightingEnabled = FALSE;
+        GS_OGLCoreRenderer::PushProjection();
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.right-ClientRect.left)/2),
+                                         ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.top-ClientRect.bottom)/2),
+                                         ((ClientRect.top-ClientRect.bottom)/2));
+        }
+
+        return TRUE;
     }
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPushMatrix();              // Store the projection matrix.
-    glLoadIdentity();            // Reset the projection matrix.
+    GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+    glPushMatrix();                            // Store the projection matrix.
+    glLoadIdentity();                          // Reset the projection matrix.
 
     // Set up an ortho screen with the same dimensions as the client area of the current
     // window and with a depth large enough to rotate the entire screen around either
@@ -361,8 +400,8 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
                 ((ClientRect.top-ClientRect.bottom)/2));
     }
 
-    glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
-    glPushMatrix();             // Store the modelview matrix.
+    GS_OGLState::SetMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
+    glPushMatrix();                           // Store the modelview matrix.
 
     return TRUE;
 }
@@ -382,21 +421,28 @@ BOOL GS_OGLParticle::BeginRender(HWND hWnd)
 void GS_OGLParticle::EndRender()
 {
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPopMatrix();               // Restore the old projection matrix.
-    glMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
-    glPopMatrix();               // Restore the old modelview matrix.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::PopProjection();     // Restore the old projection.
+    }
+    else
+    {
+        GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+        glPopMatrix();                             // Restore the old projection matrix.
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
+        glPopMatrix();                             // Restore the old modelview matrix.
+    }
 
     // Was depth testing enabled?
     if (m_bDepthTestEnabled == TRUE)
     {
-        glEnable(GL_DEPTH_TEST);
+        GS_OGLState::EnableDepthTest(TRUE);
     }
 
     // Was lighting enabled?
     if (m_bLightingEnabled == TRUE)
     {
-        glEnable(GL_LIGHTING);
+        GS_OGLState::EnableLighting(TRUE);
     }
 }
 
@@ -421,115 +467,414 @@ BOOL GS_OGLParticle::Render(HWND hWnd)
         return FALSE;
     }
 
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    if ((hWnd == NULL) && (pgsBatch != NULL))
+    {
+        // The texture coordinates are the same for every particle.
+        GLfloat glfTexCoords[8] = { m_glfTexLeft,  m_glfTexBottom, m_glfTexRight, m_glfTexBottom,
+                                    m_glfTexRight, m_glfTexTop,    m_glfTexLeft,  m_glfTexTop };
+        GLfloat glfVertices[8];
+
+        for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+        {
+            if (!m_pParticles[nLoop].bIsActive)
+            {
+                continue;
+            }
+
+            float fHalfWidth  = ((float)m_gliWidth  / 2) * m_pParticles[nLoop].glfScaleX * g_fScaleFactorX;
+            float fHalfHeight = ((float)m_gliHeight / 2) * m_pParticles[nLoop].glfScaleY * g_fScaleFactorY;
+
+            // Transform the quad the same way the modelview matrix is set up below.
+            GS_OGLSpriteBatch::TransformQuad
+            (
+                (m_pParticles[nLoop].gliDestX * g_fScaleFactorX) + fHalfWidth + g_fRenderModX,
+                (m_pParticles[nLoop].gliDestY * g_fScaleFactorY) + fHalfHeight + g_fRenderModY,
+                -fHalfWidth, -fHalfHeight, fHalfWidth, fHalfHeight,
+                m_pParticles[nLoop].glfRotateX, m_pParticles[nLoop].glfRotateY,
+                m_pParticles[nLoop].glfRotateZ, glfVertices
+            );
+
+            pgsBatch->AddQuad(m_gluTexture, GS_BLEND_ADDITIVE, glfVertices, glfTexCoords,
+                              GS_OGLColor(m_pParticles[nLoop].glfR, m_pParticles[nLoop].glfG,
+                                          m_pParticles[nLoop].glfB, m_pParticles[nLoop].glfA));
+        }
+
+        return TRUE;
+    }
+
+    // Draw any batched quads first, the particles are drawn directly.
+    GS_OGLSpriteBatch::FlushActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
         this->BeginRender(hWnd);
     }
 
-    GLint gliSrcFactor, gliDstFactor;
+    GLenum glSrcFactor, glDstFactor;
 
-    GLboolean glbIsBlendingEnabled = glIsEnabled(GL_BLEND);
+    // Save blending parameters.
+    BOOL bIsBlendingEnabled = GS_OGLState::IsBlendingEnabled();
+    GS_OGLState::GetBlendFunc(&glSrcFactor, &glDstFactor);
+
+    // Setup blending for particles.
+    GS_OGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GS_OGLState::EnableBlending(TRUE);
 
-    // Is blending enabled?
-    if (glbIsBlendingEnabled)
+    // Select the particle texture.
+    GS_OGLState::BindTexture(m_gluTexture);
+
+    // Submit all the active particles with a single draw call.
+    if ((m_gsRenderMode != GS_PARTICLE_POINTS) || (!this->RenderPoints()))
     {
-        // Save blending parameters.
-        glGetIntegerv(GL_BLEND_SRC, &gliSrcFactor);
-        glGetIntegerv(GL_BLEND_DST, &gliDstFactor);
-        // Disable blending.
-        glDisable(GL_BLEND);
+        this->RenderQuads();
     }
 
-    // Setup blending for particles.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    glEnable(GL_BLEND);
+    // Restore the original blending.
+    GS_OGLState::SetBlendFunc(glSrcFactor, glDstFactor);
+    GS_OGLState::EnableBlending(bIsBlendingEnabled);
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        this->EndRender();
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::RenderQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Expands each active particle to a (rotated) quad in one vertex array and draws them
+//          all with a single call.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::RenderQuads()
+{
+
+    if (!this->AllocateVertices(m_nNumParticles * 4))
+    {
+        return;
+    }
+
+    GLfloat glfTexCoords[8] = { m_glfTexLeft,  m_glfTexBottom, m_glfTexRight, m_glfTexBottom,
+                                m_glfTexRight, m_glfTexTop,    m_glfTexLeft,  m_glfTexTop };
+    GLfloat glfVertices[8];
+
+    GS_BatchVertex* pVertex = m_pVertices;
 
-    // For each particle.
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
+        GS_Particle* pParticle = &m_pParticles[nLoop];
 
-        // Should the specified particle be rendered?
-        if (m_gsParticles[nLoop].bIsActive)
+        if (!pParticle->bIsActive)
         {
-            // Reset the modelview matrix.
-            glLoadIdentity();
+            continue;
+        }
+
+        // Determine the scaled particle dimensions and divide by two to take into account
+        // that the particle is drawn from the center outwards.
+        float fHalfWidth  = ((float)m_gliWidth  / 2) * pParticle->glfScaleX * g_fScaleFactorX;
+        float fHalfHeight = ((float)m_gliHeight / 2) * pParticle->glfScaleY * g_fScaleFactorY;
+
+        // Position the particle by its bottom left corner and rotate it around its center.
+        GS_OGLSpriteBatch::TransformQuad
+        (
+            (pParticle->gliDestX * g_fScaleFactorX) + fHalfWidth + g_fRenderModX,
+            (pParticle->gliDestY * g_fScaleFactorY) + fHalfHeight + g_fRenderModY,
+            -fHalfWidth, -fHalfHeight, fHalfWidth, fHalfHeight,
+            pParticle->glfRotateX, pParticle->glfRotateY, pParticle->glfRotateZ, glfVertices
+        );
+
+        for (int nCorner = 0; nCorner < 4; nCorner++)
+        {
+            pVertex->fX     = glfVertices[nCorner * 2];
+            pVertex->fY     = glfVertices[(nCorner * 2) + 1];
+            pVertex->fU     = glfTexCoords[nCorner * 2];
+            pVertex->fV     = glfTexCoords[(nCorner * 2) + 1];
+            pVertex->fRed   = pParticle->glfR;
+            pVertex->fGreen = pParticle->glfG;
+            pVertex->fBlue  = pParticle->glfB;
+            pVertex->fAlpha = pParticle->glfA;
+            pVertex++;
+        }
+    }
 
-            // Select the particle texture.
-            glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+    int nNumVertices = (int) (pVertex - m_pVertices);
 
-            // Draw particle in a different hue or transparency depending on the alpha factor.
-            glColor4f(m_gsParticles[nLoop].glfR, m_gsParticles[nLoop].glfG,
-                      m_gsParticles[nLoop].glfB, m_gsParticles[nLoop].glfA);
+    if (nNumVertices == 0)
+    {
+        return;
+    }
 
-            // Determine the scaled particle dimensions and divide by two to take into account
-            // that the particle is drawn from the center outwards.
-            float fHalfWidth  = ((float)m_gliWidth  / 2) * m_gsParticles[nLoop].glfScaleX * g_fScaleFactorX;
-            float fHalfHeight = ((float)m_gliHeight / 2) * m_gsParticles[nLoop].glfScaleY * g_fScaleFactorY;
+    // The shader renderer takes the same vertices.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::DrawQuads(m_pVertices, nNumVertices);
+        return;
+    }
 
-            // Position the particle (the coordinates (0,0) is the bottom left of the screen). Note
-            // that because the particle is actually positioned from the center, some adjustments
-            // have to be made for the particle to be postioned by the bottom left corner.
-            glTranslated
-            (
-                (m_gsParticles[nLoop].gliDestX * g_fScaleFactorX) + fHalfWidth + g_fRenderModX,
-                (m_gsParticles[nLoop].gliDestY * g_fScaleFactorX) + fHalfHeight + g_fRenderModY,
-                0
-            );
+    // The vertices are already in screen coordinates.
+    glLoadIdentity();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    glVertexPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fX);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fU);
+    glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fRed);
+
+    glDrawArrays(GL_QUADS, 0, nNumVertices);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    // The color array leaves the current color undefined.
+    GS_OGLState::InvalidateColor();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::RenderPoints():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws each active particle as a point sprite, with all of them in one call. Point
+//          sprites can't be rotated, are square and share one size per draw call, and always
+//          use the whole texture, so this only works if the particles fit those limits.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the particles were drawn, FALSE if they have to be drawn as quads.
+//==============================================================================================
+
+BOOL GS_OGLParticle::RenderPoints()
+{
+
+    // Point sprites are part of the fixed-function pipeline.
+    if ((!GS_OGLExtensions::HasPointSprites()) || (GS_OGLCoreRenderer::IsActive()))
+    {
+        return FALSE;
+    }
+
+    // Point sprites always map the whole texture (so not an image in a texture atlas).
+    if ((m_glfTexLeft != 0.0f) || (m_glfTexBottom != 0.0f) || (m_glfTexRight != 1.0f) ||
+            (m_glfTexTop != 1.0f))
+    {
+        return FALSE;
+    }
+
+    if (!this->AllocateVertices(m_nNumParticles))
+    {
+        return FALSE;
+    }
+
+    GLfloat glfPointSize = -1.0f;
+
+    GS_BatchVertex* pVertex = m_pVertices;
+
+    for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
+    {
+        GS_Particle* pParticle = &m_pParticles[nLoop];
+
+        if (!pParticle->bIsActive)
+        {
+            continue;
+        }
+
+        // Rotated particles need quads.
+        if ((pParticle->glfRotateX != 0.0f) || (pParticle->glfRotateY != 0.0f) ||
+                (pParticle->glfRotateZ != 0.0f))
+        {
+            return FALSE;
+        }
+
+        float fWidth  = (float)m_gliWidth  * pParticle->glfScaleX * g_fScaleFactorX;
+        float fHeight = (float)m_gliHeight * pParticle->glfScaleY * g_fScaleFactorY;
+
+        // All particles have to be square and of the same size.
+        if (glfPointSize < 0.0f)
+        {
+            glfPointSize = fWidth;
+        }
 
-            // Rotate the particle on the X, Y and Z-axis.
-            glRotatef(m_gsParticles[nLoop].glfRotateX, 1.0f, 0.0f, 0.0f);
-            glRotatef(m_gsParticles[nLoop].glfRotateY, 0.0f, 1.0f, 0.0f);
-            glRotatef(m_gsParticles[nLoop].glfRotateZ, 0.0f, 0.0f, 1.0f);
-
-            // Start drawing a quad. In order for the particle to be rotated correctly, the
-            // particle has to/ be drawn from a center point outwards. If the center of the
-            // particle is (0, 0) then the bottom left corner of the particle is (0 - (particle
-            // width / 2), 0 - (particle height/2)), the bottom right corner of the particle is
-            // (0 + (particle width / 2), 0 - (particle height/2)), the top right corner of the
-            // particle is (0 + (particle width / 2), 0 + (particle height/2)) and the top left
-            // corner of the particle is (0 - (particle width / 2), 0 + (particle height/2)).
-            glBegin(GL_QUADS);
-            // Bottom left texture coordinate and vertex.
-            glTexCoord2f(0.0f, 0.0f);
-            glVertex2f(-fHalfWidth, -fHalfHeight);
-            // Bottom right texture coordinate and vertex.
-            glTexCoord2f(1.0f, 0.0f);
-            glVertex2f( fHalfWidth, -fHalfHeight);
-            // Top right texture coordinate and vertex.
-            glTexCoord2f(1.0f, 1.0f);
-            glVertex2f( fHalfWidth,  fHalfHeight);
-            // Top left texture coordinate and vertex.
-            glTexCoord2f(0.0f, 1.0f);
-            glVertex2f(-fHalfWidth,  fHalfHeight);
-            glEnd();
-
-            // Unselect the particle texture.
-            glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
+        if ((fabs(fWidth - fHeight) > 0.5f) || (fabs(fWidth - glfPointSize) > 0.5f))
+        {
+            return FALSE;
         }
+
+        // Points are positioned by their center.
+        pVertex->fX     = (pParticle->gliDestX * g_fScaleFactorX) + (fWidth / 2) + g_fRenderModX;
+        pVertex->fY     = (pParticle->gliDestY * g_fScaleFactorY) + (fHeight / 2) + g_fRenderModY;
+        pVertex->fU     = 0.0f;
+        pVertex->fV     = 0.0f;
+        pVertex->fRed   = pParticle->glfR;
+        pVertex->fGreen = pParticle->glfG;
+        pVertex->fBlue  = pParticle->glfB;
+        pVertex->fAlpha = pParticle->glfA;
+        pVertex++;
+    }
+
+    int nNumVertices = (int) (pVertex - m_pVertices);
+
+    if (nNumVertices == 0)
+    {
+        return TRUE;
+    }
+
+    if (glfPointSize > GS_OGLExtensions::GetMaxPointSize())
+    {
+        return FALSE;
     }
 
+    // The vertices are already in screen coordinates.
+    glLoadIdentity();
+
+    glEnable(GL_POINT_SPRITE);
+    glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE);
+    gsglPointParameteri(GL_POINT_SPRITE_COORD_ORIGIN, GL_LOWER_LEFT);
+    glPointSize(glfPointSize);
 
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
 
-    // Disable particle blending.
-    glDisable(GL_BLEND);
+    glVertexPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fX);
+    glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fRed);
 
-    // Was blending enabled originally?
-    if (glbIsBlendingEnabled)
+    glDrawArrays(GL_POINTS, 0, nNumVertices);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glPointSize(1.0f);
+    glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_FALSE);
+    glDisable(GL_POINT_SPRITE);
+
+    // The color array leaves the current color undefined.
+    GS_OGLState::InvalidateColor();
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::Allocate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes sure there is room for the specified number of particles, keeping the
+//          existing ones. New particles are inactive and have default settings.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::Allocate(int nNumParticles)
+{
+
+    if (nNumParticles <= m_nNumAllocated)
     {
-        // Restore and enable original blending;
-        glBlendFunc(gliSrcFactor, gliDstFactor);
-        glEnable(GL_BLEND);
+        return TRUE;
     }
 
-    // Reset display after 2D rendering.
-    if (hWnd != NULL)
+    // Grow by at least double to avoid growing again and again.
+    int nNumAllocated = m_nNumAllocated * 2;
+
+    if (nNumAllocated < nNumParticles)
     {
-        this->EndRender();
+        nNumAllocated = nNumParticles;
     }
 
+    GS_Particle* pParticles = new GS_Particle[nNumAllocated];
+
+    if (!pParticles)
+    {
+        GS_Error::Report("GS_OGL_PARTICLE.CPP", 772, "Failed to allocate particles!");
+        return FALSE;
+    }
+
+    if (m_pParticles)
+    {
+        memcpy(pParticles, m_pParticles, m_nNumAllocated * sizeof(GS_Particle));
+        delete[] m_pParticles;
+    }
+
+    for (int nLoop = m_nNumAllocated; nLoop < nNumAllocated; nLoop++)
+    {
+        pParticles[nLoop].bIsActive = FALSE;
+        pParticles[nLoop].gliDestX = 0;
+        pParticles[nLoop].gliDestY = 0;
+        pParticles[nLoop].glfRotateX = 0.0f;
+        pParticles[nLoop].glfRotateY = 0.0f;
+        pParticles[nLoop].glfRotateZ = 0.0f;
+        pParticles[nLoop].glfScaleX = 1.0f;
+        pParticles[nLoop].glfScaleY = 1.0f;
+        pParticles[nLoop].glfR = 1.0f;
+        pParticles[nLoop].glfG = 1.0f;
+        pParticles[nLoop].glfB = 1.0f;
+        pParticles[nLoop].glfA = 1.0f;
+    }
+
+    m_pParticles    = pParticles;
+    m_nNumAllocated = nNumAllocated;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLParticle::AllocateVertices():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes sure the vertex array used for rendering has room for the specified number
+//          of vertices (its contents are rebuilt every time the particles are drawn).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLParticle::AllocateVertices(int nNumVertices)
+{
+
+    if (nNumVertices <= m_nNumVertsAllocated)
+    {
+        return TRUE;
+    }
+
+    if (m_pVertices)
+    {
+        delete[] m_pVertices;
+    }
+
+    m_nNumVertsAllocated = 0;
+
+    m_pVertices = new GS_BatchVertex[nNumVertices];
+
+    if (!m_pVertices)
+    {
+        GS_Error::Report("GS_OGL_PARTICLE.CPP", 836, "Failed to allocate particle vertices!");
+        return FALSE;
+    }
+
+    m_nNumVertsAllocated = nNumVertices;
+
     return TRUE;
 }
 
@@ -557,6 +902,38 @@ BOOL GS_OGLParticle::IsReady()
 }
 
 
+//==============================================================================================
+// GS_OGLParticle::GetRenderMode():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: How the particles are drawn when they are not added to a sprite batch.
+//==============================================================================================
+
+GS_ParticleMode GS_OGLParticle::GetRenderMode()
+{
+
+    return m_gsRenderMode;
+}
+
+
+//==============================================================================================
+// GS_OGLParticle::SetRenderMode():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Selects quads or point sprites for drawing the particles when they are not added
+//          to a sprite batch. Point sprites are the least data per particle but particles
+//          that are rotated or differ in size are drawn as quads anyway.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLParticle::SetRenderMode(GS_ParticleMode gsRenderMode)
+{
+
+    m_gsRenderMode = gsRenderMode;
+}
+
+
 //==============================================================================================
 // GS_OGLParticle::IsActive():
 // ---------------------------------------------------------------------------------------------
@@ -577,7 +954,7 @@ BOOL GS_OGLParticle::IsActive(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].bIsActive;
+    return m_pParticles[nParticleIndex].bIsActive;
 }
 
 
@@ -601,7 +978,7 @@ void GS_OGLParticle::Activate(int nParticleIndex, BOOL bActivate)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].bIsActive = bActivate;
+    m_pParticles[nParticleIndex].bIsActive = bActivate;
 }
 
 
@@ -610,7 +987,7 @@ void GS_OGLParticle::Activate(BOOL bActivate)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].bIsActive = bActivate;
+        m_pParticles[nLoop].bIsActive = bActivate;
     }
 }
 
@@ -650,13 +1027,15 @@ void GS_OGLParticle::SetNumParticles(int nNumParticles)
 {
 
     // Is number of particles within bounds?
-    if (nNumParticles > MAX_PARTICLES)
+    if (nNumParticles < 0)
     {
-        nNumParticles = MAX_PARTICLES;
+        nNumParticles = 0;
     }
-    else if (nNumParticles < 0)
+
+    // Make room for more particles if needed.
+    if (!this->Allocate(nNumParticles))
     {
-        nNumParticles = 0;
+        return;
     }
 
     // Set the number of particles.
@@ -684,7 +1063,7 @@ GLint GS_OGLParticle::GetDestX(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].gliDestX;
+    return m_pParticles[nParticleIndex].gliDestX;
 }
 
 
@@ -708,7 +1087,7 @@ void  GS_OGLParticle::SetDestX(int nParticleIndex, GLint gliDestX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestX = gliDestX;
+    m_pParticles[nParticleIndex].gliDestX = gliDestX;
 }
 
 
@@ -717,7 +1096,7 @@ void  GS_OGLParticle::SetDestX(GLint gliDestX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestX = gliDestX;
+        m_pParticles[nLoop].gliDestX = gliDestX;
     }
 }
 
@@ -742,7 +1121,7 @@ GLint GS_OGLParticle::GetDestY(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].gliDestY;
+    return m_pParticles[nParticleIndex].gliDestY;
 }
 
 
@@ -766,7 +1145,7 @@ void  GS_OGLParticle::SetDestY(int nParticleIndex, GLint gliDestY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestY = gliDestY;
+    m_pParticles[nParticleIndex].gliDestY = gliDestY;
 }
 
 void  GS_OGLParticle::SetDestY(GLint gliDestY)
@@ -774,7 +1153,7 @@ void  GS_OGLParticle::SetDestY(GLint gliDestY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestY = gliDestY;
+        m_pParticles[nLoop].gliDestY = gliDestY;
     }
 }
 
@@ -799,7 +1178,7 @@ GLfloat GS_OGLParticle::GetRotateX(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateX;
+    return m_pParticles[nParticleIndex].glfRotateX;
 }
 
 
@@ -823,7 +1202,7 @@ void GS_OGLParticle::SetRotateX(int nParticleIndex, GLfloat glfRotateX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateX = glfRotateX;
+    m_pParticles[nParticleIndex].glfRotateX = glfRotateX;
 }
 
 void GS_OGLParticle::SetRotateX(GLfloat glfRotateX)
@@ -831,7 +1210,7 @@ void GS_OGLParticle::SetRotateX(GLfloat glfRotateX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateX = glfRotateX;
+        m_pParticles[nLoop].glfRotateX = glfRotateX;
     }
 }
 
@@ -856,7 +1235,7 @@ GLfloat GS_OGLParticle::GetRotateY(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateY;
+    return m_pParticles[nParticleIndex].glfRotateY;
 }
 
 
@@ -880,7 +1259,7 @@ void GS_OGLParticle::SetRotateY(int nParticleIndex, GLfloat glfRotateY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateY = glfRotateY;
+    m_pParticles[nParticleIndex].glfRotateY = glfRotateY;
 }
 
 void GS_OGLParticle::SetRotateY(GLfloat glfRotateY)
@@ -888,7 +1267,7 @@ void GS_OGLParticle::SetRotateY(GLfloat glfRotateY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateY = glfRotateY;
+        m_pParticles[nLoop].glfRotateY = glfRotateY;
     }
 }
 
@@ -913,7 +1292,7 @@ GLfloat GS_OGLParticle::GetRotateZ(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfRotateZ;
+    return m_pParticles[nParticleIndex].glfRotateZ;
 }
 
 
@@ -937,7 +1316,7 @@ void GS_OGLParticle::SetRotateZ(int nParticleIndex, GLfloat glfRotateZ)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateZ = glfRotateZ;
+    m_pParticles[nParticleIndex].glfRotateZ = glfRotateZ;
 }
 
 void GS_OGLParticle::SetRotateZ(GLfloat glfRotateZ)
@@ -945,7 +1324,7 @@ void GS_OGLParticle::SetRotateZ(GLfloat glfRotateZ)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateZ = glfRotateZ;
+        m_pParticles[nLoop].glfRotateZ = glfRotateZ;
     }
 }
 
@@ -970,7 +1349,7 @@ GLfloat GS_OGLParticle::GetScaleX(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfScaleX;
+    return m_pParticles[nParticleIndex].glfScaleX;
 }
 
 
@@ -994,7 +1373,7 @@ void GS_OGLParticle::SetScaleX(int nParticleIndex, GLfloat glfScaleX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleX = glfScaleX;
+    m_pParticles[nParticleIndex].glfScaleX = glfScaleX;
 }
 
 void GS_OGLParticle::SetScaleX(GLfloat glfScaleX)
@@ -1002,7 +1381,7 @@ void GS_OGLParticle::SetScaleX(GLfloat glfScaleX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX = glfScaleX;
+        m_pParticles[nLoop].glfScaleX = glfScaleX;
     }
 }
 
@@ -1027,7 +1406,7 @@ GLfloat GS_OGLParticle::GetScaleY(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return m_gsParticles[nParticleIndex].glfScaleY;
+    return m_pParticles[nParticleIndex].glfScaleY;
 }
 
 
@@ -1051,7 +1430,7 @@ void GS_OGLParticle::SetScaleY(int nParticleIndex, GLfloat glfScaleY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleY = glfScaleY;
+    m_pParticles[nParticleIndex].glfScaleY = glfScaleY;
 }
 
 void GS_OGLParticle::SetScaleY(GLfloat glfScaleY)
@@ -1059,7 +1438,7 @@ void GS_OGLParticle::SetScaleY(GLfloat glfScaleY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY = glfScaleY;
+        m_pParticles[nLoop].glfScaleY = glfScaleY;
     }
 }
 
@@ -1114,7 +1493,7 @@ GLfloat GS_OGLParticle::GetScaledWidth(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return (m_gliWidth * m_gsParticles[nParticleIndex].glfScaleX);
+    return (m_gliWidth * m_pParticles[nParticleIndex].glfScaleX);
 }
 
 
@@ -1143,11 +1522,11 @@ void GS_OGLParticle::SetScaledWidth(int nParticleIndex, GLint gliWidth)
 
     if (m_gliWidth > 0)
     {
-        m_gsParticles[nParticleIndex].glfScaleX = float(gliWidth) / m_gliWidth;
+        m_pParticles[nParticleIndex].glfScaleX = float(gliWidth) / m_gliWidth;
     }
     else
     {
-        m_gsParticles[nParticleIndex].glfScaleX = 0.0f;
+        m_pParticles[nParticleIndex].glfScaleX = 0.0f;
     }
 }
 
@@ -1167,7 +1546,7 @@ void GS_OGLParticle::SetScaledWidth(GLint gliWidth)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX = fScaleX;
+        m_pParticles[nLoop].glfScaleX = fScaleX;
     }
 }
 
@@ -1195,7 +1574,7 @@ GLfloat GS_OGLParticle::GetScaledHeight(int nParticleIndex)
         nParticleIndex = 0;
     }
 
-    return (m_gliHeight * m_gsParticles[nParticleIndex].glfScaleY);
+    return (m_gliHeight * m_pParticles[nParticleIndex].glfScaleY);
 }
 
 
@@ -1224,11 +1603,11 @@ void GS_OGLParticle::SetScaledHeight(int nParticleIndex, GLint gliHeight)
 
     if (m_gliHeight > 0)
     {
-        m_gsParticles[nParticleIndex].glfScaleY = float(gliHeight) / m_gliHeight;
+        m_pParticles[nParticleIndex].glfScaleY = float(gliHeight) / m_gliHeight;
     }
     else
     {
-        m_gsParticles[nParticleIndex].glfScaleY = 0.0f;
+        m_pParticles[nParticleIndex].glfScaleY = 0.0f;
     }
 }
 
@@ -1248,7 +1627,7 @@ void GS_OGLParticle::SetScaledHeight(GLint gliHeight)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY = fScaleY;
+        m_pParticles[nLoop].glfScaleY = fScaleY;
     }
 }
 
@@ -1277,12 +1656,12 @@ void GS_OGLParticle::GetDestRect(int nParticleIndex, long* pLeft, long* pTop, lo
         nParticleIndex = 0;
     }
 
-    *(pLeft)   = m_gsParticles[nParticleIndex].gliDestX;
-    *(pTop)    = m_gsParticles[nParticleIndex].gliDestY +
+    *(pLeft)   = m_pParticles[nParticleIndex].gliDestX;
+    *(pTop)    = m_pParticles[nParticleIndex].gliDestY +
                  long(this->GetScaledHeight(nParticleIndex));
-    *(pRight)  = m_gsParticles[nParticleIndex].gliDestX +
+    *(pRight)  = m_pParticles[nParticleIndex].gliDestX +
                  long(this->GetScaledWidth(nParticleIndex));
-    *(pBottom) = m_gsParticles[nParticleIndex].gliDestY;
+    *(pBottom) = m_pParticles[nParticleIndex].gliDestY;
 }
 
 void GS_OGLParticle::GetDestRect(int nParticleIndex, RECT* pDestRect)
@@ -1297,10 +1676,10 @@ void GS_OGLParticle::GetDestRect(int nParticleIndex, RECT* pDestRect)
         nParticleIndex = 0;
     }
 
-    SetRect(pDestRect, m_gsParticles[nParticleIndex].gliDestX,
-            m_gsParticles[nParticleIndex].gliDestY + long(this->GetScaledHeight(nParticleIndex)),
-            m_gsParticles[nParticleIndex].gliDestX + long(this->GetScaledWidth(nParticleIndex)),
-            m_gsParticles[nParticleIndex].gliDestY);
+    SetRect(pDestRect, m_pParticles[nParticleIndex].gliDestX,
+            m_pParticles[nParticleIndex].gliDestY + long(this->GetScaledHeight(nParticleIndex)),
+            m_pParticles[nParticleIndex].gliDestX + long(this->GetScaledWidth(nParticleIndex)),
+            m_pParticles[nParticleIndex].gliDestY);
 }
 
 
@@ -1332,7 +1711,7 @@ void GS_OGLParticle::AddDestX(int nParticleIndex, GLint gliAddX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestX += gliAddX;
+    m_pParticles[nParticleIndex].gliDestX += gliAddX;
 }
 
 void GS_OGLParticle::AddDestX(GLint gliAddX)
@@ -1340,7 +1719,7 @@ void GS_OGLParticle::AddDestX(GLint gliAddX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestX += gliAddX;
+        m_pParticles[nLoop].gliDestX += gliAddX;
     }
 }
 
@@ -1368,7 +1747,7 @@ void GS_OGLParticle::AddDestY(int nParticleIndex, GLint gliAddY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].gliDestY += gliAddY;
+    m_pParticles[nParticleIndex].gliDestY += gliAddY;
 }
 
 void GS_OGLParticle::AddDestY(GLint gliAddY)
@@ -1376,7 +1755,7 @@ void GS_OGLParticle::AddDestY(GLint gliAddY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].gliDestY += gliAddY;
+        m_pParticles[nLoop].gliDestY += gliAddY;
     }
 }
 
@@ -1404,7 +1783,7 @@ void GS_OGLParticle::AddRotateX(int nParticleIndex, GLfloat glfRotateX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateX += glfRotateX;
+    m_pParticles[nParticleIndex].glfRotateX += glfRotateX;
 }
 
 void GS_OGLParticle::AddRotateX(GLfloat glfRotateX)
@@ -1412,7 +1791,7 @@ void GS_OGLParticle::AddRotateX(GLfloat glfRotateX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateX += glfRotateX;
+        m_pParticles[nLoop].glfRotateX += glfRotateX;
     }
 }
 
@@ -1440,7 +1819,7 @@ void GS_OGLParticle::AddRotateY(int nParticleIndex, GLfloat glfRotateY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateY += glfRotateY;
+    m_pParticles[nParticleIndex].glfRotateY += glfRotateY;
 }
 
 void GS_OGLParticle::AddRotateY(GLfloat glfRotateY)
@@ -1448,7 +1827,7 @@ void GS_OGLParticle::AddRotateY(GLfloat glfRotateY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateY += glfRotateY;
+        m_pParticles[nLoop].glfRotateY += glfRotateY;
     }
 }
 
@@ -1476,7 +1855,7 @@ void GS_OGLParticle::AddRotateZ(int nParticleIndex, GLfloat glfRotateZ)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfRotateZ += glfRotateZ;
+    m_pParticles[nParticleIndex].glfRotateZ += glfRotateZ;
 }
 
 void GS_OGLParticle::AddRotateZ(GLfloat glfRotateZ)
@@ -1484,7 +1863,7 @@ void GS_OGLParticle::AddRotateZ(GLfloat glfRotateZ)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfRotateZ += glfRotateZ;
+        m_pParticles[nLoop].glfRotateZ += glfRotateZ;
     }
 }
 
@@ -1512,7 +1891,7 @@ void GS_OGLParticle::AddScaleX(int nParticleIndex, GLfloat glfScaleX)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleX += glfScaleX;
+    m_pParticles[nParticleIndex].glfScaleX += glfScaleX;
 }
 
 void GS_OGLParticle::AddScaleX(GLfloat glfScaleX)
@@ -1520,7 +1899,7 @@ void GS_OGLParticle::AddScaleX(GLfloat glfScaleX)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleX += glfScaleX;
+        m_pParticles[nLoop].glfScaleX += glfScaleX;
     }
 }
 
@@ -1548,7 +1927,7 @@ void GS_OGLParticle::AddScaleY(int nParticleIndex, GLfloat glfScaleY)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfScaleY += glfScaleY;
+    m_pParticles[nParticleIndex].glfScaleY += glfScaleY;
 }
 
 void GS_OGLParticle::AddScaleY(GLfloat glfScaleY)
@@ -1556,7 +1935,7 @@ void GS_OGLParticle::AddScaleY(GLfloat glfScaleY)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfScaleY += glfScaleY;
+        m_pParticles[nLoop].glfScaleY += glfScaleY;
     }
 }
 
@@ -1584,10 +1963,10 @@ void GS_OGLParticle::SetModulateColor(int nParticleIndex, GS_OGLColor gsColor)
         nParticleIndex = 0;
     }
 
-    m_gsParticles[nParticleIndex].glfR = gsColor.fRed;
-    m_gsParticles[nParticleIndex].glfG = gsColor.fGreen;
-    m_gsParticles[nParticleIndex].glfB = gsColor.fBlue;
-    m_gsParticles[nParticleIndex].glfA = gsColor.fAlpha;
+    m_pParticles[nParticleIndex].glfR = gsColor.fRed;
+    m_pParticles[nParticleIndex].glfG = gsColor.fGreen;
+    m_pParticles[nParticleIndex].glfB = gsColor.fBlue;
+    m_pParticles[nParticleIndex].glfA = gsColor.fAlpha;
 }
 
 void GS_OGLParticle::SetModulateColor(GS_OGLColor gsColor)
@@ -1595,10 +1974,10 @@ void GS_OGLParticle::SetModulateColor(GS_OGLColor gsColor)
 
     for (int nLoop = 0; nLoop < m_nNumParticles; nLoop++)
     {
-        m_gsParticles[nLoop].glfR = gsColor.fRed;
-        m_gsParticles[nLoop].glfG = gsColor.fGreen;
-        m_gsParticles[nLoop].glfB = gsColor.fBlue;
-        m_gsParticles[nLoop].glfA = gsColor.fAlpha;
+        m_pParticles[nLoop].glfR = gsColor.fRed;
+        m_pParticles[nLoop].glfG = gsColor.fGreen;
+        m_pParticles[nLoop].glfB = gsColor.fBlue;
+        m_pParticles[nLoop].glfA = gsColor.fAlpha;
     }
 }
 
@@ -1617,19 +1996,19 @@ void GS_OGLParticle::SetModulateColor(int nParticleIndex, float fRed, float fGre
 
     if (fRed   > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfR = fRed;
+        m_pParticles[nParticleIndex].glfR = fRed;
     }
     if (fGreen > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfG = fGreen;
+        m_pParticles[nParticleIndex].glfG = fGreen;
     }
     if (fBlue  > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfB = fBlue;
+        m_pParticles[nParticleIndex].glfB = fBlue;
     }
     if (fAlpha > -1.0f)
     {
-        m_gsParticles[nParticleIndex].glfA = fAlpha;
+        m_pParticles[nParticleIndex].glfA = fAlpha;
     }
 }
 
@@ -1640,19 +2019,19 @@ void GS_OGLParticle::SetModulateColor(float fRed, float fGreen, float fBlue, flo
     {
         if (fRed   > -1.0f)
         {
-            m_gsParticles[nLoop].glfR = fRed;
+            m_pParticles[nLoop].glfR = fRed;
         }
         if (fGreen > -1.0f)
         {
-            m_gsParticles[nLoop].glfG = fGreen;
+            m_pParticles[nLoop].glfG = fGreen;
         }
         if (fBlue  > -1.0f)
         {
-            m_gsParticles[nLoop].glfB = fBlue;
+            m_pParticles[nLoop].glfB = fBlue;
         }
         if (fAlpha > -1.0f)
         {
-            m_gsParticles[nLoop].glfA = fAlpha;
+            m_pParticles[nLoop].glfA = fAlpha;
         }
     }
 }
@@ -41,13 +41,16 @@
 #include "gs_object.h"
 #include "gs_ogl_texture.h"
 #include "gs_ogl_color.h"
+#include "gs_ogl_core_renderer.h"
+#include "gs_ogl_extensions.h"
+#include "gs_ogl_sprite_batch.h"
 //==============================================================================================
 
 
 //==============================================================================================
 // Particle defines.
 // ---------------------------------------------------------------------------------------------
-#define MAX_PARTICLES 1000
+#define GS_PARTICLE_MIN_ALLOC 16 // Number of particles space is allocated for initially.
 //==============================================================================================
 
 
@@ -81,6 +84,17 @@ typedef struct GS_PARTICLE
 //==============================================================================================
 
 
+//==============================================================================================
+// Particle render mode enumeration.
+// ---------------------------------------------------------------------------------------------
+typedef enum GS_PARTICLE_MODE
+{
+    GS_PARTICLE_QUADS, // A quad for each particle, all drawn with one call.
+    GS_PARTICLE_POINTS // A point sprite for each particle (falls back to quads if not possible).
+} GS_ParticleMode;
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,7 +118,24 @@ private:
     GLint m_gliWidth;  // The actual width of the particle.
     GLint m_gliHeight; // The actual height of the particle.
 
-    GS_Particle m_gsParticles[MAX_PARTICLES];
+    GLfloat m_glfTexLeft;   // Texture coordinates of the particle image (only part of the
+    GLfloat m_glfTexBottom; // texture when the image was packed into a texture atlas).
+    GLfloat m_glfTexRight;
+    GLfloat m_glfTexTop;
+
+    GS_Particle* m_pParticles;    // The particles (grown as needed, there is no fixed limit).
+    int          m_nNumAllocated; // Number of particles space has been allocated for.
+
+    GS_BatchVertex* m_pVertices;          // Vertices of the particles for single-call rendering.
+    int             m_nNumVertsAllocated; // Number of vertices space has been allocated for.
+
+    GS_ParticleMode m_gsRenderMode; // How the particles are submitted when not batched.
+
+    BOOL Allocate(int nNumParticles);
+    BOOL AllocateVertices(int nNumVertices);
+
+    BOOL RenderPoints();
+    void RenderQuads();
 
 protected:
 
@@ -126,6 +157,9 @@ public:
 
     BOOL IsReady();
 
+    GS_ParticleMode GetRenderMode();
+    void SetRenderMode(GS_ParticleMode gsRenderMode);
+
     BOOL IsActive(int nParticleIndex);
     void Activate(int nParticleIndex, BOOL bActivate = TRUE);
     void Activate(BOOL bActivate = TRUE);
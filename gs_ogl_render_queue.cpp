@@ -0,0 +1,492 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_queue.cpp, gs_ogl_render_queue.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderQueue                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Holds the quads added to a sprite batch as small commands tagged with a layer, and  |
+ |        hands them to the batch sorted by layer and, within layers that allow it, by blend  |
+ |        mode and texture, so quads sharing state end up in the same run.                    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_render_queue.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdlib.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+int  GS_OGLRenderQueue::m_nLayer         = 0;
+BOOL GS_OGLRenderQueue::m_bIsLayerSorted = FALSE;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::GS_OGLRenderQueue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderQueue::GS_OGLRenderQueue()
+{
+
+    m_pCommands = NULL;
+    m_ppSorted  = NULL;
+
+    m_nNumCommands  = 0;
+    m_nNumAllocated = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::~GS_OGLRenderQueue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderQueue::~GS_OGLRenderQueue()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Allocates room for the specified number of commands. The queue grows automatically
+//          if more commands are added, so this is only a starting size.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderQueue::Create(int nNumCommands)
+{
+
+    if (nNumCommands <= 0)
+    {
+        return FALSE;
+    }
+
+    // Destroy queue if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    if (!this->Allocate(nNumCommands))
+    {
+        GS_Error::Report("GS_OGL_RENDER_QUEUE.CPP", 116, "Failed to allocate render commands!");
+        return FALSE;
+    }
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees the commands.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderQueue::Destroy()
+{
+
+    if (m_pCommands)
+    {
+        delete [] m_pCommands;
+    }
+    m_pCommands = NULL;
+
+    if (m_ppSorted)
+    {
+        delete [] m_ppSorted;
+    }
+    m_ppSorted = NULL;
+
+    m_nNumCommands  = 0;
+    m_nNumAllocated = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::Allocate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Resizes the command arrays, keeping any commands already in the queue.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderQueue::Allocate(int nNumCommands)
+{
+
+    // Can't allocate space for less commands than currently in the queue.
+    if ((nNumCommands <= 0) || (nNumCommands < m_nNumCommands))
+    {
+        return FALSE;
+    }
+
+    GS_RenderCommand* pOldCommands = m_pCommands;
+
+    m_pCommands = new GS_RenderCommand[nNumCommands];
+
+    if (!m_pCommands)
+    {
+        m_pCommands = pOldCommands;
+        return FALSE;
+    }
+
+    // Copy any commands still waiting to be submitted to the new array.
+    if ((pOldCommands) && (m_nNumCommands > 0))
+    {
+        for (int nCommand = 0; nCommand < m_nNumCommands; nCommand++)
+        {
+            m_pCommands[nCommand] = pOldCommands[nCommand];
+        }
+    }
+
+    if (pOldCommands)
+    {
+        delete [] pOldCommands;
+    }
+
+    // The sort order is only built when the queue is submitted.
+    if (m_ppSorted)
+    {
+        delete [] m_ppSorted;
+    }
+
+    m_ppSorted = new GS_RenderCommand*[nNumCommands];
+
+    m_nNumAllocated = nNumCommands;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::AddQuad():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a quad to the current layer, taking the same parameters as
+//          GS_OGLSpriteBatch::AddQuad().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderQueue::AddQuad(GLuint gluTexture, int nBlendMode, const GLfloat* pVertices,
+                                const GLfloat* pTexCoords, const GS_OGLColor& gsColor)
+{
+
+    if ((!m_bIsReady) || (!pVertices) || (!pTexCoords))
+    {
+        return FALSE;
+    }
+
+    // Grow the queue if it is full.
+    if (m_nNumCommands >= m_nNumAllocated)
+    {
+        if (!this->Allocate(m_nNumAllocated * 2))
+        {
+            return FALSE;
+        }
+    }
+
+    GS_RenderCommand* pCommand = &m_pCommands[m_nNumCommands];
+
+    pCommand->nLayer     = m_nLayer;
+    pCommand->bIsSorted  = m_bIsLayerSorted;
+    pCommand->nBlendMode = nBlendMode;
+    pCommand->gluTexture = gluTexture;
+    pCommand->nOrder     = m_nNumCommands;
+    pCommand->gsColor    = gsColor;
+
+    memcpy(pCommand->glfVertices, pVertices, sizeof(pCommand->glfVertices));
+    memcpy(pCommand->glfTexCoords, pTexCoords, sizeof(pCommand->glfTexCoords));
+
+    m_nNumCommands++;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::CompareCommands():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Orders commands by layer and, for layers that may be sorted, then by blend mode and
+//          texture. Commands that are equal in all of those keep the order they were added in.
+// ---------------------------------------------------------------------------------------------
+// Returns: Less than, equal to or greater than zero as qsort() expects.
+//==============================================================================================
+
+int GS_OGLRenderQueue::CompareCommands(const void* pFirst, const void* pSecond)
+{
+
+    const GS_RenderCommand* pA = *(const GS_RenderCommand* const*) pFirst;
+    const GS_RenderCommand* pB = *(const GS_RenderCommand* const*) pSecond;
+
+    if (pA->nLayer != pB->nLayer)
+    {
+        return (pA->nLayer < pB->nLayer) ? -1 : 1;
+    }
+
+    // Quads that have to keep their order go first if a layer has both kinds.
+    if (pA->bIsSorted != pB->bIsSorted)
+    {
+        return (pA->bIsSorted) ? 1 : -1;
+    }
+
+    if (!pA->bIsSorted)
+    {
+        return pA->nOrder - pB->nOrder;
+    }
+
+    if (pA->nBlendMode != pB->nBlendMode)
+    {
+        return (pA->nBlendMode < pB->nBlendMode) ? -1 : 1;
+    }
+
+    if (pA->gluTexture != pB->gluTexture)
+    {
+        return (pA->gluTexture < pB->gluTexture) ? -1 : 1;
+    }
+
+    return pA->nOrder - pB->nOrder;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::Submit():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sorts the commands and adds them to the specified batch, which starts a new run
+//          whenever the blend mode or texture changes. The queue is empty afterwards.
+// ---------------------------------------------------------------------------------------------
+// Details: Within a sorted layer quads are reordered to group them by state, so anything that
+//          has to be drawn on top of something else in that layer must use a higher layer.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderQueue::Submit(GS_OGLSpriteBatch* pgsBatch)
+{
+
+    if ((!m_bIsReady) || (m_nNumCommands <= 0))
+    {
+        return;
+    }
+
+    int nLoop;
+
+    for (nLoop = 0; nLoop < m_nNumCommands; nLoop++)
+    {
+        m_ppSorted[nLoop] = &m_pCommands[nLoop];
+    }
+
+    qsort(m_ppSorted, m_nNumCommands, sizeof(GS_RenderCommand*), CompareCommands);
+
+    if (pgsBatch)
+    {
+        for (nLoop = 0; nLoop < m_nNumCommands; nLoop++)
+        {
+            GS_RenderCommand* pCommand = m_ppSorted[nLoop];
+
+            pgsBatch->AddQuad(pCommand->gluTexture, pCommand->nBlendMode, pCommand->glfVertices,
+                              pCommand->glfTexCoords, pCommand->gsColor);
+        }
+    }
+
+    m_nNumCommands = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::Clear():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Throws away all the commands in the queue and goes back to the first layer, which
+//          keeps the quads in the order they are rendered.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderQueue::Clear()
+{
+
+    m_nNumCommands   = 0;
+    m_nLayer         = 0;
+    m_bIsLayerSorted = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the queue has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderQueue::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::GetNumCommands():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of commands waiting to be submitted.
+//==============================================================================================
+
+int GS_OGLRenderQueue::GetNumCommands()
+{
+
+    return m_nNumCommands;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::SetLayer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the layer quads are added to from now on. Lower layers are drawn first. If
+//          bSortByState is TRUE the quads in the layer are grouped by blend mode and texture,
+//          otherwise they are drawn in the order they were rendered (use this for anything
+//          made of overlapping parts, like menus). When the batch the queue belongs to begins,
+//          the layer goes back to zero without sorting.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderQueue::SetLayer(int nLayer, BOOL bSortByState)
+{
+
+    m_nLayer         = nLayer;
+    m_bIsLayerSorted = bSortByState;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::GetLayer():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The layer quads are currently added to.
+//==============================================================================================
+
+int GS_OGLRenderQueue::GetLayer()
+{
+
+    return m_nLayer;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderQueue::IsLayerSorted():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks wether quads added to the current layer are grouped by state.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if quads in the current layer are grouped by state, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderQueue::IsLayerSorted()
+{
+
+    return m_bIsLayerSorted;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
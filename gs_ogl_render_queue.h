@@ -0,0 +1,128 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_queue.cpp, gs_ogl_render_queue.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderQueue                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Holds the quads added to a sprite batch as small commands tagged with a layer, and  |
+ |        hands them to the batch sorted by layer and, within layers that allow it, by blend  |
+ |        mode and texture, so quads sharing state end up in the same run.                    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_RENDER_QUEUE_H
+#define GS_OGL_RENDER_QUEUE_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_color.h"
+#include "gs_ogl_sprite_batch.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Queue defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_QUEUE_DEFAULT_COMMANDS 1024 // Number of commands initially allocated for a queue.
+//==============================================================================================
+
+
+//==============================================================================================
+// Render command structure (one textured quad, as given to GS_OGLSpriteBatch::AddQuad()).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_RENDER_COMMAND
+{
+    int         nLayer;          // Layer the quad was added to, lower layers are drawn first.
+    BOOL        bIsSorted;       // Wether the quad may be reordered within its layer.
+    int         nBlendMode;      // Blend mode of the quad (GS_BLEND_...).
+    GLuint      gluTexture;      // Texture of the quad.
+    int         nOrder;          // Position in the queue, keeps the sort stable.
+    GLfloat     glfVertices[8];  // Screen coordinates of the four corners.
+    GLfloat     glfTexCoords[8]; // Texture coordinates of the four corners.
+    GS_OGLColor gsColor;         // Modulate color of the quad.
+} GS_RenderCommand;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLRenderQueue : public GS_Object
+{
+
+private:
+
+    static int  m_nLayer;          // The layer new commands are added to.
+    static BOOL m_bIsLayerSorted;  // Wether those commands may be reordered within the layer.
+
+    GS_RenderCommand*  m_pCommands; // The commands in the order they were added.
+    GS_RenderCommand** m_ppSorted;  // The same commands in the order they are submitted.
+
+    int m_nNumCommands;  // Number of commands currently in the queue.
+    int m_nNumAllocated; // Number of commands for which space has been allocated.
+
+    BOOL m_bIsReady; // Wether the queue has been created or not.
+
+    BOOL Allocate(int nNumCommands);
+
+    static int CompareCommands(const void* pFirst, const void* pSecond);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLRenderQueue();
+    ~GS_OGLRenderQueue();
+
+    BOOL Create(int nNumCommands = GS_QUEUE_DEFAULT_COMMANDS);
+    void Destroy();
+
+    BOOL AddQuad(GLuint gluTexture, int nBlendMode, const GLfloat* pVertices,
+                 const GLfloat* pTexCoords, const GS_OGLColor& gsColor);
+
+    void Submit(GS_OGLSpriteBatch* pgsBatch);
+    void Clear();
+
+    BOOL IsReady();
+    int  GetNumCommands();
+
+    static void SetLayer(int nLayer, BOOL bSortByState = TRUE);
+    static int  GetLayer();
+    static BOOL IsLayerSorted();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
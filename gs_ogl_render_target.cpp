@@ -0,0 +1,583 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_target.cpp, gs_ogl_render_target.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderTarget                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: An offscreen texture (framebuffer object) that a mostly static part of the screen   |
+ |        can be rendered into once and then drawn as a single quad until it is invalidated.  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_render_target.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GS_OGLRenderTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderTarget::GS_OGLRenderTarget()
+{
+
+    m_gluFramebuffer = 0;
+    m_gluTexture     = 0;
+
+    m_nWidth  = 0;
+    m_nHeight = 0;
+
+    for (int nLoop = 0; nLoop < 4; nLoop++)
+    {
+        m_gliViewport[nLoop]   = 0;
+        m_glfClearColor[nLoop] = 0.0f;
+    }
+    m_gliFramebuffer = 0;
+
+    m_gliFilter = GL_NEAREST;
+
+    m_gsModulateColor = GS_OGLColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+    m_bIsRendering = FALSE;
+    m_bIsValid     = FALSE;
+    m_bIsReady     = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::~GS_OGLRenderTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLRenderTarget::~GS_OGLRenderTarget()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates a texture of the specified size in screen pixels and attaches it to a new
+//          framebuffer object. Fails quietly if framebuffer objects are not available, in which
+//          case the caller should simply render directly to the screen.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Create(int nWidth, int nHeight)
+{
+
+    // Destroy target if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    if (!GS_OGLExtensions::HasFramebuffers())
+    {
+        return FALSE;
+    }
+
+    // Create an empty RGBA texture to render into.
+    glGenTextures(1, &m_gluTexture);
+    GS_OGLState::BindTexture(m_gluTexture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_gliFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_gliFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, nWidth, nHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    // Attach the texture to a new framebuffer object.
+    gsglGenFramebuffers(1, &m_gluFramebuffer);
+    gsglBindFramebuffer(GL_FRAMEBUFFER, m_gluFramebuffer);
+    gsglFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_gluTexture, 0);
+
+    GLenum glStatus = gsglCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    gsglBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (glStatus != GL_FRAMEBUFFER_COMPLETE)
+    {
+        GS_Error::Report("GS_OGL_RENDER_TARGET.CPP", 136, "Framebuffer is not complete!");
+        gsglDeleteFramebuffers(1, &m_gluFramebuffer);
+        GS_OGLState::DeleteTexture(m_gluTexture);
+        m_gluFramebuffer = 0;
+        m_gluTexture     = 0;
+        return FALSE;
+    }
+
+    m_nWidth  = nWidth;
+    m_nHeight = nHeight;
+
+    m_bIsValid = FALSE;
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Deletes the framebuffer object and its texture.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::Destroy()
+{
+
+    if (m_bIsRendering)
+    {
+        this->End();
+    }
+
+    if ((m_gluFramebuffer) && (gsglDeleteFramebuffers))
+    {
+        gsglDeleteFramebuffers(1, &m_gluFramebuffer);
+    }
+
+    if (m_gluTexture)
+    {
+        GS_OGLState::DeleteTexture(m_gluTexture);
+    }
+
+    m_gluFramebuffer = 0;
+    m_gluTexture     = 0;
+
+    m_nWidth  = 0;
+    m_nHeight = 0;
+
+    m_bIsValid = FALSE;
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Begin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Redirects rendering into the target, which is cleared to transparent. The target
+//          covers the screen rectangle with the specified bottom left corner, so anything
+//          rendered between Begin() and End() can use the same coordinates as when rendering
+//          to the screen. Must be called between GS_OGLDisplay::BeginRender2D() and
+//          EndRender2D().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Begin(GLfloat glfLeft, GLfloat glfBottom)
+{
+
+    if ((!m_bIsReady) || (m_bIsRendering))
+    {
+        return FALSE;
+    }
+
+    // Anything batched so far belongs on the screen.
+    GS_OGLSpriteBatch::FlushActive();
+
+    // Save the framebuffer drawn to so far (another target may be rendering).
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_gliFramebuffer);
+
+    gsglBindFramebuffer(GL_FRAMEBUFFER, m_gluFramebuffer);
+
+    // Save the screen viewport and clear color.
+    glGetIntegerv(GL_VIEWPORT, m_gliViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, m_glfClearColor);
+
+    glViewport(0, 0, m_nWidth, m_nHeight);
+
+    // Map the target onto its part of the screen (same depth range as BeginRender2D()).
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::PushProjection();
+        GS_OGLCoreRenderer::SetOrtho(glfLeft, glfLeft + m_nWidth, glfBottom, glfBottom + m_nHeight,
+                                     -m_nWidth / 2, m_nWidth / 2);
+    }
+    else
+    {
+        GS_OGLState::SetMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(glfLeft, glfLeft + m_nWidth, glfBottom, glfBottom + m_nHeight,
+                -m_nWidth / 2, m_nWidth / 2);
+
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+    }
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // The software renderer draws into its own copy of the texture.
+    if (GS_SoftRenderer::IsActive())
+    {
+        GS_SoftRenderer::BeginTarget(m_gluTexture, m_nWidth, m_nHeight,
+                                     (m_gliFilter == GL_LINEAR));
+    }
+
+    m_bIsRendering = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::End():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finishes rendering into the target and restores rendering to the screen. The
+//          contents are considered valid until Invalidate() is called.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::End()
+{
+
+    if (!m_bIsRendering)
+    {
+        return;
+    }
+
+    // Draw anything batched while rendering into the target.
+    GS_OGLSpriteBatch::FlushActive();
+
+    if (GS_SoftRenderer::IsActive())
+    {
+        GS_SoftRenderer::EndTarget();
+    }
+
+    gsglBindFramebuffer(GL_FRAMEBUFFER, (GLuint) m_gliFramebuffer);
+
+    glViewport(m_gliViewport[0], m_gliViewport[1], m_gliViewport[2], m_gliViewport[3]);
+    glClearColor(m_glfClearColor[0], m_glfClearColor[1], m_glfClearColor[2],
+                 m_glfClearColor[3]);
+
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::PopProjection();
+    }
+    else
+    {
+        GS_OGLState::SetMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+    }
+
+    m_bIsRendering = FALSE;
+    m_bIsValid     = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Render():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the target as a single quad with its bottom left corner at the specified
+//          screen coordinates (already scaled, usually the same as passed to Begin()), using
+//          the current blending and the modulate color.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::Render(GLfloat glfDestX, GLfloat glfDestY)
+{
+
+    return this->RenderStretched(glfDestX, glfDestY, (GLfloat) m_nWidth, (GLfloat) m_nHeight);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::RenderStretched():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the target like Render(), stretched to the specified size in screen pixels
+//          and sampled with the filter set by SetFilter().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::RenderStretched(GLfloat glfDestX, GLfloat glfDestY,
+                                         GLfloat glfDestWidth, GLfloat glfDestHeight)
+{
+
+    if ((!m_bIsReady) || (!m_bIsValid) || (m_bIsRendering))
+    {
+        return FALSE;
+    }
+
+    GLfloat glfRight = glfDestX + glfDestWidth;
+    GLfloat glfTop   = glfDestY + glfDestHeight;
+
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    if ((pgsBatch != NULL) || (GS_OGLCoreRenderer::IsActive()))
+    {
+        GLfloat glfVertices[8]  = { glfDestX, glfDestY, glfRight, glfDestY,
+                                    glfRight, glfTop,   glfDestX, glfTop };
+        GLfloat glfTexCoords[8] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+
+        if (pgsBatch != NULL)
+        {
+            return pgsBatch->AddQuad(m_gluTexture, GS_BLEND_DEFAULT, glfVertices, glfTexCoords,
+                                     m_gsModulateColor);
+        }
+
+        GS_OGLCoreRenderer::DrawQuad(m_gluTexture, glfVertices, glfTexCoords, m_gsModulateColor);
+        return TRUE;
+    }
+
+    glLoadIdentity();
+
+    GS_OGLState::SetColor
+    (
+        m_gsModulateColor.fRed,
+        m_gsModulateColor.fGreen,
+        m_gsModulateColor.fBlue,
+        m_gsModulateColor.fAlpha
+    );
+
+    GS_OGLState::BindTexture(m_gluTexture);
+
+    glBegin(GL_QUADS);
+
+    glTexCoord2f(0.0f, 0.0f);
+    glVertex2f(glfDestX, glfDestY);
+
+    glTexCoord2f(1.0f, 0.0f);
+    glVertex2f(glfRight, glfDestY);
+
+    glTexCoord2f(1.0f, 1.0f);
+    glVertex2f(glfRight, glfTop);
+
+    glTexCoord2f(0.0f, 1.0f);
+    glVertex2f(glfDestX, glfTop);
+
+    glEnd();
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Access Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::Invalidate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Marks the contents as out of date, so the owner knows to render them again.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::Invalidate()
+{
+
+    m_bIsValid = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::IsValid():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the contents are up to date, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::IsValid()
+{
+
+    return m_bIsValid;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the target has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLRenderTarget::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::SetModulateColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the color the target is drawn with, use -1 to leave a component unchanged.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::SetModulateColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue,
+                                          GLfloat glfAlpha)
+{
+
+    if (glfRed   >= 0.0f) m_gsModulateColor.fRed   = glfRed;
+    if (glfGreen >= 0.0f) m_gsModulateColor.fGreen = glfGreen;
+    if (glfBlue  >= 0.0f) m_gsModulateColor.fBlue  = glfBlue;
+    if (glfAlpha >= 0.0f) m_gsModulateColor.fAlpha = glfAlpha;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::SetFilter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets how the target is sampled when drawn at another size, GL_NEAREST (the default,
+//          sharp pixels) or GL_LINEAR (smooth).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLRenderTarget::SetFilter(GLint gliFilter)
+{
+
+    m_gliFilter = (gliFilter == GL_LINEAR) ? GL_LINEAR : GL_NEAREST;
+
+    if (m_bIsReady)
+    {
+        GS_OGLState::BindTexture(m_gluTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_gliFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_gliFilter);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetWidth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width of the target in screen pixels.
+//==============================================================================================
+
+int GS_OGLRenderTarget::GetWidth()
+{
+
+    return m_nWidth;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of the target in screen pixels.
+//==============================================================================================
+
+int GS_OGLRenderTarget::GetHeight()
+{
+
+    return m_nHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLRenderTarget::GetTextureID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The texture holding the contents of the target.
+//==============================================================================================
+
+GLuint GS_OGLRenderTarget::GetTextureID()
+{
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_render_target.cpp, gs_ogl_render_target.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLRenderTarget                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: An offscreen texture (framebuffer object) that a mostly static part of the screen   |
+ |        can be rendered into once and then drawn as a single quad until it is invalidated.  |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_RENDER_TARGET_H
+#define GS_OGL_RENDER_TARGET_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_color.h"
+#include "gs_ogl_core_renderer.h"
+#include "gs_ogl_extensions.h"
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_state.h"
+#include "gs_soft_renderer.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLRenderTarget : public GS_Object
+{
+
+private:
+
+    GLuint m_gluFramebuffer; // The framebuffer object rendered into.
+    GLuint m_gluTexture;     // The texture attached to the framebuffer.
+
+    int m_nWidth;  // Size of the target in screen pixels.
+    int m_nHeight;
+
+    GLint   m_gliViewport[4];   // Viewport, clear color and framebuffer saved by Begin().
+    GLfloat m_glfClearColor[4];
+    GLint   m_gliFramebuffer;
+
+    GLint m_gliFilter; // Filter used when the target is drawn scaled (GL_NEAREST or GL_LINEAR).
+
+    GS_OGLColor m_gsModulateColor; // Color the target is drawn with.
+
+    BOOL m_bIsRendering; // Wether we are between Begin() and End().
+    BOOL m_bIsValid;     // Wether the contents are up to date.
+    BOOL m_bIsReady;     // Wether the target has been created or not.
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLRenderTarget();
+    ~GS_OGLRenderTarget();
+
+    BOOL Create(int nWidth, int nHeight);
+    void Destroy();
+
+    BOOL Begin(GLfloat glfLeft, GLfloat glfBottom);
+    void End();
+
+    BOOL Render(GLfloat glfDestX, GLfloat glfDestY);
+    BOOL RenderStretched(GLfloat glfDestX, GLfloat glfDestY, GLfloat glfDestWidth,
+                         GLfloat glfDestHeight);
+
+    void Invalidate();
+    BOOL IsValid();
+    BOOL IsReady();
+
+    void SetModulateColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha);
+    void SetFilter(GLint gliFilter);
+
+    int    GetWidth();
+    int    GetHeight();
+    GLuint GetTextureID();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
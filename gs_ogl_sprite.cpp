@@ -15,6 +15,7 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_sprite.h"
+#include "gs_math.h"
 //==============================================================================================
 
 
@@ -57,6 +58,11 @@ GS_OGLSprite::GS_OGLSprite()
     m_gliWidth  = 0.0f;
     m_gliHeight = 0.0f;
 
+    m_gliOffsetX    = 0;
+    m_gliOffsetY    = 0;
+    m_gliPageWidth  = 0;
+    m_gliPageHeight = 0;
+
     m_gliDestX = 0;
     m_gliDestY = 0;
 
@@ -77,6 +83,9 @@ GS_OGLSprite::GS_OGLSprite()
     m_gsModulateColor.fGreen = 1.0f;
     m_gsModulateColor.fBlue  = 1.0f;
     m_gsModulateColor.fAlpha = 1.0f;
+
+    m_pTargetData          = NULL;
+    m_nNumTargetsAllocated = 0;
 }
 
 
@@ -181,6 +190,12 @@ BOOL GS_OGLSprite::Create(const char* pszPathname, BOOL bFiltered, BOOL bMipmap)
     m_gliWidth  = m_gsTexture.GetWidth();
     m_gliHeight = m_gsTexture.GetHeight();
 
+    // Determine where the image is within the texture (it may share an atlas page).
+    m_gliOffsetX    = m_gsTexture.GetOffsetX();
+    m_gliOffsetY    = m_gsTexture.GetOffsetY();
+    m_gliPageWidth  = m_gsTexture.GetPageWidth();
+    m_gliPageHeight = m_gsTexture.GetPageHeight();
+
     // Set source rectangle to texture size.
     m_SourceRect.left   = 0;
     m_SourceRect.bottom = 0;
@@ -223,6 +238,12 @@ BOOL GS_OGLSprite::Create(GLuint glTexture, int nWidth, int nHeight)
     m_gliWidth  = nWidth;
     m_gliHeight = nHeight;
 
+    // The image covers the whole texture, use SetTextureRegion() if it doesn't.
+    m_gliOffsetX    = 0;
+    m_gliOffsetY    = 0;
+    m_gliPageWidth  = nWidth;
+    m_gliPageHeight = nHeight;
+
     // Set source rectangle to texture size.
     m_SourceRect.left   = 0;
     m_SourceRect.bottom = 0;
@@ -269,6 +290,11 @@ void GS_OGLSprite::Destroy()
     m_gliWidth  = 0.0f;
     m_gliHeight = 0.0f;
 
+    m_gliOffsetX    = 0;
+    m_gliOffsetY    = 0;
+    m_gliPageWidth  = 0;
+    m_gliPageHeight = 0;
+
     m_gliDestX = 0;
     m_gliDestY = 0;
 
@@ -287,6 +313,14 @@ void GS_OGLSprite::Destroy()
     m_gsModulateColor.fBlue  = 1.0f;
     m_gsModulateColor.fAlpha = 1.0f;
 
+    if (m_pTargetData)
+    {
+        delete[] m_pTargetData;
+        m_pTargetData = NULL;
+    }
+
+    m_nNumTargetsAllocated = 0;
+
     m_bIsReady = FALSE;
 }
 
@@ -318,37 +352,41 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
 
     RECT ClientRect;
 
-#ifdef GS_PLATFORM_WINDOWS
-    GetClientRect(hWnd, &ClientRect);
-#else
-    GS_Platform::GetClientRect(hWnd, &ClientRect);
-#endif
+    // Use the client rectangle stored for this frame instead of asking the window system.
+    GS_OGLState::GetClientRect(hWnd, &ClientRect);
 
     // Disable depth testing if enabled.
-    if (glIsEnabled(GL_DEPTH_TEST) == GL_TRUE)
-    {
-        glDisable(GL_DEPTH_TEST);
-        m_bDepthTestEnabled = TRUE;
-    }
-    else
-    {
-        m_bDepthTestEnabled = FALSE;
-    }
+    m_bDepthTestEnabled = GS_OGLState::IsDepthTestEnabled();
+    GS_OGLState::EnableDepthTest(FALSE);
 
     // Disable lighting if enabled.
-    if (glIsEnabled(GL_LIGHTING) == GL_TRUE)
-    {
-        glDisable(GL_LIGHTING);
-        m_bLightingEnabled = TRUE;
-    }
-    else
+    m_bLightingEnabled = GS_OGLState::IsLightingEnabled();
+    GS_OGLState::EnableLighting(FALSE);
+
+    // The shader renderer keeps its own projection.
+    if (GS_OGLCoreRenderer::IsActive())
     {
-        m_bLightingEnabled = FALSE;
+        GS_OGLCoreRenderer::PushProjection();
+
+        if (ClientRect.right >= ClientRect.top)
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.right-ClientRect.left)/2),
+                                         ((ClientRect.right-ClientRect.left)/2));
+        }
+        else
+        {
+            GS_OGLCoreRenderer::SetOrtho(0, ClientRect.right, 0, ClientRect.bottom,
+                                         -((ClientRect.top-ClientRect.bottom)/2),
+                                         ((ClientRect.top-ClientRect.bottom)/2));
+        }
+
+        return TRUE;
     }
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPushMatrix();              // Store the projection matrix.
-    glLoadIdentity();            // Reset the projection matrix.
+    GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+    glPushMatrix();                            // Store the projection matrix.
+    glLoadIdentity();                          // Reset the projection matrix.
 
     // Set up an ortho screen with the same dimensions as the client area of the current
     // window and with a depth large enough to rotate the entire screen around either
@@ -364,8 +402,8 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
                 ((ClientRect.top-ClientRect.bottom)/2));
     }
 
-    glMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
-    glPushMatrix();             // Store the modelview matrix.
+    GS_OGLState::SetMatrixMode(GL_MODELVIEW); // Select the modelview matrix.
+    glPushMatrix();                           // Store the modelview matrix.
 
     return TRUE;
 }
@@ -385,21 +423,28 @@ BOOL GS_OGLSprite::BeginRender(HWND hWnd)
 void GS_OGLSprite::EndRender()
 {
 
-    glMatrixMode(GL_PROJECTION); // Select the projection matrix.
-    glPopMatrix();               // Restore the old projection matrix.
-    glMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
-    glPopMatrix();               // Restore the old modelview matrix.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::PopProjection();     // Restore the old projection.
+    }
+    else
+    {
+        GS_OGLState::SetMatrixMode(GL_PROJECTION); // Select the projection matrix.
+        glPopMatrix();                             // Restore the old projection matrix.
+        GS_OGLState::SetMatrixMode(GL_MODELVIEW);  // Select the modelview matrix.
+        glPopMatrix();                             // Restore the old modelview matrix.
+    }
 
     // Was depth testing enabled?
     if (m_bDepthTestEnabled == TRUE)
     {
-        glEnable(GL_DEPTH_TEST);
+        GS_OGLState::EnableDepthTest(TRUE);
     }
 
     // Was lighting enabled?
     if (m_bLightingEnabled == TRUE)
     {
-        glEnable(GL_LIGHTING);
+        GS_OGLState::EnableLighting(TRUE);
     }
 }
 
@@ -423,9 +468,10 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
         return FALSE;
     }
 
-    // Setup display for 2D rendering.
+    // Setup display for 2D rendering (drawing any batched quads first).
     if (hWnd != NULL)
     {
+        GS_OGLSpriteBatch::FlushActive();
         this->BeginRender(hWnd);
     }
 
@@ -436,21 +482,6 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     GLfloat glfDestX = m_gliDestX * g_fScaleFactorX;
     GLfloat glfDestY = m_gliDestY * g_fScaleFactorY;
 
-    // Reset the modelview matrix.
-    glLoadIdentity();
-
-    // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-    glColor4f
-    (
-        m_gsModulateColor.fRed,
-        m_gsModulateColor.fGreen,
-        m_gsModulateColor.fBlue,
-        m_gsModulateColor.fAlpha
-    );
-
-    // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
-
     // Set default rotation point in the center of the source rectangle
     int nRotationPointX = (float((m_SourceRect.right-m_SourceRect.left))/2);
     int nRotationPointY = (float((m_SourceRect.top-m_SourceRect.bottom))/2);
@@ -473,6 +504,63 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     float fVertexHeight1 = float((nRotationPointY) * glfScaleY);
     float fVertexHeight2 = float((m_SourceRect.top - m_SourceRect.bottom - nRotationPointY) * glfScaleY);
 
+    // Determine the sprite dimensions as a factor of one, taking into account the coordinates
+    // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
+    float fLeft   = this->GetTexCoordU(m_SourceRect.left   + m_glfScrollX);
+    float fBottom = this->GetTexCoordV(m_SourceRect.bottom + m_glfScrollY);
+    float fRight  = this->GetTexCoordU(m_SourceRect.right  + m_glfScrollX);
+    float fTop    = this->GetTexCoordV(m_SourceRect.top    + m_glfScrollY);
+
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    BOOL bIsBatched = (hWnd == NULL) && (pgsBatch != NULL);
+
+    if ((bIsBatched) || (GS_OGLCoreRenderer::IsActive()))
+    {
+        GLfloat glfVertices[8];
+        GLfloat glfTexCoords[8] = { fLeft, fBottom, fRight, fBottom, fRight, fTop, fLeft, fTop };
+
+        // Transform the quad here instead of using the modelview matrix.
+        GS_OGLSpriteBatch::TransformQuad
+        (
+            glfDestX + g_fRenderModX + fVertexWidth1, glfDestY + g_fRenderModY + fVertexHeight1,
+            -fVertexWidth1, -fVertexHeight1, fVertexWidth2, fVertexHeight2,
+            m_glfRotateX, m_glfRotateY, m_glfRotateZ, glfVertices
+        );
+
+        if (bIsBatched)
+        {
+            return pgsBatch->AddQuad(m_gluTexture, GS_BLEND_DEFAULT, glfVertices, glfTexCoords,
+                                     m_gsModulateColor);
+        }
+
+        // Without a batch the shader renderer draws the quad on its own.
+        GS_OGLCoreRenderer::DrawQuad(m_gluTexture, glfVertices, glfTexCoords, m_gsModulateColor);
+
+        if (hWnd != NULL)
+        {
+            this->EndRender();
+        }
+
+        return TRUE;
+    }
+
+    // Reset the modelview matrix.
+    glLoadIdentity();
+
+    // Draw sprite in a different hue or even with transparency depending on the alpha factor.
+    GS_OGLState::SetColor
+    (
+        m_gsModulateColor.fRed,
+        m_gsModulateColor.fGreen,
+        m_gsModulateColor.fBlue,
+        m_gsModulateColor.fAlpha
+    );
+
+    // Select the sprite texture.
+    GS_OGLState::BindTexture(m_gluTexture);
+
     // Position the sprite (note that the sprite will be drawn around the rotation point).
     glTranslated(glfDestX + g_fRenderModX + fVertexWidth1, glfDestY + g_fRenderModY + fVertexHeight1, 0);
 
@@ -481,13 +569,6 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
     glRotatef(m_glfRotateY, 0.0f, 1.0f, 0.0f);
     glRotatef(m_glfRotateZ, 0.0f, 0.0f, 1.0f);
 
-    // Determine the sprite dimensions as a factor of one, taking into account the coordinates
-    // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
-    float fLeft   = (1.0f / (float)m_gliWidth)  * (m_SourceRect.left   + m_glfScrollX);
-    float fBottom = (1.0f / (float)m_gliHeight) * (m_SourceRect.bottom + m_glfScrollY);
-    float fRight  = (1.0f / (float)m_gliWidth)  * (m_SourceRect.right  + m_glfScrollX);
-    float fTop    = (1.0f / (float)m_gliHeight) * (m_SourceRect.top    + m_glfScrollY);
-
     // Start drawing a quad. In order for the sprite to be rotated correctly, the sprite has to
     // be drawn from the rotation point outwards.
     glBegin(GL_QUADS);
@@ -510,12 +591,6 @@ BOOL GS_OGLSprite::Render(HWND hWnd)
 
     glEnd();
 
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
     // Reset display after 2D rendering.
     if (hWnd != NULL)
     {
@@ -547,6 +622,9 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
         return FALSE;
     }
 
+    // Draw any batched quads first, the tiles are drawn directly.
+    GS_OGLSpriteBatch::FlushActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
@@ -571,7 +649,7 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
     if (bWrapAround)
     {
         // Create a scissor box that will automatically clip any rendering to fit.
-        glScissor
+        GS_OGLState::SetScissor
         (
             rcTileArea.left,
             rcTileArea.bottom,
@@ -580,11 +658,11 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
         );
 
         // Enable the scissor box.
-        glEnable(GL_SCISSOR_TEST);
+        GS_OGLState::EnableScissor(TRUE);
     }
 
     // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-    glColor4f
+    GS_OGLState::SetColor
     (
         m_gsModulateColor.fRed,
         m_gsModulateColor.fGreen,
@@ -593,7 +671,7 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
     );
 
     // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+    GS_OGLState::BindTexture(m_gluTexture);
 
     // Determine the scaled sprite dimensions and divide by two to take into account that the
     // sprite is drawn from the center outwards.
@@ -605,6 +683,34 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
     {
         for (int nDestX = rcTileArea.left; nDestX < (int)rcTileArea.right; nDestX+= nTileWidth)
         {
+            // The shader renderer gets each tile as a transformed quad.
+            if (GS_OGLCoreRenderer::IsActive())
+            {
+                GLfloat glfVertices[8];
+                GLfloat glfTexCoords[8] =
+                {
+                    this->GetTexCoordU(m_SourceRect.left   + m_glfScrollX),
+                    this->GetTexCoordV(m_SourceRect.bottom + m_glfScrollY),
+                    this->GetTexCoordU(m_SourceRect.right  + m_glfScrollX),
+                    this->GetTexCoordV(m_SourceRect.bottom + m_glfScrollY),
+                    this->GetTexCoordU(m_SourceRect.right  + m_glfScrollX),
+                    this->GetTexCoordV(m_SourceRect.top    + m_glfScrollY),
+                    this->GetTexCoordU(m_SourceRect.left   + m_glfScrollX),
+                    this->GetTexCoordV(m_SourceRect.top    + m_glfScrollY)
+                };
+
+                GS_OGLSpriteBatch::TransformQuad
+                (
+                    nDestX + g_fRenderModX + fHalfWidth, nDestY + g_fRenderModY + fHalfHeight,
+                    -fHalfWidth, -fHalfHeight, fHalfWidth, fHalfHeight,
+                    m_glfRotateX, m_glfRotateY, m_glfRotateZ, glfVertices
+                );
+
+                GS_OGLCoreRenderer::DrawQuad(m_gluTexture, glfVertices, glfTexCoords,
+                                             m_gsModulateColor);
+                continue;
+            }
+
             // Reset the modelview matrix.
             glLoadIdentity();
 
@@ -620,10 +726,10 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
 
             // Determine the sprite dimensions as a factor of one, taking into account the coords
             // of the source rectangle as well as how far the sprite is scrolled.
-            float fLeft   = (1.0f / (float)m_gliWidth)  * (m_SourceRect.left   + m_glfScrollX);
-            float fBottom = (1.0f / (float)m_gliHeight) * (m_SourceRect.bottom + m_glfScrollY);
-            float fRight  = (1.0f / (float)m_gliWidth)  * (m_SourceRect.right  + m_glfScrollX);
-            float fTop    = (1.0f / (float)m_gliHeight) * (m_SourceRect.top    + m_glfScrollY);
+            float fLeft   = this->GetTexCoordU(m_SourceRect.left   + m_glfScrollX);
+            float fBottom = this->GetTexCoordV(m_SourceRect.bottom + m_glfScrollY);
+            float fRight  = this->GetTexCoordU(m_SourceRect.right  + m_glfScrollX);
+            float fTop    = this->GetTexCoordV(m_SourceRect.top    + m_glfScrollY);
 
             // Start drawing a quad. In order for it to be rotated correctly, the sprite has to
             // be drawn from a center point outwards. If the center of the sprite is (0,0) then the
@@ -653,17 +759,11 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
         }
     }
 
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
     // Was clipping enabled?
     if (bWrapAround)
     {
         // Disable the scissor box.
-        glDisable(GL_SCISSOR_TEST);
+        GS_OGLState::EnableScissor(FALSE);
     }
 
     // Reset display after 2D rendering.
@@ -682,12 +782,360 @@ BOOL GS_OGLSprite::RenderTiles(RECT rcTileArea, BOOL bWrapAround, HWND hWnd)
 //==============================================================================================
 // GS_OGLSprite::RenderTargets():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Draws the sprite once for each of the specified targets. The corners and texture
+//          coordinates of all the targets are worked out on the CPU first, and the quads are
+//          then either added to the active sprite batch or drawn with a single vertex array.
+// ---------------------------------------------------------------------------------------------
+// Details: The targets are first copied into a structure-of-arrays (see GS_TargetStreams) so
+//          the loop that transforms them only does plain arithmetic on consecutive floats,
+//          which the compiler can turn into SSE2 or NEON code. A separate version of that loop
+//          is used when none of the targets are rotated and/or scaled.
 // ---------------------------------------------------------------------------------------------
 // Returns: TRUE if successfull, FALSE if not.
 //==============================================================================================
 
 BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, HWND hWnd)
+{
+
+    // Can't render if no valid sprite.
+    if ((!m_bIsReady) || (nNumTargets <= 0) || (NULL == pgsTargets))
+    {
+        return FALSE;
+    }
+
+    if (!this->AllocateTargets(nNumTargets))
+    {
+        return FALSE;
+    }
+
+    GS_TargetStreams gsStreams;
+
+    gsStreams.pDestX      = &m_pTargetData[0];
+    gsStreams.pDestY      = &m_pTargetData[nNumTargets];
+    gsStreams.pHalfWidth  = &m_pTargetData[nNumTargets * 2];
+    gsStreams.pHalfHeight = &m_pTargetData[nNumTargets * 3];
+    gsStreams.pScaleX     = &m_pTargetData[nNumTargets * 4];
+    gsStreams.pScaleY     = &m_pTargetData[nNumTargets * 5];
+    gsStreams.pM00        = &m_pTargetData[nNumTargets * 6];
+    gsStreams.pM01        = &m_pTargetData[nNumTargets * 7];
+    gsStreams.pM10        = &m_pTargetData[nNumTargets * 8];
+    gsStreams.pM11        = &m_pTargetData[nNumTargets * 9];
+
+    GLfloat* pVertices  = &m_pTargetData[nNumTargets * 10];
+    GLfloat* pTexCoords = &m_pTargetData[nNumTargets * 18];
+    GLfloat* pColors    = &m_pTargetData[nNumTargets * 26];
+
+    // The display scale factor alone is enough to need the scaling version.
+    bool bRotate = false;
+    bool bScale  = ((g_fScaleFactorX != 1.0f) || (g_fScaleFactorY != 1.0f));
+
+    for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
+    {
+        GS_RenderTarget* pgsTarget = &pgsTargets[nLoop];
+
+        gsStreams.pDestX[nLoop] = (pgsTarget->nDestX * g_fScaleFactorX) + g_fRenderModX;
+        gsStreams.pDestY[nLoop] = (pgsTarget->nDestY * g_fScaleFactorY) + g_fRenderModY;
+
+        gsStreams.pHalfWidth[nLoop]  = float(pgsTarget->nSrcRight - pgsTarget->nSrcLeft) / 2;
+        gsStreams.pHalfHeight[nLoop] = float(pgsTarget->nSrcTop - pgsTarget->nSrcBottom) / 2;
+
+        gsStreams.pScaleX[nLoop] = pgsTarget->fScaleX * g_fScaleFactorX;
+        gsStreams.pScaleY[nLoop] = pgsTarget->fScaleY * g_fScaleFactorY;
+
+        if ((pgsTarget->fScaleX != 1.0f) || (pgsTarget->fScaleY != 1.0f))
+        {
+            bScale = true;
+        }
+
+        if ((pgsTarget->fRotateX == 0.0f) && (pgsTarget->fRotateY == 0.0f) &&
+            (pgsTarget->fRotateZ == 0.0f))
+        {
+            gsStreams.pM00[nLoop] = 1.0f;
+            gsStreams.pM01[nLoop] = 0.0f;
+            gsStreams.pM10[nLoop] = 0.0f;
+            gsStreams.pM11[nLoop] = 1.0f;
+        }
+        else
+        {
+            float fSinX = GS_Sin(pgsTarget->fRotateX);
+            float fCosX = GS_Cos(pgsTarget->fRotateX);
+            float fSinY = GS_Sin(pgsTarget->fRotateY);
+            float fCosY = GS_Cos(pgsTarget->fRotateY);
+            float fSinZ = GS_Sin(pgsTarget->fRotateZ);
+            float fCosZ = GS_Cos(pgsTarget->fRotateZ);
+
+            // The same matrix GS_OGLSpriteBatch::TransformQuad() uses.
+            gsStreams.pM00[nLoop] = fCosY * fCosZ;
+            gsStreams.pM01[nLoop] = -fCosY * fSinZ;
+            gsStreams.pM10[nLoop] = (fCosX * fSinZ) + (fSinX * fSinY * fCosZ);
+            gsStreams.pM11[nLoop] = (fCosX * fCosZ) - (fSinX * fSinY * fSinZ);
+
+            bRotate = true;
+        }
+
+        // Determine the texture coordinates, taking into account how far the target is
+        // scrolled on the x- or y-axis.
+        float fLeft   = this->GetTexCoordU(pgsTarget->nSrcLeft   + pgsTarget->fScrollX);
+        float fBottom = this->GetTexCoordV(pgsTarget->nSrcBottom + pgsTarget->fScrollY);
+        float fRight  = this->GetTexCoordU(pgsTarget->nSrcRight  + pgsTarget->fScrollX);
+        float fTop    = this->GetTexCoordV(pgsTarget->nSrcTop    + pgsTarget->fScrollY);
+
+        GLfloat* pTexCoord = &pTexCoords[nLoop * 8];
+
+        pTexCoord[0] = fLeft;  pTexCoord[1] = fBottom;
+        pTexCoord[2] = fRight; pTexCoord[3] = fBottom;
+        pTexCoord[4] = fRight; pTexCoord[5] = fTop;
+        pTexCoord[6] = fLeft;  pTexCoord[7] = fTop;
+
+        GLfloat* pColor = &pColors[nLoop * 16];
+
+        for (int nCorner = 0; nCorner < 4; nCorner++)
+        {
+            pColor[(nCorner * 4)]     = pgsTarget->fRed;
+            pColor[(nCorner * 4) + 1] = pgsTarget->fGreen;
+            pColor[(nCorner * 4) + 2] = pgsTarget->fBlue;
+            pColor[(nCorner * 4) + 3] = pgsTarget->fAlpha;
+        }
+    }
+
+    // Work out the corners of all the targets.
+    if (bRotate)
+    {
+        if (bScale)
+        {
+            TransformTargets<true, true>(nNumTargets, gsStreams, pVertices);
+        }
+        else
+        {
+            TransformTargets<true, false>(nNumTargets, gsStreams, pVertices);
+        }
+    }
+    else
+    {
+        if (bScale)
+        {
+            TransformTargets<false, true>(nNumTargets, gsStreams, pVertices);
+        }
+        else
+        {
+            TransformTargets<false, false>(nNumTargets, gsStreams, pVertices);
+        }
+    }
+
+    // Is a sprite batch collecting the quads drawn inside BeginRender2D() and EndRender2D()?
+    GS_OGLSpriteBatch* pgsBatch = GS_OGLSpriteBatch::GetActive();
+
+    if ((hWnd == NULL) && (pgsBatch != NULL))
+    {
+        for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
+        {
+            GS_OGLColor gsColor;
+
+            gsColor.fRed   = pgsTargets[nLoop].fRed;
+            gsColor.fGreen = pgsTargets[nLoop].fGreen;
+            gsColor.fBlue  = pgsTargets[nLoop].fBlue;
+            gsColor.fAlpha = pgsTargets[nLoop].fAlpha;
+
+            if (!pgsBatch->AddQuad(m_gluTexture, GS_BLEND_DEFAULT, &pVertices[nLoop * 8],
+                                   &pTexCoords[nLoop * 8], gsColor))
+            {
+                return FALSE;
+            }
+        }
+
+        return TRUE;
+    }
+
+    // Draw any batched quads first, the targets are drawn directly.
+    GS_OGLSpriteBatch::FlushActive();
+
+    // Setup display for 2D rendering.
+    if (hWnd != NULL)
+    {
+        this->BeginRender(hWnd);
+    }
+
+    // Without a batch the shader renderer draws the quads one at a time.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
+        {
+            GS_OGLColor gsColor(pColors[nLoop * 16], pColors[(nLoop * 16) + 1],
+                                pColors[(nLoop * 16) + 2], pColors[(nLoop * 16) + 3]);
+
+            GS_OGLCoreRenderer::DrawQuad(m_gluTexture, &pVertices[nLoop * 8],
+                                         &pTexCoords[nLoop * 8], gsColor);
+        }
+
+        if (hWnd != NULL)
+        {
+            this->EndRender();
+        }
+
+        return TRUE;
+    }
+
+    // The vertices are already in screen coordinates.
+    glLoadIdentity();
+
+    // Select the sprite texture.
+    GS_OGLState::BindTexture(m_gluTexture);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    glVertexPointer(2, GL_FLOAT, 0, pVertices);
+    glTexCoordPointer(2, GL_FLOAT, 0, pTexCoords);
+    glColorPointer(4, GL_FLOAT, 0, pColors);
+
+    glDrawArrays(GL_QUADS, 0, nNumTargets * 4);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    // The color array leaves the current color undefined.
+    GS_OGLState::InvalidateColor();
+
+    // Reset display after 2D rendering.
+    if (hWnd != NULL)
+    {
+        this->EndRender();
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::TransformTargets():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Works out the four corners (bottom left, bottom right, top right and top left) of
+//          each target in the streams and writes them to pVertices as x,y pairs. Each target
+//          is rotated around its center. Without bRotate the rotation matrix is ignored, and
+//          without bScale the half sizes are used as they are.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+template <bool bRotate, bool bScale>
+void GS_OGLSprite::TransformTargets(int nNumTargets, const GS_TargetStreams& gsStreams,
+                                    GLfloat* pVertices)
+{
+
+    const GLfloat* pDestX      = gsStreams.pDestX;
+    const GLfloat* pDestY      = gsStreams.pDestY;
+    const GLfloat* pHalfWidth  = gsStreams.pHalfWidth;
+    const GLfloat* pHalfHeight = gsStreams.pHalfHeight;
+
+    for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
+    {
+        GLfloat glfHalfWidth  = pHalfWidth[nLoop];
+        GLfloat glfHalfHeight = pHalfHeight[nLoop];
+
+        if (bScale)
+        {
+            glfHalfWidth  *= gsStreams.pScaleX[nLoop];
+            glfHalfHeight *= gsStreams.pScaleY[nLoop];
+        }
+
+        GLfloat* pQuad = &pVertices[nLoop * 8];
+
+        if (bRotate)
+        {
+            GLfloat glfCenterX = pDestX[nLoop] + glfHalfWidth;
+            GLfloat glfCenterY = pDestY[nLoop] + glfHalfHeight;
+
+            // Half of the rotated bottom edge and half of the rotated left edge.
+            GLfloat glfEdgeXX = gsStreams.pM00[nLoop] * glfHalfWidth;
+            GLfloat glfEdgeXY = gsStreams.pM10[nLoop] * glfHalfWidth;
+            GLfloat glfEdgeYX = gsStreams.pM01[nLoop] * glfHalfHeight;
+            GLfloat glfEdgeYY = gsStreams.pM11[nLoop] * glfHalfHeight;
+
+            pQuad[0] = glfCenterX - glfEdgeXX - glfEdgeYX;
+            pQuad[1] = glfCenterY - glfEdgeXY - glfEdgeYY;
+            pQuad[2] = glfCenterX + glfEdgeXX - glfEdgeYX;
+            pQuad[3] = glfCenterY + glfEdgeXY - glfEdgeYY;
+            pQuad[4] = glfCenterX + glfEdgeXX + glfEdgeYX;
+            pQuad[5] = glfCenterY + glfEdgeXY + glfEdgeYY;
+            pQuad[6] = glfCenterX - glfEdgeXX + glfEdgeYX;
+            pQuad[7] = glfCenterY - glfEdgeXY + glfEdgeYY;
+        }
+        else
+        {
+            GLfloat glfLeft   = pDestX[nLoop];
+            GLfloat glfBottom = pDestY[nLoop];
+            GLfloat glfRight  = glfLeft + (glfHalfWidth * 2);
+            GLfloat glfTop    = glfBottom + (glfHalfHeight * 2);
+
+            pQuad[0] = glfLeft;  pQuad[1] = glfBottom;
+            pQuad[2] = glfRight; pQuad[3] = glfBottom;
+            pQuad[4] = glfRight; pQuad[5] = glfTop;
+            pQuad[6] = glfLeft;  pQuad[7] = glfTop;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::AllocateTargets():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes sure the scratch space used by RenderTargets() has room for the specified
+//          number of targets (its contents are rebuilt every time the targets are drawn).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSprite::AllocateTargets(int nNumTargets)
+{
+
+    if (nNumTargets <= m_nNumTargetsAllocated)
+    {
+        return TRUE;
+    }
+
+    if (m_pTargetData)
+    {
+        delete[] m_pTargetData;
+    }
+
+    m_nNumTargetsAllocated = 0;
+
+    m_pTargetData = new GLfloat[nNumTargets * GS_TARGET_FLOATS];
+
+    if (!m_pTargetData)
+    {
+        GS_Error::Report("GS_OGL_SPRITE.CPP", 1024, "Failed to allocate render target data!");
+        return FALSE;
+    }
+
+    m_nNumTargetsAllocated = nNumTargets;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::RenderTargetsImmediate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the sprite once for each of the specified targets, one quad at a time using
+//          the modelview matrix. This is slower than RenderTargets() and is only kept to
+//          compare against it (without the fixed-function pipeline it simply calls it).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSprite::RenderTargetsImmediate(int nNumTargets, GS_RenderTarget* pgsTargets, HWND hWnd)
 {
     GLfloat glfScaleX;
     GLfloat glfScaleY;
@@ -700,6 +1148,15 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
         return FALSE;
     }
 
+    // There is no modelview matrix to use with the shader renderer.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        return this->RenderTargets(nNumTargets, pgsTargets, hWnd);
+    }
+
+    // Draw any batched quads first, the targets are drawn directly.
+    GS_OGLSpriteBatch::FlushActive();
+
     // Setup display for 2D rendering.
     if (hWnd != NULL)
     {
@@ -709,7 +1166,7 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
     float fHalfWidth, fHalfHeight, fLeft, fBottom, fRight, fTop;
 
     // Select the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, m_gluTexture);
+    GS_OGLState::BindTexture(m_gluTexture);
 
     // Start rendering multipile objects.
     for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
@@ -721,18 +1178,20 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
         glfDestX = pgsTargets[nLoop].nDestX * g_fScaleFactorX;
         glfDestY = pgsTargets[nLoop].nDestY * g_fScaleFactorY;
 
+        // The source rectangle is in texture pixels, the scale factor is already part of the
+        // scale above (like in Render()).
         RECT rcDestRect;
-        rcDestRect.left   = pgsTargets[nLoop].nSrcLeft * g_fScaleFactorX;
-        rcDestRect.top    = pgsTargets[nLoop].nSrcTop * g_fScaleFactorY;
-        rcDestRect.right  = pgsTargets[nLoop].nSrcRight * g_fScaleFactorX;
-        rcDestRect.bottom = pgsTargets[nLoop].nSrcBottom * g_fScaleFactorY;
+        rcDestRect.left   = pgsTargets[nLoop].nSrcLeft;
+        rcDestRect.top    = pgsTargets[nLoop].nSrcTop;
+        rcDestRect.right  = pgsTargets[nLoop].nSrcRight;
+        rcDestRect.bottom = pgsTargets[nLoop].nSrcBottom;
 
         // Reset the modelview matrix.
         glLoadIdentity();
 
         // Draw sprite in a different hue or even with transparency depending on the alpha factor.
-        glColor4f(pgsTargets[nLoop].fRed, pgsTargets[nLoop].fGreen, pgsTargets[nLoop].fBlue,
-                  pgsTargets[nLoop].fAlpha);
+        GS_OGLState::SetColor(pgsTargets[nLoop].fRed, pgsTargets[nLoop].fGreen,
+                              pgsTargets[nLoop].fBlue, pgsTargets[nLoop].fAlpha);
 
         // Determine the scaled sprite dimensions and divide by two to take into account that the
         // sprite is drawn from the center outwards.
@@ -751,10 +1210,10 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
 
         // Determine the sprite dimensions as a factor of one, taking into account the coordinates
         // of the source rectangle as well as how far the sprite is scrolled on the x- or y-axis.
-        fLeft   = (1.0f / (float)m_gliWidth) * (rcDestRect.left + pgsTargets[nLoop].fScrollX);
-        fBottom = (1.0f / (float)m_gliHeight) * (rcDestRect.bottom + pgsTargets[nLoop].fScrollY);
-        fRight  = (1.0f / (float)m_gliWidth) * (rcDestRect.right + pgsTargets[nLoop].fScrollX);
-        fTop    = (1.0f / (float)m_gliHeight) * (rcDestRect.top + pgsTargets[nLoop].fScrollY);
+        fLeft   = this->GetTexCoordU(rcDestRect.left + pgsTargets[nLoop].fScrollX);
+        fBottom = this->GetTexCoordV(rcDestRect.bottom + pgsTargets[nLoop].fScrollY);
+        fRight  = this->GetTexCoordU(rcDestRect.right + pgsTargets[nLoop].fScrollX);
+        fTop    = this->GetTexCoordV(rcDestRect.top + pgsTargets[nLoop].fScrollY);
 
         // Start drawing a quad. In order for the sprite to be rotated correctly, the sprite has to
         // be drawn from a center point outwards. If the center of the sprite is (0, 0) then the
@@ -782,12 +1241,6 @@ BOOL GS_OGLSprite::RenderTargets(int nNumTargets, GS_RenderTarget* pgsTargets, H
         glEnd();
     }
 
-    // Unselect the sprite texture.
-    glBindTexture(GL_TEXTURE_2D, 0);  // Use 0 instead of NULL
-
-    // Reset the color for other textures to white.
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
     // Reset display after 2D rendering.
     if (hWnd != NULL)
     {
@@ -1565,6 +2018,84 @@ GLint GS_OGLSprite::GetTextureHeight()
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+//==============================================================================================
+// GS_OGLSprite::GetTextureID():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The OpenGL name of the sprite texture.
+//==============================================================================================
+
+GLuint GS_OGLSprite::GetTextureID()
+{
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::SetTextureRegion():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Tells the sprite its image is only part of the texture it was created with, as is
+//          the case for images packed into a texture atlas. Source rectangles stay relative to
+//          the image itself.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSprite::SetTextureRegion(GLint gliOffsetX, GLint gliOffsetY, GLint gliPageWidth,
+                                    GLint gliPageHeight)
+{
+
+    m_gliOffsetX    = gliOffsetX;
+    m_gliOffsetY    = gliOffsetY;
+    m_gliPageWidth  = gliPageWidth;
+    m_gliPageHeight = gliPageHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::GetTexCoordU():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a horizontal position in the sprite image to a texture coordinate.
+// ---------------------------------------------------------------------------------------------
+// Returns: The texture coordinate as a factor of one.
+//==============================================================================================
+
+GLfloat GS_OGLSprite::GetTexCoordU(GLfloat glfPixelX)
+{
+
+    return (1.0f / (float)m_gliPageWidth) * (m_gliOffsetX + glfPixelX);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSprite::GetTexCoordV():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a vertical position in the sprite image to a texture coordinate.
+// ---------------------------------------------------------------------------------------------
+// Returns: The texture coordinate as a factor of one.
+//==============================================================================================
+
+GLfloat GS_OGLSprite::GetTexCoordV(GLfloat glfPixelY)
+{
+
+    return (1.0f / (float)m_gliPageHeight) * (m_gliOffsetY + glfPixelY);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
 //==============================================================================================
 // GS_OGLSprite::GetScaledWidth():
 // ---------------------------------------------------------------------------------------------
@@ -41,6 +41,8 @@
 #include "gs_error.h"
 #include "gs_ogl_texture.h"
 #include "gs_ogl_color.h"
+#include "gs_ogl_core_renderer.h"
+#include "gs_ogl_sprite_batch.h"
 //==============================================================================================
 
 
@@ -90,6 +92,34 @@ typedef struct GS_RENDER_TARGET
 //==============================================================================================
 
 
+//==============================================================================================
+// Structure-of-arrays copy of a GS_RenderTarget array, used to transform all the targets at
+// once in GS_OGLSprite::RenderTargets() (each pointer points to one value per target).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_TARGET_STREAMS
+{
+    GLfloat* pDestX;      // Bottom left corner in screen coordinates.
+    GLfloat* pDestY;
+    GLfloat* pHalfWidth;  // Half the size of the source rectangle (before scaling).
+    GLfloat* pHalfHeight;
+    GLfloat* pScaleX;     // Target scale multiplied by the display scale factor.
+    GLfloat* pScaleY;
+    GLfloat* pM00;        // The upper left 2x2 part of the rotation matrix.
+    GLfloat* pM01;
+    GLfloat* pM10;
+    GLfloat* pM11;
+} GS_TargetStreams;
+//==============================================================================================
+
+
+//==============================================================================================
+// Number of floats of scratch space RenderTargets() needs per target (ten streams, eight
+// vertex coordinates, eight texture coordinates and four colors).
+// ---------------------------------------------------------------------------------------------
+#define GS_TARGET_FLOATS 42
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Class Definition. ///////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,6 +143,11 @@ private:
     GLint m_gliWidth;  // The actual width of the sprite.
     GLint m_gliHeight; // The actual height of the sprite.
 
+    GLint m_gliOffsetX;    // Position of the sprite image within the texture (non-zero when the
+    GLint m_gliOffsetY;    // image was packed into a texture atlas).
+    GLint m_gliPageWidth;  // The width of the texture holding the sprite image.
+    GLint m_gliPageHeight; // The height of the texture holding the sprite image.
+
     GLint m_gliDestX; // The destination X position of the bottom left corner of the sprite.
     GLint m_gliDestY; // The destination Y position of the bottom left corner of the sprite.
 
@@ -132,6 +167,15 @@ private:
 
     GS_OGLColor m_gsModulateColor; // Color to modulate the sprite with.
 
+    GLfloat* m_pTargetData;          // Scratch space used by RenderTargets().
+    int      m_nNumTargetsAllocated; // Number of targets the scratch space has room for.
+
+    BOOL AllocateTargets(int nNumTargets);
+
+    template <bool bRotate, bool bScale>
+    static void TransformTargets(int nNumTargets, const GS_TargetStreams& gsStreams,
+                                 GLfloat* pVertices);
+
 protected:
 
     // ...
@@ -150,6 +194,8 @@ public:
     BOOL Render(HWND hWnd = NULL);
     BOOL RenderTiles(RECT rcDestRect, BOOL bClipRect = TRUE, HWND hWnd = NULL);
     BOOL RenderTargets(int nNumTargets, GS_RenderTarget* gsTargets = NULL, HWND hWnd = NULL);
+    BOOL RenderTargetsImmediate(int nNumTargets, GS_RenderTarget* gsTargets = NULL,
+                                HWND hWnd = NULL);
 
     BOOL IsReady();
 
@@ -208,6 +254,12 @@ public:
 
     GLint GetTextureWidth();
     GLint GetTextureHeight();
+    GLuint GetTextureID();
+
+    void SetTextureRegion(GLint gliOffsetX, GLint gliOffsetY, GLint gliPageWidth,
+                          GLint gliPageHeight);
+    GLfloat GetTexCoordU(GLfloat glfPixelX);
+    GLfloat GetTexCoordV(GLfloat glfPixelY);
 
     GLfloat GetScaledWidth();
     GLfloat GetScaledHeight();
@@ -0,0 +1,676 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_sprite_batch.cpp, gs_ogl_sprite_batch.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLSpriteBatch                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Collects pre-transformed textured quads in a client-side vertex array and draws     |
+ |        each run of quads sharing the same texture and blend mode with one glDrawArrays.    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_sprite_batch.h"
+#include "gs_ogl_core_renderer.h"
+#include "gs_ogl_render_queue.h"
+#include "gs_math.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+GS_OGLSpriteBatch* GS_OGLSpriteBatch::m_pActiveBatch = NULL;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::GS_OGLSpriteBatch():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data to defaults when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLSpriteBatch::GS_OGLSpriteBatch()
+{
+
+    m_pVertices = NULL;
+
+    m_nNumVertices  = 0;
+    m_nNumAllocated = 0;
+
+    m_gluTexture = 0;
+    m_nBlendMode = GS_BLEND_DEFAULT;
+
+    m_pQueue        = NULL;
+    m_bIsSubmitting = FALSE;
+
+    m_nNumQuads     = 0;
+    m_nNumDrawCalls = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::~GS_OGLSpriteBatch():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed and frees
+//          all memory used by it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLSpriteBatch::~GS_OGLSpriteBatch()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Allocates the vertex array with room for the specified number of quads. The array
+//          grows automatically if more quads are added, so this is only a starting size.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSpriteBatch::Create(int nNumQuads)
+{
+
+    // Can't create a batch without room for at least one quad.
+    if (nNumQuads <= 0)
+    {
+        return FALSE;
+    }
+
+    // Destroy batch if created previously.
+    if (m_bIsReady)
+    {
+        this->Destroy();
+    }
+
+    // Allocate space for four vertices per quad.
+    this->Allocate(nNumQuads * 4);
+
+    if (!m_pVertices)
+    {
+        GS_Error::Report("GS_OGL_SPRITE_BATCH.CPP", 124, "Failed to allocate batch vertices!");
+        return FALSE;
+    }
+
+    m_bIsReady = TRUE;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::Destroy()
+{
+
+    if (!m_bIsReady)
+    {
+        return;
+    }
+
+    // Make sure Render() calls are no longer routed to this batch.
+    if (m_pActiveBatch == this)
+    {
+        m_pActiveBatch = NULL;
+    }
+
+    if (m_pVertices)
+    {
+        delete [] m_pVertices;
+    }
+    m_pVertices = NULL;
+
+    m_nNumVertices  = 0;
+    m_nNumAllocated = 0;
+
+    m_gluTexture = 0;
+    m_nBlendMode = GS_BLEND_DEFAULT;
+
+    m_pQueue        = NULL;
+    m_bIsSubmitting = FALSE;
+
+    m_nNumQuads     = 0;
+    m_nNumDrawCalls = 0;
+
+    m_bIsReady = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Memory Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::Allocate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Resizes the vertex array, keeping any vertices already in it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::Allocate(int nNumVertices)
+{
+
+    // Can't allocate space for less vertices than currently in the array.
+    if ((nNumVertices <= 0) || (nNumVertices < m_nNumVertices))
+    {
+        return;
+    }
+
+    GS_BatchVertex* pOldVertices = m_pVertices;
+
+    m_nNumAllocated = nNumVertices;
+    m_pVertices     = new GS_BatchVertex[m_nNumAllocated];
+
+    // Copy any vertices still waiting to be drawn to the new array.
+    if ((pOldVertices) && (m_nNumVertices > 0))
+    {
+        memcpy(m_pVertices, pOldVertices, m_nNumVertices * sizeof(GS_BatchVertex));
+    }
+
+    if (pOldVertices)
+    {
+        delete [] pOldVertices;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Render Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::Begin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the active batch, meaning that GS_OGLSprite::Render() and
+//          GS_OGLParticle::Render() calls made without a window handle (i.e. inside
+//          BeginRender2D() and EndRender2D()) add their quads to it instead of drawing them.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSpriteBatch::Begin()
+{
+
+    if (!m_bIsReady)
+    {
+        return FALSE;
+    }
+
+    // Draw whatever another batch may still be holding.
+    if ((m_pActiveBatch) && (m_pActiveBatch != this))
+    {
+        m_pActiveBatch->End();
+    }
+
+    m_nNumVertices  = 0;
+    m_nNumQuads     = 0;
+    m_nNumDrawCalls = 0;
+
+    // Start the frame with an empty queue on the first layer.
+    if (m_pQueue)
+    {
+        m_pQueue->Clear();
+    }
+
+    m_pActiveBatch = this;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::End():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws any remaining quads and stops routing Render() calls into the batch.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::End()
+{
+
+    this->Flush();
+
+    if (m_pActiveBatch == this)
+    {
+        m_pActiveBatch = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::Flush():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws all quads currently in the vertex array with a single glDrawArrays call.
+// ---------------------------------------------------------------------------------------------
+// Details: This has to be called before anything changes GL state the batched quads depend on
+//          (scissor box, blending, matrices) or draws directly, otherwise the quads would be
+//          drawn with the wrong state or in the wrong order.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::Flush()
+{
+
+    // Add the queued quads in sorted order first (which draws each run as it is completed).
+    if ((m_bIsReady) && (m_pQueue) && (!m_bIsSubmitting))
+    {
+        m_bIsSubmitting = TRUE;
+        m_pQueue->Submit(this);
+        m_bIsSubmitting = FALSE;
+    }
+
+    // Nothing to do if the batch holds no quads.
+    if ((!m_bIsReady) || (m_nNumVertices <= 0))
+    {
+        return;
+    }
+
+    GLenum glSrcFactor, glDstFactor;
+
+    // Save blending parameters.
+    BOOL bIsBlendingEnabled = GS_OGLState::IsBlendingEnabled();
+    GS_OGLState::GetBlendFunc(&glSrcFactor, &glDstFactor);
+
+    // Do the quads need a specific blend mode?
+    if (m_nBlendMode != GS_BLEND_DEFAULT)
+    {
+        if (m_nBlendMode == GS_BLEND_ADDITIVE)
+        {
+            GS_OGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        }
+        else
+        {
+            GS_OGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        GS_OGLState::EnableBlending(TRUE);
+    }
+
+    // Select the texture shared by all the quads.
+    GS_OGLState::BindTexture(m_gluTexture);
+
+    // Let the shader renderer draw the quads if it is active.
+    if (GS_OGLCoreRenderer::IsActive())
+    {
+        GS_OGLCoreRenderer::DrawQuads(m_pVertices, m_nNumVertices);
+    }
+    else
+    {
+        // The vertices are already in screen coordinates.
+        glLoadIdentity();
+
+        // Point OpenGL to the interleaved vertex data.
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+
+        glVertexPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fX);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fU);
+        glColorPointer(4, GL_FLOAT, sizeof(GS_BatchVertex), &m_pVertices[0].fRed);
+
+        // Draw all the quads at once.
+        glDrawArrays(GL_QUADS, 0, m_nNumVertices);
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+
+        // Drawing with a color array leaves the current color undefined.
+        GS_OGLState::InvalidateColor();
+    }
+
+    // Restore the blending state if it was changed.
+    if (m_nBlendMode != GS_BLEND_DEFAULT)
+    {
+        GS_OGLState::SetBlendFunc(glSrcFactor, glDstFactor);
+        GS_OGLState::EnableBlending(bIsBlendingEnabled);
+    }
+
+    m_nNumVertices = 0;
+    m_nNumDrawCalls++;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::AddQuad():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds a quad to the batch. The vertices (four x,y pairs) must already be in screen
+//          coordinates and are given in the order bottom left, bottom right, top right and
+//          top left, as are the texture coordinates. If the texture or blend mode differs
+//          from the quads already in the batch, those are drawn first.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSpriteBatch::AddQuad(GLuint gluTexture, int nBlendMode, const GLfloat* pVertices,
+                                const GLfloat* pTexCoords, const GS_OGLColor& gsColor)
+{
+
+    if ((!m_bIsReady) || (!pVertices) || (!pTexCoords))
+    {
+        return FALSE;
+    }
+
+    // Let the queue hold on to the quad until the batch is flushed.
+    if ((m_pQueue) && (!m_bIsSubmitting))
+    {
+        return m_pQueue->AddQuad(gluTexture, nBlendMode, pVertices, pTexCoords, gsColor);
+    }
+
+    // Start a new run if the state differs from the quads already in the batch.
+    if ((m_nNumVertices > 0) && ((gluTexture != m_gluTexture) || (nBlendMode != m_nBlendMode)))
+    {
+        this->Flush();
+    }
+
+    m_gluTexture = gluTexture;
+    m_nBlendMode = nBlendMode;
+
+    // Grow the vertex array if it is full.
+    if (m_nNumVertices + 4 > m_nNumAllocated)
+    {
+        this->Allocate(m_nNumAllocated * 2);
+    }
+
+    GS_BatchVertex* pVertex = &m_pVertices[m_nNumVertices];
+
+    for (int nLoop = 0; nLoop < 4; nLoop++)
+    {
+        pVertex[nLoop].fX     = pVertices[nLoop * 2];
+        pVertex[nLoop].fY     = pVertices[nLoop * 2 + 1];
+        pVertex[nLoop].fU     = pTexCoords[nLoop * 2];
+        pVertex[nLoop].fV     = pTexCoords[nLoop * 2 + 1];
+        pVertex[nLoop].fRed   = gsColor.fRed;
+        pVertex[nLoop].fGreen = gsColor.fGreen;
+        pVertex[nLoop].fBlue  = gsColor.fBlue;
+        pVertex[nLoop].fAlpha = gsColor.fAlpha;
+    }
+
+    m_nNumVertices += 4;
+    m_nNumQuads++;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::TransformQuad():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Does on the CPU what glTranslated() followed by glRotatef() on the X, Y and Z-axis
+//          does for a single quad, so it can be added to a batch. The quad edges are given
+//          relative to the point the quad rotates around (glfCenterX, glfCenterY) and the
+//          result is written to pVertices as four x,y pairs (bottom left, bottom right, top
+//          right and top left).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::TransformQuad(GLfloat glfCenterX, GLfloat glfCenterY, GLfloat glfLeft,
+                                      GLfloat glfBottom, GLfloat glfRight, GLfloat glfTop,
+                                      GLfloat glfRotateX, GLfloat glfRotateY,
+                                      GLfloat glfRotateZ, GLfloat* pVertices)
+{
+
+    GLfloat glfCornersX[4] = { glfLeft,   glfRight,  glfRight, glfLeft };
+    GLfloat glfCornersY[4] = { glfBottom, glfBottom, glfTop,   glfTop  };
+
+    // Most sprites are not rotated at all, so just translate them.
+    if ((glfRotateX == 0.0f) && (glfRotateY == 0.0f) && (glfRotateZ == 0.0f))
+    {
+        for (int nLoop = 0; nLoop < 4; nLoop++)
+        {
+            pVertices[nLoop * 2]     = glfCenterX + glfCornersX[nLoop];
+            pVertices[nLoop * 2 + 1] = glfCenterY + glfCornersY[nLoop];
+        }
+        return;
+    }
+
+    float fSinX = GS_Sin(glfRotateX);
+    float fCosX = GS_Cos(glfRotateX);
+    float fSinY = GS_Sin(glfRotateY);
+    float fCosY = GS_Cos(glfRotateY);
+    float fSinZ = GS_Sin(glfRotateZ);
+    float fCosZ = GS_Cos(glfRotateZ);
+
+    // The upper left 2x2 part of Rx * Ry * Rz, the depth is dropped by the ortho projection.
+    float fM00 = fCosY * fCosZ;
+    float fM01 = -fCosY * fSinZ;
+    float fM10 = (fCosX * fSinZ) + (fSinX * fSinY * fCosZ);
+    float fM11 = (fCosX * fCosZ) - (fSinX * fSinY * fSinZ);
+
+    for (int nLoop = 0; nLoop < 4; nLoop++)
+    {
+        pVertices[nLoop * 2]     = glfCenterX + (fM00 * glfCornersX[nLoop]) + (fM01 * glfCornersY[nLoop]);
+        pVertices[nLoop * 2 + 1] = glfCenterY + (fM10 * glfCornersX[nLoop]) + (fM11 * glfCornersY[nLoop]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Get/Set Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::IsReady():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the batch has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSpriteBatch::IsReady()
+{
+
+    return m_bIsReady;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::IsActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if Render() calls are currently routed into this batch, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLSpriteBatch::IsActive()
+{
+
+    return (m_pActiveBatch == this);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::GetNumQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of quads added since Begin() was last called.
+//==============================================================================================
+
+int GS_OGLSpriteBatch::GetNumQuads()
+{
+
+    return m_nNumQuads;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::GetNumDrawCalls():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of draw calls issued since Begin() was last called.
+//==============================================================================================
+
+int GS_OGLSpriteBatch::GetNumDrawCalls()
+{
+
+    return m_nNumDrawCalls;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::SetQueue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Puts a render queue in front of the batch (NULL removes it). Quads added to the
+//          batch are then held by the queue and added in sorted order when the batch is
+//          flushed, so a flush also acts as a barrier between what was drawn before and after.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::SetQueue(GS_OGLRenderQueue* pgsQueue)
+{
+
+    // Draw whatever the current queue is holding.
+    this->Flush();
+
+    m_pQueue = pgsQueue;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::GetQueue():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A pointer to the render queue in front of the batch, NULL if there is none.
+//==============================================================================================
+
+GS_OGLRenderQueue* GS_OGLSpriteBatch::GetQueue()
+{
+
+    return m_pQueue;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: A pointer to the active batch, NULL if there is none.
+//==============================================================================================
+
+GS_OGLSpriteBatch* GS_OGLSpriteBatch::GetActive()
+{
+
+    return m_pActiveBatch;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteBatch::FlushActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Flushes the active batch, if any. Called by code that draws directly or changes
+//          GL state so that batched quads are drawn first.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteBatch::FlushActive()
+{
+
+    if (m_pActiveBatch)
+    {
+        m_pActiveBatch->Flush();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_sprite_batch.cpp, gs_ogl_sprite_batch.h                                      |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLSpriteBatch                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Collects pre-transformed textured quads in a client-side vertex array and draws     |
+ |        each run of quads sharing the same texture and blend mode with one glDrawArrays.    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_SPRITE_BATCH_H
+#define GS_OGL_SPRITE_BATCH_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_color.h"
+#include "gs_ogl_state.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_BLEND_DEFAULT  0 // Use whatever blending is currently set (sprites, fonts, maps).
+#define GS_BLEND_ALPHA    1 // Standard alpha blending (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+#define GS_BLEND_ADDITIVE 2 // Additive blending (GL_SRC_ALPHA, GL_ONE) as used by particles.
+// ---------------------------------------------------------------------------------------------
+#define GS_BATCH_DEFAULT_QUADS 1024 // Number of quads initially allocated for a batch.
+//==============================================================================================
+
+
+//==============================================================================================
+// Forward declarations.
+// ---------------------------------------------------------------------------------------------
+class GS_OGLRenderQueue;
+//==============================================================================================
+
+
+//==============================================================================================
+// Batch vertex structure (interleaved so it can be handed to OpenGL as is).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_BATCH_VERTEX
+{
+    GLfloat fX;     // Screen coordinates of the vertex.
+    GLfloat fY;
+    GLfloat fU;     // Texture coordinates of the vertex.
+    GLfloat fV;
+    GLfloat fRed;   // Modulate color of the vertex.
+    GLfloat fGreen;
+    GLfloat fBlue;
+    GLfloat fAlpha;
+} GS_BatchVertex;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLSpriteBatch : public GS_Object
+{
+
+private:
+
+    static GS_OGLSpriteBatch* m_pActiveBatch; // The batch Render() calls are routed into.
+
+    GS_BatchVertex* m_pVertices; // The client-side vertex array holding the batched quads.
+
+    int m_nNumVertices;  // Number of vertices currently in the array.
+    int m_nNumAllocated; // Number of vertices for which space has been allocated.
+
+    GLuint m_gluTexture; // The texture used by the quads currently in the array.
+    int    m_nBlendMode; // The blend mode used by the quads currently in the array.
+
+    GS_OGLRenderQueue* m_pQueue;  // Queue sorting the quads before they are added, if any.
+    BOOL m_bIsSubmitting;         // Wether the queue is currently adding its quads.
+
+    int m_nNumQuads;     // Number of quads submitted since the batch was started.
+    int m_nNumDrawCalls; // Number of draw calls issued since the batch was started.
+
+    BOOL m_bIsReady; // Wether the batch has been created or not.
+
+    void Allocate(int nNumVertices);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLSpriteBatch();
+    ~GS_OGLSpriteBatch();
+
+    BOOL Create(int nNumQuads = GS_BATCH_DEFAULT_QUADS);
+    void Destroy();
+
+    BOOL Begin();
+    void End();
+    void Flush();
+
+    BOOL AddQuad(GLuint gluTexture, int nBlendMode, const GLfloat* pVertices,
+                 const GLfloat* pTexCoords, const GS_OGLColor& gsColor);
+
+    BOOL IsReady();
+    BOOL IsActive();
+
+    int GetNumQuads();
+    int GetNumDrawCalls();
+
+    void SetQueue(GS_OGLRenderQueue* pgsQueue);
+    GS_OGLRenderQueue* GetQueue();
+
+    static GS_OGLSpriteBatch* GetActive();
+    static void FlushActive();
+
+    static void TransformQuad(GLfloat glfCenterX, GLfloat glfCenterY, GLfloat glfLeft,
+                              GLfloat glfBottom, GLfloat glfRight, GLfloat glfTop,
+                              GLfloat glfRotateX, GLfloat glfRotateY, GLfloat glfRotateZ,
+                              GLfloat* pVertices);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -440,4 +440,37 @@ GLfloat GS_OGLSpriteEx::GetFrameHeight()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLSpriteEx::GetFrameRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the texture coordinates (in pixels) of the specified frame, the frame
+//          number is clamped the same way SetFrame() does.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLSpriteEx::GetFrameRect(int nFrame, RECT* pFrameRect)
+{
+
+    if ((!pFrameRect) || (!m_pFrameRects) || (m_nTotalFrames <= 0))
+    {
+        return;
+    }
+
+    if (nFrame >= m_nTotalFrames)
+    {
+        nFrame = m_nTotalFrames - 1;
+    }
+    else if (nFrame < 0)
+    {
+        nFrame = 0;
+    }
+
+    *pFrameRect = m_pFrameRects[nFrame];
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,745 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_state.cpp, gs_ogl_state.h                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLState                                                                         |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Shadow copy of the OpenGL state changed by the GS_OGL* classes. State changes that  |
+ |        would not change anything are skipped and queries are answered without asking the  |
+ |        driver. GS_OGLDisplay resets the cache when it creates the rendering context.       |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_state.h"
+#include "gs_soft_renderer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+BOOL GS_OGLState::m_bIsFixedFunction = TRUE;
+
+GLuint GS_OGLState::m_gluTexture      = 0;
+BOOL   GS_OGLState::m_bIsTextureKnown = FALSE;
+// ---------------------------------------------------------------------------------------------
+GLfloat GS_OGLState::m_glfColor[4]   = { 1.0f, 1.0f, 1.0f, 1.0f };
+BOOL    GS_OGLState::m_bIsColorKnown = FALSE;
+// ---------------------------------------------------------------------------------------------
+BOOL   GS_OGLState::m_bIsBlendingEnabled = FALSE;
+GLenum GS_OGLState::m_glBlendSrc         = GL_ONE;
+GLenum GS_OGLState::m_glBlendDst         = GL_ZERO;
+// ---------------------------------------------------------------------------------------------
+BOOL  GS_OGLState::m_bIsScissorEnabled = FALSE;
+GLint GS_OGLState::m_gliScissor[4]     = { 0, 0, 0, 0 };
+// ---------------------------------------------------------------------------------------------
+BOOL GS_OGLState::m_bIsDepthTestEnabled = FALSE;
+BOOL GS_OGLState::m_bIsLightingEnabled  = FALSE;
+// ---------------------------------------------------------------------------------------------
+GLenum GS_OGLState::m_glMatrixMode = GL_MODELVIEW;
+// ---------------------------------------------------------------------------------------------
+HWND GS_OGLState::m_hWnd         = NULL;
+RECT GS_OGLState::m_rcClientRect = { 0, 0, 0, 0 };
+// ---------------------------------------------------------------------------------------------
+int GS_OGLState::m_nNumCalls            = 0;
+int GS_OGLState::m_nNumSkippedCalls     = 0;
+int GS_OGLState::m_nLastNumCalls        = 0;
+int GS_OGLState::m_nLastNumSkippedCalls = 0;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame Methods. //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::Reset():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Puts the OpenGL state covered by the cache into a known state so that it never has
+//          to be read back from the driver. Must be called with the rendering context current
+//          (GS_OGLDisplay::Create() does this). Without the fixed-function pipeline (a core
+//          profile context) the color, lighting and matrix mode are only tracked, not set.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::Reset(BOOL bFixedFunction)
+{
+
+    m_bIsFixedFunction = bFixedFunction;
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_gluTexture      = 0;
+    m_bIsTextureKnown = TRUE;
+
+    if (m_bIsFixedFunction)
+    {
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    m_glfColor[0]   = 1.0f;
+    m_glfColor[1]   = 1.0f;
+    m_glfColor[2]   = 1.0f;
+    m_glfColor[3]   = 1.0f;
+    m_bIsColorKnown = TRUE;
+
+    glDisable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ZERO);
+    m_bIsBlendingEnabled = FALSE;
+    m_glBlendSrc         = GL_ONE;
+    m_glBlendDst         = GL_ZERO;
+
+    glDisable(GL_SCISSOR_TEST);
+    m_bIsScissorEnabled = FALSE;
+    m_gliScissor[0]     = -1;
+    m_gliScissor[1]     = -1;
+    m_gliScissor[2]     = -1;
+    m_gliScissor[3]     = -1;
+
+    glDisable(GL_DEPTH_TEST);
+    m_bIsDepthTestEnabled = FALSE;
+
+    if (m_bIsFixedFunction)
+    {
+        glDisable(GL_LIGHTING);
+        glMatrixMode(GL_MODELVIEW);
+    }
+    m_bIsLightingEnabled = FALSE;
+    m_glMatrixMode       = GL_MODELVIEW;
+
+    m_hWnd = NULL;
+
+    m_nNumCalls            = 0;
+    m_nNumSkippedCalls     = 0;
+    m_nLastNumCalls        = 0;
+    m_nLastNumSkippedCalls = 0;
+}
+
+
+//==============================================================================================
+// GS_OGLState::IsFixedFunction():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Checks wether the state was reset for a context with the fixed-function pipeline.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if it was, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsFixedFunction()
+{
+
+    return m_bIsFixedFunction;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::BeginFrame():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Keeps the call counts of the previous frame and starts counting from zero.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::BeginFrame()
+{
+
+    m_nLastNumCalls        = m_nNumCalls;
+    m_nLastNumSkippedCalls = m_nNumSkippedCalls;
+
+    m_nNumCalls        = 0;
+    m_nNumSkippedCalls = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::IsRedundant():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Counts a state call and wether it was skipped.
+// ---------------------------------------------------------------------------------------------
+// Returns: The value passed in.
+//==============================================================================================
+
+BOOL GS_OGLState::IsRedundant(BOOL bIsRedundant)
+{
+
+    m_nNumCalls++;
+
+    if (bIsRedundant)
+    {
+        m_nNumSkippedCalls++;
+    }
+
+    return bIsRedundant;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::BindTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Binds a 2D texture unless it is already bound.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::BindTexture(GLuint gluTexture)
+{
+
+    if (IsRedundant((m_bIsTextureKnown) && (m_gluTexture == gluTexture)))
+    {
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, gluTexture);
+    m_gluTexture      = gluTexture;
+    m_bIsTextureKnown = TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLState::DeleteTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Deletes a texture, OpenGL binds texture 0 if the texture was bound at the time.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::DeleteTexture(GLuint gluTexture)
+{
+
+    glDeleteTextures(1, &gluTexture);
+
+    // Forget the copy the software renderer may have made of it.
+    GS_SoftRenderer::ReleaseTexture(gluTexture);
+
+    if (m_gluTexture == gluTexture)
+    {
+        m_gluTexture = 0;
+    }
+}
+
+
+//==============================================================================================
+// GS_OGLState::InvalidateTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets the bound texture, for code that binds textures without going through the
+//          cache.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::InvalidateTexture()
+{
+
+    m_bIsTextureKnown = FALSE;
+}
+
+
+//==============================================================================================
+// GS_OGLState::GetTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the bound texture, only asking the driver if it isn't known.
+// ---------------------------------------------------------------------------------------------
+// Returns: The bound texture.
+//==============================================================================================
+
+GLuint GS_OGLState::GetTexture()
+{
+
+    if (!m_bIsTextureKnown)
+    {
+        GLint gliTexture = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &gliTexture);
+        m_gluTexture      = (GLuint) gliTexture;
+        m_bIsTextureKnown = TRUE;
+    }
+
+    return m_gluTexture;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Color Methods. //////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::SetColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the current color unless it is already set.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha)
+{
+
+    if (IsRedundant((m_bIsColorKnown) && (m_glfColor[0] == glfRed) &&
+                    (m_glfColor[1] == glfGreen) && (m_glfColor[2] == glfBlue) &&
+                    (m_glfColor[3] == glfAlpha)))
+    {
+        return;
+    }
+
+    if (m_bIsFixedFunction)
+    {
+        glColor4f(glfRed, glfGreen, glfBlue, glfAlpha);
+    }
+    m_glfColor[0]   = glfRed;
+    m_glfColor[1]   = glfGreen;
+    m_glfColor[2]   = glfBlue;
+    m_glfColor[3]   = glfAlpha;
+    m_bIsColorKnown = TRUE;
+}
+
+
+//==============================================================================================
+// GS_OGLState::InvalidateColor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets the current color. Must be called after drawing with a color array, which
+//          leaves the current color undefined.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::InvalidateColor()
+{
+
+    m_bIsColorKnown = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Blending Methods. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::EnableBlending():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enables or disables blending unless it already is.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::EnableBlending(BOOL bEnable)
+{
+
+    if (IsRedundant((m_bIsBlendingEnabled != FALSE) == (bEnable != FALSE)))
+    {
+        return;
+    }
+
+    if (bEnable)
+    {
+        glEnable(GL_BLEND);
+    }
+    else
+    {
+        glDisable(GL_BLEND);
+    }
+    m_bIsBlendingEnabled = bEnable;
+}
+
+
+//==============================================================================================
+// GS_OGLState::SetBlendFunc():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the blend factors unless they are already set.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetBlendFunc(GLenum glSourceFactor, GLenum glDestFactor)
+{
+
+    if (IsRedundant((m_glBlendSrc == glSourceFactor) && (m_glBlendDst == glDestFactor)))
+    {
+        return;
+    }
+
+    glBlendFunc(glSourceFactor, glDestFactor);
+    m_glBlendSrc = glSourceFactor;
+    m_glBlendDst = glDestFactor;
+}
+
+
+//==============================================================================================
+// GS_OGLState::IsBlendingEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if blending is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsBlendingEnabled()
+{
+
+    return m_bIsBlendingEnabled;
+}
+
+
+//==============================================================================================
+// GS_OGLState::GetBlendFunc():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the current blend factors.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::GetBlendFunc(GLenum* pSourceFactor, GLenum* pDestFactor)
+{
+
+    if (pSourceFactor)
+    {
+        *pSourceFactor = m_glBlendSrc;
+    }
+
+    if (pDestFactor)
+    {
+        *pDestFactor = m_glBlendDst;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Capability Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::EnableScissor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enables or disables the scissor test unless it already is.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::EnableScissor(BOOL bEnable)
+{
+
+    if (IsRedundant((m_bIsScissorEnabled != FALSE) == (bEnable != FALSE)))
+    {
+        return;
+    }
+
+    if (bEnable)
+    {
+        glEnable(GL_SCISSOR_TEST);
+    }
+    else
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+    m_bIsScissorEnabled = bEnable;
+}
+
+
+//==============================================================================================
+// GS_OGLState::SetScissor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the scissor box unless it is already set.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetScissor(GLint gliX, GLint gliY, GLsizei glWidth, GLsizei glHeight)
+{
+
+    if (IsRedundant((m_gliScissor[0] == gliX) && (m_gliScissor[1] == gliY) &&
+                    (m_gliScissor[2] == glWidth) && (m_gliScissor[3] == glHeight)))
+    {
+        return;
+    }
+
+    glScissor(gliX, gliY, glWidth, glHeight);
+    m_gliScissor[0] = gliX;
+    m_gliScissor[1] = gliY;
+    m_gliScissor[2] = glWidth;
+    m_gliScissor[3] = glHeight;
+}
+
+
+//==============================================================================================
+// GS_OGLState::IsScissorEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the scissor test is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsScissorEnabled()
+{
+
+    return m_bIsScissorEnabled;
+}
+
+
+//==============================================================================================
+// GS_OGLState::GetScissor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the scissor box (x, y, width and height).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::GetScissor(GLint* pScissor)
+{
+
+    if (pScissor)
+    {
+        pScissor[0] = m_gliScissor[0];
+        pScissor[1] = m_gliScissor[1];
+        pScissor[2] = m_gliScissor[2];
+        pScissor[3] = m_gliScissor[3];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::EnableDepthTest():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enables or disables depth testing unless it already is.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::EnableDepthTest(BOOL bEnable)
+{
+
+    if (IsRedundant((m_bIsDepthTestEnabled != FALSE) == (bEnable != FALSE)))
+    {
+        return;
+    }
+
+    if (bEnable)
+    {
+        glEnable(GL_DEPTH_TEST);
+    }
+    else
+    {
+        glDisable(GL_DEPTH_TEST);
+    }
+    m_bIsDepthTestEnabled = bEnable;
+}
+
+
+//==============================================================================================
+// GS_OGLState::IsDepthTestEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if depth testing is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsDepthTestEnabled()
+{
+
+    return m_bIsDepthTestEnabled;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::EnableLighting():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Enables or disables lighting unless it already is.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::EnableLighting(BOOL bEnable)
+{
+
+    if (IsRedundant((m_bIsLightingEnabled != FALSE) == (bEnable != FALSE)))
+    {
+        return;
+    }
+
+    if (m_bIsFixedFunction)
+    {
+        if (bEnable)
+        {
+            glEnable(GL_LIGHTING);
+        }
+        else
+        {
+            glDisable(GL_LIGHTING);
+        }
+    }
+    m_bIsLightingEnabled = bEnable;
+}
+
+
+//==============================================================================================
+// GS_OGLState::IsLightingEnabled():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if lighting is enabled, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLState::IsLightingEnabled()
+{
+
+    return m_bIsLightingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::SetMatrixMode():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Selects the matrix stack unless it is already selected.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetMatrixMode(GLenum glMode)
+{
+
+    if (IsRedundant(m_glMatrixMode == glMode))
+    {
+        return;
+    }
+
+    if (m_bIsFixedFunction)
+    {
+        glMatrixMode(glMode);
+    }
+    m_glMatrixMode = glMode;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Window Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::SetClientRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stores the client rectangle of the window, GS_OGLDisplay::BeginRender2D() does
+//          this once every frame so a resized window is picked up.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::SetClientRect(HWND hWnd, RECT rcClientRect)
+{
+
+    m_hWnd         = hWnd;
+    m_rcClientRect = rcClientRect;
+}
+
+
+//==============================================================================================
+// GS_OGLState::GetClientRect():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the client rectangle of the window, only asking the window system if the
+//          rectangle of that window has not been stored yet.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLState::GetClientRect(HWND hWnd, RECT* pClientRect)
+{
+
+    if (!pClientRect)
+    {
+        return;
+    }
+
+    if (IsRedundant((hWnd != NULL) && (hWnd == m_hWnd)))
+    {
+        *pClientRect = m_rcClientRect;
+        return;
+    }
+
+#ifdef GS_PLATFORM_WINDOWS
+    ::GetClientRect(hWnd, pClientRect);
+#else
+    GS_Platform::GetClientRect(hWnd, pClientRect);
+#endif
+
+    m_hWnd         = hWnd;
+    m_rcClientRect = *pClientRect;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Statistics Methods. /////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLState::GetNumCalls():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of state calls made during the previous frame.
+//==============================================================================================
+
+int GS_OGLState::GetNumCalls()
+{
+
+    return m_nLastNumCalls;
+}
+
+
+//==============================================================================================
+// GS_OGLState::GetNumSkippedCalls():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of state calls skipped during the previous frame.
+//==============================================================================================
+
+int GS_OGLState::GetNumSkippedCalls()
+{
+
+    return m_nLastNumSkippedCalls;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_state.cpp, gs_ogl_state.h                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLState                                                                         |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Shadow copy of the OpenGL state changed by the GS_OGL* classes. State changes that  |
+ |        would not change anything are skipped and queries are answered without asking the  |
+ |        driver. GS_OGLDisplay resets the cache when it creates the rendering context.       |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_STATE_H
+#define GS_OGL_STATE_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLState
+{
+
+private:
+
+    static BOOL m_bIsFixedFunction; // Wether the context has the fixed-function pipeline.
+
+    static GLuint m_gluTexture;      // The currently bound texture.
+    static BOOL   m_bIsTextureKnown; // Wether the bound texture is known.
+
+    static GLfloat m_glfColor[4];  // The current color.
+    static BOOL    m_bIsColorKnown; // Wether the current color is known.
+
+    static BOOL   m_bIsBlendingEnabled; // Wether blending is enabled.
+    static GLenum m_glBlendSrc;         // The current blend factors.
+    static GLenum m_glBlendDst;
+
+    static BOOL  m_bIsScissorEnabled; // Wether the scissor test is enabled.
+    static GLint m_gliScissor[4];     // The current scissor box.
+
+    static BOOL m_bIsDepthTestEnabled; // Wether depth testing is enabled.
+    static BOOL m_bIsLightingEnabled;  // Wether lighting is enabled.
+
+    static GLenum m_glMatrixMode; // The current matrix mode.
+
+    static HWND m_hWnd;         // The window the cached client rectangle belongs to.
+    static RECT m_rcClientRect; // The cached client rectangle of the window.
+
+    static int m_nNumCalls;          // Number of state calls made during the current frame.
+    static int m_nNumSkippedCalls;   // Number of those calls that were skipped.
+    static int m_nLastNumCalls;      // The same counts for the previous frame.
+    static int m_nLastNumSkippedCalls;
+
+    static BOOL IsRedundant(BOOL bIsRedundant);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    static void Reset(BOOL bFixedFunction = TRUE);
+    static BOOL IsFixedFunction();
+    static void BeginFrame();
+
+    static void BindTexture(GLuint gluTexture);
+    static void DeleteTexture(GLuint gluTexture);
+    static void InvalidateTexture();
+    static GLuint GetTexture();
+
+    static void SetColor(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha);
+    static void InvalidateColor();
+
+    static void EnableBlending(BOOL bEnable);
+    static void SetBlendFunc(GLenum glSourceFactor, GLenum glDestFactor);
+    static BOOL IsBlendingEnabled();
+    static void GetBlendFunc(GLenum* pSourceFactor, GLenum* pDestFactor);
+
+    static void EnableScissor(BOOL bEnable);
+    static void SetScissor(GLint gliX, GLint gliY, GLsizei glWidth, GLsizei glHeight);
+    static BOOL IsScissorEnabled();
+    static void GetScissor(GLint* pScissor);
+
+    static void EnableDepthTest(BOOL bEnable);
+    static BOOL IsDepthTestEnabled();
+
+    static void EnableLighting(BOOL bEnable);
+    static BOOL IsLightingEnabled();
+
+    static void SetMatrixMode(GLenum glMode);
+
+    static void SetClientRect(HWND hWnd, RECT rcClientRect);
+    static void GetClientRect(HWND hWnd, RECT* pClientRect);
+
+    static int GetNumCalls();
+    static int GetNumSkippedCalls();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -15,6 +15,8 @@
 // Include Game System (GS) header files.
 // ---------------------------------------------------------------------------------------------
 #include "gs_ogl_texture.h"
+#include "gs_ogl_texture_atlas.h"
+#include "gs_soft_renderer.h"
 //==============================================================================================
 
 
@@ -101,11 +103,41 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
     m_gsTextureInfo.nBpp      = m_gsImage.GetColorBytes();
     m_gsTextureInfo.bHasAlpha = m_gsImage.HasAlpha();
 
+    // Pack the image into the active texture atlas if there is one and it has room for it.
+    GS_OGLTextureAtlas* pAtlas = GS_OGLTextureAtlas::GetActive();
+
+    int nPageSize = 0;
+
+    if ((pAtlas) && (pAtlas->Insert(m_gsImage.GetData(), m_gsTextureInfo.nWidth,
+                                    m_gsTextureInfo.nHeight, m_gsTextureInfo.nBpp,
+                                    gsTextureType, glMinFilter, glMagFilter,
+                                    &m_gsTextureInfo.glID, &m_gsTextureInfo.nOffsetX,
+                                    &m_gsTextureInfo.nOffsetY, &nPageSize)))
+    {
+        m_gsTextureInfo.glFormat    = GL_RGBA;
+        m_gsTextureInfo.nPageWidth  = nPageSize;
+        m_gsTextureInfo.nPageHeight = nPageSize;
+        m_gsTextureInfo.bIsInAtlas  = TRUE;
+
+        m_gsImage.Destroy();
+
+        m_gsTextureInfo.bIsReady = TRUE;
+
+        return TRUE;
+    }
+
+    // The image gets a texture of its own.
+    m_gsTextureInfo.nOffsetX    = 0;
+    m_gsTextureInfo.nOffsetY    = 0;
+    m_gsTextureInfo.nPageWidth  = m_gsTextureInfo.nWidth;
+    m_gsTextureInfo.nPageHeight = m_gsTextureInfo.nHeight;
+    m_gsTextureInfo.bIsInAtlas  = FALSE;
+
     // Generate an OpenGL texture ID for one texture.
     glGenTextures(1, &m_gsTextureInfo.glID);
 
     // Bind the texture ID to the texture.
-    glBindTexture(GL_TEXTURE_2D, m_gsTextureInfo.glID);
+    GS_OGLState::BindTexture(m_gsTextureInfo.glID);
 
     // Determine the color format of the image. GL_RGB tells OpenGL the image data is made up of
     // red, green and blue data in that order, GL_RGBA includes an alpha channel.
@@ -136,7 +168,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
         // Zero is the border. It's usually left at zero. The next paramter specifies the data
         // format. GL_UNSIGNED_BYTE means the data that makes up the image is made up of unsigned
         // bytes, and finally... a pointer that tells OpenGL where to get the actual texture data.
-        glTexImage2D(GL_TEXTURE_2D, 0, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
+        glTexImage2D(GL_TEXTURE_2D, 0, m_gsTextureInfo.glFormat, m_gsTextureInfo.nWidth,
                      m_gsTextureInfo.nHeight, 0, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
                      m_gsImage.GetData());
     }
@@ -152,11 +184,16 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
         // height of 64*64,128*128 or 256*256 the gluBuild2DMipmaps() function has no such limits
         // and you can use any size image you want since OpenGL will automatically size it to the
         // proper width and height.
-        gluBuild2DMipmaps(GL_TEXTURE_2D, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
+        gluBuild2DMipmaps(GL_TEXTURE_2D, m_gsTextureInfo.glFormat, m_gsTextureInfo.nWidth,
                           m_gsTextureInfo.nHeight, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
                           m_gsImage.GetData());
     }
 
+    // The software renderer keeps its own copy of the pixels, it never reads them back.
+    GS_SoftRenderer::StoreTexture(m_gsTextureInfo.glID, m_gsImage.GetData(),
+                                  m_gsTextureInfo.nWidth, m_gsTextureInfo.nHeight,
+                                  m_gsTextureInfo.nBpp, glMinFilter, glMagFilter);
+
     // Free all memory allocated to the texture image.
     m_gsImage.Destroy();
 
@@ -234,7 +271,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
    glGenTextures(1, &m_gsTextureInfo.glID);
 
    // Bind the texture ID to the texture.
-   glBindTexture(GL_TEXTURE_2D, m_gsTextureInfo.glID);
+   GS_OGLState::BindTexture(m_gsTextureInfo.glID);
 
    // Determine the color format of the image. GL_RGB tells OpenGL the image data is made up of
    // red, green and blue data in that order, GL_RGBA includes an alpha channel.
@@ -263,7 +300,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
       // Zero is the border. It's usually left at zero. The next paramter specifies the data
       // format. GL_UNSIGNED_BYTE means the data that makes up the image is made up of unsigned
       // bytes, and finally... a pointer that tells OpenGL where to get the actual texture data.
-      glTexImage2D(GL_TEXTURE_2D, 0, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
+      glTexImage2D(GL_TEXTURE_2D, 0, m_gsTextureInfo.glFormat, m_gsTextureInfo.nWidth,
                    m_gsTextureInfo.nHeight, 0, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
                    auxTextureImage[0]->data);
       }
@@ -278,7 +315,7 @@ BOOL GS_OGLTexture::Create(const char* pszFilename, GS_TextureType gsTextureType
       // height of 64*64,128*128 or 256*256 the gluBuild2DMipmaps() function has no such limits
       // and you can use any size image you want since OpenGL will automatically size it to the
       // proper width and height.
-      gluBuild2DMipmaps(GL_TEXTURE_2D, m_gsTextureInfo.nBpp, m_gsTextureInfo.nWidth,
+      gluBuild2DMipmaps(GL_TEXTURE_2D, m_gsTextureInfo.glFormat, m_gsTextureInfo.nWidth,
                         m_gsTextureInfo.nHeight, m_gsTextureInfo.glFormat, GL_UNSIGNED_BYTE,
                         auxTextureImage[0]->data);
       }
@@ -317,7 +354,11 @@ void GS_OGLTexture::Destroy()
         return;
     }
 
-    glDeleteTextures(1, &m_gsTextureInfo.glID);
+    // Atlas pages are deleted by the atlas they belong to.
+    if (!m_gsTextureInfo.bIsInAtlas)
+    {
+        GS_OGLState::DeleteTexture(m_gsTextureInfo.glID);
+    }
 
     ZeroMemory(&m_gsTextureInfo, sizeof(GS_TextureInfo));
 
@@ -40,6 +40,7 @@
 #include "gs_error.h"
 #include "gs_object.h"
 #include "gs_ogl_image.h"
+#include "gs_ogl_state.h"
 //==============================================================================================
 
 
@@ -66,6 +67,11 @@ typedef struct GS_TEXTURE_INFO
     int nBpp;        // Texture color size in bytes.
     BOOL bHasAlpha;  // Whether the texture has an alpha component.
     BOOL bIsReady;   // Wether the texture has been created or not.
+    BOOL bIsInAtlas; // Wether the image was packed into a texture atlas page.
+    int nOffsetX;    // Position of the image within the OpenGL texture in pixels.
+    int nOffsetY;
+    int nPageWidth;  // Size of the OpenGL texture in pixels (differs from the image size when
+    int nPageHeight; // the image was packed into an atlas).
 } GS_TextureInfo;
 //==============================================================================================
 
@@ -120,6 +126,26 @@ public:
     {
         return m_gsTextureInfo.bHasAlpha;
     }
+    BOOL   IsInAtlas()
+    {
+        return m_gsTextureInfo.bIsInAtlas;
+    }
+    int    GetOffsetX()
+    {
+        return m_gsTextureInfo.nOffsetX;
+    }
+    int    GetOffsetY()
+    {
+        return m_gsTextureInfo.nOffsetY;
+    }
+    int    GetPageWidth()
+    {
+        return m_gsTextureInfo.nPageWidth;
+    }
+    int    GetPageHeight()
+    {
+        return m_gsTextureInfo.nPageHeight;
+    }
     BOOL   IsReady()
     {
         return m_gsTextureInfo.bIsReady;
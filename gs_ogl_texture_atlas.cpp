@@ -0,0 +1,639 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_atlas.cpp, gs_ogl_texture_atlas.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLTextureAtlas                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Packs the images of textures created between Begin() and End() into a few large     |
+ |        atlas pages (skyline bottom-left packing), so sprites using different images can be |
+ |        drawn without switching textures.                                                   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_ogl_texture_atlas.h"
+#include "gs_soft_renderer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+GS_OGLTextureAtlas* GS_OGLTextureAtlas::m_pActiveAtlas = NULL;
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods. /////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::GS_OGLTextureAtlas():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLTextureAtlas::GS_OGLTextureAtlas()
+{
+
+    ZeroMemory(m_gsPages, sizeof(m_gsPages));
+
+    m_nNumPages = 0;
+    m_nPageSize = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::~GS_OGLTextureAtlas():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The destructor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_OGLTextureAtlas::~GS_OGLTextureAtlas()
+{
+
+    this->Destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Begin/End Methods. //////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::Begin():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes this the atlas that textures created from image files are packed into, until
+//          End() is called. Textures too large to share a page are created normally.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLTextureAtlas::Begin()
+{
+
+    // Only one atlas can be collecting textures at a time.
+    if ((m_pActiveAtlas != NULL) && (m_pActiveAtlas != this))
+    {
+        return FALSE;
+    }
+
+    // Determine the page size the first time around (once, this is a synchronous query).
+    if (m_nPageSize <= 0)
+    {
+        GLint gliMaxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &gliMaxSize);
+
+        m_nPageSize = GS_ATLAS_MAX_PAGE_SIZE;
+
+        while ((m_nPageSize > 64) && (m_nPageSize > gliMaxSize))
+        {
+            m_nPageSize /= 2;
+        }
+    }
+
+    m_pActiveAtlas = this;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::End():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops packing textures and uploads the pages that were filled since Begin().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLTextureAtlas::End()
+{
+
+    for (int nPage = 0; nPage < m_nNumPages; nPage++)
+    {
+        if (m_gsPages[nPage].pPixels)
+        {
+            this->Upload(&m_gsPages[nPage]);
+        }
+    }
+
+    if (m_pActiveAtlas == this)
+    {
+        m_pActiveAtlas = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Deletes all the pages, the textures packed into them can no longer be used.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLTextureAtlas::Destroy()
+{
+
+    if (m_pActiveAtlas == this)
+    {
+        m_pActiveAtlas = NULL;
+    }
+
+    for (int nPage = 0; nPage < m_nNumPages; nPage++)
+    {
+        if (m_gsPages[nPage].gluTexture)
+        {
+            GS_OGLState::DeleteTexture(m_gsPages[nPage].gluTexture);
+        }
+        if (m_gsPages[nPage].pPixels)
+        {
+            delete[] m_gsPages[nPage].pPixels;
+        }
+        if (m_gsPages[nPage].pNodes)
+        {
+            delete[] m_gsPages[nPage].pNodes;
+        }
+    }
+
+    ZeroMemory(m_gsPages, sizeof(m_gsPages));
+
+    m_nNumPages = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Packing Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::Insert():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Packs an image into the first page of the same type and filtering that has room
+//          for it, adding a page if none has. GS_OGLTexture::Create() calls this while the
+//          atlas is active. The page texture name is valid right away, its contents are
+//          uploaded by End().
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the image was packed, FALSE if it has to be a texture of its own.
+//==============================================================================================
+
+BOOL GS_OGLTextureAtlas::Insert(const BYTE* pData, int nWidth, int nHeight, int nBpp,
+                                GS_TextureType gsTextureType, GLint glMinFilter,
+                                GLint glMagFilter, GLuint* pTexture, int* pOffsetX,
+                                int* pOffsetY, int* pPageSize)
+{
+
+    if ((!pData) || (nWidth <= 0) || (nHeight <= 0) || ((nBpp != 3) && (nBpp != 4)))
+    {
+        return FALSE;
+    }
+
+    int nPaddedWidth  = nWidth  + (GS_ATLAS_PADDING * 2);
+    int nPaddedHeight = nHeight + (GS_ATLAS_PADDING * 2);
+
+    // Images that would fill most of a page are better off on their own.
+    if ((nPaddedWidth > (m_nPageSize / 2)) && (nPaddedHeight > (m_nPageSize / 2)))
+    {
+        return FALSE;
+    }
+
+    if ((nPaddedWidth > m_nPageSize) || (nPaddedHeight > m_nPageSize))
+    {
+        return FALSE;
+    }
+
+    int nX, nY, nNode;
+
+    GS_AtlasPage* pPage = NULL;
+
+    // Look for a page that takes this kind of image and still has room for it.
+    for (int nPage = 0; nPage < m_nNumPages; nPage++)
+    {
+        if ((m_gsPages[nPage].pPixels) &&
+                (m_gsPages[nPage].gsTextureType == gsTextureType) &&
+                (m_gsPages[nPage].glMinFilter == glMinFilter) &&
+                (m_gsPages[nPage].glMagFilter == glMagFilter) &&
+                (this->FindPosition(&m_gsPages[nPage], nPaddedWidth, nPaddedHeight,
+                                    &nX, &nY, &nNode)))
+        {
+            pPage = &m_gsPages[nPage];
+            break;
+        }
+    }
+
+    // Start a new page if none had room.
+    if (!pPage)
+    {
+        if (!this->AddPage(gsTextureType, glMinFilter, glMagFilter))
+        {
+            return FALSE;
+        }
+
+        pPage = &m_gsPages[m_nNumPages - 1];
+
+        if (!this->FindPosition(pPage, nPaddedWidth, nPaddedHeight, &nX, &nY, &nNode))
+        {
+            return FALSE;
+        }
+    }
+
+    this->AddSkyline(pPage, nNode, nX, nY, nPaddedWidth, nPaddedHeight);
+
+    this->CopyImage(pPage, nX, nY, pData, nWidth, nHeight, nBpp);
+
+    pPage->nNumImages++;
+
+    if (pTexture)
+    {
+        *pTexture = pPage->gluTexture;
+    }
+    if (pOffsetX)
+    {
+        *pOffsetX = nX + GS_ATLAS_PADDING;
+    }
+    if (pOffsetY)
+    {
+        *pOffsetY = nY + GS_ATLAS_PADDING;
+    }
+    if (pPageSize)
+    {
+        *pPageSize = m_nPageSize;
+    }
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::AddPage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Adds an empty page for images of the specified type and filtering.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLTextureAtlas::AddPage(GS_TextureType gsTextureType, GLint glMinFilter,
+                                 GLint glMagFilter)
+{
+
+    if (m_nNumPages >= GS_ATLAS_MAX_PAGES)
+    {
+        return FALSE;
+    }
+
+    GS_AtlasPage* pPage = &m_gsPages[m_nNumPages];
+
+    pPage->pPixels = new BYTE[m_nPageSize * m_nPageSize * 4];
+    pPage->pNodes  = new GS_AtlasNode[m_nPageSize];
+
+    if ((!pPage->pPixels) || (!pPage->pNodes))
+    {
+        GS_Error::Report("GS_OGL_TEXTURE_ATLAS.CPP", 320, "Failed to allocate atlas page!");
+        return FALSE;
+    }
+
+    // Unused parts of the page are fully transparent.
+    memset(pPage->pPixels, 0, m_nPageSize * m_nPageSize * 4);
+
+    // Generate the texture name now so textures can refer to it before the page is uploaded.
+    glGenTextures(1, &pPage->gluTexture);
+
+    pPage->gsTextureType = gsTextureType;
+    pPage->glMinFilter   = glMinFilter;
+    pPage->glMagFilter   = glMagFilter;
+
+    // The skyline starts out as a single segment along the bottom of the page.
+    pPage->pNodes[0].nX     = 0;
+    pPage->pNodes[0].nY     = 0;
+    pPage->pNodes[0].nWidth = m_nPageSize;
+    pPage->nNumNodes        = 1;
+
+    pPage->nNumImages = 0;
+
+    m_nNumPages++;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::FindPosition():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the lowest position on the skyline of the page where a rectangle of the
+//          given size fits (the leftmost one if there are several).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the rectangle fits, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLTextureAtlas::FindPosition(GS_AtlasPage* pPage, int nWidth, int nHeight, int* pX,
+                                      int* pY, int* pNode)
+{
+
+    int nBestY    = m_nPageSize;
+    int nBestNode = -1;
+
+    for (int nNode = 0; nNode < pPage->nNumNodes; nNode++)
+    {
+        int nX = pPage->pNodes[nNode].nX;
+
+        // Does the rectangle stick out on the right?
+        if ((nX + nWidth) > m_nPageSize)
+        {
+            break;
+        }
+
+        // The rectangle rests on the highest segment below it.
+        int nY         = 0;
+        int nRemaining = nWidth;
+
+        for (int nNext = nNode; (nNext < pPage->nNumNodes) && (nRemaining > 0); nNext++)
+        {
+            if (pPage->pNodes[nNext].nY > nY)
+            {
+                nY = pPage->pNodes[nNext].nY;
+            }
+            nRemaining -= pPage->pNodes[nNext].nWidth;
+        }
+
+        if (((nY + nHeight) <= m_nPageSize) && (nY < nBestY))
+        {
+            nBestY    = nY;
+            nBestNode = nNode;
+        }
+    }
+
+    if (nBestNode < 0)
+    {
+        return FALSE;
+    }
+
+    *pX    = pPage->pNodes[nBestNode].nX;
+    *pY    = nBestY;
+    *pNode = nBestNode;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::AddSkyline():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Raises the skyline over a rectangle placed by FindPosition().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLTextureAtlas::AddSkyline(GS_AtlasPage* pPage, int nNode, int nX, int nY,
+                                    int nWidth, int nHeight)
+{
+
+    GS_AtlasNode* pNodes = pPage->pNodes;
+
+    // Insert a segment for the top of the rectangle.
+    for (int nLoop = pPage->nNumNodes; nLoop > nNode; nLoop--)
+    {
+        pNodes[nLoop] = pNodes[nLoop - 1];
+    }
+    pNodes[nNode].nX     = nX;
+    pNodes[nNode].nY     = nY + nHeight;
+    pNodes[nNode].nWidth = nWidth;
+    pPage->nNumNodes++;
+
+    // Shorten or remove the segments now covered by the rectangle.
+    int nRight = nX + nWidth;
+
+    while ((nNode + 1) < pPage->nNumNodes)
+    {
+        GS_AtlasNode* pNext = &pNodes[nNode + 1];
+
+        if (pNext->nX >= nRight)
+        {
+            break;
+        }
+
+        int nOverlap = nRight - pNext->nX;
+
+        if (nOverlap < pNext->nWidth)
+        {
+            pNext->nX     += nOverlap;
+            pNext->nWidth -= nOverlap;
+            break;
+        }
+
+        for (int nLoop = nNode + 1; nLoop < (pPage->nNumNodes - 1); nLoop++)
+        {
+            pNodes[nLoop] = pNodes[nLoop + 1];
+        }
+        pPage->nNumNodes--;
+    }
+
+    // Merge neighbouring segments of the same height.
+    for (int nLoop = 0; nLoop < (pPage->nNumNodes - 1); )
+    {
+        if (pNodes[nLoop].nY == pNodes[nLoop + 1].nY)
+        {
+            pNodes[nLoop].nWidth += pNodes[nLoop + 1].nWidth;
+
+            for (int nMove = nLoop + 1; nMove < (pPage->nNumNodes - 1); nMove++)
+            {
+                pNodes[nMove] = pNodes[nMove + 1];
+            }
+            pPage->nNumNodes--;
+        }
+        else
+        {
+            nLoop++;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::CopyImage():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies an image into its padded rectangle on the page, filling the padding with
+//          the nearest edge pixels so filtering and mipmapping don't bleed in the neighbours.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLTextureAtlas::CopyImage(GS_AtlasPage* pPage, int nX, int nY, const BYTE* pData,
+                                   int nWidth, int nHeight, int nBpp)
+{
+
+    for (int nRow = -GS_ATLAS_PADDING; nRow < (nHeight + GS_ATLAS_PADDING); nRow++)
+    {
+        int nSrcRow = (nRow < 0) ? 0 : ((nRow >= nHeight) ? (nHeight - 1) : nRow);
+
+        BYTE* pDest = pPage->pPixels +
+                      ((((nY + GS_ATLAS_PADDING + nRow) * m_nPageSize) + nX) * 4);
+
+        for (int nCol = -GS_ATLAS_PADDING; nCol < (nWidth + GS_ATLAS_PADDING); nCol++)
+        {
+            int nSrcCol = (nCol < 0) ? 0 : ((nCol >= nWidth) ? (nWidth - 1) : nCol);
+
+            const BYTE* pSrc = pData + (((nSrcRow * nWidth) + nSrcCol) * nBpp);
+
+            pDest[0] = pSrc[0];
+            pDest[1] = pSrc[1];
+            pDest[2] = pSrc[2];
+            pDest[3] = (nBpp == 4) ? pSrc[3] : 255;
+
+            pDest += 4;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::Upload():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Uploads a page to its texture and frees the pixels kept for packing, no more
+//          images can be added to the page afterwards.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_OGLTextureAtlas::Upload(GS_AtlasPage* pPage)
+{
+
+    GS_OGLState::BindTexture(pPage->gluTexture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, pPage->glMinFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, pPage->glMagFilter);
+
+    if (pPage->gsTextureType == GS_IMAGE2D)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_nPageSize, m_nPageSize, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, pPage->pPixels);
+    }
+    else
+    {
+        gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, m_nPageSize, m_nPageSize, GL_RGBA,
+                          GL_UNSIGNED_BYTE, pPage->pPixels);
+    }
+
+    // The software renderer keeps its own copy of the pixels, it never reads them back.
+    GS_SoftRenderer::StoreTexture(pPage->gluTexture, pPage->pPixels, m_nPageSize, m_nPageSize, 4,
+                                  pPage->glMinFilter, pPage->glMagFilter);
+
+    delete[] pPage->pPixels;
+    pPage->pPixels = NULL;
+
+    delete[] pPage->pNodes;
+    pPage->pNodes    = NULL;
+    pPage->nNumNodes = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Access Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::IsActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if textures are being packed into this atlas, FALSE if not.
+//==============================================================================================
+
+BOOL GS_OGLTextureAtlas::IsActive()
+{
+
+    return (m_pActiveAtlas == this);
+}
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::GetNumPages():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of pages in the atlas.
+//==============================================================================================
+
+int GS_OGLTextureAtlas::GetNumPages()
+{
+
+    return m_nNumPages;
+}
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::GetPageSize():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width and height of the atlas pages in pixels.
+//==============================================================================================
+
+int GS_OGLTextureAtlas::GetPageSize()
+{
+
+    return m_nPageSize;
+}
+
+
+//==============================================================================================
+// GS_OGLTextureAtlas::GetActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The atlas between Begin() and End(), NULL if there is none.
+//==============================================================================================
+
+GS_OGLTextureAtlas* GS_OGLTextureAtlas::GetActive()
+{
+
+    return m_pActiveAtlas;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_ogl_texture_atlas.cpp, gs_ogl_texture_atlas.h                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_OGLTextureAtlas                                                                  |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Packs the images of textures created between Begin() and End() into a few large     |
+ |        atlas pages (skyline bottom-left packing), so sprites using different images can be |
+ |        drawn without switching textures.                                                   |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_OGL_TEXTURE_ATLAS_H
+#define GS_OGL_TEXTURE_ATLAS_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_object.h"
+#include "gs_ogl_texture.h"
+#include "gs_ogl_state.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Atlas defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_ATLAS_MAX_PAGES     8    // Maximum number of pages in an atlas.
+#define GS_ATLAS_MAX_PAGE_SIZE 2048 // Largest width and height of a page (if OpenGL allows it).
+#define GS_ATLAS_PADDING       2    // Pixels around each image, filled with its edge pixels.
+//==============================================================================================
+
+
+//==============================================================================================
+// Atlas structures.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_ATLAS_NODE
+{
+    int nX;     // Left end of a horizontal segment of the skyline.
+    int nY;     // Height of the segment.
+    int nWidth; // Width of the segment.
+} GS_AtlasNode;
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_ATLAS_PAGE
+{
+    GLuint         gluTexture;    // The OpenGL texture holding the page.
+    BYTE*          pPixels;       // RGBA pixels of the page until it is uploaded.
+    GS_TextureType gsTextureType; // Type and filtering shared by all images on the page.
+    GLint          glMinFilter;
+    GLint          glMagFilter;
+    GS_AtlasNode*  pNodes;        // The skyline along the top of the packed images.
+    int            nNumNodes;     // Number of segments in the skyline.
+    int            nNumImages;    // Number of images packed into the page.
+} GS_AtlasPage;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_OGLTextureAtlas : public GS_Object
+{
+
+private:
+
+    static GS_OGLTextureAtlas* m_pActiveAtlas; // The atlas GS_OGLTexture::Create() packs into.
+
+    GS_AtlasPage m_gsPages[GS_ATLAS_MAX_PAGES]; // The pages of the atlas.
+    int          m_nNumPages;                   // Number of pages in use.
+    int          m_nPageSize;                   // Width and height of every page.
+
+    BOOL AddPage(GS_TextureType gsTextureType, GLint glMinFilter, GLint glMagFilter);
+    BOOL FindPosition(GS_AtlasPage* pPage, int nWidth, int nHeight, int* pX, int* pY,
+                      int* pNode);
+    void AddSkyline(GS_AtlasPage* pPage, int nNode, int nX, int nY, int nWidth, int nHeight);
+    void CopyImage(GS_AtlasPage* pPage, int nX, int nY, const BYTE* pData, int nWidth,
+                   int nHeight, int nBpp);
+    void Upload(GS_AtlasPage* pPage);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_OGLTextureAtlas();
+    ~GS_OGLTextureAtlas();
+
+    BOOL Begin();
+    void End();
+    void Destroy();
+
+    BOOL Insert(const BYTE* pData, int nWidth, int nHeight, int nBpp,
+                GS_TextureType gsTextureType, GLint glMinFilter, GLint glMagFilter,
+                GLuint* pTexture, int* pOffsetX, int* pOffsetY, int* pPageSize);
+
+    BOOL IsActive();
+    int  GetNumPages();
+    int  GetPageSize();
+
+    static GS_OGLTextureAtlas* GetActive();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -209,6 +209,8 @@ int MessageBox(void* hwnd, const char* text, const char* caption, unsigned int t
     
     int buttonid;
     if (SDL_ShowMessageBox(&messageboxdata, &buttonid) < 0) {
+        // No message box without a display (e.g. headless runs), so at least log the text.
+        std::cerr << caption << ": " << text << std::endl;
         return IDCANCEL;
     }
     
@@ -46,6 +46,8 @@ GS_Snake::GS_Snake() : GS_Application()
     m_gsSettings.bEnableAliasing = -1;
     m_gsSettings.bEnableAliasing = -1;
     m_gsSettings.fFrameCap = -1;
+    m_gsSettings.nRenderer = -1;
+    m_gsSettings.nUpscale = -1;
     m_gsSettings.nMusicVolume = -1;
     m_gsSettings.nEffectsVolume = -1;
 
@@ -89,6 +91,12 @@ GS_Snake::GS_Snake() : GS_Application()
     m_nScoreIndex = 0;
     m_lScore = 0;
 
+    m_lShownScore = -1;
+    m_nShownLives = -1;
+    m_nShownRatsEaten = -1;
+    m_nShownWorld = -1;
+    m_nShownLevel = -1;
+
     m_defaultRatState = RAT_STATE_MOVING;
     m_gameMode = NORMAL_MODE;
 
@@ -149,6 +157,8 @@ BOOL GS_Snake::GameSetup()
         m_gsSettings.bEnableVSync = DEFAULT_VSYNC;
         m_gsSettings.bEnableAliasing = DEFAULT_ALIAS;
         m_gsSettings.fFrameCap = DEFAULT_FRAMECAP;
+        m_gsSettings.nRenderer = DEFAULT_RENDERER;
+        m_gsSettings.nUpscale = DEFAULT_UPSCALE;
         m_gsSettings.nMusicVolume = DEFAULT_MUSIC;
         m_gsSettings.nEffectsVolume = DEFAULT_SOUND;
     }
@@ -201,7 +211,8 @@ BOOL GS_Snake::GameInit()
     /////////////////////////////////////////////////////////////////////////////////////////////
 
     // Did we fail creating the OpenGL display?
-    if (!m_gsDisplay.Create(this->GetDevice(), this->GetWidth(), this->GetHeight(), this->GetColorDepth()))
+    if (!m_gsDisplay.Create(this->GetDevice(), this->GetWidth(), this->GetHeight(), this->GetColorDepth(),
+                            m_gsSettings.nRenderer))
     {
         GS_Error::Report("GS_SNAKE.CPP", 186, "Failed to create OpenGL display!");
         return FALSE;
@@ -216,6 +227,23 @@ BOOL GS_Snake::GameInit()
     // Enable blending for transparency in textures.
     m_gsDisplay.EnableBlending(TRUE);
 
+    // Batch sprites and particles drawn during 2D rendering.
+    m_gsDisplay.EnableBatching(TRUE);
+
+    // Sort batched quads by layer and state (the play screens set the layers).
+    m_gsDisplay.EnableSorting(TRUE);
+
+    // Read every frame back when a headless run should save its last frame.
+    m_gsDisplay.EnableReadback(this->IsHeadless() && (NULL != this->GetReadbackFile()));
+
+    // Render at the internal resolution and scale it to the window in one pass if specified
+    // in the game settings (sprites are then no longer scaled one by one).
+    if (m_gsSettings.nUpscale != GS_UPSCALE_NONE)
+    {
+        m_gsDisplay.SetInternalResolution(INTERNAL_RES_X, INTERNAL_RES_Y, m_gsSettings.nUpscale);
+        this->SetRenderScaling(this->GetWidth(), this->GetHeight(), m_bKeepAspectRatio);
+    }
+
     // Are we in fullscreen mode?
     // if (!this->IsWindowed())
     // {
@@ -265,6 +293,10 @@ BOOL GS_Snake::GameInit()
     // Postion the background at the bottom left of the screen.
     m_gsBackSprite.SetDestXY(0, 0);
 
+    // Pack the images created from here on into a texture atlas, so the sprites can be drawn
+    // without switching textures. The background is left out above because it is scrolled.
+    m_gsTextureAtlas.Begin();
+
     // Create an unfiltered sprite that will be used for the cursor.
     bResult = m_gsCursorSprite.Create("data/cursor_01.tga", FALSE);
 
@@ -308,8 +340,7 @@ BOOL GS_Snake::GameInit()
 
     // Use the font texture to create a font with 16 characters per line and with a width
     // and height of 16x16 pixels per character.
-    bResult = m_gsFont.Create(m_gsFontTexture.GetID(), m_gsFontTexture.GetWidth(),
-                              m_gsFontTexture.GetHeight(), 16, 16, 16);
+    bResult = m_gsFont.Create(m_gsFontTexture, 16, 16, 16);
 
     // Were we not successful?
     if (FALSE == bResult)
@@ -318,9 +349,7 @@ BOOL GS_Snake::GameInit()
     }
 
     // Create a menu using the "menu_01.tga" image and the font texture created earlier.
-    bResult = m_gsMenu.Create("data/menu_01.tga", m_gsFontTexture.GetID(),
-                              m_gsFontTexture.GetWidth(), m_gsFontTexture.GetHeight(),
-                              16, 16, 16);
+    bResult = m_gsMenu.Create("data/menu_01.tga", m_gsFontTexture, 16, 16, 16);
 
     // Were we not successful?
     if (FALSE == bResult)
@@ -355,6 +384,13 @@ BOOL GS_Snake::GameInit()
     // Create the level
     m_level.Create(m_rcPlayArea, true);
 
+    // Keep track of the cells not taken by the level or the snake to spawn rats on
+    m_spawner.Create(m_rcPlayArea, RAT_ELEMENT_WIDTH, RAT_ELEMENT_HEIGHT);
+    m_snake.SetSpawner(&m_spawner);
+
+    // Upload the texture atlas pages.
+    m_gsTextureAtlas.End();
+
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Custom Sound Initialization ///////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
@@ -387,6 +423,11 @@ BOOL GS_Snake::GameInit()
         m_gsSound.PlayStream(MUSIC_TITLE, m_gsSettings.nMusicVolume);
     }
 
+#ifdef GS_BENCHMARK_TARGETS
+    // Compare the two ways of drawing render targets before the game starts.
+    this->BenchmarkTargets();
+#endif
+
     return TRUE;
 }
 
@@ -412,6 +453,17 @@ BOOL GS_Snake::GameShutdown()
     // Reset controller data.
     m_gsController.Reset();
 
+    // Destroy the texture atlas pages and the score area target while the rendering context
+    // still exists.
+    m_gsTextureAtlas.Destroy();
+    m_gsScoreTarget.Destroy();
+
+    // Save the last frame of a headless run.
+    if (m_gsDisplay.IsReadbackEnabled())
+    {
+        m_gsDisplay.SaveFrame(this->GetReadbackFile());
+    }
+
     // Destroy the OpenGL display.
     m_gsDisplay.Destroy();
 
@@ -447,13 +499,13 @@ BOOL GS_Snake::GameRelease()
     // Set OpenGL clear color to black.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     // Clear screen and depth buffer.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset the current modelview matrix.
     glLoadIdentity();
 
     // Swap buffers (double buffering) to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     // Pause all game sound.
     m_gsSound.Pause(TRUE);
@@ -753,8 +805,14 @@ LRESULT GS_Snake::MsgProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     case WM_MOUSEMOVE:
         // Save mouse coordinates (coordinates are relative to the top left of the client
         // area of the window). Note that the Y coordinates are inverted for OpenGL.
-        m_gsMouse.SetX(LOWORD(lParam));
-        m_gsMouse.SetY(INTERNAL_RES_Y - HIWORD(lParam) - 1);
+        {
+            int nMouseX = LOWORD(lParam);
+            int nMouseY = HIWORD(lParam);
+            // Map them to the internal resolution when the display scales it to the window.
+            m_gsDisplay.WindowToInternal(&nMouseX, &nMouseY);
+            m_gsMouse.SetX(nMouseX);
+            m_gsMouse.SetY(INTERNAL_RES_Y - nMouseY - 1);
+        }
         return 0L;
 
     // The WM_LBUTTONDOWN message is posted when the user presses the left mouse
@@ -904,7 +962,7 @@ BOOL GS_Snake::GameIntro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -932,7 +990,7 @@ BOOL GS_Snake::GameIntro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -1054,7 +1112,7 @@ BOOL GS_Snake::GameOutro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -1136,7 +1194,7 @@ BOOL GS_Snake::GameOutro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -1223,7 +1281,7 @@ BOOL GS_Snake::TitleIntro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -1244,7 +1302,7 @@ BOOL GS_Snake::TitleIntro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -1713,7 +1771,7 @@ BOOL GS_Snake::TitleScreen()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -1804,7 +1862,7 @@ BOOL GS_Snake::TitleScreen()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -1885,7 +1943,7 @@ BOOL GS_Snake::TitleOutro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -1945,7 +2003,7 @@ BOOL GS_Snake::TitleOutro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -2022,7 +2080,7 @@ BOOL GS_Snake::OptionIntro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -2036,7 +2094,7 @@ BOOL GS_Snake::OptionIntro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -2407,7 +2465,7 @@ BOOL GS_Snake::OptionScreen()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -2435,7 +2493,7 @@ BOOL GS_Snake::OptionScreen()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -2521,7 +2579,7 @@ BOOL GS_Snake::OptionOutro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -2535,7 +2593,7 @@ BOOL GS_Snake::OptionOutro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -2772,7 +2830,7 @@ BOOL GS_Snake::PlayIntro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -2794,7 +2852,7 @@ BOOL GS_Snake::PlayIntro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -2868,17 +2926,17 @@ BOOL GS_Snake::PlayGame()
 
         // Load the level
         m_level.Load(m_currentLevel);
+        this->UpdateSpawnCells();
         m_nGameProgress = PLAY_UPDATE;
 
         // Re-create the snake
-        m_snake.Reset(m_level.GetSnakeStartX(), m_level.GetSnakeStartY(), SNAKE_MOVEMENT_INTERVAL_MAX);
+        m_snake.Reset(m_level.GetSnakeStartX(), m_level.GetSnakeStartY(), m_level.GetSnakeInterval());
         m_snake.SetState(SNAKE_STATE_MOVING);
 
         // Re-create the rat
         int ratX = (m_rcPlayArea.right - m_rcPlayArea.left) - (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / 4);
         int ratY = (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) / 2 * RAT_ELEMENT_HEIGHT;
-        m_rat.Reset(ratX, ratY, RAT_MOVEMENT_INTERVAL_MAX);
-        m_rat.SetState(m_defaultRatState);
+        this->ResetRat(ratX, ratY);
 
         // Is the game in hard mode?
         if (m_gameMode == HARD_MODE)
@@ -2887,7 +2945,6 @@ BOOL GS_Snake::PlayGame()
             for (int i = 0; i < 3; i++)
             {
                 m_snake.Speedup();
-                m_rat.Speedup();
             }
         }
 
@@ -2895,7 +2952,6 @@ BOOL GS_Snake::PlayGame()
         for (int i = 0; i < m_currentWorld; i++)
         {
             m_snake.Speedup();
-            m_rat.Speedup();
         }
 
         // Clear the keyboard buffer.
@@ -3073,24 +3129,9 @@ BOOL GS_Snake::PlayGame()
                 m_snake.Reset(m_level.GetSnakeStartX(), m_level.GetSnakeStartY());
                 m_snake.SetState(SNAKE_STATE_MOVING);
 
-                // Respawn the rat
-                int ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-                int ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-                m_rat.SetPosition(ratX, ratY);
-                m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-
-                // Make certain the rat does not respawn on the snake or the level
-                while ((m_snake.CheckCollision(rcRat) != SNAKE_COLLIDE_NONE) || (m_level.CheckCollision(rcRat)))
-                {
-                    ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-                    ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-                    m_rat.SetPosition(ratX, ratY);
-                    m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-                }
-
-                // Reset the rat and start it moving again
-                m_rat.Reset(ratX, ratY);
-                m_rat.SetState(m_defaultRatState);
+                // Respawn the rat on a free cell (if there is none it stays dead and is
+                // respawned once there is)
+                this->RespawnRat();
 
                 // Clear the keyboard buffer
                 m_gsKeyboard.ClearBuffer();
@@ -3139,37 +3180,19 @@ BOOL GS_Snake::PlayGame()
                     m_gsSound.PlaySample(SAMPLE_SNAKE_GROWING);
                 }
 
-                // Make the snake faster
+                // Make the snake faster (the next rat is made faster when it respawns)
                 m_snake.Speedup();
 
-                // Make the rats faster
-                m_rat.Speedup();
-
                 // std::cout << "Yum!\n";
             }
         }
-        else if ((m_rat.GetState() == RAT_STATE_DEAD) && (m_ratsEaten < RATS_PER_LEVEL))
+        else if ((m_rat.GetState() == RAT_STATE_DEAD) && (m_ratsEaten < m_level.GetRatCount()))
         {
             // Is the snake still alive?
             if (m_snake.GetState() < SNAKE_STATE_DYING)
             {
-                // Respawn the rat
-                int ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-                int ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-                m_rat.SetPosition(ratX, ratY);
-                m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-
-                // Make certain the rat does not respawn on the snake or the level
-                while ((m_snake.CheckCollision(rcRat) != SNAKE_COLLIDE_NONE) || (m_level.CheckCollision(rcRat)))
-                {
-                    ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-                    ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-                    m_rat.SetPosition(ratX, ratY);
-                    m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-                }
-
-                // Start the rat moving again
-                m_rat.SetState(m_defaultRatState);
+                // Respawn the rat on a free cell, if there is one
+                this->RespawnRat();
             }
         }
 
@@ -3224,13 +3247,13 @@ BOOL GS_Snake::PlayGame()
         }
 
         // Have all the rats for the level been eaten?
-        if ((m_ratsEaten >= RATS_PER_LEVEL))
+        if ((m_ratsEaten >= m_level.GetRatCount()))
         { // && (m_rat.GetState() == RAT_STATE_DEAD) ) {
             // Go to the next level
             m_currentLevel++;
 
-            // Have we reached the last level?
-            if (m_currentLevel > MAX_LEVEL)
+            // Have we reached the last level in the level pack?
+            if (m_currentLevel >= MIN_LEVEL + m_level.GetNumLevels())
             {
                 // Go to the next world
                 m_currentWorld++;
@@ -3239,33 +3262,19 @@ BOOL GS_Snake::PlayGame()
                 m_currentLevel = MIN_LEVEL;
             }
 
-            // Load the new level
+            // Switch to the new level (already in memory)
             m_level.Load(m_currentLevel);
+            this->UpdateSpawnCells();
             m_nGameProgress = PLAY_UPDATE;
 
             // Reset the snake
-            m_snake.Reset(m_level.GetSnakeStartX(), m_level.GetSnakeStartY(), SNAKE_MOVEMENT_INTERVAL_MAX);
+            m_snake.Reset(m_level.GetSnakeStartX(), m_level.GetSnakeStartY(), m_level.GetSnakeInterval());
             m_snake.SetState(SNAKE_STATE_MOVING);
             m_ratsEaten = 0;
 
-            // Respawn the rat
-            int ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-            int ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-            m_rat.SetPosition(ratX, ratY);
-            m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-
-            // Make certain the rat does not respawn on the snake or the level
-            while ((m_snake.CheckCollision(rcRat) != SNAKE_COLLIDE_NONE) || (m_level.CheckCollision(rcRat)))
-            {
-                ratX = (rand() % (((m_rcPlayArea.right - m_rcPlayArea.left) - ((m_rcPlayArea.right - m_rcPlayArea.left) % RAT_ELEMENT_WIDTH)) / RAT_ELEMENT_WIDTH) * RAT_ELEMENT_WIDTH);
-                ratY = (rand() % (((m_rcPlayArea.top - m_rcPlayArea.bottom) - ((m_rcPlayArea.top - m_rcPlayArea.bottom) % RAT_ELEMENT_HEIGHT)) / RAT_ELEMENT_HEIGHT) * RAT_ELEMENT_HEIGHT);
-                m_rat.SetPosition(ratX, ratY);
-                m_rat.GetCollideRect(&rcRat, RAT_MOVE_NONE);
-            }
-
-            // Reset the rat and start it moving again
-            m_rat.Reset(ratX, ratY, RAT_MOVEMENT_INTERVAL_MAX);
-            m_rat.SetState(m_defaultRatState);
+            // Respawn the rat on a free cell (if there is none it stays dead and is
+            // respawned once there is)
+            this->RespawnRat();
 
             // Is the game in hard mode?
             if (m_gameMode == HARD_MODE)
@@ -3274,7 +3283,6 @@ BOOL GS_Snake::PlayGame()
                 for (int i = 0; i < 3; i++)
                 {
                     m_snake.Speedup();
-                    m_rat.Speedup();
                 }
             }
 
@@ -3282,7 +3290,6 @@ BOOL GS_Snake::PlayGame()
             for (int i = 0; i < m_currentWorld; i++)
             {
                 m_snake.Speedup();
-                m_rat.Speedup();
             }
 
             // Clear the keyboard buffer
@@ -3302,7 +3309,7 @@ BOOL GS_Snake::PlayGame()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -3313,18 +3320,27 @@ BOOL GS_Snake::PlayGame()
     // Render the background image.
     // this->RenderBackground();
 
+    // Draw the play area in its own layer, its quads can be sorted by state
+    GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
     // Render the score area
     this->RenderScore();
 
     // Render the level
     m_level.Render();
 
+    // Draw the snake and the rat over the play area (their particles go one layer up)
+    GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
     // Render the snake
     m_snake.Render();
 
     // Render the rat
     m_rat.Render();
 
+    // Draw everything from here on over the game, in the order it is rendered
+    GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
     // Render the frame rate.
     this->RenderFrameRate(0.25f);
 
@@ -3332,7 +3348,7 @@ BOOL GS_Snake::PlayGame()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -3426,7 +3442,7 @@ BOOL GS_Snake::PlayUpdate()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -3437,18 +3453,27 @@ BOOL GS_Snake::PlayUpdate()
     // Render the background image.
     // this->RenderBackground();
 
+    // Draw the play area in its own layer, its quads can be sorted by state
+    GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
     // Render the score area
     this->RenderScore(0.25f);
 
     // Render the level
     m_level.Render(0.25f);
 
+    // Draw the snake and the rat over the play area (their particles go one layer up)
+    GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
     // Render the snake
     m_snake.Render(0.25f);
 
     // Render the rat
     m_rat.Render(0.25f);
 
+    // Draw everything from here on over the game, in the order it is rendered
+    GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
     // Render the frame rate.
     this->RenderFrameRate(0.25f);
 
@@ -3475,7 +3500,7 @@ BOOL GS_Snake::PlayUpdate()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -3549,7 +3574,7 @@ BOOL GS_Snake::PlayPause()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -3560,12 +3585,18 @@ BOOL GS_Snake::PlayPause()
     // Render the background image.
     // this->RenderBackground(0.5f);
 
+    // Draw the play area in its own layer, its quads can be sorted by state
+    GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
     // Render the score area
     this->RenderScore(0.25f);
 
     // Render the level
     m_level.Render(0.25f);
 
+    // Draw the snake and the rat over the play area (their particles go one layer up)
+    GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
     // Render the snake
     m_snake.Render(0.25f);
 
@@ -3577,6 +3608,9 @@ BOOL GS_Snake::PlayPause()
     // m_gsTileSprite.RenderTiles(m_rcScreen);
     // m_gsTileSprite.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
 
+    // Draw everything from here on over the game, in the order it is rendered
+    GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
     // Render the frame rate.
     this->RenderFrameRate(0.25f);
 
@@ -3597,7 +3631,7 @@ BOOL GS_Snake::PlayPause()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     return TRUE;
 }
@@ -3845,7 +3879,7 @@ BOOL GS_Snake::PlayExit()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -3861,15 +3895,24 @@ BOOL GS_Snake::PlayExit()
     // m_gsTileSprite.RenderTiles(m_rcScreen);
     // m_gsTileSprite.SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
 
+    // Draw the play area in its own layer, its quads can be sorted by state
+    GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
     // Render the level
     m_level.Render(0.25f);
 
+    // Draw the snake and the rat over the play area (their particles go one layer up)
+    GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
     // Render the snake
     m_snake.Render(0.25f);
 
     // Render the rat
     m_rat.Render(0.25f);
 
+    // Draw everything from here on over the game, in the order it is rendered
+    GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
     // Render the frame rate.
     this->RenderFrameRate(0.25f);
 
@@ -3887,7 +3930,7 @@ BOOL GS_Snake::PlayExit()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4006,7 +4049,7 @@ BOOL GS_Snake::PlayOutro()
 
     // Clear the screen to the specified color.
     glClearColor(1.0f - m_fAlpha, 1.0f - m_fAlpha, 1.0f - m_fAlpha, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -4021,15 +4064,24 @@ BOOL GS_Snake::PlayOutro()
     // m_gsTileSprite.SetModulateColor(1.0f, 1.0f, 1.0f, m_fAlpha);
     // m_gsTileSprite.RenderTiles(m_rcScreen);
 
+    // Draw the play area in its own layer, its quads can be sorted by state
+    GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
     // Render the level
     m_level.Render(m_fAlpha);
 
+    // Draw the snake and the rat over the play area (their particles go one layer up)
+    GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
     // Render the snake
     m_snake.Render(m_fAlpha);
 
     // Render the rat
     m_rat.Render(m_fAlpha);
 
+    // Draw everything from here on over the game, in the order it is rendered
+    GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
     // Render the frame rate.
     this->RenderFrameRate(m_fAlpha);
 
@@ -4044,7 +4096,7 @@ BOOL GS_Snake::PlayOutro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4154,7 +4206,7 @@ BOOL GS_Snake::ScoresIntro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -4168,7 +4220,7 @@ BOOL GS_Snake::ScoresIntro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4265,7 +4317,7 @@ BOOL GS_Snake::ScoresView()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -4340,7 +4392,7 @@ BOOL GS_Snake::ScoresView()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4637,7 +4689,7 @@ BOOL GS_Snake::ScoresAdd()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -4682,7 +4734,7 @@ BOOL GS_Snake::ScoresAdd()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4764,7 +4816,7 @@ BOOL GS_Snake::ScoresOutro()
 
     // Clear the screen to the specified color.
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_gsDisplay.BeginRender();
 
     // Reset display.
     glLoadIdentity();
@@ -4778,7 +4830,7 @@ BOOL GS_Snake::ScoresOutro()
     m_gsDisplay.EndRender2D();
 
     // Swap buffers to display results.
-    SwapBuffers(this->GetDevice());
+    m_gsDisplay.EndRender(this->GetDevice());
 
     /////////////////////////////////////////////////////////////////////////////////////////////
     // Do Method Cleanup ////////////////////////////////////////////////////////////////////////
@@ -4836,6 +4888,9 @@ BOOL GS_Snake::LoadSettings()
     m_gsSettings.bEnableVSync = gsIniFile.ReadInt("Display", "EnableVSync", -1);
     m_gsSettings.bEnableAliasing = gsIniFile.ReadInt("Display", "EnableAliasing", -1);
     m_gsSettings.fFrameCap = gsIniFile.ReadInt("Display", "FrameCap", -1);
+    // Older settings files have no renderer setting, so don't fail without it.
+    m_gsSettings.nRenderer = gsIniFile.ReadInt("Display", "Renderer", DEFAULT_RENDERER);
+    m_gsSettings.nUpscale = gsIniFile.ReadInt("Display", "Upscale", DEFAULT_UPSCALE);
 
     // Did reading display settings fail?
     if (-1 == m_gsSettings.nDisplayWidth)
@@ -4923,6 +4978,8 @@ BOOL GS_Snake::SaveSettings()
     gsIniFile.WriteInt("Display", "EnableVSync", m_gsSettings.bEnableVSync);
     gsIniFile.WriteInt("Display", "EnableAliasing", m_gsSettings.bEnableAliasing);
     gsIniFile.WriteInt("Display", "FrameCap", m_gsSettings.fFrameCap);
+    gsIniFile.WriteInt("Display", "Renderer", m_gsSettings.nRenderer);
+    gsIniFile.WriteInt("Display", "Upscale", m_gsSettings.nUpscale);
 
     // Write sound settings.
     gsIniFile.WriteInt("Sound", "MusicVolume", m_gsSettings.nMusicVolume);
@@ -5068,12 +5125,72 @@ void GS_Snake::RenderBackground(float fAlpha)
 //==============================================================================================
 // GS_Snake::RenderScore():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...
+// Purpose: Displays the score area. The area is rendered into an offscreen target only when
+//          one of the values shown changes and is otherwise drawn as a single quad. Renders the
+//          area directly if the target could not be created.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
 void GS_Snake::RenderScore(float fAlpha)
+{
+    // Screen position and size of the score area.
+    GLfloat glfLeft = GS_OGLDisplay::GetRenderModX();
+    GLfloat glfBottom = (PLAY_AREA_HEIGHT * GS_OGLDisplay::GetScaleFactorY()) + GS_OGLDisplay::GetRenderModY();
+    int nWidth = int((INTERNAL_RES_X * GS_OGLDisplay::GetScaleFactorX()) + 0.5f);
+    int nHeight = int((SCORE_AREA_HEIGHT * GS_OGLDisplay::GetScaleFactorY()) + 0.5f);
+
+    // Create the target again if the display has been resized.
+    if ((nWidth != m_gsScoreTarget.GetWidth()) || (nHeight != m_gsScoreTarget.GetHeight()))
+    {
+        m_gsScoreTarget.Create(nWidth, nHeight);
+    }
+
+    if (!m_gsScoreTarget.IsReady())
+    {
+        this->RenderScoreArea(fAlpha);
+        return;
+    }
+
+    // Has anything shown in the score area changed?
+    if ((m_lShownScore != m_lScore) || (m_nShownLives != m_lives) ||
+        (m_nShownRatsEaten != m_ratsEaten) || (m_nShownWorld != m_currentWorld) ||
+        (m_nShownLevel != m_currentLevel))
+    {
+        m_gsScoreTarget.Invalidate();
+    }
+
+    if (!m_gsScoreTarget.IsValid())
+    {
+        // Render the score area fully opaque, the whole area is faded when it is drawn.
+        if (m_gsScoreTarget.Begin(glfLeft, glfBottom))
+        {
+            this->RenderScoreArea(1.0f);
+            m_gsScoreTarget.End();
+        }
+
+        m_lShownScore = m_lScore;
+        m_nShownLives = m_lives;
+        m_nShownRatsEaten = m_ratsEaten;
+        m_nShownWorld = m_currentWorld;
+        m_nShownLevel = m_currentLevel;
+    }
+
+    m_gsScoreTarget.SetModulateColor(1.0f, 1.0f, 1.0f, fAlpha);
+    m_gsScoreTarget.Render(glfLeft, glfBottom);
+}
+
+// *********************************************************************************************
+
+//==============================================================================================
+// GS_Snake::RenderScoreArea():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Renders the background and text of the score area.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Snake::RenderScoreArea(float fAlpha)
 {
     // Set the alpha value to determine the transparency of the background.
     m_gsBackSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, fAlpha);
@@ -5106,7 +5223,7 @@ void GS_Snake::RenderScore(float fAlpha)
     m_gsFont.Render();
 
     // Display rats for next leavel
-    m_gsFont.SetText("NEXT %d/%d", m_ratsEaten, RATS_PER_LEVEL);
+    m_gsFont.SetText("NEXT %d/%d", m_ratsEaten, m_level.GetRatCount());
     m_gsFont.SetModulateColor(1.0f, 1.0f, 1.0f, fAlpha);
     m_gsFont.SetScaleXY(1.0f, 1.0f);
     m_gsFont.SetDestX((((INTERNAL_RES_X / 4) - m_gsFont.GetTextWidth()) / 2) + (INTERNAL_RES_X / 4 * 1));
@@ -5310,8 +5427,9 @@ void GS_Snake::RenderFrameRate(float fAlpha)
 
 void GS_Snake::SetRenderScaling(int nWidth, int nHeight, bool bKeepAspect)
 {
-    // Is no scaling required?
-    if ((nWidth == INTERNAL_RES_X) && (nHeight == INTERNAL_RES_Y))
+    // Is no scaling required (also when the display scales the whole scene)?
+    if (((nWidth == INTERNAL_RES_X) && (nHeight == INTERNAL_RES_Y)) ||
+        (m_gsDisplay.IsInternalResolution()))
     {
         // Reset the default scaling values
         GS_OGLDisplay::SetScaleFactorX(1.0f);
@@ -5401,6 +5519,208 @@ float GS_Snake::GetActionInterval(float fActionsPerSecond)
     return ((this->GetFrameTime() / 1000) * fActionsPerSecond);
 }
 
+//==============================================================================================
+// GS_Snake::UpdateSpawnCells():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Blocks the cells of the spawner taken by the current level (the snake keeps the
+//          spawner up to date with the cells it takes itself). Call after loading a level.
+//          Each row of cells is checked as a whole first, which the level map answers with
+//          its summed area table, so only rows with a wall on them are checked cell by cell.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Snake::UpdateSpawnCells()
+{
+
+    RECT rcCell;
+    RECT rcRow;
+
+    int numCols = (m_rcPlayArea.right - m_rcPlayArea.left) / RAT_ELEMENT_WIDTH;
+
+    for (int y = m_rcPlayArea.bottom; y + RAT_ELEMENT_HEIGHT <= m_rcPlayArea.top; y += RAT_ELEMENT_HEIGHT)
+    {
+        // Get the whole row the same way, it covers all of its cells
+        SetRect(&rcRow, m_rcPlayArea.left, y + RAT_ELEMENT_HEIGHT - 1,
+                m_rcPlayArea.left + (numCols * RAT_ELEMENT_WIDTH) - 1, y);
+
+        bool isRowClear = !m_level.CheckCollision(rcRow);
+
+        for (int x = m_rcPlayArea.left; x + RAT_ELEMENT_WIDTH <= m_rcPlayArea.right; x += RAT_ELEMENT_WIDTH)
+        {
+            if (isRowClear)
+            {
+                m_spawner.SetBlocked(x, y, false);
+                continue;
+            }
+
+            // Get the cell the same way the rat collision area is taken
+            SetRect(&rcCell, x, y + RAT_ELEMENT_HEIGHT - 1, x + RAT_ELEMENT_WIDTH - 1, y);
+
+            m_spawner.SetBlocked(x, y, m_level.CheckCollision(rcCell));
+        }
+    }
+}
+
+//==============================================================================================
+// GS_Snake::SpawnRat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Picks a random cell for the rat not taken by the level or the snake, away from the
+//          snake head if there is room.
+// ---------------------------------------------------------------------------------------------
+// Returns: true and the coordinates of the cell if one was found, false if the play area is
+//          full.
+//==============================================================================================
+
+bool GS_Snake::SpawnRat(int* pRatX, int* pRatY)
+{
+
+    RECT rcSnakeHead;
+    m_snake.GetCollideRect(&rcSnakeHead);
+
+    // Try to keep the rat away from the snake head first
+    if (m_spawner.GetFreePosition(pRatX, pRatY, rcSnakeHead.left, rcSnakeHead.bottom, RAT_SPAWN_DISTANCE))
+    {
+        return true;
+    }
+
+    return m_spawner.GetFreePosition(pRatX, pRatY);
+}
+
+//==============================================================================================
+// GS_Snake::ResetRat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Puts the rat at the given coordinates and starts it moving again, at the speed of
+//          the current level made faster for hard mode, the current world and each rat eaten
+//          on the level so far.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Snake::ResetRat(int ratX, int ratY)
+{
+
+    m_rat.Reset(ratX, ratY, m_level.GetRatInterval());
+
+    int numSpeedups = m_currentWorld + m_ratsEaten;
+
+    // Is the game in hard mode?
+    if (m_gameMode == HARD_MODE)
+    {
+        numSpeedups += 3;
+    }
+
+    for (int i = 0; i < numSpeedups; i++)
+    {
+        m_rat.Speedup();
+    }
+
+    m_rat.SetState(m_defaultRatState);
+}
+
+//==============================================================================================
+// GS_Snake::RespawnRat():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Resets the rat on a free cell picked by SpawnRat(). If the play area is full the
+//          rat is left dead, PlayGame() tries again every frame until a cell is free.
+// ---------------------------------------------------------------------------------------------
+// Returns: true if the rat was respawned, false if there was no free cell.
+//==============================================================================================
+
+bool GS_Snake::RespawnRat()
+{
+
+    int ratX, ratY;
+
+    if (!this->SpawnRat(&ratX, &ratY))
+    {
+        m_rat.SetState(RAT_STATE_DEAD);
+        return false;
+    }
+
+    this->ResetRat(ratX, ratY);
+
+    return true;
+}
+
+// *********************************************************************************************
+
+#ifdef GS_BENCHMARK_TARGETS
+
+//==============================================================================================
+// GS_Snake::BenchmarkTargets():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the same set of cursor sprites with GS_OGLSprite::RenderTargetsImmediate()
+//          and with GS_OGLSprite::RenderTargets() a number of times, and shows how long each
+//          took in a message box. Only built when GS_BENCHMARK_TARGETS is defined.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Snake::BenchmarkTargets()
+{
+    const int nNumTargets = 2000;
+    const int nNumRuns    = 100;
+
+    GS_RenderTarget* pgsTargets = new GS_RenderTarget[nNumTargets];
+
+    // Scatter the targets over the screen, rotating and scaling every other one.
+    for (int nLoop = 0; nLoop < nNumTargets; nLoop++)
+    {
+        pgsTargets[nLoop].nDestX     = rand() % INTERNAL_RES_X;
+        pgsTargets[nLoop].nDestY     = rand() % INTERNAL_RES_Y;
+        pgsTargets[nLoop].nSrcLeft   = 0;
+        pgsTargets[nLoop].nSrcTop    = m_gsCursorSprite.GetHeight();
+        pgsTargets[nLoop].nSrcRight  = m_gsCursorSprite.GetWidth();
+        pgsTargets[nLoop].nSrcBottom = 0;
+
+        if (nLoop % 2)
+        {
+            pgsTargets[nLoop].fRotateZ = float(rand() % 360);
+            pgsTargets[nLoop].fScaleX  = 1.5f;
+            pgsTargets[nLoop].fScaleY  = 1.5f;
+        }
+    }
+
+    HWND hWnd = this->GetWindow();
+
+    GS_Timer gsTimer;
+    float fTimes[2];
+
+    for (int nPath = 0; nPath < 2; nPath++)
+    {
+        // Make sure nothing from before is still being drawn.
+        glFinish();
+        gsTimer.Reset();
+
+        for (int nRun = 0; nRun < nNumRuns; nRun++)
+        {
+            if (nPath == 0)
+            {
+                m_gsCursorSprite.RenderTargetsImmediate(nNumTargets, pgsTargets, hWnd);
+            }
+            else
+            {
+                m_gsCursorSprite.RenderTargets(nNumTargets, pgsTargets, hWnd);
+            }
+        }
+
+        glFinish();
+        fTimes[nPath] = gsTimer.GetTime();
+    }
+
+    delete[] pgsTargets;
+
+    char szOutput[256] = { 0 };
+
+    sprintf(szOutput, "%d x %d targets:\n\nRenderTargetsImmediate(): %0.2f ms\nRenderTargets(): %0.2f ms",
+            nNumRuns, nNumTargets, fTimes[0], fTimes[1]);
+
+    MessageBox(NULL, szOutput, "GAME INFORMATION", MB_OK | MB_ICONINFORMATION);
+}
+
+#endif
+
 // *********************************************************************************************
 
 // GS_Error::Report("GS_SNAKE.CPP", 441, "Break Point!");
@@ -26,6 +26,8 @@
 #include "gs_ogl_menu.h"
 #include "gs_ogl_sprite_ex.h"
 #include "gs_ogl_particle.h"
+#include "gs_ogl_render_target.h"
+#include "gs_ogl_texture_atlas.h"
 #include "gs_sdl_controller.h"
 
 #ifdef GS_USE_SDL_MIXER
@@ -38,6 +40,7 @@
 //================================================================================================
 // Include custom game header files.
 // -----------------------------------------------------------------------------------------------
+#include "spawner.h"
 #include "snake.h"
 #include "rat.h"
 #include "level.h"
@@ -75,6 +78,8 @@
 #define DEFAULT_VSYNC 0
 #define DEFAULT_ALIAS 0
 #define DEFAULT_FRAMECAP 60.0f
+#define DEFAULT_RENDERER GS_BACKEND_FIXED
+#define DEFAULT_UPSCALE GS_UPSCALE_NONE
 #define DEFAULT_LIMIT 1
 #define DEFAULT_MUSIC 255
 #define DEFAULT_SOUND 255
@@ -106,6 +111,10 @@
 // ---------------------------------------------------------------------------------------------
 #define MAX_SCORES 10
 // ---------------------------------------------------------------------------------------------
+#define LAYER_PLAY_AREA 0
+#define LAYER_ACTORS 1
+#define LAYER_OVERLAY 3
+// ---------------------------------------------------------------------------------------------
 #define MUSIC_TITLE 0
 #define MUSIC_GAME 1
 // ---------------------------------------------------------------------------------------------
@@ -117,9 +126,9 @@
 #define SAMPLE_RAT_MOVING 5
 #define SAMPLE_RAT_DYING 6
 // ---------------------------------------------------------------------------------------------
-#define RATS_PER_LEVEL 10
 #define RATE_BASE_SCORE 10
 #define DEFAULT_LIVES 5
+#define RAT_SPAWN_DISTANCE 4 // Cells between the snake head and a spawned rat, if there is room
 // ---------------------------------------------------------------------------------------------
 #define EASY_MODE 1
 #define NORMAL_MODE 2
@@ -138,6 +147,8 @@ typedef struct GS_SETTINGS
     BOOL bEnableVSync;    // Whether to syncronize rendering with refresh rate.
     BOOL bEnableAliasing; // Whether to enable anti-aliasing or not.
     float fFrameCap;      // Set the framerate cap (0.0f for uncapped)
+    int nRenderer;        // The rendering backend (GS_BACKEND_FIXED, _SHADER or _SOFTWARE).
+    int nUpscale;         // How the internal resolution is scaled (GS_UPSCALE_NONE, ...).
     int nMusicVolume;     // The volume of the music (0-255).
     int nEffectsVolume;   // The volume of the sound effects (0-255).
 } GS_Settings;
@@ -187,6 +198,8 @@ private:
 
     GS_Timer m_gsTimer; // Timer object.
 
+    GS_OGLTextureAtlas m_gsTextureAtlas; // Atlas the smaller game images are packed into.
+
     GS_OGLSprite m_gsBackSprite;   // Sprite used for the game background.
     GS_OGLSprite m_gsCursorSprite; // Sprite used for the mouse cursor.
     // GS_OGLSprite m_gsTileSprite;   // Sprite used for tile background.
@@ -225,9 +238,17 @@ private:
 
     GS_OGLSpriteEx m_gsScoreBackground; // Create a sprite for creating a backckgroun for displaying the score
 
+    GS_OGLRenderTarget m_gsScoreTarget; // Holds the score area until one of its values changes.
+    long m_lShownScore;                 // Values the score area was last rendered with.
+    int m_nShownLives;
+    int m_nShownRatsEaten;
+    int m_nShownWorld;
+    int m_nShownLevel;
+
     GS_OGLParticle m_snakeParticle;
     ParticleSnake m_particleSnake[MAX_PARTICLE_SNAKES];
 
+    Spawner m_spawner; // Keeps track of the free cells of the play area to spawn rats on
     Snake m_snake;
     Rat m_rat;
     Level m_level;
@@ -298,10 +319,19 @@ public:
     // Helper methods.
     void RenderBackground(float fAlpha = 1.0f);
     void RenderScore(float fAlpha = 1.0f);
+    void RenderScoreArea(float fAlpha = 1.0f);
     void RenderCursor(float fAlpha = 1.0f);
     void RenderFrameRate(float fAlpha = 1.0f);
     void SetRenderScaling(int nWidth, int nHeight, bool bKeepAspect);
     float GetActionInterval(float fActionsPerSecond);
+    void UpdateSpawnCells();
+    bool SpawnRat(int* pRatX, int* pRatY);
+    void ResetRat(int ratX, int ratY);
+    bool RespawnRat();
+
+#ifdef GS_BENCHMARK_TARGETS
+    void BenchmarkTargets();
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,1686 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_soft_renderer.cpp, gs_soft_renderer.h                                            |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SoftRenderer                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Rasterizes the quads of the GS library on the CPU into a framebuffer in memory, for |
+ |        thumbnails and determinism checks that must not depend on the graphics driver. The |
+ |        screen is split into tiles that are rasterized by several threads and the spans    |
+ |        are blended with SSE2 where it is available. GS_OGLCoreRenderer hands it the quads |
+ |        when the display uses GS_BACKEND_SOFTWARE.                                          |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_soft_renderer.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C++ library header files.
+// ---------------------------------------------------------------------------------------------
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Use SSE2 to blend spans where the compiler targets it (every x86-64 processor has it).
+// ---------------------------------------------------------------------------------------------
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define GS_SOFT_SSE2
+    #include <emmintrin.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Blend modes, the first three have their own span functions.
+// ---------------------------------------------------------------------------------------------
+#define GS_SOFT_BLEND_NONE     0 // The source replaces the destination.
+#define GS_SOFT_BLEND_ALPHA    1 // (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+#define GS_SOFT_BLEND_ADDITIVE 2 // (GL_SRC_ALPHA, GL_ONE).
+#define GS_SOFT_BLEND_OTHER    3 // Any other factors.
+// ---------------------------------------------------------------------------------------------
+#define GS_SOFT_SUBPIXELS      16      // Subpixel steps per pixel (28.4 fixed point).
+#define GS_SOFT_MAX_COORD      1000000 // Vertices are clamped to this many pixels off screen.
+//==============================================================================================
+
+
+//==============================================================================================
+// Triangle structure, a quad set up for rasterizing is two of them.
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_SOFT_TRIANGLE
+{
+    long long nX[3];  // Window coordinates in fixed point, counter-clockwise.
+    long long nY[3];
+    int   nBias[3];   // 0 if the edge facing the vertex is a top or left edge, -1 if not.
+    int   nMinX;      // Pixels that may be covered (maximum excluded), clipped.
+    int   nMinY;
+    int   nMaxX;
+    int   nMaxY;
+    float fX;         // Window coordinates of the first vertex.
+    float fY;
+    float fAttrib[6]; // U, V, red, green, blue and alpha at the first vertex.
+    float fDX[6];     // Change of the attributes per pixel to the right.
+    float fDY[6];     // Change of the attributes per pixel up.
+    BOOL  bMagnified; // Wether the texture is magnified (more pixels than texels).
+} GS_SoftTriangle;
+//==============================================================================================
+
+
+//==============================================================================================
+// Static member variables.
+// ---------------------------------------------------------------------------------------------
+BOOL GS_SoftRenderer::m_bIsActive = FALSE;
+
+BYTE* GS_SoftRenderer::m_pFrame       = NULL;
+int   GS_SoftRenderer::m_nFrameWidth  = 0;
+int   GS_SoftRenderer::m_nFrameHeight = 0;
+
+GS_SoftTexture* GS_SoftRenderer::m_pSurface = NULL;
+GLuint          GS_SoftRenderer::m_gluTargets[GS_SOFT_MAX_TARGETS] = { 0 };
+int             GS_SoftRenderer::m_nNumTargets = 0;
+
+int   GS_SoftRenderer::m_nNumThreads = 1;
+BYTE* GS_SoftRenderer::m_pSpans[GS_SOFT_MAX_THREADS] = { NULL };
+int   GS_SoftRenderer::m_nSpanSize   = 0;
+//==============================================================================================
+
+
+//==============================================================================================
+// Copies of the textures given to OpenGL and render targets, by OpenGL texture name.
+// ---------------------------------------------------------------------------------------------
+static std::map<GLuint, GS_SoftTexture> g_softTextures;
+//==============================================================================================
+
+
+//==============================================================================================
+// The draw being rasterized, only read while the threads are running.
+// ---------------------------------------------------------------------------------------------
+static GS_SoftTriangle* g_pTriangles     = NULL;
+static int              g_nTrianglesSize = 0;
+static int              g_nNumTriangles  = 0;
+
+static GS_SoftTexture*  g_pDrawTexture = NULL;
+static BYTE*            g_pDrawPixels  = NULL;
+static int              g_nDrawWidth   = 0;
+static int              g_nClip[4]     = { 0, 0, 0, 0 }; // Left, bottom, right and top.
+
+static int              g_nBlendMode = GS_SOFT_BLEND_NONE;
+static GLenum           g_glBlendSrc = GL_ONE;
+static GLenum           g_glBlendDst = GL_ZERO;
+//==============================================================================================
+
+
+//==============================================================================================
+// The worker threads, started by Create() and waiting for a draw in between (the thread that
+// calls DrawQuads() is thread 0, so only g_workers[1] and up are used).
+// ---------------------------------------------------------------------------------------------
+static std::thread             g_workers[GS_SOFT_MAX_THREADS];
+static int                     g_nNumWorkers = 0;
+
+static std::mutex              g_workMutex;     // Guards the variables below.
+static std::condition_variable g_workCondition; // Wakes the workers when a draw is handed out.
+static std::condition_variable g_doneCondition; // Wakes DrawQuads() when the workers are done.
+static unsigned int            g_nDrawNumber = 0;     // Counts the draws handed out.
+static int                     g_nNumBusy    = 0;     // Workers still rasterizing the draw.
+static BOOL                    g_bIsStopping = FALSE; // Wether the workers should end.
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper Functions. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// Div255():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Divides a product of two 8-bit values by 255, rounded to the nearest integer. The
+//          SSE2 code uses the same steps so both give the same result.
+// ---------------------------------------------------------------------------------------------
+// Returns: The quotient.
+//==============================================================================================
+
+static inline int Div255(int nValue)
+{
+
+    nValue += 128;
+    return (nValue + (nValue >> 8)) >> 8;
+}
+
+
+//==============================================================================================
+// FloorDiv():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Divides rounding towards negative infinity, nDivisor must be positive.
+// ---------------------------------------------------------------------------------------------
+// Returns: The quotient.
+//==============================================================================================
+
+static inline long long FloorDiv(long long nValue, long long nDivisor)
+{
+
+    long long nQuotient = nValue / nDivisor;
+
+    if (((nValue % nDivisor) != 0) && (nValue < 0))
+    {
+        nQuotient--;
+    }
+
+    return nQuotient;
+}
+
+
+//==============================================================================================
+// ToFixed():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a window coordinate to fixed point, clamped so the edge functions can't
+//          overflow.
+// ---------------------------------------------------------------------------------------------
+// Returns: The fixed point coordinate.
+//==============================================================================================
+
+static inline long long ToFixed(float fCoord)
+{
+
+    if (fCoord < -GS_SOFT_MAX_COORD)
+    {
+        fCoord = -GS_SOFT_MAX_COORD;
+    }
+    else if (fCoord > GS_SOFT_MAX_COORD)
+    {
+        fCoord = GS_SOFT_MAX_COORD;
+    }
+
+    return (long long) floor((fCoord * GS_SOFT_SUBPIXELS) + 0.5f);
+}
+
+
+//==============================================================================================
+// ToByte():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Converts a color component from 0.0 - 1.0 to 0 - 255.
+// ---------------------------------------------------------------------------------------------
+// Returns: The component.
+//==============================================================================================
+
+static inline int ToByte(float fValue)
+{
+
+    if (fValue <= 0.0f)
+    {
+        return 0;
+    }
+    if (fValue >= 1.0f)
+    {
+        return 255;
+    }
+
+    return (int) ((fValue * 255.0f) + 0.5f);
+}
+
+
+//==============================================================================================
+// WrapTexel():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Wraps or clamps a texel coordinate like GL_REPEAT or GL_CLAMP_TO_EDGE do.
+// ---------------------------------------------------------------------------------------------
+// Returns: The texel coordinate.
+//==============================================================================================
+
+static inline int WrapTexel(int nTexel, int nSize, BOOL bRepeat)
+{
+
+    if (bRepeat)
+    {
+        nTexel %= nSize;
+        return (nTexel < 0) ? nTexel + nSize : nTexel;
+    }
+
+    if (nTexel < 0)
+    {
+        return 0;
+    }
+
+    return (nTexel >= nSize) ? nSize - 1 : nTexel;
+}
+
+
+//==============================================================================================
+// SampleTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Samples a texture at the given texture coordinates, nearest or bilinear filtered.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing (the RGBA texel is stored in pTexel).
+//==============================================================================================
+
+static inline void SampleTexture(const GS_SoftTexture* pTexture, float fU, float fV,
+                                 BOOL bLinear, int* pTexel)
+{
+
+    if ((!pTexture) || (!pTexture->pPixels))
+    {
+        pTexel[0] = pTexel[1] = pTexel[2] = pTexel[3] = 255;
+        return;
+    }
+
+    int nWidth  = pTexture->nWidth;
+    int nHeight = pTexture->nHeight;
+
+    if (!bLinear)
+    {
+        int nX = WrapTexel((int) floorf(fU * nWidth), nWidth, pTexture->bRepeatS);
+        int nY = WrapTexel((int) floorf(fV * nHeight), nHeight, pTexture->bRepeatT);
+
+        const BYTE* pSource = pTexture->pPixels + (((nY * nWidth) + nX) * 4);
+
+        pTexel[0] = pSource[0];
+        pTexel[1] = pSource[1];
+        pTexel[2] = pSource[2];
+        pTexel[3] = pSource[3];
+        return;
+    }
+
+    // Blend the four texels around the sample point, weights in 1/256ths.
+    float fX = (fU * nWidth) - 0.5f;
+    float fY = (fV * nHeight) - 0.5f;
+
+    float fLeft   = floorf(fX);
+    float fBottom = floorf(fY);
+
+    int nWeightX = (int) ((fX - fLeft) * 256.0f);
+    int nWeightY = (int) ((fY - fBottom) * 256.0f);
+
+    int nX0 = WrapTexel((int) fLeft, nWidth, pTexture->bRepeatS);
+    int nX1 = WrapTexel((int) fLeft + 1, nWidth, pTexture->bRepeatS);
+    int nY0 = WrapTexel((int) fBottom, nHeight, pTexture->bRepeatT);
+    int nY1 = WrapTexel((int) fBottom + 1, nHeight, pTexture->bRepeatT);
+
+    const BYTE* p00 = pTexture->pPixels + (((nY0 * nWidth) + nX0) * 4);
+    const BYTE* p10 = pTexture->pPixels + (((nY0 * nWidth) + nX1) * 4);
+    const BYTE* p01 = pTexture->pPixels + (((nY1 * nWidth) + nX0) * 4);
+    const BYTE* p11 = pTexture->pPixels + (((nY1 * nWidth) + nX1) * 4);
+
+    for (int nChannel = 0; nChannel < 4; nChannel++)
+    {
+        int nBottom = (p00[nChannel] * (256 - nWeightX)) + (p10[nChannel] * nWeightX);
+        int nTop    = (p01[nChannel] * (256 - nWeightX)) + (p11[nChannel] * nWeightX);
+
+        pTexel[nChannel] = ((nBottom * (256 - nWeightY)) + (nTop * nWeightY) + 32768) >> 16;
+    }
+}
+
+
+//==============================================================================================
+// BlendFactor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Determines a blend factor (0 - 255) for one channel, for GS_SOFT_BLEND_OTHER.
+// ---------------------------------------------------------------------------------------------
+// Returns: The factor.
+//==============================================================================================
+
+static inline int BlendFactor(GLenum glFactor, const BYTE* pSource, const BYTE* pDest,
+                              int nChannel)
+{
+
+    switch (glFactor)
+    {
+    case GL_ZERO:
+        return 0;
+    case GL_SRC_COLOR:
+        return pSource[nChannel];
+    case GL_ONE_MINUS_SRC_COLOR:
+        return 255 - pSource[nChannel];
+    case GL_DST_COLOR:
+        return pDest[nChannel];
+    case GL_ONE_MINUS_DST_COLOR:
+        return 255 - pDest[nChannel];
+    case GL_SRC_ALPHA:
+        return pSource[3];
+    case GL_ONE_MINUS_SRC_ALPHA:
+        return 255 - pSource[3];
+    case GL_DST_ALPHA:
+        return pDest[3];
+    case GL_ONE_MINUS_DST_ALPHA:
+        return 255 - pDest[3];
+    default:
+        return 255;
+    }
+}
+
+
+//==============================================================================================
+// BlendSpan():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Blends a span of source pixels into the destination with the current blend mode,
+//          four pixels at a time with SSE2 for alpha and additive blending.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void BlendSpan(BYTE* pDest, const BYTE* pSource, int nNumPixels)
+{
+
+    int nPixel = 0;
+
+    if (g_nBlendMode == GS_SOFT_BLEND_NONE)
+    {
+        memcpy(pDest, pSource, nNumPixels * 4);
+        return;
+    }
+
+#ifdef GS_SOFT_SSE2
+    if ((g_nBlendMode == GS_SOFT_BLEND_ALPHA) || (g_nBlendMode == GS_SOFT_BLEND_ADDITIVE))
+    {
+        const __m128i xmmZero = _mm_setzero_si128();
+        const __m128i xmm128  = _mm_set1_epi16(128);
+        const __m128i xmm255  = _mm_set1_epi16(255);
+
+        for (; (nPixel + 4) <= nNumPixels; nPixel += 4)
+        {
+            __m128i xmmSource = _mm_loadu_si128((const __m128i*) (pSource + (nPixel * 4)));
+            __m128i xmmDest   = _mm_loadu_si128((const __m128i*) (pDest + (nPixel * 4)));
+
+            // Two pixels in each register, 16 bits per channel.
+            __m128i xmmSourceLo = _mm_unpacklo_epi8(xmmSource, xmmZero);
+            __m128i xmmSourceHi = _mm_unpackhi_epi8(xmmSource, xmmZero);
+
+            // Copy the alpha of each pixel to all its channels.
+            __m128i xmmAlphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(xmmSourceLo,
+                                 _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i xmmAlphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(xmmSourceHi,
+                                 _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128i xmmLo = _mm_mullo_epi16(xmmSourceLo, xmmAlphaLo);
+            __m128i xmmHi = _mm_mullo_epi16(xmmSourceHi, xmmAlphaHi);
+
+            if (g_nBlendMode == GS_SOFT_BLEND_ALPHA)
+            {
+                __m128i xmmDestLo = _mm_unpacklo_epi8(xmmDest, xmmZero);
+                __m128i xmmDestHi = _mm_unpackhi_epi8(xmmDest, xmmZero);
+
+                xmmLo = _mm_add_epi16(xmmLo, _mm_mullo_epi16(xmmDestLo,
+                                                             _mm_sub_epi16(xmm255, xmmAlphaLo)));
+                xmmHi = _mm_add_epi16(xmmHi, _mm_mullo_epi16(xmmDestHi,
+                                                             _mm_sub_epi16(xmm255, xmmAlphaHi)));
+            }
+
+            // Divide by 255 the same way Div255() does.
+            xmmLo = _mm_add_epi16(xmmLo, xmm128);
+            xmmHi = _mm_add_epi16(xmmHi, xmm128);
+            xmmLo = _mm_srli_epi16(_mm_add_epi16(xmmLo, _mm_srli_epi16(xmmLo, 8)), 8);
+            xmmHi = _mm_srli_epi16(_mm_add_epi16(xmmHi, _mm_srli_epi16(xmmHi, 8)), 8);
+
+            __m128i xmmResult = _mm_packus_epi16(xmmLo, xmmHi);
+
+            if (g_nBlendMode == GS_SOFT_BLEND_ADDITIVE)
+            {
+                xmmResult = _mm_adds_epu8(xmmDest, xmmResult);
+            }
+
+            _mm_storeu_si128((__m128i*) (pDest + (nPixel * 4)), xmmResult);
+        }
+    }
+#endif
+
+    // Blend the pixels that are left (or all of them without SSE2).
+    for (; nPixel < nNumPixels; nPixel++)
+    {
+        const BYTE* pSrc = pSource + (nPixel * 4);
+        BYTE*       pDst = pDest + (nPixel * 4);
+
+        if (g_nBlendMode == GS_SOFT_BLEND_ALPHA)
+        {
+            int nAlpha = pSrc[3];
+            for (int nChannel = 0; nChannel < 4; nChannel++)
+            {
+                pDst[nChannel] = (BYTE) Div255((pSrc[nChannel] * nAlpha) +
+                                               (pDst[nChannel] * (255 - nAlpha)));
+            }
+        }
+        else if (g_nBlendMode == GS_SOFT_BLEND_ADDITIVE)
+        {
+            int nAlpha = pSrc[3];
+            for (int nChannel = 0; nChannel < 4; nChannel++)
+            {
+                int nValue = pDst[nChannel] + Div255(pSrc[nChannel] * nAlpha);
+                pDst[nChannel] = (BYTE) ((nValue > 255) ? 255 : nValue);
+            }
+        }
+        else
+        {
+            BYTE byResult[4];
+            for (int nChannel = 0; nChannel < 4; nChannel++)
+            {
+                int nValue = Div255((pSrc[nChannel] *
+                                     BlendFactor(g_glBlendSrc, pSrc, pDst, nChannel)) +
+                                    (pDst[nChannel] *
+                                     BlendFactor(g_glBlendDst, pSrc, pDst, nChannel)));
+                byResult[nChannel] = (BYTE) ((nValue > 255) ? 255 : nValue);
+            }
+            memcpy(pDst, byResult, 4);
+        }
+    }
+}
+
+
+//==============================================================================================
+// SetupTriangle():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets up a triangle for rasterizing from three vertices in window coordinates, each
+//          with six attributes (U, V, red, green, blue and alpha).
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the triangle may cover pixels inside the clip box, FALSE if not.
+//==============================================================================================
+
+static BOOL SetupTriangle(const float* pX, const float* pY, const float (*pAttribs)[6],
+                          const GS_SoftTexture* pTexture, GS_SoftTriangle* pTriangle)
+{
+
+    int nOrder[3] = { 0, 1, 2 };
+
+    long long nX[3], nY[3];
+
+    for (int nVertex = 0; nVertex < 3; nVertex++)
+    {
+        nX[nVertex] = ToFixed(pX[nVertex]);
+        nY[nVertex] = ToFixed(pY[nVertex]);
+    }
+
+    long long nArea = ((nX[1] - nX[0]) * (nY[2] - nY[0])) - ((nY[1] - nY[0]) * (nX[2] - nX[0]));
+
+    if (nArea == 0)
+    {
+        return FALSE;
+    }
+
+    // Make the triangle counter-clockwise, the edge functions are positive inside it then.
+    if (nArea < 0)
+    {
+        nOrder[1] = 2;
+        nOrder[2] = 1;
+        nArea     = -nArea;
+    }
+
+    long long nMinX = 0, nMinY = 0, nMaxX = 0, nMaxY = 0;
+
+    for (int nVertex = 0; nVertex < 3; nVertex++)
+    {
+        pTriangle->nX[nVertex] = nX[nOrder[nVertex]];
+        pTriangle->nY[nVertex] = nY[nOrder[nVertex]];
+
+        if ((nVertex == 0) || (pTriangle->nX[nVertex] < nMinX)) nMinX = pTriangle->nX[nVertex];
+        if ((nVertex == 0) || (pTriangle->nX[nVertex] > nMaxX)) nMaxX = pTriangle->nX[nVertex];
+        if ((nVertex == 0) || (pTriangle->nY[nVertex] < nMinY)) nMinY = pTriangle->nY[nVertex];
+        if ((nVertex == 0) || (pTriangle->nY[nVertex] > nMaxY)) nMaxY = pTriangle->nY[nVertex];
+    }
+
+    // The pixels whose centers may lie inside the triangle, clipped.
+    pTriangle->nMinX = (int) FloorDiv(nMinX, GS_SOFT_SUBPIXELS);
+    pTriangle->nMinY = (int) FloorDiv(nMinY, GS_SOFT_SUBPIXELS);
+    pTriangle->nMaxX = (int) FloorDiv(nMaxX, GS_SOFT_SUBPIXELS) + 1;
+    pTriangle->nMaxY = (int) FloorDiv(nMaxY, GS_SOFT_SUBPIXELS) + 1;
+
+    if (pTriangle->nMinX < g_nClip[0]) pTriangle->nMinX = g_nClip[0];
+    if (pTriangle->nMinY < g_nClip[1]) pTriangle->nMinY = g_nClip[1];
+    if (pTriangle->nMaxX > g_nClip[2]) pTriangle->nMaxX = g_nClip[2];
+    if (pTriangle->nMaxY > g_nClip[3]) pTriangle->nMaxY = g_nClip[3];
+
+    if ((pTriangle->nMinX >= pTriangle->nMaxX) || (pTriangle->nMinY >= pTriangle->nMaxY))
+    {
+        return FALSE;
+    }
+
+    // Pixel centers exactly on an edge belong to the triangle if the edge is a left edge (going
+    // down) or a top edge (horizontal, going left), so shared edges are only drawn once.
+    for (int nEdge = 0; nEdge < 3; nEdge++)
+    {
+        int nFrom = (nEdge + 1) % 3;
+        int nTo   = (nEdge + 2) % 3;
+
+        long long nDeltaX = pTriangle->nX[nTo] - pTriangle->nX[nFrom];
+        long long nDeltaY = pTriangle->nY[nTo] - pTriangle->nY[nFrom];
+
+        BOOL bTopLeft = (nDeltaY < 0) || ((nDeltaY == 0) && (nDeltaX < 0));
+
+        pTriangle->nBias[nEdge] = bTopLeft ? 0 : -1;
+    }
+
+    // Set up the planes the attributes are interpolated on.
+    float fX[3], fY[3];
+
+    for (int nVertex = 0; nVertex < 3; nVertex++)
+    {
+        fX[nVertex] = (float) pTriangle->nX[nVertex] / GS_SOFT_SUBPIXELS;
+        fY[nVertex] = (float) pTriangle->nY[nVertex] / GS_SOFT_SUBPIXELS;
+    }
+
+    float fArea = (float) nArea / (GS_SOFT_SUBPIXELS * GS_SOFT_SUBPIXELS);
+
+    pTriangle->fX = fX[0];
+    pTriangle->fY = fY[0];
+
+    for (int nAttrib = 0; nAttrib < 6; nAttrib++)
+    {
+        float fA = pAttribs[nOrder[0]][nAttrib];
+        float fB = pAttribs[nOrder[1]][nAttrib] - fA;
+        float fC = pAttribs[nOrder[2]][nAttrib] - fA;
+
+        pTriangle->fAttrib[nAttrib] = fA;
+        pTriangle->fDX[nAttrib] = ((fB * (fY[2] - fY[0])) - (fC * (fY[1] - fY[0]))) / fArea;
+        pTriangle->fDY[nAttrib] = ((fC * (fX[1] - fX[0])) - (fB * (fX[2] - fX[0]))) / fArea;
+    }
+
+    // Texels covered by one pixel decide between the magnification and minification filters.
+    pTriangle->bMagnified = TRUE;
+
+    if (pTexture)
+    {
+        float fTexels = fabsf((pTriangle->fDX[0] * pTriangle->fDY[1]) -
+                              (pTriangle->fDY[0] * pTriangle->fDX[1])) *
+                        pTexture->nWidth * pTexture->nHeight;
+
+        pTriangle->bMagnified = (fTexels <= 1.0f);
+    }
+
+    return TRUE;
+}
+
+
+//==============================================================================================
+// RasterizeRows():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Rasterizes the rows nFirstRow to nLastRow (excluded) of a triangle, each row is
+//          shaded into pSpan and then blended into the surface.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void RasterizeRows(const GS_SoftTriangle* pTriangle, int nFirstRow, int nLastRow,
+                          BYTE* pSpan)
+{
+
+    const GS_SoftTexture* pTexture = g_pDrawTexture;
+
+    BOOL bLinear = FALSE;
+
+    if (pTexture)
+    {
+        bLinear = pTriangle->bMagnified ? pTexture->bMagLinear : pTexture->bMinLinear;
+    }
+
+    for (int nRow = nFirstRow; nRow < nLastRow; nRow++)
+    {
+        long long nCenterY = ((long long) nRow * GS_SOFT_SUBPIXELS) + (GS_SOFT_SUBPIXELS / 2);
+
+        long long nStart = pTriangle->nMinX;
+        long long nEnd   = pTriangle->nMaxX;
+
+        // Narrow the span down to the pixels inside all three edges.
+        for (int nEdge = 0; (nEdge < 3) && (nStart < nEnd); nEdge++)
+        {
+            int nFrom = (nEdge + 1) % 3;
+            int nTo   = (nEdge + 2) % 3;
+
+            long long nDeltaX = pTriangle->nX[nTo] - pTriangle->nX[nFrom];
+            long long nDeltaY = pTriangle->nY[nTo] - pTriangle->nY[nFrom];
+
+            // The edge function at the center of pixel nPixel is nBase - nStep * nPixel.
+            long long nBase = (nDeltaX * (nCenterY - pTriangle->nY[nFrom])) -
+                              (nDeltaY * ((GS_SOFT_SUBPIXELS / 2) - pTriangle->nX[nFrom])) +
+                              pTriangle->nBias[nEdge];
+            long long nStep = nDeltaY * GS_SOFT_SUBPIXELS;
+
+            if (nStep == 0)
+            {
+                if (nBase < 0)
+                {
+                    nEnd = nStart;
+                }
+            }
+            else if (nStep < 0)
+            {
+                long long nFirst = -FloorDiv(nBase, -nStep);
+                if (nFirst > nStart)
+                {
+                    nStart = nFirst;
+                }
+            }
+            else
+            {
+                long long nLast = FloorDiv(nBase, nStep) + 1;
+                if (nLast < nEnd)
+                {
+                    nEnd = nLast;
+                }
+            }
+        }
+
+        if (nStart >= nEnd)
+        {
+            continue;
+        }
+
+        // Interpolate the attributes from the center of the first pixel.
+        float fOffsetX = ((float) nStart + 0.5f) - pTriangle->fX;
+        float fOffsetY = ((float) nRow + 0.5f) - pTriangle->fY;
+
+        float fAttrib[6];
+
+        for (int nAttrib = 0; nAttrib < 6; nAttrib++)
+        {
+            fAttrib[nAttrib] = pTriangle->fAttrib[nAttrib] +
+                               (pTriangle->fDX[nAttrib] * fOffsetX) +
+                               (pTriangle->fDY[nAttrib] * fOffsetY);
+        }
+
+        int   nNumPixels = (int) (nEnd - nStart);
+        BYTE* pPixel     = pSpan;
+
+        for (int nPixel = 0; nPixel < nNumPixels; nPixel++)
+        {
+            int nTexel[4];
+            SampleTexture(pTexture, fAttrib[0], fAttrib[1], bLinear, nTexel);
+
+            // Modulate the texel with the color, like GL_MODULATE.
+            pPixel[0] = (BYTE) Div255(nTexel[0] * ToByte(fAttrib[2]));
+            pPixel[1] = (BYTE) Div255(nTexel[1] * ToByte(fAttrib[3]));
+            pPixel[2] = (BYTE) Div255(nTexel[2] * ToByte(fAttrib[4]));
+            pPixel[3] = (BYTE) Div255(nTexel[3] * ToByte(fAttrib[5]));
+            pPixel += 4;
+
+            for (int nAttrib = 0; nAttrib < 6; nAttrib++)
+            {
+                fAttrib[nAttrib] += pTriangle->fDX[nAttrib];
+            }
+        }
+
+        BlendSpan(g_pDrawPixels + ((((long long) nRow * g_nDrawWidth) + nStart) * 4), pSpan,
+                  nNumPixels);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Create/Destroy Methods. /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates the framebuffer and starts the worker threads. The number of threads
+//          defaults to the number of processor cores (at most GS_SOFT_MAX_THREADS), the
+//          calling thread being one of them. The output doesn't depend on it, every tile is
+//          rasterized by one thread in the order the quads were drawn.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::Create(int nWidth, int nHeight, int nNumThreads)
+{
+
+    if (m_bIsActive)
+    {
+        Destroy();
+    }
+
+    if (nNumThreads <= 0)
+    {
+        nNumThreads = (int) std::thread::hardware_concurrency();
+    }
+
+    if (nNumThreads < 1)
+    {
+        nNumThreads = 1;
+    }
+    else if (nNumThreads > GS_SOFT_MAX_THREADS)
+    {
+        nNumThreads = GS_SOFT_MAX_THREADS;
+    }
+
+    m_nNumThreads = nNumThreads;
+
+    if (!Resize(nWidth, nHeight))
+    {
+        GS_Error::Report("GS_SOFT_RENDERER.CPP", 744, "Failed to create the framebuffer!");
+        Destroy();
+        return FALSE;
+    }
+
+    m_pSurface    = NULL;
+    m_nNumTargets = 0;
+    m_bIsActive   = TRUE;
+
+    // No draw has been handed out to the workers yet.
+    g_nDrawNumber = 0;
+    g_nNumBusy    = 0;
+    g_bIsStopping = FALSE;
+
+    for (int nThread = 1; nThread < m_nNumThreads; nThread++)
+    {
+        g_workers[nThread] = std::thread(Work, nThread);
+    }
+    g_nNumWorkers = m_nNumThreads - 1;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Stops the worker threads and frees the framebuffer and all texture copies.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::Destroy()
+{
+
+    // Let the workers end, they are waiting for a draw.
+    if (g_nNumWorkers > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_workMutex);
+            g_bIsStopping = TRUE;
+        }
+        g_workCondition.notify_all();
+
+        for (int nThread = 1; nThread <= g_nNumWorkers; nThread++)
+        {
+            g_workers[nThread].join();
+        }
+        g_nNumWorkers = 0;
+    }
+
+    std::map<GLuint, GS_SoftTexture>::iterator itTexture;
+
+    for (itTexture = g_softTextures.begin(); itTexture != g_softTextures.end(); ++itTexture)
+    {
+        delete[] itTexture->second.pPixels;
+    }
+    g_softTextures.clear();
+
+    if (m_pFrame)
+    {
+        delete[] m_pFrame;
+        m_pFrame = NULL;
+    }
+    m_nFrameWidth  = 0;
+    m_nFrameHeight = 0;
+
+    for (int nThread = 0; nThread < GS_SOFT_MAX_THREADS; nThread++)
+    {
+        if (m_pSpans[nThread])
+        {
+            delete[] m_pSpans[nThread];
+            m_pSpans[nThread] = NULL;
+        }
+    }
+    m_nSpanSize = 0;
+
+    if (g_pTriangles)
+    {
+        delete[] g_pTriangles;
+        g_pTriangles = NULL;
+    }
+    g_nTrianglesSize = 0;
+    g_nNumTriangles  = 0;
+
+    m_pSurface    = NULL;
+    m_nNumTargets = 0;
+    m_bIsActive   = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Resize():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Changes the size of the framebuffer (GS_OGLDisplay::SetViewport() calls this), the
+//          contents are cleared.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::Resize(int nWidth, int nHeight)
+{
+
+    if ((nWidth <= 0) || (nHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    if ((!m_pFrame) || (nWidth != m_nFrameWidth) || (nHeight != m_nFrameHeight))
+    {
+        if (m_pFrame)
+        {
+            delete[] m_pFrame;
+        }
+        m_pFrame       = new BYTE[nWidth * nHeight * 4];
+        m_nFrameWidth  = nWidth;
+        m_nFrameHeight = nHeight;
+    }
+
+    memset(m_pFrame, 0, nWidth * nHeight * 4);
+
+    return MakeSpans(nWidth);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::MakeSpans():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Makes sure the span of each thread can hold a row of the specified width.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::MakeSpans(int nWidth)
+{
+
+    if (nWidth <= m_nSpanSize)
+    {
+        return TRUE;
+    }
+
+    for (int nThread = 0; nThread < GS_SOFT_MAX_THREADS; nThread++)
+    {
+        if (m_pSpans[nThread])
+        {
+            delete[] m_pSpans[nThread];
+        }
+        m_pSpans[nThread] = new BYTE[nWidth * 4];
+    }
+
+    m_nSpanSize = nWidth;
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::IsActive():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if the renderer has been created, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::IsActive()
+{
+
+    return m_bIsActive;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Texture Methods. ////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::FindTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Finds the copy of a texture made by StoreTexture() or BeginTarget(), OpenGL is
+//          never asked for the pixels.
+// ---------------------------------------------------------------------------------------------
+// Returns: The copy, NULL for texture 0 or a texture without a copy (sampled as white).
+//==============================================================================================
+
+GS_SoftTexture* GS_SoftRenderer::FindTexture(GLuint gluTexture)
+{
+
+    if (gluTexture == 0)
+    {
+        return NULL;
+    }
+
+    std::map<GLuint, GS_SoftTexture>::iterator itTexture = g_softTextures.find(gluTexture);
+
+    if (itTexture == g_softTextures.end())
+    {
+        return NULL;
+    }
+
+    return &itTexture->second;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::StoreTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Keeps a copy of the pixels (RGB or RGBA, the bottom row first) given to OpenGL for
+//          a texture, GS_OGLTexture::Create() and GS_OGLTextureAtlas call this when they
+//          upload them. The filters are those of the texture, which repeats like OpenGL's
+//          default. Nothing is copied while the renderer isn't active.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::StoreTexture(GLuint gluTexture, const BYTE* pData, int nWidth,
+                                   int nHeight, int nBpp, GLint glMinFilter, GLint glMagFilter)
+{
+
+    if ((!m_bIsActive) || (gluTexture == 0) || (!pData) || (nWidth <= 0) || (nHeight <= 0) ||
+        ((nBpp != 3) && (nBpp != 4)))
+    {
+        return;
+    }
+
+    GS_SoftTexture* pTexture = &g_softTextures[gluTexture];
+
+    if ((!pTexture->pPixels) || (pTexture->nWidth != nWidth) || (pTexture->nHeight != nHeight))
+    {
+        if (pTexture->pPixels)
+        {
+            delete[] pTexture->pPixels;
+        }
+        pTexture->pPixels = new BYTE[nWidth * nHeight * 4];
+        pTexture->nWidth  = nWidth;
+        pTexture->nHeight = nHeight;
+    }
+
+    // Mipmaps aren't copied, minified textures are sampled from the base level.
+    pTexture->bMinLinear = (glMinFilter != GL_NEAREST) &&
+                           (glMinFilter != GL_NEAREST_MIPMAP_NEAREST) &&
+                           (glMinFilter != GL_NEAREST_MIPMAP_LINEAR);
+    pTexture->bMagLinear = (glMagFilter == GL_LINEAR);
+    pTexture->bRepeatS   = TRUE;
+    pTexture->bRepeatT   = TRUE;
+
+    int nNumPixels = nWidth * nHeight;
+
+    if (nBpp == 4)
+    {
+        memcpy(pTexture->pPixels, pData, nNumPixels * 4);
+        return;
+    }
+
+    for (int nPixel = 0; nPixel < nNumPixels; nPixel++)
+    {
+        pTexture->pPixels[(nPixel * 4)]     = pData[(nPixel * 3)];
+        pTexture->pPixels[(nPixel * 4) + 1] = pData[(nPixel * 3) + 1];
+        pTexture->pPixels[(nPixel * 4) + 2] = pData[(nPixel * 3) + 2];
+        pTexture->pPixels[(nPixel * 4) + 3] = 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::ReleaseTexture():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Frees the copy of a texture, GS_OGLState::DeleteTexture() calls this so a texture
+//          name reused by OpenGL doesn't keep the old pixels.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::ReleaseTexture(GLuint gluTexture)
+{
+
+    std::map<GLuint, GS_SoftTexture>::iterator itTexture = g_softTextures.find(gluTexture);
+
+    if (itTexture == g_softTextures.end())
+    {
+        return;
+    }
+
+    if (m_pSurface == &itTexture->second)
+    {
+        m_pSurface = NULL;
+    }
+
+    for (int nTarget = 0; nTarget < m_nNumTargets; nTarget++)
+    {
+        if (m_gluTargets[nTarget] == gluTexture)
+        {
+            m_gluTargets[nTarget] = 0;
+        }
+    }
+
+    delete[] itTexture->second.pPixels;
+    g_softTextures.erase(itTexture);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::BeginTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Redirects drawing into the copy of a render target's texture, which is cleared to
+//          transparent (GS_OGLRenderTarget::Begin() calls this). The target drawn to so far is
+//          drawn to again after EndTarget(). The copy is sampled with bilinear filtering if
+//          bLinear is TRUE, like the texture.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::BeginTarget(GLuint gluTexture, int nWidth, int nHeight, BOOL bLinear)
+{
+
+    if ((!m_bIsActive) || (gluTexture == 0) || (nWidth <= 0) || (nHeight <= 0))
+    {
+        return FALSE;
+    }
+
+    if (m_nNumTargets >= GS_SOFT_MAX_TARGETS)
+    {
+        GS_Error::Report("GS_SOFT_RENDERER.CPP", 1036, "Too many nested render targets!");
+        return FALSE;
+    }
+
+    GS_SoftTexture* pTarget = &g_softTextures[gluTexture];
+
+    if ((!pTarget->pPixels) || (pTarget->nWidth != nWidth) || (pTarget->nHeight != nHeight))
+    {
+        if (pTarget->pPixels)
+        {
+            delete[] pTarget->pPixels;
+        }
+        pTarget->pPixels = new BYTE[nWidth * nHeight * 4];
+        pTarget->nWidth  = nWidth;
+        pTarget->nHeight = nHeight;
+    }
+
+    // Render targets don't repeat.
+    pTarget->bMinLinear = bLinear;
+    pTarget->bMagLinear = bLinear;
+    pTarget->bRepeatS   = FALSE;
+    pTarget->bRepeatT   = FALSE;
+
+    memset(pTarget->pPixels, 0, nWidth * nHeight * 4);
+
+    // Remember the target drawn to so far (0 for the frame).
+    GLuint gluSurface = 0;
+
+    std::map<GLuint, GS_SoftTexture>::iterator itTexture;
+
+    for (itTexture = g_softTextures.begin(); itTexture != g_softTextures.end(); ++itTexture)
+    {
+        if (m_pSurface == &itTexture->second)
+        {
+            gluSurface = itTexture->first;
+            break;
+        }
+    }
+
+    m_gluTargets[m_nNumTargets] = gluSurface;
+    m_nNumTargets++;
+
+    m_pSurface = pTarget;
+
+    return MakeSpans(nWidth);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::EndTarget():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Restores drawing into the target (or framebuffer) drawn to before BeginTarget().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::EndTarget()
+{
+
+    m_pSurface = NULL;
+
+    if (m_nNumTargets <= 0)
+    {
+        return;
+    }
+
+    m_nNumTargets--;
+
+    std::map<GLuint, GS_SoftTexture>::iterator itTexture =
+        g_softTextures.find(m_gluTargets[m_nNumTargets]);
+
+    if (itTexture != g_softTextures.end())
+    {
+        m_pSurface = &itTexture->second;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Draw Methods. ///////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Clear():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Clears the framebuffer (or the render target being drawn to) to a color.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::Clear(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha)
+{
+
+    if (!m_bIsActive)
+    {
+        return;
+    }
+
+    BYTE* pPixels   = m_pSurface ? m_pSurface->pPixels : m_pFrame;
+    int   nNumPixels = m_pSurface ? (m_pSurface->nWidth * m_pSurface->nHeight) :
+                                    (m_nFrameWidth * m_nFrameHeight);
+
+    BYTE byColor[4] = { (BYTE) ToByte(glfRed), (BYTE) ToByte(glfGreen), (BYTE) ToByte(glfBlue),
+                        (BYTE) ToByte(glfAlpha) };
+
+    for (int nPixel = 0; nPixel < nNumPixels; nPixel++)
+    {
+        memcpy(pPixels + (nPixel * 4), byColor, 4);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::DrawQuads():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws quads (four vertices each) with a texture, using the blend mode and scissor
+//          box of GS_OGLState. The vertices are transformed by the projection (column major,
+//          as given to OpenGL) and set up here, the tiles they cover are rasterized by the
+//          threads if there are enough pixels to go around.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::DrawQuads(GLuint gluTexture, const GS_BatchVertex* pVertices,
+                                int nNumVertices, const GLfloat* pProjection)
+{
+
+    if ((!m_bIsActive) || (!pVertices) || (!pProjection) || (nNumVertices < 4))
+    {
+        return;
+    }
+
+    int nNumQuads = nNumVertices / 4;
+
+    // Make room for two triangles per quad.
+    if ((nNumQuads * 2) > g_nTrianglesSize)
+    {
+        if (g_pTriangles)
+        {
+            delete[] g_pTriangles;
+        }
+        g_nTrianglesSize = nNumQuads * 2;
+        g_pTriangles     = new GS_SoftTriangle[g_nTrianglesSize];
+    }
+
+    // Determine the surface, its clip box and the blend mode.
+    int nWidth  = m_pSurface ? m_pSurface->nWidth : m_nFrameWidth;
+    int nHeight = m_pSurface ? m_pSurface->nHeight : m_nFrameHeight;
+
+    g_pDrawPixels  = m_pSurface ? m_pSurface->pPixels : m_pFrame;
+    g_nDrawWidth   = nWidth;
+    g_pDrawTexture = FindTexture(gluTexture);
+
+    g_nClip[0] = 0;
+    g_nClip[1] = 0;
+    g_nClip[2] = nWidth;
+    g_nClip[3] = nHeight;
+
+    if (GS_OGLState::IsScissorEnabled())
+    {
+        GLint gliScissor[4];
+        GS_OGLState::GetScissor(gliScissor);
+
+        if (gliScissor[0] > g_nClip[0]) g_nClip[0] = gliScissor[0];
+        if (gliScissor[1] > g_nClip[1]) g_nClip[1] = gliScissor[1];
+
+        int nRight = gliScissor[0] + gliScissor[2];
+        int nTop   = gliScissor[1] + gliScissor[3];
+
+        if (nRight < g_nClip[2]) g_nClip[2] = nRight;
+        if (nTop < g_nClip[3]) g_nClip[3] = nTop;
+    }
+
+    if ((g_nClip[0] >= g_nClip[2]) || (g_nClip[1] >= g_nClip[3]))
+    {
+        return;
+    }
+
+    g_nBlendMode = GS_SOFT_BLEND_NONE;
+
+    if (GS_OGLState::IsBlendingEnabled())
+    {
+        GS_OGLState::GetBlendFunc(&g_glBlendSrc, &g_glBlendDst);
+
+        if ((g_glBlendSrc == GL_SRC_ALPHA) && (g_glBlendDst == GL_ONE_MINUS_SRC_ALPHA))
+        {
+            g_nBlendMode = GS_SOFT_BLEND_ALPHA;
+        }
+        else if ((g_glBlendSrc == GL_SRC_ALPHA) && (g_glBlendDst == GL_ONE))
+        {
+            g_nBlendMode = GS_SOFT_BLEND_ADDITIVE;
+        }
+        else if ((g_glBlendSrc != GL_ONE) || (g_glBlendDst != GL_ZERO))
+        {
+            g_nBlendMode = GS_SOFT_BLEND_OTHER;
+        }
+    }
+
+    // Transform the quads to window coordinates and set up their triangles.
+    long long nNumPixels = 0;
+
+    g_nNumTriangles = 0;
+
+    for (int nQuad = 0; nQuad < nNumQuads; nQuad++)
+    {
+        const GS_BatchVertex* pQuad = &pVertices[nQuad * 4];
+
+        float fX[4], fY[4], fAttribs[4][6];
+
+        for (int nCorner = 0; nCorner < 4; nCorner++)
+        {
+            float fClipX = (pProjection[0] * pQuad[nCorner].fX) +
+                           (pProjection[4] * pQuad[nCorner].fY) + pProjection[12];
+            float fClipY = (pProjection[1] * pQuad[nCorner].fX) +
+                           (pProjection[5] * pQuad[nCorner].fY) + pProjection[13];
+
+            fX[nCorner] = (fClipX + 1.0f) * 0.5f * nWidth;
+            fY[nCorner] = (fClipY + 1.0f) * 0.5f * nHeight;
+
+            fAttribs[nCorner][0] = pQuad[nCorner].fU;
+            fAttribs[nCorner][1] = pQuad[nCorner].fV;
+            fAttribs[nCorner][2] = pQuad[nCorner].fRed;
+            fAttribs[nCorner][3] = pQuad[nCorner].fGreen;
+            fAttribs[nCorner][4] = pQuad[nCorner].fBlue;
+            fAttribs[nCorner][5] = pQuad[nCorner].fAlpha;
+        }
+
+        // Split the quad the same way the shader renderer's indices do (0, 1, 2 and 0, 2, 3).
+        for (int nHalf = 0; nHalf < 2; nHalf++)
+        {
+            int nCorners[3] = { 0, 1 + nHalf, 2 + nHalf };
+
+            float fTriX[3], fTriY[3], fTriAttribs[3][6];
+
+            for (int nVertex = 0; nVertex < 3; nVertex++)
+            {
+                fTriX[nVertex] = fX[nCorners[nVertex]];
+                fTriY[nVertex] = fY[nCorners[nVertex]];
+                memcpy(fTriAttribs[nVertex], fAttribs[nCorners[nVertex]], sizeof(fTriAttribs[0]));
+            }
+
+            GS_SoftTriangle* pTriangle = &g_pTriangles[g_nNumTriangles];
+
+            if (SetupTriangle(fTriX, fTriY, fTriAttribs, g_pDrawTexture, pTriangle))
+            {
+                nNumPixels += (long long) (pTriangle->nMaxX - pTriangle->nMinX) *
+                              (pTriangle->nMaxY - pTriangle->nMinY) / 2;
+                g_nNumTriangles++;
+            }
+        }
+    }
+
+    if (g_nNumTriangles == 0)
+    {
+        return;
+    }
+
+    // Small draws aren't worth waking the workers for.
+    if ((nNumPixels < GS_SOFT_MIN_PARALLEL) || (g_nNumWorkers <= 0))
+    {
+        RasterizeTiles(0, 1, m_pSpans[0]);
+        return;
+    }
+
+    // Hand the draw to the workers and rasterize the first tiles here meanwhile.
+    {
+        std::lock_guard<std::mutex> lock(g_workMutex);
+        g_nNumBusy = g_nNumWorkers;
+        g_nDrawNumber++;
+    }
+    g_workCondition.notify_all();
+
+    RasterizeTiles(0, m_nNumThreads, m_pSpans[0]);
+
+    std::unique_lock<std::mutex> lock(g_workMutex);
+
+    while (g_nNumBusy > 0)
+    {
+        g_doneCondition.wait(lock);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Work():
+// ---------------------------------------------------------------------------------------------
+// Purpose: A worker thread: waits for DrawQuads() to hand out a draw, rasterizes its share of
+//          the tiles and waits again, until Destroy() lets it end.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::Work(int nThread)
+{
+
+    std::unique_lock<std::mutex> lock(g_workMutex);
+
+    unsigned int nLastDraw = 0;
+
+    while (!g_bIsStopping)
+    {
+        if (g_nDrawNumber == nLastDraw)
+        {
+            g_workCondition.wait(lock);
+            continue;
+        }
+
+        nLastDraw = g_nDrawNumber;
+
+        // The draw doesn't change until every worker is done with it.
+        lock.unlock();
+        RasterizeTiles(nThread, m_nNumThreads, m_pSpans[nThread]);
+        lock.lock();
+
+        if (--g_nNumBusy == 0)
+        {
+            g_doneCondition.notify_one();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::RasterizeTiles():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Rasterizes every nTileStep-th tile starting with nFirstTile, the triangles of each
+//          tile in the order they were drawn. No two threads touch the same pixels.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::RasterizeTiles(int nFirstTile, int nTileStep, BYTE* pSpan)
+{
+
+    int nFirstRow = g_nClip[1] - (g_nClip[1] % GS_SOFT_TILE_HEIGHT);
+
+    for (int nTile = nFirstTile; ; nTile += nTileStep)
+    {
+        int nTileBottom = nFirstRow + (nTile * GS_SOFT_TILE_HEIGHT);
+        int nTileTop    = nTileBottom + GS_SOFT_TILE_HEIGHT;
+
+        if (nTileBottom >= g_nClip[3])
+        {
+            break;
+        }
+
+        for (int nTriangle = 0; nTriangle < g_nNumTriangles; nTriangle++)
+        {
+            const GS_SoftTriangle* pTriangle = &g_pTriangles[nTriangle];
+
+            int nBottom = (pTriangle->nMinY > nTileBottom) ? pTriangle->nMinY : nTileBottom;
+            int nTop    = (pTriangle->nMaxY < nTileTop) ? pTriangle->nMaxY : nTileTop;
+
+            if (nBottom < nTop)
+            {
+                RasterizeRows(pTriangle, nBottom, nTop, pSpan);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::Present():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies the framebuffer to the OpenGL back buffer, so the frame can be shown in a
+//          window (GS_OGLDisplay::EndRender() calls this before swapping the buffers).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_SoftRenderer::Present()
+{
+
+    if ((!m_bIsActive) || (!m_pFrame))
+    {
+        return;
+    }
+
+    // Save the state changed here, so the state shadowed by GS_OGLState stays valid.
+    glPushAttrib(GL_ENABLE_BIT | GL_TRANSFORM_BIT);
+
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // The bottom left corner of the window.
+    glRasterPos2f(-1.0f, -1.0f);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glDrawPixels(m_nFrameWidth, m_nFrameHeight, GL_RGBA, GL_UNSIGNED_BYTE, m_pFrame);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+
+    glPopAttrib();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::PresentToMemory():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Copies the framebuffer to a buffer of GetWidth() * GetHeight() * 4 bytes (RGBA,
+//          the bottom row first) instead of the back buffer, without any OpenGL calls.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::PresentToMemory(BYTE* pBuffer)
+{
+
+    if ((!m_bIsActive) || (!m_pFrame) || (!pBuffer))
+    {
+        return FALSE;
+    }
+
+    memcpy(pBuffer, m_pFrame, m_nFrameWidth * m_nFrameHeight * 4);
+
+    return TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::PresentToFile():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Writes the framebuffer to an uncompressed 32-bit TGA file instead of the back
+//          buffer, without any OpenGL calls.
+// ---------------------------------------------------------------------------------------------
+// Returns: TRUE if successfull, FALSE if not.
+//==============================================================================================
+
+BOOL GS_SoftRenderer::PresentToFile(LPCTSTR pszFilename)
+{
+
+    if ((!m_bIsActive) || (!m_pFrame) || (!pszFilename))
+    {
+        return FALSE;
+    }
+
+    FILE* pFile = fopen(pszFilename, "wb");
+
+    if (!pFile)
+    {
+        GS_Error::Report("GS_SOFT_RENDERER.CPP", 1501, "Failed to create frame file!");
+        return FALSE;
+    }
+
+    // An uncompressed true-color header with the origin in the lower left, the order the rows
+    // of the framebuffer are in.
+    BYTE byHeader[18] = { 0 };
+    byHeader[2]  = 2;
+    byHeader[12] = (BYTE) (m_nFrameWidth & 0xFF);
+    byHeader[13] = (BYTE) ((m_nFrameWidth >> 8) & 0xFF);
+    byHeader[14] = (BYTE) (m_nFrameHeight & 0xFF);
+    byHeader[15] = (BYTE) ((m_nFrameHeight >> 8) & 0xFF);
+    byHeader[16] = 32;
+    byHeader[17] = 8;
+
+    BOOL bResult = (fwrite(byHeader, sizeof(BYTE), 18, pFile) == 18);
+
+    // TGA files store the pixels as BGRA.
+    int   nRowSize = m_nFrameWidth * 4;
+    BYTE* pRow     = new BYTE[nRowSize];
+
+    for (int nRow = 0; (nRow < m_nFrameHeight) && bResult; nRow++)
+    {
+        const BYTE* pSource = m_pFrame + (nRow * nRowSize);
+
+        for (int nByte = 0; nByte < nRowSize; nByte += 4)
+        {
+            pRow[nByte]     = pSource[nByte + 2];
+            pRow[nByte + 1] = pSource[nByte + 1];
+            pRow[nByte + 2] = pSource[nByte];
+            pRow[nByte + 3] = pSource[nByte + 3];
+        }
+
+        bResult = (fwrite(pRow, sizeof(BYTE), nRowSize, pFile) == (size_t) nRowSize);
+    }
+
+    delete[] pRow;
+
+    fclose(pFile);
+
+    return bResult;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Access Methods. /////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_SoftRenderer::GetPixels():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Retrieves the framebuffer, RGBA with the bottom row first (like glReadPixels()).
+// ---------------------------------------------------------------------------------------------
+// Returns: The pixels of the framebuffer, NULL if there is none.
+//==============================================================================================
+
+const BYTE* GS_SoftRenderer::GetPixels()
+{
+
+    return m_pFrame;
+}
+
+
+//==============================================================================================
+// GS_SoftRenderer::GetWidth():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The width of the framebuffer in pixels.
+//==============================================================================================
+
+int GS_SoftRenderer::GetWidth()
+{
+
+    return m_nFrameWidth;
+}
+
+
+//==============================================================================================
+// GS_SoftRenderer::GetHeight():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The height of the framebuffer in pixels.
+//==============================================================================================
+
+int GS_SoftRenderer::GetHeight()
+{
+
+    return m_nFrameHeight;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
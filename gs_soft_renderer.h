@@ -0,0 +1,141 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: gs_soft_renderer.cpp, gs_soft_renderer.h                                            |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: GS_SoftRenderer                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Rasterizes the quads of the GS library on the CPU into a framebuffer in memory, for |
+ |        thumbnails and determinism checks that must not depend on the graphics driver. The |
+ |        screen is split into tiles that are rasterized by several threads and the spans    |
+ |        are blended with SSE2 where it is available. GS_OGLCoreRenderer hands it the quads |
+ |        when the display uses GS_BACKEND_SOFTWARE.                                          |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef GS_SOFT_RENDERER_H
+#define GS_SOFT_RENDERER_H
+
+
+//==============================================================================================
+// Include platform abstraction header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Include OpenGL header files.
+// ---------------------------------------------------------------------------------------------
+#ifdef __APPLE__
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glu.h>
+#else
+    #include <GL/gl.h>
+    #include <GL/glu.h>
+#endif
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_error.h"
+#include "gs_ogl_state.h"
+#include "gs_ogl_sprite_batch.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Software renderer defines.
+// ---------------------------------------------------------------------------------------------
+#define GS_SOFT_MAX_THREADS   8     // Most threads the tiles are rasterized with.
+#define GS_SOFT_TILE_HEIGHT   32    // Height in pixels of the tiles handed to the threads.
+#define GS_SOFT_MIN_PARALLEL  16384 // Fewest pixels a draw must cover to be worth the threads.
+#define GS_SOFT_MAX_TARGETS   4     // Most render targets that can be drawn to inside each other.
+//==============================================================================================
+
+
+//==============================================================================================
+// Software texture structure (a copy of the pixels given to OpenGL, or a render target).
+// ---------------------------------------------------------------------------------------------
+typedef struct GS_SOFT_TEXTURE
+{
+    BYTE* pPixels;     // RGBA pixels, the bottom row first like OpenGL stores them.
+    int   nWidth;      // Dimensions in pixels.
+    int   nHeight;
+    BOOL  bMinLinear;  // Wether the texture is filtered when minified or magnified.
+    BOOL  bMagLinear;
+    BOOL  bRepeatS;    // Wether the texture repeats horizontally and vertically.
+    BOOL  bRepeatT;
+} GS_SoftTexture;
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_SoftRenderer
+{
+
+private:
+
+    static BOOL m_bIsActive; // Wether the renderer has been created.
+
+    static BYTE* m_pFrame;       // The framebuffer (RGBA, bottom row first).
+    static int   m_nFrameWidth;  // Dimensions of the framebuffer.
+    static int   m_nFrameHeight;
+
+    static GS_SoftTexture* m_pSurface; // The render target being drawn to, NULL for the frame.
+    static GLuint m_gluTargets[GS_SOFT_MAX_TARGETS]; // Targets drawn to before the current one.
+    static int    m_nNumTargets;                     // Number of targets in the above.
+
+    static int   m_nNumThreads;       // Number of threads the tiles are rasterized with.
+    static BYTE* m_pSpans[GS_SOFT_MAX_THREADS]; // A span of source pixels for each thread.
+    static int   m_nSpanSize;         // Size of each span in pixels.
+
+    static BOOL MakeSpans(int nWidth);
+    static GS_SoftTexture* FindTexture(GLuint gluTexture);
+    static void RasterizeTiles(int nFirstTile, int nTileStep, BYTE* pSpan);
+    static void Work(int nThread);
+
+protected:
+
+    // No protected members.
+
+public:
+
+    static BOOL Create(int nWidth, int nHeight, int nNumThreads = 0);
+    static void Destroy();
+    static BOOL Resize(int nWidth, int nHeight);
+
+    static BOOL IsActive();
+
+    static void Clear(GLfloat glfRed, GLfloat glfGreen, GLfloat glfBlue, GLfloat glfAlpha);
+    static void DrawQuads(GLuint gluTexture, const GS_BatchVertex* pVertices, int nNumVertices,
+                          const GLfloat* pProjection);
+
+    static BOOL BeginTarget(GLuint gluTexture, int nWidth, int nHeight, BOOL bLinear = FALSE);
+    static void EndTarget();
+
+    static void StoreTexture(GLuint gluTexture, const BYTE* pData, int nWidth, int nHeight,
+                             int nBpp, GLint glMinFilter, GLint glMagFilter);
+    static void ReleaseTexture(GLuint gluTexture);
+
+    static void Present();
+    static BOOL PresentToMemory(BYTE* pBuffer);
+    static BOOL PresentToFile(LPCTSTR pszFilename);
+
+    static const BYTE* GetPixels();
+    static int GetWidth();
+    static int GetHeight();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -3,7 +3,7 @@
  |--------------------------------------------------------------------------------------------|
  | FILES: gs_timer.cpp, gs_timer.h                                                            |
  |--------------------------------------------------------------------------------------------|
- | CLASS: GS_Timer, GS_FrameTimer                                                             |
+ | CLASS: GS_Timer, GS_FrameTimer, GS_FrameLimiter                                            |
  |--------------------------------------------------------------------------------------------|
  | ABOUT: ...                                                                                 |
  |--------------------------------------------------------------------------------------------|
@@ -18,6 +18,13 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <math.h>
+//==============================================================================================
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor Methods //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +58,9 @@ GS_Timer::GS_Timer()
         m_dwStartTime = timeGetTime();
     }
 #else
-    m_lStartTime = GS_Platform::GetTickCount();
+    // SDL_GetTicks() only counts whole milliseconds, use the performance counter instead.
+    m_n64PerfFreq   = SDL_GetPerformanceFrequency();
+    m_n64StartCount = SDL_GetPerformanceCounter();
 #endif
 }
 
@@ -104,7 +113,7 @@ void GS_Timer::Reset()
         m_dwStartTime = timeGetTime();
     }
 #else
-    m_lStartTime = GS_Platform::GetTickCount();
+    m_n64StartCount = SDL_GetPerformanceCounter();
 #endif
 }
 
@@ -146,8 +155,8 @@ float GS_Timer::GetTime()
         return (float(timeGetTime() - m_dwStartTime));
     }
 #else
-    unsigned long lCurrentTime = GS_Platform::GetTickCount();
-    return (float)(lCurrentTime - m_lStartTime);
+    Uint64 n64CurrentCount = SDL_GetPerformanceCounter() - m_n64StartCount;
+    return (float) ((double(n64CurrentCount) / double(m_n64PerfFreq)) * 1000.0);
 #endif
 }
 
@@ -158,20 +167,102 @@ float GS_Timer::GetTime()
 //==============================================================================================
 // GS_Timer::Wait():
 // ---------------------------------------------------------------------------------------------
-// Purpose: ...                                                                                 |
+// Purpose: Waits for the specified number of milliseconds. Most of the time is slept away, only
+//          the last couple of milliseconds (which the system may oversleep) are spun.
 // ---------------------------------------------------------------------------------------------
 // Returns: Nothing.
 //==============================================================================================
 
 void GS_Timer::Wait(float fWaitTime)
 {
-    // Add the time to wait to the current time.
-    fWaitTime += (this->GetTime());
+    // Determine when to stop waiting.
+    long long nDeadline = GetNanoseconds() + (long long) (fWaitTime * 1000000.0f);
+
+    // Sleep until shortly before the deadline.
+    long long nRemaining = nDeadline - GetNanoseconds();
+
+    if (nRemaining > GS_LIMITER_START_SPIN)
+    {
+        SleepFor(nRemaining - GS_LIMITER_START_SPIN);
+    }
+
+    // Loop until the current time is equal to or larger than the deadline.
+    while (GetNanoseconds() < nDeadline)
+    {
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::GetNanoseconds():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reads a monotonic clock with (up to) nanosecond resolution, it never goes back when
+//          the system time is changed.
+// ---------------------------------------------------------------------------------------------
+// Returns: The time in nanoseconds since an arbitrary starting point.
+//==============================================================================================
+
+long long GS_Timer::GetNanoseconds()
+{
+#ifdef GS_PLATFORM_WINDOWS
+    __int64 n64PerfFreq, n64Count;
+
+    // Fall back to the multi-media timer without a performance counter.
+    if ((!QueryPerformanceFrequency((LARGE_INTEGER*) &n64PerfFreq)) || (n64PerfFreq <= 0))
+    {
+        return (long long) timeGetTime() * 1000000;
+    }
+
+    QueryPerformanceCounter((LARGE_INTEGER*) &n64Count);
+#else
+    Uint64 n64PerfFreq = SDL_GetPerformanceFrequency();
+    Uint64 n64Count    = SDL_GetPerformanceCounter();
+#endif
+
+    // Convert whole seconds and the remainder separately so the counts can't overflow.
+    return ((long long) (n64Count / n64PerfFreq) * 1000000000) +
+           (((long long) (n64Count % n64PerfFreq) * 1000000000) / (long long) n64PerfFreq);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_Timer::SleepFor():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Gives up the processor for (at least) the specified number of nanoseconds. How
+//          precise it is depends on the system, Windows rounds up to whole milliseconds and
+//          only manages that while the timer resolution is raised, so it is raised for as
+//          long as the sleep lasts.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_Timer::SleepFor(long long nNanoseconds)
+{
+
+    if (nNanoseconds <= 0)
+    {
+        return;
+    }
 
-    // Loop until the current time is equal to or larger than the wait time.
-    while (this->GetTime() < fWaitTime)
+#ifdef GS_PLATFORM_WINDOWS
+    // Without raising it the timer only ticks every 15.6 ms or so.
+    BOOL bIsPeriodSet = (timeBeginPeriod(1) == TIMERR_NOERROR);
+
+    ::Sleep((DWORD) (nNanoseconds / 1000000));
+
+    if (bIsPeriodSet)
     {
+        timeEndPeriod(1);
     }
+#else
+    std::this_thread::sleep_for(std::chrono::nanoseconds(nNanoseconds));
+#endif
 }
 
 
@@ -296,4 +387,263 @@ void GS_FrameTimer::MarkFrame()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::GS_FrameLimiter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FrameLimiter::GS_FrameLimiter()
+{
+    m_nPeriod    = 0;
+    m_nDeadline  = 0;
+    m_nSpinTime  = GS_LIMITER_START_SPIN;
+    m_bIsStarted = FALSE;
+
+    this->ResetStats();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::~GS_FrameLimiter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The destructor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+GS_FrameLimiter::~GS_FrameLimiter()
+{
+    // Does nothing.
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame Limiter Methods ///////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::SetFrameRate():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Sets the frame rate Wait() holds the frames to, 0 to not limit it.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameLimiter::SetFrameRate(float fFrameRate)
+{
+
+    long long nPeriod = 0;
+
+    if (fFrameRate > 0.0f)
+    {
+        nPeriod = (long long) (1000000000.0 / fFrameRate);
+    }
+
+    if (nPeriod != m_nPeriod)
+    {
+        m_nPeriod = nPeriod;
+        this->Reset();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::Reset():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Forgets the deadline, so the next frame is timed from when Wait() is called next
+//          (after a pause, for example, there's no time to catch up on).
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameLimiter::Reset()
+{
+    m_bIsStarted = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::Wait():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Waits until the next frame is due. The deadlines are absolute (each one period after
+//          the last), so rounding errors and late wake ups don't add up over time. The thread
+//          sleeps until the spin time before the deadline and then spins, the spin time grows
+//          right away when a sleep overshoots and shrinks slowly when they are on time.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameLimiter::Wait()
+{
+
+    long long nNow = GS_Timer::GetNanoseconds();
+
+    // Without a limit or a previous frame there is nothing to wait for.
+    if ((m_nPeriod <= 0) || (!m_bIsStarted))
+    {
+        m_nDeadline  = nNow + m_nPeriod;
+        m_bIsStarted = TRUE;
+        return;
+    }
+
+    long long nRemaining = m_nDeadline - nNow;
+
+    // Sleep away everything but the spin time.
+    if (nRemaining > m_nSpinTime)
+    {
+        long long nSleepTime = nRemaining - m_nSpinTime;
+
+        GS_Timer::SleepFor(nSleepTime);
+
+        nNow = GS_Timer::GetNanoseconds();
+
+        // How much later than asked for the thread woke up.
+        long long nOvershoot = (nNow - (m_nDeadline - nRemaining)) - nSleepTime;
+
+        if (nOvershoot > m_nSpinTime)
+        {
+            m_nSpinTime = nOvershoot;
+        }
+        else
+        {
+            m_nSpinTime -= (m_nSpinTime - nOvershoot) / 16;
+        }
+
+        if (m_nSpinTime < GS_LIMITER_MIN_SPIN)
+        {
+            m_nSpinTime = GS_LIMITER_MIN_SPIN;
+        }
+        else if (m_nSpinTime > GS_LIMITER_MAX_SPIN)
+        {
+            m_nSpinTime = GS_LIMITER_MAX_SPIN;
+        }
+    }
+
+    // Spin for the rest.
+    while (nNow < m_nDeadline)
+    {
+        nNow = GS_Timer::GetNanoseconds();
+    }
+
+    // Record how late the frame starts.
+    float fJitter = (float) ((double) (nNow - m_nDeadline) / 1000000.0);
+
+    m_nNumFrames++;
+    m_dJitterTotal   += fJitter;
+    m_dJitterSquares += (double) fJitter * fJitter;
+
+    if (fJitter > m_fMaxJitter)
+    {
+        m_fMaxJitter = fJitter;
+    }
+
+    // Schedule the next frame, if this one is more than a period late (the frame took too long)
+    // start over from now instead of rushing frames out to catch up.
+    m_nDeadline += m_nPeriod;
+
+    if (m_nDeadline <= nNow)
+    {
+        m_nDeadline = nNow + m_nPeriod;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::ResetStats():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Starts gathering the jitter statistics all over again.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void GS_FrameLimiter::ResetStats()
+{
+    m_nNumFrames     = 0;
+    m_dJitterTotal   = 0.0;
+    m_dJitterSquares = 0.0;
+    m_fMaxJitter     = 0.0f;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::GetMeanJitter():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: How late the frames started on average in milliseconds.
+//==============================================================================================
+
+float GS_FrameLimiter::GetMeanJitter()
+{
+
+    if (m_nNumFrames <= 0)
+    {
+        return 0.0f;
+    }
+
+    return (float) (m_dJitterTotal / m_nNumFrames);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// GS_FrameLimiter::GetJitterDeviation():
+// ---------------------------------------------------------------------------------------------
+// Purpose: ...
+// ---------------------------------------------------------------------------------------------
+// Returns: The standard deviation of how late the frames started in milliseconds.
+//==============================================================================================
+
+float GS_FrameLimiter::GetJitterDeviation()
+{
+
+    if (m_nNumFrames <= 0)
+    {
+        return 0.0f;
+    }
+
+    double dMean     = m_dJitterTotal / m_nNumFrames;
+    double dVariance = (m_dJitterSquares / m_nNumFrames) - (dMean * dMean);
+
+    return (dVariance > 0.0) ? (float) sqrt(dVariance) : 0.0f;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
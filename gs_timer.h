@@ -3,7 +3,7 @@
  |--------------------------------------------------------------------------------------------|
  | FILES: gs_timer.cpp, gs_timer.h                                                            |
  |--------------------------------------------------------------------------------------------|
- | CLASS: GS_Timer, GS_FrameTimer                                                             |
+ | CLASS: GS_Timer, GS_FrameTimer, GS_FrameLimiter                                            |
  |--------------------------------------------------------------------------------------------|
  | ABOUT: ...                                                                                 |
  |--------------------------------------------------------------------------------------------|
@@ -32,6 +32,13 @@
 // ---------------------------------------------------------------------------------------------
 #include <mmsystem.h>
 //==============================================================================================
+#else
+//==============================================================================================
+// Include standard C++ library header files (SDL only).
+// ---------------------------------------------------------------------------------------------
+#include <chrono>
+#include <thread>
+//==============================================================================================
 #endif
 
 //==============================================================================================
@@ -57,7 +64,8 @@ private:
     __int64 m_n64StartCount; // The initial number of counts of the performance counter.
     DWORD   m_dwStartTime;   // The initial start time of the multi-media counter.
 #else
-    unsigned long m_lStartTime; // Start time in milliseconds (SDL)
+    Uint64 m_n64PerfFreq;   // The frequency (counts per second) of the performance counter (SDL).
+    Uint64 m_n64StartCount; // The initial number of counts of the performance counter (SDL).
 #endif
 
 protected:
@@ -72,6 +80,9 @@ public:
     void  Reset();
     float GetTime();
     void  Wait(float fWaitTime);
+
+    static long long GetNanoseconds();
+    static void      SleepFor(long long nNanoseconds);
 };
 
 
@@ -118,6 +129,68 @@ public:
     };
 };
 
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// The frame limiter sleeps until shortly before each frame is due and spins for the rest. The
+// spin time adapts to how late the system wakes the thread up, within the limits below (in
+// nanoseconds).
+// ---------------------------------------------------------------------------------------------
+#define GS_LIMITER_MIN_SPIN    200000 // Shortest time spent spinning before a frame.
+#define GS_LIMITER_MAX_SPIN   4000000 // Longest time spent spinning before a frame.
+#define GS_LIMITER_START_SPIN 2000000 // Spin time until the first sleeps have been measured.
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class GS_FrameLimiter : public GS_Object
+{
+
+private:
+
+    long long m_nPeriod;    // Time between frames in nanoseconds, 0 if not limited.
+    long long m_nDeadline;  // The time the next frame is due.
+    long long m_nSpinTime;  // Time spent spinning instead of sleeping before a frame.
+    BOOL      m_bIsStarted; // Whether a deadline has been set.
+
+    int       m_nNumFrames;     // Number of frames the statistics were gathered over.
+    double    m_dJitterTotal;   // Sum of how late those frames started in milliseconds.
+    double    m_dJitterSquares; // Sum of the squares of the same.
+    float     m_fMaxJitter;     // Latest any of those frames started in milliseconds.
+
+protected:
+
+    // No protected members.
+
+public:
+
+    GS_FrameLimiter();
+    ~GS_FrameLimiter();
+
+    void SetFrameRate(float fFrameRate);
+    void Reset();
+    void Wait();
+
+    void  ResetStats();
+    int   GetNumFrames()
+    {
+        return m_nNumFrames;
+    };
+    float GetMeanJitter();
+    float GetMaxJitter()
+    {
+        return m_fMaxJitter;
+    };
+    float GetJitterDeviation();
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 #endif
@@ -38,6 +38,10 @@ Level::Level()
     m_snakeStartPosX = 0;
     m_snakeStartPosY = 0;
 
+    m_snakeInterval = DEFAULT_SNAKE_INTERVAL;
+    m_ratInterval = DEFAULT_RAT_INTERVAL;
+    m_ratCount = DEFAULT_RAT_COUNT;
+
     m_currentLevel = 0;
 
     m_state = 0;
@@ -79,7 +83,10 @@ bool Level::Create(RECT areaRect, bool filtered, GS_OGLColor levelColor)
     }
 
     bResult = m_levelMap.Create("data/level.tga", 512, 32, LEVEL_TILE_WIDTH, LEVEL_TILE_HEIGHT, filtered);
-    m_levelMap.LoadMap("data/level_01.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
+
+    // Read all the levels once, so that loading a level later on does no I/O
+    bResult = bResult && this->LoadPack();
+
     m_levelMap.SetClipBox(areaRect);
     m_levelMap.SetMapX(0);
     m_levelMap.SetMapY(0);
@@ -90,7 +97,8 @@ bool Level::Create(RECT areaRect, bool filtered, GS_OGLColor levelColor)
     m_levelMap.SetClearTileID(CLEAR_TILE_ID);
     m_levelMap.SetModulateColor(levelColor);
 
-    m_currentLevel = 1;
+    // Start at the first level
+    bResult = bResult && this->Load(MIN_LEVEL);
 
     // Were we not successful?
     if (FALSE == bResult) {
@@ -123,6 +131,10 @@ void Level::Destroy()
     m_snakeStartPosX = 0;
     m_snakeStartPosY = 0;
 
+    m_snakeInterval = DEFAULT_SNAKE_INTERVAL;
+    m_ratInterval = DEFAULT_RAT_INTERVAL;
+    m_ratCount = DEFAULT_RAT_COUNT;
+
     m_currentLevel = 0;
 
     m_state = 0;
@@ -130,6 +142,7 @@ void Level::Destroy()
     m_gsTimer.Reset();
 
     m_levelMap.Destroy();
+    m_levelPack.Destroy();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -174,22 +187,58 @@ void Level::SetState( int stateNum )
 //==============================================================================================
 
 bool Level::CheckCollision( RECT rcRect ) {
-    // Is the rectangle not on the clear tile?
-    if( !m_levelMap.IsOnTile(rcRect, CLEAR_TILE_ID) ) {
+    // Is the rectangle on a solid tile (anything but the clear tile)?
+    if( m_levelMap.IsSolid(rcRect) ) {
         return true;
     }
 
     return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Level::LoadPack():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Function to read all the levels into memory, from the level pack or, if there is
+//          none, from the separate level files
+// ---------------------------------------------------------------------------------------------
+// Returns: true if successful, false if not
+//==============================================================================================
+
+bool Level::LoadPack()
+{
+    // Is there a level pack?
+    if( m_levelPack.Load(LEVEL_PACK) ) {
+        return true;
+    }
+
+    // Read the separate level files instead, with the default settings
+    for( int i = MIN_LEVEL; i <= MAX_LEVEL; i++ ) {
+        char szPathname[_MAX_PATH];
+        snprintf(szPathname, _MAX_PATH, "data/level_%02d.gsm", i);
+
+        GS_MapFile gsMapFile;
+
+        if( !gsMapFile.Load(szPathname) || !m_levelPack.AddMap(&gsMapFile) ) {
+            GS_Error::Report("LEVEL.CPP", 230, "Failed to load levels!");
+            m_levelPack.Destroy();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 //==============================================================================================
 // Level::Load():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Function to load a new level
+// Purpose: Function to switch to a new level, read from memory (see LoadPack())
 // ---------------------------------------------------------------------------------------------
-// Returns: Nothing
+// Returns: true if successful, false if not
 //==============================================================================================
 
 bool Level::Load( int nLevelNum )
@@ -197,63 +246,39 @@ bool Level::Load( int nLevelNum )
     bool bResult;
 
     // Is the level out of bounds?
-    if( (nLevelNum < MIN_LEVEL) || (nLevelNum > MAX_LEVEL) ) {
-        return FALSE;
+    if( (nLevelNum < MIN_LEVEL) || (nLevelNum >= MIN_LEVEL + this->GetNumLevels()) ) {
+        return false;
+    }
+
+    int index = nLevelNum - MIN_LEVEL;
+    GS_MapFile* pgsMapFile = m_levelPack.GetMap(index);
+
+    bResult = (TRUE == m_levelMap.LoadMap(pgsMapFile));
+
+    // Start at the default position if the map does not say where.
+    if( pgsMapFile->GetStartCol() < 0 || pgsMapFile->GetStartRow() < 0 ) {
+        m_snakeStartPosX = DEFAULT_START_COL * LEVEL_TILE_WIDTH;
+        m_snakeStartPosY = DEFAULT_START_ROW * LEVEL_TILE_HEIGHT;
+    } else {
+        m_snakeStartPosX = pgsMapFile->GetStartCol() * LEVEL_TILE_WIDTH;
+        m_snakeStartPosY = pgsMapFile->GetStartRow() * LEVEL_TILE_HEIGHT;
+    }
+
+    // Use the default settings for any the pack does not specify
+    m_snakeInterval = m_levelPack.GetProperty(index, LEVEL_PROPERTY_SNAKE_INTERVAL);
+    m_ratInterval = m_levelPack.GetProperty(index, LEVEL_PROPERTY_RAT_INTERVAL);
+    m_ratCount = m_levelPack.GetProperty(index, LEVEL_PROPERTY_RAT_COUNT);
+
+    if( m_snakeInterval <= 0 ) {
+        m_snakeInterval = DEFAULT_SNAKE_INTERVAL;
+    }
+
+    if( m_ratInterval <= 0 ) {
+        m_ratInterval = DEFAULT_RAT_INTERVAL;
     }
 
-    switch (nLevelNum) {
-        case 1:
-            bResult = m_levelMap.LoadMap("data/level_01.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 2:
-            bResult = m_levelMap.LoadMap("data/level_02.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 16 * LEVEL_TILE_HEIGHT;
-            break;
-        case 3:
-            bResult = m_levelMap.LoadMap("data/level_03.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 4:
-            bResult = m_levelMap.LoadMap("data/level_04.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 14 * LEVEL_TILE_HEIGHT;
-            break;
-        case 5:
-            bResult = m_levelMap.LoadMap("data/level_05.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 6:
-            bResult = m_levelMap.LoadMap("data/level_06.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 7:
-            bResult = m_levelMap.LoadMap("data/level_07.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 8:
-            bResult = m_levelMap.LoadMap("data/level_08.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 9:
-            bResult = m_levelMap.LoadMap("data/level_09.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        case 10:
-            bResult = m_levelMap.LoadMap("data/level_10.map", LEVEL_MAP_ROWS, LEVEL_MAP_COLS);
-            m_snakeStartPosX = 1 * LEVEL_TILE_WIDTH;
-            m_snakeStartPosY = 15 * LEVEL_TILE_HEIGHT;
-            break;
-        default:
-            return FALSE;
+    if( m_ratCount <= 0 ) {
+        m_ratCount = DEFAULT_RAT_COUNT;
     }
 
     // Were we not successful?
@@ -19,6 +19,7 @@
 // Include Game System (GS) header files.
 // -----------------------------------------------------------------------------------------------
 #include "gs_ogl_collide.h"
+#include "gs_map_pack.h"
 #include "gs_ogl_map.h"
 #include "gs_ogl_particle.h"
 #include "gs_ogl_sprite_ex.h"
@@ -44,7 +45,20 @@
 #define LEVEL_MAP_ROWS 30
 // ---------------------------------------------------------------------------------------------
 #define MIN_LEVEL 1
-#define MAX_LEVEL 10
+#define MAX_LEVEL 10 // Number of level files loaded if there is no level pack
+// ---------------------------------------------------------------------------------------------
+#define LEVEL_PACK "data/levels.gsp" // All levels, loaded once when the level is created
+// ---------------------------------------------------------------------------------------------
+#define LEVEL_PROPERTY_SNAKE_INTERVAL 0 // Level pack properties (see GS_MapPack)
+#define LEVEL_PROPERTY_RAT_INTERVAL   1
+#define LEVEL_PROPERTY_RAT_COUNT      2
+// ---------------------------------------------------------------------------------------------
+#define DEFAULT_SNAKE_INTERVAL 100 // Used when the level pack does not specify them
+#define DEFAULT_RAT_INTERVAL   500
+#define DEFAULT_RAT_COUNT      10
+// ---------------------------------------------------------------------------------------------
+#define DEFAULT_START_COL 1  // Tile the snake starts on if the level file does not say
+#define DEFAULT_START_ROW 15
 // ---------------------------------------------------------------------------------------------
 #define CLEAR_TILE_ID 0
 // ---------------------------------------------------------------------------------------------
@@ -66,6 +80,7 @@ class Level
 
 private:
     GS_OGLMap m_levelMap;           // The layout for the level
+    GS_MapPack m_levelPack;         // The layouts and settings of all the levels
 
     GS_OGLSpriteEx m_levelSprite;   // The sprite object used to draw the level
 
@@ -82,6 +97,10 @@ private:
     int m_snakeStartPosX; // The X coordinate in pixels where the snake should start
     int m_snakeStartPosY; // The Y coordinate in pixels where the snake should start
 
+    int m_snakeInterval; // The movement interval the snake starts the level with
+    int m_ratInterval;   // The movement interval the rat starts the level with
+    int m_ratCount;      // The number of rats to eat to finish the level
+
     int m_state;  // The state of the level (see defines above for available states)
 
     int m_currentLevel; // The currently loaded level
@@ -125,8 +144,33 @@ public:
         return m_snakeStartPosY;
     }
 
+    // Get the movement interval the snake starts the level with
+    inline int GetSnakeInterval()
+    {
+        return m_snakeInterval;
+    }
+
+    // Get the movement interval the rat starts the level with
+    inline int GetRatInterval()
+    {
+        return m_ratInterval;
+    }
+
+    // Get the number of rats to eat to finish the level
+    inline int GetRatCount()
+    {
+        return m_ratCount;
+    }
+
+    // Get the number of levels that can be loaded
+    inline int GetNumLevels()
+    {
+        return m_levelPack.GetNumMaps();
+    }
+
     bool CheckCollision( RECT rcRect );
 
+    bool LoadPack();
     bool Load( int nLevelNum );
 
     // Update the level (position, animation, etc,.)
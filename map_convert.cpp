@@ -0,0 +1,210 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: map_convert.cpp                                                                     |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: None                                                                                |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Command line tool converting text map files to binary map files (see GS_MapFile)    |
+ |        and back, e.g. to turn data/level_01.map into data/level_01.gsm:                    |
+ |                                                                                            |
+ |        MapConvert data/level_01.map data/level_01.gsm 30 60 1 15 16 16                     |
+ |                                                                                            |
+ |        It also builds map packs (see GS_MapPack) from a list of binary maps:               |
+ |                                                                                            |
+ |        MapConvert -pack data/levels.gsp data/levels.txt                                    |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// The tool has its own main(), keep SDL from replacing it.
+// ---------------------------------------------------------------------------------------------
+#define SDL_MAIN_HANDLED
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_map_file.h"
+#include "gs_map_pack.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// HasExtension():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check wether the filename ends with the specified extension.
+// ---------------------------------------------------------------------------------------------
+// Returns: true if it does, false if not.
+//==============================================================================================
+
+static bool HasExtension(const char* pszFilename, const char* pszExtension)
+{
+
+    size_t nNameLength      = strlen(pszFilename);
+    size_t nExtensionLength = strlen(pszExtension);
+
+    return (nNameLength >= nExtensionLength) &&
+           (strcmp(pszFilename + nNameLength - nExtensionLength, pszExtension) == 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// BuildPack():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Builds a map pack from a text file listing a binary map per line, each followed by
+//          up to GS_MAP_PACK_PROPERTIES numbers stored as its properties. Empty lines and lines
+//          starting with '#' are skipped.
+// ---------------------------------------------------------------------------------------------
+// Returns: 0 if successful, 1 if not.
+//==============================================================================================
+
+static int BuildPack(const char* pszPackname, const char* pszListname)
+{
+
+    FILE* pListFile = fopen(pszListname, "r");
+
+    if (NULL == pListFile)
+    {
+        printf("Failed to open %s!\n", pszListname);
+        return 1;
+    }
+
+    GS_MapPack gsMapPack;
+    char       szLine[_MAX_PATH + 64];
+
+    while (fgets(szLine, sizeof(szLine), pListFile))
+    {
+        char szMapname[_MAX_PATH];
+        int  nProperties[GS_MAP_PACK_PROPERTIES] = { 0 };
+
+        if ((szLine[0] == '#') ||
+            (sscanf(szLine, "%s %d %d %d %d", szMapname, &nProperties[0], &nProperties[1],
+                    &nProperties[2], &nProperties[3]) < 1))
+        {
+            continue;
+        }
+
+        GS_MapFile gsMapFile;
+
+        if ((!gsMapFile.Load(szMapname)) || (!gsMapPack.AddMap(&gsMapFile, nProperties)))
+        {
+            printf("Failed to add %s!\n", szMapname);
+            fclose(pListFile);
+            return 1;
+        }
+
+        printf("%s (%d %d %d %d)\n", szMapname, nProperties[0], nProperties[1], nProperties[2],
+               nProperties[3]);
+    }
+
+    fclose(pListFile);
+
+    if (!gsMapPack.Save(pszPackname))
+    {
+        printf("Failed to save %s!\n", pszPackname);
+        return 1;
+    }
+
+    printf("%s -> %s (%d maps)\n", pszListname, pszPackname, gsMapPack.GetNumMaps());
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// main():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Loads the input map and writes it as a text map if the output name ends in ".map",
+//          or as a binary map otherwise. The number of rows and columns are needed for text
+//          input, the start position and tile size are stored in binary output.
+// ---------------------------------------------------------------------------------------------
+// Returns: 0 if successful, 1 if not.
+//==============================================================================================
+
+int main(int argc, char* argv[])
+{
+
+    if (argc < 3)
+    {
+        printf("Usage: MapConvert <input> <output> [rows cols [start_col start_row "
+               "[tile_width tile_height]]]\n");
+        printf("       MapConvert -pack <output> <list>\n");
+        return 1;
+    }
+
+    if (strcmp(argv[1], "-pack") == 0)
+    {
+        if (argc < 4)
+        {
+            printf("Usage: MapConvert -pack <output> <list>\n");
+            return 1;
+        }
+
+        return BuildPack(argv[2], argv[3]);
+    }
+
+    int nNumRows = (argc > 4) ? atoi(argv[3]) : 0;
+    int nNumCols = (argc > 4) ? atoi(argv[4]) : 0;
+
+    GS_MapFile gsMapFile;
+
+    if (!gsMapFile.Load(argv[1], nNumRows, nNumCols))
+    {
+        printf("Failed to load %s!\n", argv[1]);
+        return 1;
+    }
+
+    if (argc > 6)
+    {
+        gsMapFile.SetStart(atoi(argv[5]), atoi(argv[6]));
+    }
+
+    if (argc > 8)
+    {
+        gsMapFile.SetTileSize(atoi(argv[7]), atoi(argv[8]));
+    }
+
+    BOOL bResult;
+
+    if (HasExtension(argv[2], ".map"))
+    {
+        bResult = gsMapFile.SaveText(argv[2]);
+    }
+    else
+    {
+        bResult = gsMapFile.Save(argv[2]);
+    }
+
+    if (!bResult)
+    {
+        printf("Failed to save %s!\n", argv[2]);
+        return 1;
+    }
+
+    printf("%s -> %s (%d x %d)\n", argv[1], argv[2], gsMapFile.GetNumCols(),
+           gsMapFile.GetNumRows());
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
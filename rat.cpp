@@ -475,9 +475,17 @@ bool Rat::Render(float fAlpha)
     color.fGreen = color.fGreen - (color.fGreen / m_length);
     color.fBlue = color.fBlue - (color.fBlue / m_length);
 
-    // Render the particle effect over the rat
+    // Render the particle effect over the rat, one layer up so it stays on top when the render
+    // queue sorts the current layer
+    int layer = GS_OGLRenderQueue::GetLayer();
+    BOOL sorted = GS_OGLRenderQueue::IsLayerSorted();
+    GS_OGLRenderQueue::SetLayer(layer + 1, sorted);
+
     m_ratParticle.Render();
 
+    // Go back to the layer of the rat
+    GS_OGLRenderQueue::SetLayer(layer, sorted);
+
     // Reset the rat to the head coordinates
     // m_ratSprite.SetDestXY( m_posX, m_posY );
 
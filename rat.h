@@ -22,6 +22,7 @@
 #include "gs_ogl_texture.h"
 #include "gs_ogl_sprite_ex.h"
 #include "gs_ogl_particle.h"
+#include "gs_ogl_render_queue.h"
 #include "gs_timer.h"
 //================================================================================================
 
@@ -0,0 +1,440 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: render_check.cpp                                                                    |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: None                                                                                |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Headless check of the software renderer (see GS_SoftRenderer) against OpenGL. It    |
+ |        draws a frame of the play screen for every level, the way the game draws it, once   |
+ |        with the fixed-function backend and once with the software backend, and compares    |
+ |        the frames pixel by pixel:                                                          |
+ |                                                                                            |
+ |        RenderCheck [results.ini [frame_prefix]]                                            |
+ |                                                                                            |
+ |        The results of every frame are written to the INI file (render_check.ini if none    |
+ |        is given) and the frames are saved as TGA files when a prefix is given. It returns  |
+ |        0 if all frames match, 1 if not (or if the frames could not be drawn).              |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// The tool has its own main(), keep SDL from replacing it.
+// ---------------------------------------------------------------------------------------------
+#define SDL_MAIN_HANDLED
+//==============================================================================================
+
+
+//==============================================================================================
+// Include standard C library header files.
+// ---------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//==============================================================================================
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "gs_snake.h"
+//==============================================================================================
+
+
+//==============================================================================================
+// Render check defines.
+// ---------------------------------------------------------------------------------------------
+#define CHECK_RESULTS_FILE "render_check.ini" // Results file used if none is given.
+#define CHECK_MAX_FRAMES   MAX_LEVEL // A frame is drawn for each of up to this many levels.
+#define CHECK_TOLERANCE    3  // Most a color channel may differ (filtering rounds differently).
+#define CHECK_SEED         1  // Seed for the random numbers, so both backends draw the same.
+#define CHECK_SNAKE_GROWTH 12 // Segments the snake grows by before each frame is drawn.
+#define CHECK_SNAKE_TURN   8  // Move after which the snake turns up.
+#define CHECK_SNAKE_SPEED  11 // Movement interval of the snake in milliseconds.
+//==============================================================================================
+
+
+//==============================================================================================
+// RenderScoreArea():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Renders the background and text of the score area, like GS_Snake::RenderScoreArea().
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+static void RenderScoreArea(GS_OGLSprite* pgsBackSprite, GS_OGLFont* pgsFont, int nLevel)
+{
+
+    pgsBackSprite->SetSourceRect(0, INTERNAL_RES_Y + SCORE_AREA_HEIGHT, INTERNAL_RES_X,
+                                 INTERNAL_RES_Y);
+    pgsBackSprite->SetDestXY(0, PLAY_AREA_HEIGHT);
+    pgsBackSprite->Render();
+
+    // Restore the background source and position.
+    pgsBackSprite->SetSourceRect(0, INTERNAL_RES_Y, INTERNAL_RES_X, 0);
+    pgsBackSprite->SetDestXY(0, 0);
+
+    pgsFont->SetText("LEVEL 1-%d", nLevel);
+    pgsFont->SetModulateColor(1.0f, 1.0f, 1.0f, 1.0f);
+    pgsFont->SetScaleXY(1.0f, 1.0f);
+    pgsFont->SetDestX(((INTERNAL_RES_X / 4) - pgsFont->GetTextWidth()) / 2);
+    pgsFont->SetDestY(INTERNAL_RES_Y - SCORE_AREA_HEIGHT +
+                      ((SCORE_AREA_HEIGHT - pgsFont->GetTextHeight()) / 2));
+    pgsFont->Render();
+
+    pgsFont->SetText("SCORE %ld", nLevel * 1250l);
+    pgsFont->SetDestX((((INTERNAL_RES_X / 4) - pgsFont->GetTextWidth()) / 2) +
+                      (INTERNAL_RES_X / 4 * 3));
+    pgsFont->Render();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// DrawFrames():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Creates a display with the specified backend, loads the game images the way
+//          GS_Snake::GameInit() does and draws a frame of the play screen for each level: the
+//          background, tiles clipped to an area that cuts through them, the score area from
+//          its render target, the level map, the snake and the rat with their particles and
+//          text on top. The frames are copied to pFrames (INTERNAL_RES_X * INTERNAL_RES_Y RGBA
+//          pixels each) and saved as TGA files if pszPrefix isn't NULL.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of frames drawn, 0 if the display could not be created.
+//==============================================================================================
+
+static int DrawFrames(SDL_Window* pWindow, int nBackend, BYTE* pFrames, const char* pszPrefix)
+{
+
+    GS_OGLDisplay gsDisplay;
+
+    // Don't compare a backend the display fell back from.
+    if ((!gsDisplay.Create(pWindow, INTERNAL_RES_X, INTERNAL_RES_Y, 32, nBackend)) ||
+        (gsDisplay.GetBackend() != nBackend))
+    {
+        GS_Error::Report("RENDER_CHECK.CPP", 119, "Failed to create the display!");
+        gsDisplay.Destroy();
+        return 0;
+    }
+
+    gsDisplay.EnableBlending(TRUE);
+    gsDisplay.EnableBatching(TRUE);
+    gsDisplay.EnableSorting(TRUE);
+    gsDisplay.EnableReadback(TRUE);
+
+    GS_OGLDisplay::SetScaleFactorXY(1.0f, 1.0f);
+    GS_OGLDisplay::SetRenderModXY(0.0f, 0.0f);
+
+    // Give the particle effects the same random colors with both backends.
+    srand(CHECK_SEED);
+
+    RECT rcPlayArea;
+    SetRect(&rcPlayArea, 0, PLAY_AREA_HEIGHT, PLAY_AREA_WIDTH, 0);
+
+    GS_OGLSprite gsBackSprite;
+    gsBackSprite.Create("data/image_01.tga", TRUE);
+    gsBackSprite.SetSourceRect(0, INTERNAL_RES_Y, INTERNAL_RES_X, 0);
+    gsBackSprite.SetDestXY(0, 0);
+
+    GS_OGLSprite gsTileSprite;
+    gsTileSprite.Create("data/image_02.tga", TRUE);
+
+    GS_OGLTextureAtlas gsTextureAtlas;
+    gsTextureAtlas.Begin();
+
+    GS_OGLTexture gsFontTexture;
+    gsFontTexture.Create("data/font_01.tga", GS_MIPMAP, GL_NEAREST, GL_NEAREST);
+
+    GS_OGLFont gsFont;
+    gsFont.Create(gsFontTexture, 16, 16, 16);
+
+    Snake snake;
+    snake.Create(rcPlayArea, -1, -1, true);
+
+    Rat rat;
+    rat.Create(rcPlayArea, -1, -1, true);
+
+    Level level;
+    level.Create(rcPlayArea, true);
+
+    gsTextureAtlas.End();
+
+    GS_OGLRenderTarget gsScoreTarget;
+    gsScoreTarget.Create(INTERNAL_RES_X, SCORE_AREA_HEIGHT);
+
+    int nNumPixels = INTERNAL_RES_X * INTERNAL_RES_Y;
+    int nNumFrames = 0;
+
+    while ((nNumFrames < CHECK_MAX_FRAMES) && (nNumFrames < level.GetNumLevels()))
+    {
+        int nLevel = nNumFrames + 1;
+
+        level.Load(nLevel);
+
+        // Move the grown snake from the start of the level, the snake only moves once its
+        // movement interval has passed.
+        snake.Reset(level.GetSnakeStartX(), level.GetSnakeStartY(), CHECK_SNAKE_SPEED);
+        snake.SetState(SNAKE_STATE_MOVING);
+        snake.Grow(CHECK_SNAKE_GROWTH);
+
+        for (int nMove = 0; nMove < CHECK_SNAKE_GROWTH; nMove++)
+        {
+            if (nMove == CHECK_SNAKE_TURN)
+            {
+                snake.SetMovementDirection(SNAKE_MOVE_UP);
+            }
+
+            GS_Timer::SleepFor((CHECK_SNAKE_SPEED + 1) * 1000000LL);
+            snake.Update();
+        }
+
+        // Put the rat where a new game puts it.
+        int nRatX = PLAY_AREA_WIDTH -
+                    ((PLAY_AREA_WIDTH - (PLAY_AREA_WIDTH % RAT_ELEMENT_WIDTH)) / 4);
+        int nRatY = (PLAY_AREA_HEIGHT / RAT_ELEMENT_HEIGHT) / 2 * RAT_ELEMENT_HEIGHT;
+
+        rat.Reset(nRatX, nRatY, level.GetRatInterval());
+        rat.SetState(RAT_STATE_STATIC);
+
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        gsDisplay.BeginRender();
+        gsDisplay.BeginRender2D(pWindow);
+
+        gsBackSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, 0.25f);
+        gsBackSprite.Render();
+        gsBackSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, 1.0f);
+
+        // Cut through the tiles on every side, a little differently in every frame.
+        RECT rcTileArea;
+        SetRect(&rcTileArea, 37 + (nNumFrames * 11), PLAY_AREA_HEIGHT - 29,
+                INTERNAL_RES_X - 53, 23 + (nNumFrames * 5));
+
+        gsTileSprite.SetModulateColor(-1.0f, -1.0f, -1.0f, 0.5f);
+        gsTileSprite.RenderTiles(rcTileArea, TRUE);
+
+        GS_OGLRenderQueue::SetLayer(LAYER_PLAY_AREA);
+
+        gsScoreTarget.Invalidate();
+
+        if (gsScoreTarget.Begin(0.0f, (GLfloat) PLAY_AREA_HEIGHT))
+        {
+            RenderScoreArea(&gsBackSprite, &gsFont, nLevel);
+            gsScoreTarget.End();
+        }
+
+        gsScoreTarget.SetModulateColor(1.0f, 1.0f, 1.0f, 0.75f);
+        gsScoreTarget.Render(0.0f, (GLfloat) PLAY_AREA_HEIGHT);
+
+        level.Render();
+
+        GS_OGLRenderQueue::SetLayer(LAYER_ACTORS);
+
+        snake.Render();
+        rat.Render();
+
+        GS_OGLRenderQueue::SetLayer(LAYER_OVERLAY, FALSE);
+
+        gsFont.SetText("GET READY!");
+        gsFont.SetModulateColor(1.0f, 0.25f, 0.25f, 1.0f);
+        gsFont.SetScaleXY(2.0f, 2.0f);
+        gsFont.SetDestX((INTERNAL_RES_X / 2) - (gsFont.GetTextWidth() / 2));
+        gsFont.SetDestY(INTERNAL_RES_Y / 2);
+        gsFont.Render();
+
+        gsDisplay.EndRender2D();
+        gsDisplay.EndRender(pWindow);
+
+        if ((!gsDisplay.GetReadback()) || (gsDisplay.GetReadbackWidth() != INTERNAL_RES_X) ||
+            (gsDisplay.GetReadbackHeight() != INTERNAL_RES_Y))
+        {
+            GS_Error::Report("RENDER_CHECK.CPP", 254, "Failed to read the frame back!");
+            break;
+        }
+
+        memcpy(pFrames + (nNumFrames * nNumPixels * 4), gsDisplay.GetReadback(), nNumPixels * 4);
+
+        if (pszPrefix)
+        {
+            char szFilename[_MAX_PATH];
+            sprintf(szFilename, "%s_%s_%02d.tga", pszPrefix,
+                    (nBackend == GS_BACKEND_SOFTWARE) ? "software" : "opengl", nLevel);
+            gsDisplay.SaveFrame(szFilename);
+        }
+
+        nNumFrames++;
+    }
+
+    // Release everything while the rendering context still exists.
+    gsScoreTarget.Destroy();
+    level.Destroy();
+    rat.Destroy();
+    snake.Destroy();
+    gsFont.Destroy();
+    gsFontTexture.Destroy();
+    gsTextureAtlas.Destroy();
+    gsTileSprite.Destroy();
+    gsBackSprite.Destroy();
+    gsDisplay.Destroy();
+
+    return nNumFrames;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// CompareFrames():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Compares the red, green and blue channels of two frames of nNumPixels RGBA pixels
+//          (alpha isn't compared, the back buffer may not have it) and stores the largest
+//          difference found in pnMaxDifference.
+// ---------------------------------------------------------------------------------------------
+// Returns: The number of pixels with a channel that differs by more than CHECK_TOLERANCE.
+//==============================================================================================
+
+static int CompareFrames(const BYTE* pFrameA, const BYTE* pFrameB, int nNumPixels,
+                         int* pnMaxDifference)
+{
+
+    int nNumDiffering = 0;
+
+    *pnMaxDifference = 0;
+
+    for (int nPixel = 0; nPixel < nNumPixels; nPixel++)
+    {
+        BOOL bDiffers = FALSE;
+
+        for (int nChannel = 0; nChannel < 3; nChannel++)
+        {
+            int nDifference = abs(pFrameA[(nPixel * 4) + nChannel] -
+                                  pFrameB[(nPixel * 4) + nChannel]);
+
+            if (nDifference > *pnMaxDifference)
+            {
+                *pnMaxDifference = nDifference;
+            }
+
+            if (nDifference > CHECK_TOLERANCE)
+            {
+                bDiffers = TRUE;
+            }
+        }
+
+        if (bDiffers)
+        {
+            nNumDiffering++;
+        }
+    }
+
+    return nNumDiffering;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==============================================================================================
+// main():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Draws the frames with OpenGL and with the software renderer in an offscreen window
+//          and writes a section with the differing pixels and the largest difference of each
+//          frame to the results file, followed by a summary.
+// ---------------------------------------------------------------------------------------------
+// Returns: 0 if all frames match, 1 if not.
+//==============================================================================================
+
+int main(int argc, char* argv[])
+{
+
+    const char* pszResults = (argc > 1) ? argv[1] : CHECK_RESULTS_FILE;
+    const char* pszPrefix  = (argc > 2) ? argv[2] : NULL;
+
+    // Render into the EGL pbuffer of SDL's offscreen driver, no display is needed.
+    SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+
+    if (SDL_Init(SDL_INIT_VIDEO) < 0)
+    {
+        GS_Error::Report("RENDER_CHECK.CPP", 362, "Failed to initialize SDL!");
+        return 1;
+    }
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
+    SDL_Window* pWindow = SDL_CreateWindow("Render Check", SDL_WINDOWPOS_CENTERED,
+                                           SDL_WINDOWPOS_CENTERED, INTERNAL_RES_X,
+                                           INTERNAL_RES_Y, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+
+    if (!pWindow)
+    {
+        GS_Error::Report("RENDER_CHECK.CPP", 376, "Failed to create SDL window!");
+        SDL_Quit();
+        return 1;
+    }
+
+    int   nNumPixels = INTERNAL_RES_X * INTERNAL_RES_Y;
+    BYTE* pOpenGLFrames   = new BYTE[CHECK_MAX_FRAMES * nNumPixels * 4];
+    BYTE* pSoftwareFrames = new BYTE[CHECK_MAX_FRAMES * nNumPixels * 4];
+
+    int nNumFrames  = DrawFrames(pWindow, GS_BACKEND_FIXED, pOpenGLFrames, pszPrefix);
+    int nNumDrawn   = DrawFrames(pWindow, GS_BACKEND_SOFTWARE, pSoftwareFrames, pszPrefix);
+    int nNumFailed  = 0;
+
+    // Start with an empty results file.
+    remove(pszResults);
+
+    GS_IniFile gsResults;
+    gsResults.Open(pszResults);
+
+    for (int nFrame = 0; nFrame < nNumFrames; nFrame++)
+    {
+        char szSection[32];
+        sprintf(szSection, "Frame%02d", nFrame + 1);
+
+        int nNumDiffering  = nNumPixels;
+        int nMaxDifference = 255;
+
+        if (nFrame < nNumDrawn)
+        {
+            nNumDiffering = CompareFrames(pOpenGLFrames + (nFrame * nNumPixels * 4),
+                                          pSoftwareFrames + (nFrame * nNumPixels * 4),
+                                          nNumPixels, &nMaxDifference);
+        }
+
+        if (nNumDiffering > 0)
+        {
+            nNumFailed++;
+        }
+
+        gsResults.WriteInt(szSection, "Level", nFrame + 1);
+        gsResults.WriteInt(szSection, "DifferingPixels", nNumDiffering);
+        gsResults.WriteInt(szSection, "LargestDifference", nMaxDifference);
+        gsResults.WriteString(szSection, "Result", (nNumDiffering > 0) ? "failed" : "passed");
+    }
+
+    // Nothing was compared if either backend drew no frames.
+    BOOL bIsPassed = (nNumFrames > 0) && (nNumDrawn == nNumFrames) && (nNumFailed == 0);
+
+    gsResults.WriteInt("RenderCheck", "Frames", nNumFrames);
+    gsResults.WriteInt("RenderCheck", "FailedFrames", nNumFailed);
+    gsResults.WriteInt("RenderCheck", "Tolerance", CHECK_TOLERANCE);
+    gsResults.WriteString("RenderCheck", "Result", bIsPassed ? "passed" : "failed");
+    gsResults.Close();
+
+    delete[] pOpenGLFrames;
+    delete[] pSoftwareFrames;
+
+    SDL_DestroyWindow(pWindow);
+    SDL_Quit();
+
+    return bIsPassed ? 0 : 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
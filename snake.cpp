@@ -19,6 +19,20 @@
 //==============================================================================================
 
 
+//==============================================================================================
+// FloorDivide():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Divide rounding down, also for negative values (used to find the cell of a pixel)
+// ---------------------------------------------------------------------------------------------
+// Returns: The rounded down quotient
+//==============================================================================================
+
+static int FloorDivide( int value, int divisor )
+{
+    return ( value >= 0 ? value / divisor : -((divisor - 1 - value) / divisor) );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor Methods //////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,7 +52,12 @@ Snake::Snake()
     m_posX = 0;
     m_posY = 0;
 
-    m_length = 1;
+    m_length = 0;
+    m_growLength = 0;
+
+    m_segments = NULL;
+    m_capacity = 0;
+    m_headIndex = 0;
 
     m_snakeFrame = 0;
 
@@ -49,6 +68,12 @@ Snake::Snake()
     m_particleAlphaMod = 0.01f;
 
     m_state = SNAKE_STATE_MOVING;
+
+    m_occupancy = NULL;
+    m_occupancyCols = 0;
+    m_occupancyRows = 0;
+
+    m_spawner = NULL;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,9 +111,24 @@ bool Snake::Create(RECT areaRect, int startX, int startY, bool filtered, GS_OGLC
         this->Destroy();
     }
 
+    // Release a grid left by an earlier failed create (taking the segments off the spawner first)
+    if( m_occupancy ) {
+        this->ClearOccupancy();
+        delete[] m_occupancy;
+        m_occupancy = NULL;
+    }
+
     // Set the snake movement area
     m_areaRect = areaRect;
 
+    // Create a grid of cells covering the movement area to keep count of the snake segments on
+    m_occupancyCols = (m_areaRect.right - m_areaRect.left) / SNAKE_ELEMENT_WIDTH;
+    m_occupancyRows = (m_areaRect.top - m_areaRect.bottom) / SNAKE_ELEMENT_HEIGHT;
+    m_occupancyCols = ( m_occupancyCols > 0 ? m_occupancyCols : 0 );
+    m_occupancyRows = ( m_occupancyRows > 0 ? m_occupancyRows : 0 );
+
+    m_occupancy = new int[m_occupancyCols * m_occupancyRows]();
+
     // Set snake details
     m_posX = ( startX > -1 ? startX : m_posX );
     m_posY = ( startY > -1 ? startY : m_posY );
@@ -122,33 +162,13 @@ bool Snake::Create(RECT areaRect, int startX, int startY, bool filtered, GS_OGLC
     m_snakeSprite.SetDestXY(m_posX, m_posY);
     m_snakeSprite.SetFrame(m_snakeFrame);
 
-    // Reset all the snake moves
-    for(int i = 0; i < SNAKE_MAX_LENGTH; i++)
-    {
-        m_segments[i].bIsActive  = false;
-        m_segments[i].nCoordX  = -1;
-        m_segments[i].nCoordY  = -1;
-        m_segments[i].nDirection  = SNAKE_MOVE_NONE;
-    }
-
-    // Set the default starting length
-    m_length = 2;
-
-    // Set the postion of the available snake elements
-    for(int i = 0; i < m_length; i++) {
-        m_segments[i].bIsActive  = true;
-        m_segments[i].nCoordX  = m_posX;
-        m_segments[i].nCoordY  = m_posY;
-        m_segments[i].nDirection  = SNAKE_MOVE_NONE;
-    }
-
-    // Activate the first segment
-    m_segments[0].bIsActive  = true;
-    m_segments[0].nCoordX  = m_posX;
-    m_segments[0].nCoordY  = m_posY;
-    m_segments[0].nDirection = SNAKE_MOVE_RIGHT;
+    // Start with just the head, moving right
+    this->ResetSegments();
     m_newDirection = SNAKE_MOVE_RIGHT;
 
+    // Count the segments on each cell
+    this->ResetOccupancy();
+
     // Reset the timer
     m_gsTimer.Reset();
 
@@ -186,6 +206,26 @@ void Snake::Destroy()
     m_gsTimer.Reset();
 
     m_snakeSprite.Destroy();
+
+    // Release the occupancy grid (taking the segments off the spawner while the body still
+    // tells which cells they are on)
+    if( m_occupancy ) {
+        this->ClearOccupancy();
+        delete[] m_occupancy;
+        m_occupancy = NULL;
+    }
+    m_occupancyCols = 0;
+    m_occupancyRows = 0;
+
+    // Release the body
+    if( m_segments ) {
+        delete[] m_segments;
+        m_segments = NULL;
+    }
+    m_capacity = 0;
+    m_headIndex = 0;
+    m_length = 0;
+    m_growLength = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -230,35 +270,188 @@ void Snake::Reset(int startX, int startY, int interval)
     m_snakeSprite.SetDestXY(m_posX, m_posY);
     m_snakeSprite.SetFrame(m_snakeFrame);
 
-    // Reset all the snake moves
-    for(int i = 0; i < SNAKE_MAX_LENGTH; i++)
-    {
-        m_segments[i].bIsActive  = false;
-        m_segments[i].nCoordX  = -1;
-        m_segments[i].nCoordY  = -1;
-        m_segments[i].nDirection  = SNAKE_MOVE_NONE;
+    // Take the old body off the cells before it is replaced
+    this->ClearOccupancy();
+
+    // Start with just the head, moving right
+    this->ResetSegments();
+    m_newDirection = SNAKE_MOVE_RIGHT;
+
+    // Count the segments on each cell
+    this->ResetOccupancy();
+
+    // Reset the timer
+    m_gsTimer.Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::ResetSegments():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Reset the body to just the head at the snake position, with one more segment to be
+//          added at the tail (the default starting length is two)
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing
+//==============================================================================================
+
+void Snake::ResetSegments()
+{
+    this->ReserveSegments( SNAKE_START_CAPACITY );
+
+    m_headIndex = 0;
+    m_length = 1;
+    m_growLength = 1;
+
+    m_segments[0].nCoordX = m_posX;
+    m_segments[0].nCoordY = m_posY;
+    m_segments[0].nDirection = SNAKE_MOVE_RIGHT;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::ReserveSegments():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Make certain the ring buffer can hold the given number of segments, doubling its
+//          size as often as needed and moving the head to the start of the new buffer
+// ---------------------------------------------------------------------------------------------
+// Returns: true if the segments fit, false if not
+//==============================================================================================
+
+bool Snake::ReserveSegments( int length )
+{
+    if( length <= m_capacity ) return true;
+
+    if( length > SNAKE_MAX_LENGTH ) return false;
+
+    int capacity = ( m_capacity > 0 ? m_capacity : SNAKE_START_CAPACITY );
+    while( capacity < length ) {
+        capacity = capacity * 2;
     }
 
-    // Set the default starting length
-    m_length = 2;
+    SnakeSegments* segments = new SnakeSegments[capacity];
 
-    // Set the postion of the available snake elements
-    for(int i = 0; i < m_length; i++) {
-        m_segments[i].bIsActive  = true;
-        m_segments[i].nCoordX  = m_posX;
-        m_segments[i].nCoordY  = m_posY;
-        m_segments[i].nDirection  = SNAKE_MOVE_NONE;
+    // Copy the body from the head to the tail
+    for( int i = 0; i < m_length; i++ ) {
+        segments[i] = GetSegment(i);
     }
 
-    // Activate the first segment
-    m_segments[0].bIsActive  = true;
-    m_segments[0].nCoordX  = m_posX;
-    m_segments[0].nCoordY  = m_posY;
-    m_segments[0].nDirection = SNAKE_MOVE_RIGHT;
-    m_newDirection = SNAKE_MOVE_RIGHT;
+    if( m_segments ) {
+        delete[] m_segments;
+    }
 
-    // Reset the timer
-    m_gsTimer.Reset();
+    m_segments = segments;
+    m_capacity = capacity;
+    m_headIndex = 0;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::ClearOccupancy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Set the count of segments to zero on the cells the body is on, removing them from
+//          the spawner. Only those cells are visited, so this has to be done before the body
+//          is changed other than by moving or growing.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing
+//==============================================================================================
+
+void Snake::ClearOccupancy()
+{
+    if( (NULL == m_occupancy) || (NULL == m_segments) ) return;
+
+    for( int i = 0; i < m_length; i++ ) {
+        int x = GetSegment(i).nCoordX;
+        int y = GetSegment(i).nCoordY;
+
+        // Ignore coordinates outside of the movement area
+        if( (x < m_areaRect.left) || (y < m_areaRect.bottom) ) continue;
+
+        int col = (x - m_areaRect.left) / SNAKE_ELEMENT_WIDTH;
+        int row = (y - m_areaRect.bottom) / SNAKE_ELEMENT_HEIGHT;
+
+        if( (col >= m_occupancyCols) || (row >= m_occupancyRows) ) continue;
+
+        // Release the cell only once, however many segments are on it
+        int& count = m_occupancy[(row * m_occupancyCols) + col];
+
+        if( (count != 0) && m_spawner ) {
+            m_spawner->Occupy( x, y, -count );
+        }
+
+        count = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::ResetOccupancy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Count the segments on each cell of the movement area from scratch, the grid having
+//          been cleared before the body was last reset
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing
+//==============================================================================================
+
+void Snake::ResetOccupancy()
+{
+    // Count the segments of the body (segments still to be added are not checked for collisions)
+    for( int i = 0; i < m_length; i++ ) {
+        this->ChangeOccupancy( GetSegment(i).nCoordX, GetSegment(i).nCoordY, 1 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::ChangeOccupancy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Add an amount to the count of segments on the cell at the given coordinates
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing
+//==============================================================================================
+
+void Snake::ChangeOccupancy( int x, int y, int amount )
+{
+    // Ignore coordinates outside of the movement area
+    if( (x < m_areaRect.left) || (y < m_areaRect.bottom) ) return;
+
+    int col = (x - m_areaRect.left) / SNAKE_ELEMENT_WIDTH;
+    int row = (y - m_areaRect.bottom) / SNAKE_ELEMENT_HEIGHT;
+
+    if( (col >= m_occupancyCols) || (row >= m_occupancyRows) ) return;
+
+    m_occupancy[(row * m_occupancyCols) + col] += amount;
+
+    // Keep the spawner up to date
+    if( m_spawner ) {
+        m_spawner->Occupy( x, y, amount );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Snake::SetSpawner():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Set the spawner to tell about the cells taken by the snake (NULL for none), moving
+//          the current segments from the old spawner to the new one
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing
+//==============================================================================================
+
+void Snake::SetSpawner( Spawner* spawner )
+{
+    this->ClearOccupancy();
+
+    m_spawner = spawner;
+
+    this->ResetOccupancy();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -324,7 +517,8 @@ void Snake::SetState( int stateNum )
 //==============================================================================================
 // Snake::SetState():
 // ---------------------------------------------------------------------------------------------
-// Purpose: Grow the snake a given number of segments
+// Purpose: Grow the snake a given number of segments. The segments are added at the tail one
+//          at a time, by not removing the tail the next moves.
 // ---------------------------------------------------------------------------------------------
 // Returns: true if snake could grow false if not
 //==============================================================================================
@@ -332,18 +526,10 @@ void Snake::SetState( int stateNum )
 bool Snake::Grow( int numSegments ) {
 
     // Do not grow the snake more than the maximum allowed length
-    if( (m_length + numSegments ) > SNAKE_MAX_LENGTH ) return false;
-
-    // Activate the indicated segments
-    for( int i = m_length; i < m_length + numSegments; i++ ) {
-        m_segments[i].bIsActive  = true;
-        m_segments[i].nCoordX  = m_segments[m_length-1].nCoordX;
-        m_segments[i].nCoordY  = m_segments[m_length-1].nCoordY;
-        m_segments[i].nDirection  = SNAKE_MOVE_NONE;
-    }
+    if( (m_length + m_growLength + numSegments ) > SNAKE_MAX_LENGTH ) return false;
 
-    // Update the snake length
-    m_length = m_length + numSegments;
+    // Remember how many segments to add
+    m_growLength = m_growLength + numSegments;
 
     // Set the state of the snake to growing
     this->SetState( SNAKE_STATE_GROWING );
@@ -365,10 +551,10 @@ void Snake::GetCollideRect(RECT* pSourceRect)
 {
     SetRect(
         pSourceRect,
-        m_segments[0].nCoordX,
-        m_segments[0].nCoordY + SNAKE_ELEMENT_HEIGHT - 1,
-        m_segments[0].nCoordX + SNAKE_ELEMENT_WIDTH - 1,
-        m_segments[0].nCoordY
+        GetSegment(0).nCoordX,
+        GetSegment(0).nCoordY + SNAKE_ELEMENT_HEIGHT - 1,
+        GetSegment(0).nCoordX + SNAKE_ELEMENT_WIDTH - 1,
+        GetSegment(0).nCoordY
     );
 }
 
@@ -377,42 +563,52 @@ void Snake::GetCollideRect(RECT* pSourceRect)
 //==============================================================================================
 // Snake::CheckCollision():
 // ---------------------------------------------------------------------------------------------
-// Purpose: To check whether a target rectangle has collided with the snakes head or body
+// Purpose: To check whether a target rectangle has collided with the snakes head or body. Only
+//          the cells overlapped by the target are looked at, so the length of the snake does
+//          not matter.
 // ---------------------------------------------------------------------------------------------
 // Returns: 0 if no collision, 1 if collision with head, 2 if collision with body
 //==============================================================================================
 
 int Snake::CheckCollision(RECT rcTarget, BOOL bExcludeHead)
 {
-    // For every snake segment
-    for( int i = 0; i < m_length; i++ ) {
-        // Only check active segments and segments that have started moving
-        if( (true != m_segments[i].bIsActive) || (SNAKE_MOVE_NONE == m_segments[i].nDirection) ) break;
-
-        // Skip the head if not included
-        if( (TRUE == bExcludeHead) && (i == 0) ) continue;
-
-        // Get the segment rectangle
-        RECT rcSegment;
-        SetRect(
-            &rcSegment,
-            m_segments[i].nCoordX,
-            m_segments[i].nCoordY + SNAKE_ELEMENT_HEIGHT - 1,
-            m_segments[i].nCoordX + SNAKE_ELEMENT_WIDTH - 1,
-            m_segments[i].nCoordY
-        );
-
-// if(  i == 0 ) {
-// std::cout << rcSegment.left << "," << rcSegment.top << "," << rcSegment.right << "," << rcSegment.bottom << "\n";
-// }
-
-        // Is there a collsion with the target rectangle?
-        if( TRUE == m_gsCollide.IsRectOnRect(rcTarget, rcSegment) ) {
-            // Was it the head?
-            if( i == 0 ) {
-                return SNAKE_COLLIDE_HEAD;
+    // Nothing to collide with without a body
+    if( m_length <= 0 ) return SNAKE_COLLIDE_NONE;
+
+    // Get the cells overlapped by the target rectangle (a segment rectangle is one pixel less
+    // than a cell wide and high, and only overlaps if it is not merely touching the target)
+    int firstCol = FloorDivide( rcTarget.left - m_areaRect.left - SNAKE_ELEMENT_WIDTH + 1, SNAKE_ELEMENT_WIDTH ) + 1;
+    int lastCol = FloorDivide( rcTarget.right - m_areaRect.left - 1, SNAKE_ELEMENT_WIDTH );
+    int firstRow = FloorDivide( rcTarget.bottom - m_areaRect.bottom - SNAKE_ELEMENT_HEIGHT + 1, SNAKE_ELEMENT_HEIGHT ) + 1;
+    int lastRow = FloorDivide( rcTarget.top - m_areaRect.bottom - 1, SNAKE_ELEMENT_HEIGHT );
+
+    // Only cells in the movement area can hold segments
+    firstCol = ( firstCol > 0 ? firstCol : 0 );
+    firstRow = ( firstRow > 0 ? firstRow : 0 );
+    lastCol = ( lastCol < m_occupancyCols ? lastCol : m_occupancyCols - 1 );
+    lastRow = ( lastRow < m_occupancyRows ? lastRow : m_occupancyRows - 1 );
+
+    // Get the cell of the head
+    int headCol = FloorDivide( GetSegment(0).nCoordX - m_areaRect.left, SNAKE_ELEMENT_WIDTH );
+    int headRow = FloorDivide( GetSegment(0).nCoordY - m_areaRect.bottom, SNAKE_ELEMENT_HEIGHT );
+
+    // Is there a collision with the head (checked first, like the rest of the game expects)?
+    if( (TRUE != bExcludeHead) && (headCol >= firstCol) && (headCol <= lastCol) &&
+        (headRow >= firstRow) && (headRow <= lastRow) ) {
+        return SNAKE_COLLIDE_HEAD;
+    }
+
+    // Is there a collision with the body on any of the cells?
+    for( int row = firstRow; row <= lastRow; row++ ) {
+        for( int col = firstCol; col <= lastCol; col++ ) {
+            int count = m_occupancy[(row * m_occupancyCols) + col];
+
+            // Don't count the head
+            if( (col == headCol) && (row == headRow) ) {
+                count--;
             }
-            else {
+
+            if( count > 0 ) {
                 return SNAKE_COLLIDE_BODY;
             }
         }
@@ -437,10 +633,12 @@ void Snake::SetMovementDirection( int direction ) {
     if( (direction < 0) || (direction > 3) ) return;
 
     // Prevent moving in the opposite direction
-    if ( ((direction == SNAKE_MOVE_UP) && (m_segments[0].nDirection == SNAKE_MOVE_DOWN)) ||
-         ((direction == SNAKE_MOVE_DOWN) && (m_segments[0].nDirection == SNAKE_MOVE_UP)) ||
-         ((direction == SNAKE_MOVE_LEFT) && (m_segments[0].nDirection == SNAKE_MOVE_RIGHT)) ||
-         ((direction == SNAKE_MOVE_RIGHT) && (m_segments[0].nDirection == SNAKE_MOVE_LEFT)) ) {
+    int currentDirection = this->GetMovementDirection();
+
+    if ( ((direction == SNAKE_MOVE_UP) && (currentDirection == SNAKE_MOVE_DOWN)) ||
+         ((direction == SNAKE_MOVE_DOWN) && (currentDirection == SNAKE_MOVE_UP)) ||
+         ((direction == SNAKE_MOVE_LEFT) && (currentDirection == SNAKE_MOVE_RIGHT)) ||
+         ((direction == SNAKE_MOVE_RIGHT) && (currentDirection == SNAKE_MOVE_LEFT)) ) {
         return;
     }
 
@@ -490,63 +688,62 @@ void Snake::Update()
 
     // Is the snake moving and is it time to move?
     if( ((m_state == SNAKE_STATE_MOVING) || (m_state == SNAKE_STATE_GROWING)) && (m_gsTimer.GetTime() >= m_movementInterval) ) {
-        // Set new direction, if any
-        m_segments[0].nDirection = m_newDirection;
-
-        // Adjust all the snake coordinates
-        for( int i = 0; i < m_length; i++ ) {
-            // Only move the active segments that have a direction specified
-            if( (true != m_segments[i].bIsActive) && (m_segments[i].nDirection != SNAKE_MOVE_NONE) ) break;
+        // Get the current position of the head
+        int posX = GetSegment(0).nCoordX;
+        int posY = GetSegment(0).nCoordY;
 
-            // Get the current position of the segment
-            int posX = m_segments[i].nCoordX;
-            int posY = m_segments[i].nCoordY;
-
-            // Depending on the direction the snake is moving in
-            if( m_segments[i].nDirection == SNAKE_MOVE_UP ) {
-                posY = posY + m_movementAmount;
-            }
-            else if( m_segments[i].nDirection == SNAKE_MOVE_RIGHT ) {
-                posX = posX + m_movementAmount;
-            }
-            else if( m_segments[i].nDirection == SNAKE_MOVE_DOWN ) {
-                posY = posY - m_movementAmount;
-            }
-            else if( m_segments[i].nDirection == SNAKE_MOVE_LEFT ) {
-                posX = posX - m_movementAmount;
-            }
+        // Depending on the direction the snake is moving in
+        if( m_newDirection == SNAKE_MOVE_UP ) {
+            posY = posY + m_movementAmount;
+        }
+        else if( m_newDirection == SNAKE_MOVE_RIGHT ) {
+            posX = posX + m_movementAmount;
+        }
+        else if( m_newDirection == SNAKE_MOVE_DOWN ) {
+            posY = posY - m_movementAmount;
+        }
+        else if( m_newDirection == SNAKE_MOVE_LEFT ) {
+            posX = posX - m_movementAmount;
+        }
 
-            // Wrap the snake if it move outside of the play area
-            if( posY + SNAKE_ELEMENT_HEIGHT > m_areaRect.top ) {
-                posY = m_areaRect.bottom;
-            }
-            else if( posX + SNAKE_ELEMENT_WIDTH > m_areaRect.right ) {
-                posX = m_areaRect.left;
-            }
-            else if( posY < m_areaRect.bottom ) {
-                posY = m_areaRect.top - (m_areaRect.top % SNAKE_ELEMENT_HEIGHT) - SNAKE_ELEMENT_HEIGHT;
-            }
-            else if( posX < m_areaRect.left ) {
-                posX = m_areaRect.right - (m_areaRect.right % SNAKE_ELEMENT_WIDTH) - SNAKE_ELEMENT_WIDTH;
-            }
+        // Wrap the snake if it move outside of the play area
+        if( posY + SNAKE_ELEMENT_HEIGHT > m_areaRect.top ) {
+            posY = m_areaRect.bottom;
+        }
+        else if( posX + SNAKE_ELEMENT_WIDTH > m_areaRect.right ) {
+            posX = m_areaRect.left;
+        }
+        else if( posY < m_areaRect.bottom ) {
+            posY = m_areaRect.top - (m_areaRect.top % SNAKE_ELEMENT_HEIGHT) - SNAKE_ELEMENT_HEIGHT;
+        }
+        else if( posX < m_areaRect.left ) {
+            posX = m_areaRect.right - (m_areaRect.right % SNAKE_ELEMENT_WIDTH) - SNAKE_ELEMENT_WIDTH;
+        }
 
-            // Save the new coordinates
-            m_segments[i].nCoordX = posX;
-            m_segments[i].nCoordY = posY;
+        // Every segment takes the place of the one in front of it, so only the tail has to be
+        // removed, unless the snake is growing, in which case the tail stays to add a segment
+        if( m_growLength > 0 ) {
+            m_growLength--;
+        }
+        else if( m_length > 0 ) {
+            this->ChangeOccupancy( GetSegment(m_length-1).nCoordX, GetSegment(m_length-1).nCoordY, -1 );
+            m_length--;
         }
 
-        // Adjust the direction so that next time, the next element will move the same way as the current element did
-        for( int i = m_length - 1; i > 0; i-- ) {
-            // Only update the directions of the active segments
-            if( true != m_segments[i].bIsActive ) continue;
+        // Add the new head in front of the body (making room for it first if needed)
+        if( this->ReserveSegments( m_length + 1 ) ) {
+            m_headIndex = (m_headIndex - 1) & (m_capacity - 1);
+            m_length++;
 
-            // The next segment should have the move direction of the previous segment
-            m_segments[i].nDirection = m_segments[i-1].nDirection;
+            GetSegment(0).nCoordX = posX;
+            GetSegment(0).nCoordY = posY;
+            GetSegment(0).nDirection = m_newDirection;
 
+            this->ChangeOccupancy( posX, posY, 1 );
         }
 
-        // Has the snake finished gowing (i.e., has the last segment started moving)?
-        if( (SNAKE_STATE_GROWING == m_state) && (m_segments[m_length-1].nDirection != SNAKE_MOVE_NONE) ) {
+        // Has the snake finished gowing (i.e., has the last segment been added)?
+        if( (SNAKE_STATE_GROWING == m_state) && (m_growLength <= 0) ) {
             // Set the snake state to moving again
             this->SetState( SNAKE_STATE_MOVING );
 
@@ -623,10 +820,12 @@ bool Snake::Render(float fAlpha)
     // Set the color for the particle
     GS_OGLColor color = m_particleColor;
 
+    // Fade the particle colors over the full length, including segments still to be added
+    int fadeLength = m_length + m_growLength;
+
     // Render the body of the snake
     for( int i = 0; i < m_length; i++ ) {
-        // Only render the active segments
-        if( true != m_segments[i].bIsActive ) break;
+        SnakeSegments& segment = GetSegment(i);
 
         // The following code enables smooth movement for the snake (but it needs a lot of work)
         float modX = 0;
@@ -636,41 +835,52 @@ bool Snake::Render(float fAlpha)
 
 //        // Is the snake not dead or dying?
 //        if( m_state < SNAKE_STATE_DYING ) {
-//            if( m_segments[i].nDirection == SNAKE_MOVE_UP ) {
+//            if( segment.nDirection == SNAKE_MOVE_UP ) {
 //                modY = round(mod * SNAKE_ELEMENT_HEIGHT);
 //            }
-//            else if( m_segments[i].nDirection == SNAKE_MOVE_DOWN ) {
+//            else if( segment.nDirection == SNAKE_MOVE_DOWN ) {
 //                modY = round(-mod * SNAKE_ELEMENT_HEIGHT);
 //            }
-//            else if( m_segments[i].nDirection == SNAKE_MOVE_RIGHT ) {
+//            else if( segment.nDirection == SNAKE_MOVE_RIGHT ) {
 //                modX = round(mod * SNAKE_ELEMENT_WIDTH);
 //            }
-//            else if( m_segments[i].nDirection == SNAKE_MOVE_LEFT ) {
+//            else if( segment.nDirection == SNAKE_MOVE_LEFT ) {
 //                modX = round(-mod * SNAKE_ELEMENT_WIDTH);
 //            }
 //        }
 
         // Set the destination of the specified snake segment
-        m_snakeSprite.SetDestXY( m_segments[i].nCoordX + modX, m_segments[i].nCoordY + modY );
+        m_snakeSprite.SetDestXY( segment.nCoordX + modX, segment.nCoordY + modY );
 
         // Render the snake segment
         m_snakeSprite.Render();
+    }
+
+    // Render the particle effects in a second pass so the segments and the particles each end
+    // up in a single run when sprite batching is enabled, one layer up so they stay on top
+    // when the render queue sorts the current layer
+    int layer = GS_OGLRenderQueue::GetLayer();
+    BOOL sorted = GS_OGLRenderQueue::IsLayerSorted();
+    GS_OGLRenderQueue::SetLayer(layer + 1, sorted);
 
-        // Skip the particale rendering for non-moving segments
-        if( m_segments[i].nDirection < 0 ) continue;
+    for( int i = 0; i < m_length; i++ ) {
+        SnakeSegments& segment = GetSegment(i);
+
+        float modX = 0;
+        float modY = 0;
 
         // Render the particle effect centered on the segment
-        m_snakeParticle.SetDestX(0, m_segments[i].nCoordX + modX - ((m_snakeParticle.GetScaledWidth(0) - SNAKE_ELEMENT_WIDTH) / 2));
-        m_snakeParticle.SetDestY(0, m_segments[i].nCoordY + modY - ((m_snakeParticle.GetScaledHeight(0) - SNAKE_ELEMENT_HEIGHT) /2));
+        m_snakeParticle.SetDestX(0, segment.nCoordX + modX - ((m_snakeParticle.GetScaledWidth(0) - SNAKE_ELEMENT_WIDTH) / 2));
+        m_snakeParticle.SetDestY(0, segment.nCoordY + modY - ((m_snakeParticle.GetScaledHeight(0) - SNAKE_ELEMENT_HEIGHT) /2));
 
         // Depedning on the snake state
         if( m_state == SNAKE_STATE_MOVING ) {
             // Don't fade the snake's head
             if( i > 0 ) {
                 // Fade the particle effect color towards the end of the snake
-                color.fRed = color.fRed - (color.fRed / m_length);
-                color.fGreen = color.fGreen - (color.fGreen / m_length);
-                color.fBlue = color.fBlue - (color.fBlue / m_length);
+                color.fRed = color.fRed - (color.fRed / fadeLength);
+                color.fGreen = color.fGreen - (color.fGreen / fadeLength);
+                color.fBlue = color.fBlue - (color.fBlue / fadeLength);
             }
         }
         else if( m_state == SNAKE_STATE_GROWING ) {
@@ -692,6 +902,9 @@ bool Snake::Render(float fAlpha)
         m_snakeParticle.Render();
     }
 
+    // Go back to the layer of the segments
+    GS_OGLRenderQueue::SetLayer(layer, sorted);
+
     // Reset the snake to the head coordinates
     // m_snakeSprite.SetDestXY( m_posX, m_posY );
 
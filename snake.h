@@ -22,11 +22,19 @@
 #include "gs_ogl_texture.h"
 #include "gs_ogl_sprite_ex.h"
 #include "gs_ogl_particle.h"
+#include "gs_ogl_render_queue.h"
 #include "gs_ogl_collide.h"
 #include "gs_timer.h"
 //================================================================================================
 
 
+//================================================================================================
+// Include custom game header files.
+// -----------------------------------------------------------------------------------------------
+#include "spawner.h"
+//================================================================================================
+
+
 //================================================================================================
 // Include standard C library header files.
 // -----------------------------------------------------------------------------------------------
@@ -38,7 +46,8 @@
 //==============================================================================================
 // Snake defines.
 // ---------------------------------------------------------------------------------------------
-#define SNAKE_MAX_LENGTH    200
+#define SNAKE_MAX_LENGTH    1048576 // The body grows as needed up to this many segments
+#define SNAKE_START_CAPACITY 256    // The number of segments the body can hold at first
 #define SNAKE_MOVE_NONE     -1
 #define SNAKE_MOVE_UP       0
 #define SNAKE_MOVE_RIGHT    1
@@ -70,10 +79,9 @@
 // ---------------------------------------------------------------------------------------------
 typedef struct SNAKE_SEGMENTS
 {
-    bool bIsActive;     // Whether the segment is active or not
     int  nCoordX;       // The x coordinate of the segment
     int  nCoordY;       // The y coordinate of the segment
-    int  nDirection;    // The direction in which the segment should move
+    int  nDirection;    // The direction in which the segment moved onto its cell
                         // (see definitaions above for available directions)
 } SnakeSegments;
 //==============================================================================================
@@ -104,7 +112,8 @@ private:
     int m_posX; // The X coordinate in pixels of the snake head
     int m_posY; // The Y coordinate in pixels of the snake head
 
-    int m_length; // The length of the snake
+    int m_length;     // The number of segments in the body of the snake
+    int m_growLength; // The number of segments still to be added at the tail
 
     int m_movementAmount;    // The amount which the snake should move every movement interval
     int m_movementInterval;  // The interval (in ms) at which the snake should move
@@ -114,7 +123,15 @@ private:
 
     int m_state;  // The state of the snake (see defines above for available states)
 
-    SnakeSegments m_segments[SNAKE_MAX_LENGTH];
+    SnakeSegments* m_segments; // The body as a ring buffer, moving pushes a head and pops the tail
+    int m_capacity;            // The number of segments the ring buffer can hold (a power of two)
+    int m_headIndex;           // The index of the head in the ring buffer
+
+    int* m_occupancy;    // The number of moving segments on each cell of the movement area
+    int m_occupancyCols; // The number of columns and rows of cells in the movement area
+    int m_occupancyRows;
+
+    Spawner* m_spawner; // Told about every change to the occupancy grid, if any
 
     float m_velocityX;
     float m_velocityY;
@@ -127,6 +144,21 @@ private:
         m_snakeSprite.SetFrame(frameNum);
     }
 
+    // Get a segment of the body, 0 being the head and m_length - 1 the tail
+    inline SnakeSegments& GetSegment( int index )
+    {
+        return m_segments[(m_headIndex + index) & (m_capacity - 1)];
+    }
+
+    // Manage the ring buffer holding the body
+    void ResetSegments();
+    bool ReserveSegments( int length );
+
+    // Keep count of the segments on each cell
+    void ClearOccupancy();
+    void ResetOccupancy();
+    void ChangeOccupancy( int x, int y, int amount );
+
 protected:
 
     // No protected members.
@@ -202,6 +234,9 @@ public:
         return m_snakeSprite.GetFrameHeight();
     }
 
+    // Set the spawner to keep up to date with the cells taken by the snake
+    void SetSpawner( Spawner* spawner );
+
     // Collision functions
     void GetCollideRect(RECT* pSourceRect);
     int CheckCollision(RECT rcTarget, BOOL bExcludeHead = false);
@@ -210,7 +245,7 @@ public:
     void SetMovementDirection( int direction );
     inline int GetMovementDirection()
     {
-        return m_segments[0].nDirection;
+        return ( m_length > 0 ? GetSegment(0).nDirection : SNAKE_MOVE_NONE );
     }
 
     // Update the snake (position, animation, etc,.)
@@ -0,0 +1,357 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: spawner.cpp, spawner.h                                                              |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: Spawner                                                                             |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Class to keep track of the free cells of an area and pick one to spawn on  :-)      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+//==============================================================================================
+// Include Game System (GS) header files.
+// ---------------------------------------------------------------------------------------------
+#include "spawner.h"
+//==============================================================================================
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor/Destructor Methods //////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::Spawner():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The constructor, initializes class data when class object is created.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+Spawner::Spawner()
+{
+    SetRect(&m_areaRect, 0, 0, 0, 0);
+
+    m_cellWidth = 0;
+    m_cellHeight = 0;
+    m_cols = 0;
+    m_rows = 0;
+
+    m_blocked = NULL;
+    m_occupants = NULL;
+
+    m_freeCells = NULL;
+    m_freeIndex = NULL;
+    m_numFree = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::~Spawner():
+// ---------------------------------------------------------------------------------------------
+// Purpose: The de-structor, de-initializes class data when class object is destroyed.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+Spawner::~Spawner()
+{
+    this->Destroy();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::Create():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Divide an area into cells of the given size, all of them free
+// ---------------------------------------------------------------------------------------------
+// Returns: true if successful, false if not
+//==============================================================================================
+
+bool Spawner::Create( RECT areaRect, int cellWidth, int cellHeight )
+{
+    this->Destroy();
+
+    if( (cellWidth <= 0) || (cellHeight <= 0) ) return false;
+
+    m_areaRect = areaRect;
+
+    m_cellWidth = cellWidth;
+    m_cellHeight = cellHeight;
+    m_cols = (m_areaRect.right - m_areaRect.left) / m_cellWidth;
+    m_rows = (m_areaRect.top - m_areaRect.bottom) / m_cellHeight;
+
+    if( (m_cols <= 0) || (m_rows <= 0) ) {
+        m_cols = 0;
+        m_rows = 0;
+        return false;
+    }
+
+    m_blocked = new bool[m_cols * m_rows];
+    m_occupants = new int[m_cols * m_rows];
+    m_freeCells = new int[m_cols * m_rows];
+    m_freeIndex = new int[m_cols * m_rows];
+
+    this->Reset();
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::Destroy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Release the cells
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void Spawner::Destroy()
+{
+    if( m_blocked ) {
+        delete[] m_blocked;
+        m_blocked = NULL;
+    }
+
+    if( m_occupants ) {
+        delete[] m_occupants;
+        m_occupants = NULL;
+    }
+
+    if( m_freeCells ) {
+        delete[] m_freeCells;
+        m_freeCells = NULL;
+    }
+
+    if( m_freeIndex ) {
+        delete[] m_freeIndex;
+        m_freeIndex = NULL;
+    }
+
+    m_cols = 0;
+    m_rows = 0;
+    m_numFree = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::Reset():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Make all the cells free (not blocked and nothing on them)
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void Spawner::Reset()
+{
+    m_numFree = m_cols * m_rows;
+
+    for( int i = 0; i < m_numFree; i++ ) {
+        m_blocked[i] = false;
+        m_occupants[i] = 0;
+        m_freeCells[i] = i;
+        m_freeIndex[i] = i;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::GetCell():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Get the cell at the given coordinates
+// ---------------------------------------------------------------------------------------------
+// Returns: The index of the cell, -1 if the coordinates are outside of the area
+//==============================================================================================
+
+int Spawner::GetCell( int x, int y )
+{
+    if( (x < m_areaRect.left) || (y < m_areaRect.bottom) ) return -1;
+
+    int col = (x - m_areaRect.left) / m_cellWidth;
+    int row = (y - m_areaRect.bottom) / m_cellHeight;
+
+    if( (col >= m_cols) || (row >= m_rows) ) return -1;
+
+    return (row * m_cols) + col;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::UpdateCell():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Add the cell to the free cells if it has become free, or remove it if it no longer
+//          is. A cell is removed by moving the last free cell into its place.
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void Spawner::UpdateCell( int cell )
+{
+    bool isFree = (false == m_blocked[cell]) && (m_occupants[cell] <= 0);
+
+    // Has the cell become free?
+    if( isFree && (m_freeIndex[cell] < 0) ) {
+        m_freeIndex[cell] = m_numFree;
+        m_freeCells[m_numFree] = cell;
+        m_numFree++;
+    }
+    // Is the cell no longer free?
+    else if( (false == isFree) && (m_freeIndex[cell] >= 0) ) {
+        int lastCell = m_freeCells[m_numFree-1];
+
+        m_freeCells[m_freeIndex[cell]] = lastCell;
+        m_freeIndex[lastCell] = m_freeIndex[cell];
+        m_freeIndex[cell] = -1;
+        m_numFree--;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::SetBlocked():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Block or unblock the cell at the given coordinates
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void Spawner::SetBlocked( int x, int y, bool blocked )
+{
+    int cell = this->GetCell( x, y );
+
+    if( cell < 0 ) return;
+
+    m_blocked[cell] = blocked;
+    this->UpdateCell( cell );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::Occupy():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Add an amount to the number of things on the cell at the given coordinates, a
+//          negative amount removing them again
+// ---------------------------------------------------------------------------------------------
+// Returns: Nothing.
+//==============================================================================================
+
+void Spawner::Occupy( int x, int y, int amount )
+{
+    int cell = this->GetCell( x, y );
+
+    if( cell < 0 ) return;
+
+    m_occupants[cell] += amount;
+    this->UpdateCell( cell );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::IsFree():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Check whether the cell at the given coordinates is free
+// ---------------------------------------------------------------------------------------------
+// Returns: true if it is, false if not or if the coordinates are outside of the area
+//==============================================================================================
+
+bool Spawner::IsFree( int x, int y )
+{
+    int cell = this->GetCell( x, y );
+
+    return (cell >= 0) && (m_freeIndex[cell] >= 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::GetDistance():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Get the number of cells to move horizontally and vertically to get from a cell to a
+//          column and row, going around the edges of the area if that is shorter
+// ---------------------------------------------------------------------------------------------
+// Returns: The distance in cells
+//==============================================================================================
+
+int Spawner::GetDistance( int cell, int col, int row )
+{
+    int distanceX = abs( (cell % m_cols) - col );
+    int distanceY = abs( (cell / m_cols) - row );
+
+    distanceX = ( distanceX < m_cols - distanceX ? distanceX : m_cols - distanceX );
+    distanceY = ( distanceY < m_rows - distanceY ? distanceY : m_rows - distanceY );
+
+    return distanceX + distanceY;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+//==============================================================================================
+// Spawner::GetFreePosition():
+// ---------------------------------------------------------------------------------------------
+// Purpose: Pick one of the free cells at random, each as likely as the others. If a minimum
+//          distance is given only the cells at least that far from the away position are
+//          picked from. A few random picks are tried first and only if none of them is far
+//          enough are all the free cells looked through, so the time taken stays small even
+//          when nearly every cell is taken.
+// ---------------------------------------------------------------------------------------------
+// Returns: true and the coordinates of the bottom left of the cell if one was found, false if
+//          there is no (far enough) free cell
+//==============================================================================================
+
+bool Spawner::GetFreePosition( int* pX, int* pY, int awayX, int awayY, int minDistance )
+{
+    if( m_numFree <= 0 ) return false;
+
+    int cell = m_freeCells[rand() % m_numFree];
+
+    // Is there a position to stay away from?
+    int awayCell = this->GetCell( awayX, awayY );
+
+    if( (minDistance > 0) && (awayCell >= 0) ) {
+        int awayCol = awayCell % m_cols;
+        int awayRow = awayCell / m_cols;
+
+        int tries = 1;
+        while( (this->GetDistance( cell, awayCol, awayRow ) < minDistance) &&
+               (tries < SPAWNER_MAX_TRIES) ) {
+            cell = m_freeCells[rand() % m_numFree];
+            tries++;
+        }
+
+        // Were all the picks too close?
+        if( this->GetDistance( cell, awayCol, awayRow ) < minDistance ) {
+            // Pick from all the free cells that are far enough, keeping each one found with a
+            // chance of one in the number found so far
+            int numFound = 0;
+
+            for( int i = 0; i < m_numFree; i++ ) {
+                if( this->GetDistance( m_freeCells[i], awayCol, awayRow ) < minDistance ) continue;
+
+                numFound++;
+                if( (rand() % numFound) == 0 ) {
+                    cell = m_freeCells[i];
+                }
+            }
+
+            if( numFound == 0 ) return false;
+        }
+    }
+
+    *pX = m_areaRect.left + ((cell % m_cols) * m_cellWidth);
+    *pY = m_areaRect.bottom + ((cell / m_cols) * m_cellHeight);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,108 @@
+/*============================================================================================+
+ | Game System (GS) Library                                                                   |
+ |--------------------------------------------------------------------------------------------|
+ | FILES: spawner.cpp, spawner.h                                                              |
+ |--------------------------------------------------------------------------------------------|
+ | CLASS: Spawner                                                                             |
+ |--------------------------------------------------------------------------------------------|
+ | ABOUT: Class to keep track of the free cells of an area and pick one to spawn on  :-)      |
+ |--------------------------------------------------------------------------------------------|
+ |                                                                                    10/2026 |
+ +============================================================================================*/
+
+
+#ifndef SPAWNER_H
+#define SPAWNER_H
+
+
+//================================================================================================
+// Include platform abstraction header files.
+// -----------------------------------------------------------------------------------------------
+#include "gs_platform.h"
+//================================================================================================
+
+
+//================================================================================================
+// Include standard C library header files.
+// -----------------------------------------------------------------------------------------------
+#include <stdlib.h>
+//================================================================================================
+
+
+//==============================================================================================
+// Spawner defines.
+// ---------------------------------------------------------------------------------------------
+#define SPAWNER_MAX_TRIES 8 // Random picks tried before looking through all the free cells
+// ---------------------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Definition. ///////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+class Spawner
+{
+
+private:
+
+    RECT m_areaRect; // A rectangle indicating the coordinates of the area divided into cells
+
+    int m_cellWidth;  // The size of a cell in pixels
+    int m_cellHeight;
+    int m_cols;       // The number of columns and rows of cells in the area
+    int m_rows;
+
+    bool* m_blocked;  // Whether each cell is blocked (by a wall for instance)
+    int* m_occupants; // The number of things (snake segments for instance) on each cell
+
+    int* m_freeCells; // The free cells, only the first m_numFree are used
+    int* m_freeIndex; // The position of each cell in m_freeCells, -1 if it is not free
+    int m_numFree;    // The number of free cells
+
+    // Get the cell at the given coordinates, -1 if outside of the area
+    int GetCell( int x, int y );
+
+    // Add the cell to or remove it from the free cells
+    void UpdateCell( int cell );
+
+    // Get the distance in cells between two cells, going around the edges of the area
+    int GetDistance( int cell, int col, int row );
+
+protected:
+
+    // No protected members.
+
+public:
+
+    Spawner();
+    ~Spawner();
+
+    bool Create( RECT areaRect, int cellWidth, int cellHeight );
+    void Destroy();
+
+    // Make all the cells free
+    void Reset();
+
+    // Block or unblock the cell at the given coordinates
+    void SetBlocked( int x, int y, bool blocked );
+
+    // Add an amount (negative to remove) to the number of things on the cell at the coordinates
+    void Occupy( int x, int y, int amount = 1 );
+
+    // Check whether the cell at the given coordinates is free
+    bool IsFree( int x, int y );
+
+    // Get the number of free cells
+    inline int GetNumFree()
+    {
+        return m_numFree;
+    }
+
+    // Pick a free cell at random, optionally at least a distance (in cells) away from a position
+    bool GetFreePosition( int* pX, int* pY, int awayX = -1, int awayY = -1, int minDistance = 0 );
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif